@@ -98,6 +98,15 @@ main(int argc, char** argv) {
     return 1;
   }
 
+  // Netlink receive buffer sizes are passed to netlink socket as unsigned
+  if (FLAGS_netlink_rcvbuf_bytes < 0 or FLAGS_netlink_max_rcvbuf_bytes < 0) {
+    XLOG(ERR) << "Invalid netlink receive buffer size. "
+              << "--netlink_rcvbuf_bytes: " << FLAGS_netlink_rcvbuf_bytes
+              << ", --netlink_max_rcvbuf_bytes: "
+              << FLAGS_netlink_max_rcvbuf_bytes << ". Must be non-negative.";
+    return 1;
+  }
+
   // start config module
   std::shared_ptr<Config> config;
   try {
@@ -243,7 +252,11 @@ main(int argc, char** argv) {
   // NOTE: Start EventBase only after NetlinkProtocolSocket has been constructed
   auto nlOpenrEvb = std::make_unique<OpenrEventBase>();
   auto nlSock = std::make_unique<openr::fbnl::NetlinkProtocolSocket>(
-      nlOpenrEvb->getEvb(), netlinkEventsQueue);
+      nlOpenrEvb->getEvb(),
+      netlinkEventsQueue,
+      false /* enableIPv6RouteReplaceSemantics */,
+      FLAGS_netlink_rcvbuf_bytes,
+      FLAGS_netlink_max_rcvbuf_bytes);
   startEventBase(
       allThreads, orderedEvbs, watchdog, "netlink", std::move(nlOpenrEvb));
   watchdog->addQueue(netlinkEventsQueue, "netlinkEventsQueue");
@@ -306,6 +319,11 @@ main(int argc, char** argv) {
           logSampleQueue,
           config->getAreaIds(),
           config->toThriftKvStoreConfig()));
+  if (watchdog) {
+    for (auto* areaEvb : kvStore->getAreaEvbs()) {
+      watchdog->addEvb(areaEvb);
+    }
+  }
   watchdog->addQueue(kvStoreUpdatesQueue, "kvStoreUpdatesQueue");
 
   // Start Dispatcher
@@ -476,7 +494,8 @@ main(int argc, char** argv) {
       prefixManager,
       spark,
       config,
-      dispatcher);
+      dispatcher,
+      watchdog);
   startEventBase(
       allThreads, orderedEvbs, watchdog, "ctrl_evb", std::move(ctrlOpenrEvb));
 
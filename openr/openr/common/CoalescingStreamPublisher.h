@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <fb303/ServiceData.h>
+#include <fmt/format.h>
+#include <folly/CancellationToken.h>
+#include <folly/ExceptionWrapper.h>
+#include <folly/Function.h>
+#include <folly/experimental/coro/AsyncGenerator.h>
+#include <folly/experimental/coro/Baton.h>
+#include <folly/logging/xlog.h>
+#include <thrift/lib/cpp2/async/ServerStream.h>
+
+namespace openr {
+
+/**
+ * Drop-in replacement of `apache::thrift::ServerStreamPublisher` with a bounded
+ * per-subscriber queue.
+ *
+ * ServerStreamPublisher buffers every update until the client consumes it, and
+ * hence a stuck client lets its buffer grow without bound inside the server.
+ * CoalescingStreamPublisher backs the stream with a generator pulling from its
+ * own queue, which is drained only as fast as the client grants credits. When
+ * the number of pending updates reaches the high watermark, the subscriber is
+ * considered slow and either
+ * - pending updates are coalesced with `coalesce`, i.e. merged into the
+ *   minimal list of updates having the same effect. Memory is then bounded by
+ *   the size of the module state instead of the number of updates, or
+ * - if `dropSlowSubscriber` is set, the stream is terminated with an error and
+ *   client is expected to re-subscribe (and re-snapshot).
+ *
+ * Exports counters
+ * - ctrl.stream.<name>.slow_subscriber.count: watermark crossings
+ * - ctrl.stream.<name>.coalesced_updates.sum: updates merged away
+ * - ctrl.stream.<name>.dropped_subscriber.count: streams terminated
+ */
+template <typename T>
+class CoalescingStreamPublisher final {
+ public:
+  struct Options {
+    // name of the stream, used in counters
+    std::string name;
+    // number of pending updates at which subscriber is considered slow
+    size_t highWatermark{1024};
+    // terminate slow subscriber instead of coalescing its pending updates
+    bool dropSlowSubscriber{false};
+    // merge pending updates, in order, into fewer updates with same effect
+    std::vector<T> (*coalesce)(std::vector<T>&&){nullptr};
+  };
+
+  /**
+   * Create stream and its publisher. `onStreamCompleteOrCancel` is invoked
+   * once the stream terminates, either on completion or on cancellation by
+   * the client.
+   */
+  static std::pair<apache::thrift::ServerStream<T>, CoalescingStreamPublisher>
+  createPublisher(
+      Options options, folly::Function<void()> onStreamCompleteOrCancel) {
+    CHECK_GT(options.highWatermark, 0);
+    CHECK(options.dropSlowSubscriber or options.coalesce);
+    auto state = std::make_shared<State>(std::move(options));
+    return std::make_pair(
+        apache::thrift::ServerStream<T>(
+            generate(
+                state,
+                CompletionCallback(std::move(onStreamCompleteOrCancel)))),
+        CoalescingStreamPublisher(state));
+  }
+
+  CoalescingStreamPublisher(CoalescingStreamPublisher&&) noexcept = default;
+  CoalescingStreamPublisher& operator=(CoalescingStreamPublisher&&) noexcept =
+      default;
+
+  ~CoalescingStreamPublisher() {
+    // Stream must be terminated if it's not explicitly completed
+    if (state_) {
+      complete();
+    }
+  }
+
+  // Enqueue update for the subscriber
+  void
+  next(T value) const {
+    {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      if (state_->completed) {
+        return;
+      }
+      state_->pending.emplace_back(std::move(value));
+      if (state_->pending.size() >= state_->options.highWatermark) {
+        onSlowSubscriber();
+      }
+    }
+    state_->baton.post();
+  }
+
+  // Terminate the stream once pending updates are consumed
+  void
+  complete() const {
+    complete(folly::exception_wrapper());
+  }
+
+  void
+  complete(folly::exception_wrapper ew) const {
+    {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      if (state_->completed) {
+        return;
+      }
+      state_->completed = true;
+      state_->error = std::move(ew);
+    }
+    state_->baton.post();
+  }
+
+  // Number of updates not yet consumed by the subscriber
+  size_t
+  getNumPending() const {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    return state_->pending.size();
+  }
+
+ private:
+  struct State {
+    explicit State(Options options)
+        : options(std::move(options)),
+          slowSubscriberCounter(fmt::format(
+              "ctrl.stream.{}.slow_subscriber", this->options.name)),
+          coalescedUpdatesCounter(fmt::format(
+              "ctrl.stream.{}.coalesced_updates", this->options.name)),
+          droppedSubscriberCounter(fmt::format(
+              "ctrl.stream.{}.dropped_subscriber", this->options.name)) {}
+
+    const Options options;
+    const std::string slowSubscriberCounter;
+    const std::string coalescedUpdatesCounter;
+    const std::string droppedSubscriberCounter;
+
+    std::mutex mutex;
+    std::deque<T> pending;
+    bool completed{false};
+    folly::exception_wrapper error;
+
+    // Posted on every change of the state above
+    folly::coro::Baton baton;
+  };
+
+  explicit CoalescingStreamPublisher(std::shared_ptr<State> state)
+      : state_(std::move(state)) {}
+
+  // NOTE: Invoked with the state lock held
+  void
+  onSlowSubscriber() const {
+    auto& state = *state_;
+    facebook::fb303::fbData->addStatValue(
+        state.slowSubscriberCounter, 1, facebook::fb303::COUNT);
+
+    if (state.options.dropSlowSubscriber) {
+      XLOG(WARNING) << "Terminating slow " << state.options.name
+                    << " stream subscriber with " << state.pending.size()
+                    << " pending updates";
+      facebook::fb303::fbData->addStatValue(
+          state.droppedSubscriberCounter, 1, facebook::fb303::COUNT);
+      state.pending.clear();
+      state.completed = true;
+      state.error = folly::make_exception_wrapper<std::runtime_error>(
+          fmt::format(
+              "Slow subscriber of {} stream. Re-subscribe to get a snapshot.",
+              state.options.name));
+      return;
+    }
+
+    const auto numPending = state.pending.size();
+    std::vector<T> updates(
+        std::make_move_iterator(state.pending.begin()),
+        std::make_move_iterator(state.pending.end()));
+    state.pending.clear();
+    for (auto& update : state.options.coalesce(std::move(updates))) {
+      state.pending.emplace_back(std::move(update));
+    }
+    XLOG(DBG1) << "Coalesced " << numPending << " pending updates of "
+               << state.options.name << " stream subscriber into "
+               << state.pending.size();
+    facebook::fb303::fbData->addStatValue(
+        state.coalescedUpdatesCounter,
+        numPending - state.pending.size(),
+        facebook::fb303::SUM);
+  }
+
+  // Invokes callback on destruction. Being a parameter of the generator, it
+  // is destroyed with the generator even if the generator was never started.
+  struct CompletionCallback {
+    explicit CompletionCallback(folly::Function<void()> callback)
+        : callback(std::move(callback)) {}
+
+    CompletionCallback(CompletionCallback&&) noexcept = default;
+
+    ~CompletionCallback() {
+      // NOTE: Moved-from callback is empty
+      if (callback) {
+        callback();
+      }
+    }
+
+    folly::Function<void()> callback;
+  };
+
+  static folly::coro::AsyncGenerator<T&&>
+  generate(std::shared_ptr<State> state, CompletionCallback /* onComplete */) {
+    // Wake up on cancellation by the client
+    auto token = co_await folly::coro::co_current_cancellation_token;
+    folly::CancellationCallback cb(token, [&state] { state->baton.post(); });
+
+    while (true) {
+      std::optional<T> value;
+      folly::exception_wrapper error;
+      bool completed{false};
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (not state->pending.empty()) {
+          value = std::move(state->pending.front());
+          state->pending.pop_front();
+        } else if (state->completed) {
+          completed = true;
+          error = std::move(state->error);
+        } else {
+          // Reset under lock, publisher posts after enqueueing
+          state->baton.reset();
+        }
+      }
+
+      if (value.has_value()) {
+        co_yield std::move(value).value();
+        continue;
+      }
+      if (completed) {
+        if (error) {
+          co_yield folly::coro::co_error(std::move(error));
+        }
+        co_return;
+      }
+      if (token.isCancellationRequested()) {
+        co_return;
+      }
+      co_await state->baton;
+    }
+  }
+
+  std::shared_ptr<State> state_;
+};
+
+} // namespace openr
@@ -47,6 +47,23 @@ class Constants {
   // event log category
   static constexpr folly::StringPiece kEventLogCategory{"perfpipe_aquaman"};
 
+  // interval of the timer measuring event loop lag of OpenrEventBase
+  static constexpr std::chrono::milliseconds kEvbLoopLagProbeInterval{100};
+
+  // event loop and queue latency stats cover one to two windows of this size
+  static constexpr std::chrono::seconds kRuntimeStatsWindow{60};
+
+  // number of recent slow event loop iterations retained per OpenrEventBase
+  static constexpr size_t kEvbMaxSlowLoops{32};
+
+  // interval of draining CPU profiler samples, and window of CPU profiles
+  static constexpr std::chrono::seconds kCpuProfileCollectInterval{1};
+  static constexpr std::chrono::seconds kCpuProfileWindow{300};
+
+  // heap profiles are dumped to rotated files <prefix>.<index>.heap
+  static constexpr folly::StringPiece kHeapProfilePrefix{"/tmp/openr_heap"};
+  static constexpr uint32_t kMaxHeapProfiles{3};
+
   /*
    * [Exponential Backoff Constants]
    */
@@ -86,6 +103,18 @@ class Constants {
       100};
   static constexpr std::chrono::milliseconds kPersistentStoreMaxBackoff{5000};
 
+  // Min/max backoff for saving route snapshot used for warm-start
+  static constexpr std::chrono::milliseconds kRouteSnapshotSaveMinBackoff{1s};
+  static constexpr std::chrono::milliseconds kRouteSnapshotSaveMaxBackoff{10s};
+
+  // Max number of pending KvStore publications drained and coalesced by
+  // Decision into a single batch
+  static constexpr size_t kDecisionMaxPublicationBatch{1000};
+
+  // Max number of (src, dest, k) results of k-th shortest paths memoized per
+  // area, evicted in LRU order
+  static constexpr size_t kKthPathsCacheSize{10000};
+
   /*
    * [LinkMonitor Constants]
    */
@@ -99,6 +128,10 @@ class Constants {
   // Adjacency DOWN event is immediately advertised.
   static constexpr std::chrono::milliseconds kAdjacencyThrottleTimeout{1000};
 
+  // Interval for batched publication of per-neighbor metric counters
+  static constexpr std::chrono::milliseconds
+      kNeighborMetricCountersPublishInterval{1000};
+
   /*
    * [Spark Constants]
    */
@@ -207,6 +240,17 @@ class Constants {
   // hold time for longPoll requests in openrCtrl thrift server
   static constexpr std::chrono::milliseconds kLongPollReqHoldTime{20000};
 
+  // number of recent deltas retained per stream type in openrCtrl thrift
+  // server, for clients resuming the stream after reconnection
+  static constexpr size_t kCtrlStreamReplayBufferSize{1024};
+
+  // max total serialized size of the deltas retained per stream type
+  static constexpr size_t kCtrlStreamReplayBufferMaxBytes{32 * 1024 * 1024};
+
+  // deltas are retained while streams are active, and for this long after the
+  // last stream ended to allow it to resume
+  static constexpr std::chrono::seconds kCtrlStreamReplayRetention{300};
+
   //
   // Prefix manager specific
   //
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <openr/common/ConvergenceStats.h>
+
+#include <algorithm>
+
+#include <fb303/ServiceData.h>
+#include <fmt/format.h>
+
+#include <openr/common/LsdbUtil.h>
+
+namespace fb303 = facebook::fb303;
+
+namespace openr {
+
+namespace {
+
+// Percentiles exported as counters
+const std::vector<std::pair<std::string, double>> kCounterPercentiles = {
+    {"p50", 50}, {"p90", 90}, {"p99", 99}};
+
+} // namespace
+
+thrift::LatencyStats
+toLatencyStats(const LatencyHistogram& histogram) {
+  thrift::LatencyStats stats;
+  stats.count() = histogram.getCount();
+  stats.minMs() = histogram.getMin();
+  stats.maxMs() = histogram.getMax();
+  stats.avgMs() = histogram.getAvg();
+  stats.p50Ms() = histogram.getPercentile(50);
+  stats.p90Ms() = histogram.getPercentile(90);
+  stats.p99Ms() = histogram.getPercentile(99);
+  for (size_t i = 0; i < LatencyHistogram::kNumBuckets; ++i) {
+    if (auto count = histogram.getBucketCount(i)) {
+      stats.buckets()->emplace(LatencyHistogram::getBucketUpperBound(i), count);
+    }
+  }
+  return stats;
+}
+
+//
+// ConvergenceStats
+//
+
+ConvergenceStats::ConvergenceStats(std::string counterPrefix)
+    : counterPrefix_(std::move(counterPrefix)) {
+  stages_.emplace_back(Stage{
+      "flood",
+      thrift::PerfEventType::ADJ_DB_UPDATED,
+      thrift::PerfEventType::DECISION_RECEIVED,
+      {}});
+  stages_.emplace_back(Stage{
+      "spf",
+      thrift::PerfEventType::DECISION_RECEIVED,
+      thrift::PerfEventType::ROUTE_UPDATE,
+      {}});
+  stages_.emplace_back(Stage{
+      "fib_program",
+      thrift::PerfEventType::ROUTE_UPDATE,
+      thrift::PerfEventType::FIB_ROUTES_PROGRAMMED,
+      {}});
+  stages_.emplace_back(Stage{
+      "total",
+      thrift::PerfEventType::UNKNOWN,
+      thrift::PerfEventType::FIB_ROUTES_PROGRAMMED,
+      {}});
+}
+
+void
+ConvergenceStats::record(const thrift::PerfEvents& perfEvents) {
+  const auto& events = *perfEvents.events();
+  if (events.empty()) {
+    return;
+  }
+
+  // Types are resolved once, as stages share the boundary events
+  std::vector<thrift::PerfEventType> types;
+  types.reserve(events.size());
+  for (const auto& event : events) {
+    types.emplace_back(getPerfEventType(event));
+  }
+
+  for (auto& stage : stages_) {
+    // First occurrence of `from`, followed by first occurrence of `to`
+    auto fromIt = stage.from == thrift::PerfEventType::UNKNOWN
+        ? types.begin()
+        : std::find(types.begin(), types.end(), stage.from);
+    if (fromIt == types.end()) {
+      continue;
+    }
+    auto toIt = std::find(fromIt + 1, types.end(), stage.to);
+    if (toIt == types.end()) {
+      continue;
+    }
+    const auto duration = *events.at(toIt - types.begin()).unixTs() -
+        *events.at(fromIt - types.begin()).unixTs();
+    if (duration < 0) {
+      continue;
+    }
+    stage.histogram.addValue(duration);
+    updateCounters(stage);
+  }
+}
+
+thrift::ConvergenceStats
+ConvergenceStats::toThrift() const {
+  thrift::ConvergenceStats stats;
+  for (const auto& stage : stages_) {
+    stats.stages()->emplace(stage.name, toLatencyStats(stage.histogram));
+  }
+  return stats;
+}
+
+void
+ConvergenceStats::updateCounters(const Stage& stage) const {
+  const auto& histogram = stage.histogram;
+  for (const auto& [suffix, pct] : kCounterPercentiles) {
+    fb303::fbData->setCounter(
+        fmt::format("{}.{}_ms.{}", counterPrefix_, stage.name, suffix),
+        histogram.getPercentile(pct));
+  }
+  fb303::fbData->setCounter(
+      fmt::format("{}.{}_ms.count", counterPrefix_, stage.name),
+      histogram.getCount());
+}
+
+} // namespace openr
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <openr/common/LatencyHistogram.h>
+#include <openr/if/gen-cpp2/Types_types.h>
+
+namespace openr {
+
+/**
+ * Convert histogram of values in ms to thrift
+ */
+thrift::LatencyStats toLatencyStats(const LatencyHistogram& histogram);
+
+/**
+ * Tracks latency distributions of convergence stages, measured between typed
+ * perf events of route updates, see `thrift::ConvergenceStats` for stages.
+ * Percentiles of every stage are exported as fb303 counters
+ * `<counterPrefix>.<stage>_ms.p50|p90|p99` along with `.count`.
+ *
+ * NOTE: Not thread-safe. Meant to be owned by module's event base.
+ */
+class ConvergenceStats {
+ public:
+  explicit ConvergenceStats(std::string counterPrefix);
+
+  /**
+   * Record all stages found in perf events of a converged update. Stages with
+   * missing events, or with negative duration due to clock skew across nodes,
+   * are skipped.
+   */
+  void record(const thrift::PerfEvents& perfEvents);
+
+  thrift::ConvergenceStats toThrift() const;
+
+ private:
+  struct Stage {
+    std::string name;
+    // Start of the stage. UNKNOWN denotes the first event.
+    thrift::PerfEventType from;
+    thrift::PerfEventType to;
+    LatencyHistogram histogram;
+  };
+
+  void updateCounters(const Stage& stage) const;
+
+  const std::string counterPrefix_;
+  std::vector<Stage> stages_;
+};
+
+} // namespace openr
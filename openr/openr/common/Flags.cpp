@@ -38,3 +38,60 @@ DEFINE_string(
     rib_policy_file,
     "/dev/shm/rib_policy.txt",
     "File in which thrift::RibPolicy is stored across Open/R restarts");
+DEFINE_string(
+    route_snapshot_file,
+    "/dev/shm/openr_route_snapshot.bin",
+    "File in which routes computed by Decision are stored across Open/R "
+    "restarts for warm-start");
+DEFINE_int32(
+    netlink_rcvbuf_bytes,
+    1 * 1024 * 1024,
+    "Initial receive buffer size of netlink socket");
+DEFINE_int32(
+    netlink_max_rcvbuf_bytes,
+    16 * 1024 * 1024,
+    "Maximum receive buffer size of netlink socket. Receive buffer is grown "
+    "up to this size on receive buffer overrun");
+DEFINE_int32(
+    ctrl_stream_high_watermark,
+    1024,
+    "Number of pending updates of a ctrl-server stream subscriber at which it "
+    "is considered slow, and its pending updates are coalesced");
+DEFINE_bool(
+    ctrl_stream_drop_slow_subscriber,
+    false,
+    "Terminate the stream of a slow subscriber instead of coalescing its "
+    "pending updates. Client is expected to re-subscribe.");
+DEFINE_string(
+    event_log_file,
+    "",
+    "File to which Monitor appends event logs in binary format. Disabled if "
+    "empty. Read with `EventLogFileSink::readFile()`.");
+DEFINE_int32(
+    event_log_file_max_bytes,
+    10 * 1024 * 1024,
+    "Size of event log file at which it is rotated");
+DEFINE_int32(
+    event_log_file_max_files,
+    3,
+    "Number of event log files to keep, including the current one");
+DEFINE_int32(
+    evb_loop_sample_rate,
+    1,
+    "Busy time of every N-th iteration of OpenrEventBase loops is sampled");
+DEFINE_int32(
+    evb_slow_loop_threshold_ms,
+    100,
+    "Busy time of an OpenrEventBase loop iteration at which it is logged as "
+    "slow");
+DEFINE_int32(
+    cpu_profiler_hz,
+    0,
+    "Frequency of stack samples per second of CPU time of every module's "
+    "thread. Retrieved as folded stacks with `getProcessProfile`. Disabled if "
+    "0.");
+DEFINE_bool(
+    decision_verify_route_delta,
+    false,
+    "Verify route delta computed by Decision on full route builds against full "
+    "comparison of all routes. Expensive, meant for debugging.");
@@ -22,3 +22,27 @@ DECLARE_string(tls_ecc_curve_name);
 
 // file storing thrift::RibPolicy
 DECLARE_string(rib_policy_file);
+DECLARE_string(route_snapshot_file);
+
+// netlink socket receive buffer
+DECLARE_int32(netlink_rcvbuf_bytes);
+DECLARE_int32(netlink_max_rcvbuf_bytes);
+
+// bounded per-subscriber queues of ctrl-server streams
+DECLARE_int32(ctrl_stream_high_watermark);
+DECLARE_bool(ctrl_stream_drop_slow_subscriber);
+
+// binary event log file written by Monitor
+DECLARE_string(event_log_file);
+DECLARE_int32(event_log_file_max_bytes);
+DECLARE_int32(event_log_file_max_files);
+
+// event loop instrumentation of OpenrEventBase
+DECLARE_int32(evb_loop_sample_rate);
+DECLARE_int32(evb_slow_loop_threshold_ms);
+
+// sampling CPU profiler of module threads
+DECLARE_int32(cpu_profiler_hz);
+
+// verification of route delta computed by Decision
+DECLARE_bool(decision_verify_route_delta);
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <openr/common/LatencyHistogram.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <folly/lang/Bits.h>
+
+namespace openr {
+
+//
+// LatencyHistogram
+//
+
+void
+LatencyHistogram::addValue(int64_t value) {
+  value = std::clamp<int64_t>(value, 0, kMaxValue);
+  ++buckets_.at(getBucketIndex(value));
+  min_ = count_ ? std::min(min_, value) : value;
+  max_ = std::max(max_, value);
+  sum_ += value;
+  ++count_;
+}
+
+int64_t
+LatencyHistogram::getPercentile(double pct) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  // Rank of the sample at given percentile, 1-based
+  const auto rank = std::max<int64_t>(
+      1, static_cast<int64_t>(std::ceil(pct / 100 * count_)));
+  int64_t cumulative{0};
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    cumulative += buckets_[i];
+    if (cumulative >= rank) {
+      return std::min(getBucketUpperBound(i), max_);
+    }
+  }
+  return max_;
+}
+
+void
+LatencyHistogram::clear() {
+  *this = LatencyHistogram();
+}
+
+void
+LatencyHistogram::merge(const LatencyHistogram& other) {
+  if (other.count_ == 0) {
+    return;
+  }
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    buckets_[i] += other.buckets_[i];
+  }
+  min_ = count_ ? std::min(min_, other.min_) : other.min_;
+  max_ = std::max(max_, other.max_);
+  sum_ += other.sum_;
+  count_ += other.count_;
+}
+
+size_t
+LatencyHistogram::getBucketIndex(int64_t value) {
+  value = std::clamp<int64_t>(value, 0, kMaxValue);
+  if (value < 2 * kSubBuckets) {
+    return value;
+  }
+  // Values in [2^msb, 2^(msb+1)) are split into `kSubBuckets` buckets of
+  // width 2^shift
+  const int msb = folly::findLastSet(static_cast<uint64_t>(value)) - 1;
+  const int shift = msb - kSubBucketBits;
+  return (shift + 1) * kSubBuckets + ((value >> shift) - kSubBuckets);
+}
+
+int64_t
+LatencyHistogram::getBucketLowerBound(size_t index) {
+  if (index < 2 * kSubBuckets) {
+    return index;
+  }
+  const int shift = index / kSubBuckets - 1;
+  return (kSubBuckets + index % kSubBuckets) << shift;
+}
+
+int64_t
+LatencyHistogram::getBucketUpperBound(size_t index) {
+  if (index + 1 >= kNumBuckets) {
+    return kMaxValue;
+  }
+  return getBucketLowerBound(index + 1) - 1;
+}
+
+//
+// WindowedLatencyHistogram
+//
+
+void
+WindowedLatencyHistogram::addValue(
+    int64_t value, std::chrono::steady_clock::time_point now) {
+  rotate(now);
+  current_.addValue(value);
+}
+
+LatencyHistogram
+WindowedLatencyHistogram::get(std::chrono::steady_clock::time_point now) const {
+  LatencyHistogram histogram;
+  const auto elapsed = now - windowStart_;
+  if (elapsed < 2 * window_) {
+    // Current window is still recent
+    histogram.merge(current_);
+  }
+  if (elapsed < window_) {
+    histogram.merge(previous_);
+  }
+  return histogram;
+}
+
+void
+WindowedLatencyHistogram::rotate(std::chrono::steady_clock::time_point now) {
+  const auto elapsed = now - windowStart_;
+  if (elapsed < window_) {
+    return;
+  }
+  if (elapsed < 2 * window_) {
+    previous_ = current_;
+    windowStart_ += window_;
+  } else {
+    // No values were recorded in the last window
+    previous_.clear();
+    windowStart_ = now;
+  }
+  current_.clear();
+}
+
+} // namespace openr
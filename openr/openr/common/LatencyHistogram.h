@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace openr {
+
+/**
+ * Fixed-bucket latency histogram with log-linear (HDR-style) buckets. Values
+ * below 16 have their own bucket, and every power of two above is split into
+ * 8 linear buckets. Hence reported percentiles are within 12.5% of the exact
+ * value, for values up to `kMaxValue`. Larger values are clamped.
+ *
+ * All buckets are preallocated, and recording a value doesn't allocate.
+ * Fixed bucket boundaries allow histograms of different nodes to be summed up.
+ * Unit of values is up to the user.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr int kSubBucketBits{3};
+  static constexpr int64_t kSubBuckets{1 << kSubBucketBits};
+  // Values up to ~4.6 hours in ms, or ~16 seconds in us
+  static constexpr int kMaxValueBits{24};
+  static constexpr int64_t kMaxValue{(int64_t(1) << kMaxValueBits) - 1};
+  static constexpr size_t kNumBuckets{
+      (kMaxValueBits - kSubBucketBits + 1) * kSubBuckets};
+
+  // Record value. Negative values are recorded as 0.
+  void addValue(int64_t value);
+
+  /**
+   * Upper bound of the bucket holding given percentile, in [0, 100], capped by
+   * the maximum recorded value. Returns 0 if histogram is empty.
+   */
+  int64_t getPercentile(double pct) const;
+
+  int64_t
+  getCount() const {
+    return count_;
+  }
+
+  int64_t
+  getMin() const {
+    return count_ ? min_ : 0;
+  }
+
+  int64_t
+  getMax() const {
+    return max_;
+  }
+
+  int64_t
+  getAvg() const {
+    return count_ ? sum_ / count_ : 0;
+  }
+
+  // Number of values recorded in the bucket
+  int64_t
+  getBucketCount(size_t index) const {
+    return buckets_.at(index);
+  }
+
+  // Reset to empty histogram
+  void clear();
+
+  // Add all values recorded by other histogram
+  void merge(const LatencyHistogram& other);
+
+  // Bucket of the value, and inclusive bounds of a bucket
+  static size_t getBucketIndex(int64_t value);
+  static int64_t getBucketLowerBound(size_t index);
+  static int64_t getBucketUpperBound(size_t index);
+
+ private:
+  std::array<int64_t, kNumBuckets> buckets_{};
+  int64_t count_{0};
+  int64_t sum_{0};
+  int64_t min_{0};
+  int64_t max_{0};
+};
+
+/**
+ * Latency histogram of recent values only. Values are recorded in windows of
+ * fixed duration, and the histogram covers the current and the previous
+ * window, i.e. between one and two window durations of most recent values.
+ *
+ * NOTE: Not thread-safe.
+ */
+class WindowedLatencyHistogram {
+ public:
+  explicit WindowedLatencyHistogram(std::chrono::steady_clock::duration window)
+      : window_(window) {}
+
+  void addValue(
+      int64_t value,
+      std::chrono::steady_clock::time_point now =
+          std::chrono::steady_clock::now());
+
+  LatencyHistogram get(
+      std::chrono::steady_clock::time_point now =
+          std::chrono::steady_clock::now()) const;
+
+ private:
+  // Start new window if current one has elapsed
+  void rotate(std::chrono::steady_clock::time_point now);
+
+  const std::chrono::steady_clock::duration window_;
+  std::chrono::steady_clock::time_point windowStart_{
+      std::chrono::steady_clock::now()};
+  LatencyHistogram current_;
+  LatencyHistogram previous_;
+};
+
+} // namespace openr
@@ -5,18 +5,175 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <deque>
+#include <vector>
+
 #include <fmt/core.h>
+#include <folly/Indestructible.h>
+#include <folly/SharedMutex.h>
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
 
 #include <openr/common/LsdbTypes.h>
 #include <re2/re2.h>
 
 namespace openr {
 
+namespace {
+
+struct NodeNames {
+  // Names are never erased, hence views and references on them stay valid
+  std::deque<std::string> names;
+  folly::F14FastMap<std::string_view, uint32_t> ids;
+};
+
+folly::Synchronized<NodeNames, folly::SharedMutex>&
+getNodeNames() {
+  static folly::Indestructible<
+      folly::Synchronized<NodeNames, folly::SharedMutex>>
+      nodeNames;
+  return *nodeNames;
+}
+
+// Per-thread cache of the intern table. Lookups of names already interned
+// don't contend on the process-wide lock.
+struct NodeNamesCache {
+  folly::F14FastMap<std::string_view, uint32_t> ids;
+  std::vector<std::string const*> names;
+};
+
+NodeNamesCache&
+getNodeNamesCache() {
+  static thread_local NodeNamesCache cache;
+  return cache;
+}
+
+inline bool
+isDigit(char c) {
+  return c >= '0' and c <= '9';
+}
+
+inline bool
+isNodeNameChar(char c) {
+  return isDigit(c) or (c >= 'a' and c <= 'z') or (c >= 'A' and c <= 'Z') or
+      c == '.' or c == '-' or c == '_';
+}
+
+inline bool
+isIpAddressChar(char c) {
+  return isDigit(c) or (c >= 'a' and c <= 'f') or (c >= 'A' and c <= 'F') or
+      c == '.' or c == ':';
+}
+
+/**
+ * Tokenize `prefix:<node>:[<ip>/<plen>]` in a single pass, without
+ * allocation. Accepts exactly the keys matched by PrefixKey::getPrefixRE2V2().
+ */
+bool
+tokenizePrefixKey(
+    std::string_view key,
+    std::string_view& node,
+    std::string_view& ip,
+    int& plen) {
+  const std::string_view marker{
+      Constants::kPrefixDbMarker.data(), Constants::kPrefixDbMarker.size()};
+  if (key.substr(0, marker.size()) != marker) {
+    return false;
+  }
+  size_t pos = marker.size();
+
+  const auto nodeStart = pos;
+  while (pos < key.size() and isNodeNameChar(key[pos])) {
+    ++pos;
+  }
+  if (pos == nodeStart or key.substr(pos, 2) != ":[") {
+    return false;
+  }
+  node = key.substr(nodeStart, pos - nodeStart);
+  pos += 2;
+
+  const auto ipStart = pos;
+  while (pos < key.size() and isIpAddressChar(key[pos])) {
+    ++pos;
+  }
+  if (pos == ipStart or pos == key.size() or key[pos] != '/') {
+    return false;
+  }
+  ip = key.substr(ipStart, pos - ipStart);
+  ++pos;
+
+  const auto plenStart = pos;
+  plen = 0;
+  while (pos < key.size() and isDigit(key[pos]) and pos - plenStart < 3) {
+    plen = plen * 10 + (key[pos] - '0');
+    ++pos;
+  }
+  // Closing bracket must end the key
+  return pos != plenStart and pos + 1 == key.size() and key[pos] == ']';
+}
+
+} // namespace
+
+uint32_t
+NodeNameTable::getId(std::string_view name) {
+  auto& cache = getNodeNamesCache();
+  auto cached = cache.ids.find(name);
+  if (cached != cache.ids.end()) {
+    return cached->second;
+  }
+
+  // Cache views the name stored in the intern table, which outlives it
+  auto [storedName, id] = [&]() -> std::pair<std::string_view, uint32_t> {
+    auto& nodeNames = getNodeNames();
+    {
+      auto rlocked = nodeNames.rlock();
+      auto it = rlocked->ids.find(name);
+      if (it != rlocked->ids.end()) {
+        return *it;
+      }
+    }
+
+    auto wlocked = nodeNames.wlock();
+    // Name may have been interned since read lock was released
+    auto it = wlocked->ids.find(name);
+    if (it != wlocked->ids.end()) {
+      return *it;
+    }
+    const uint32_t newId = wlocked->names.size();
+    const auto& newName = wlocked->names.emplace_back(name);
+    wlocked->ids.emplace(newName, newId);
+    return {newName, newId};
+  }();
+  cache.ids.emplace(storedName, id);
+  return id;
+}
+
+std::string const&
+NodeNameTable::getName(uint32_t id) {
+  auto& cache = getNodeNamesCache();
+  if (id < cache.names.size() and cache.names[id]) {
+    return *cache.names[id];
+  }
+
+  const auto& name = getNodeNames().rlock()->names.at(id);
+  if (id >= cache.names.size()) {
+    cache.names.resize(id + 1, nullptr);
+  }
+  cache.names[id] = &name;
+  return name;
+}
+
+size_t
+NodeNameTable::size() {
+  return getNodeNames().rlock()->names.size();
+}
+
 PrefixKey::PrefixKey(
     std::string const& node,
     folly::CIDRNetwork const& prefix,
     const std::string& area)
     : nodeAndArea_(node, area),
+      nodeId_(NodeNameTable::getId(node)),
       prefix_(prefix),
       prefixKeyStringV2_(fmt::format(
           "{}{}:[{}/{}]",
@@ -25,15 +182,59 @@ PrefixKey::PrefixKey(
           prefix_.first.str(),
           prefix_.second)) {}
 
+PrefixKey::PrefixKey(
+    std::string_view key,
+    std::string_view node,
+    folly::CIDRNetwork const& prefix,
+    const std::string& area)
+    : nodeAndArea_(std::string(node), area),
+      nodeId_(NodeNameTable::getId(node)),
+      prefix_(prefix),
+      prefixKeyStringV2_(key) {}
+
+folly::Expected<PrefixKey, std::string>
+PrefixKey::fromStr(std::string_view key, const std::string& areaIn) {
+  std::string_view node;
+  std::string_view ipStr;
+  int plen{0};
+  if (tokenizePrefixKey(key, node, ipStr, plen)) {
+    auto maybeIp = folly::IPAddress::tryFromString(ipStr);
+    if (maybeIp.hasValue() and plen <= maybeIp->bitCount()) {
+      // Same as folly::IPAddress::createNetwork() with mask applied
+      folly::CIDRNetwork network{
+          maybeIp->mask(plen), static_cast<uint8_t>(plen)};
+
+      // Reuse the key if it is the one built from the prefix, i.e. address
+      // has no host bits set and both address and length are in canonical
+      // form. IPv4 parsing rejects non-canonical addresses.
+      const auto plenStr =
+          key.substr(ipStr.data() + ipStr.size() + 1 - key.data());
+      if (network.first == *maybeIp and
+          (plen ? plenStr.front() != '0' : plenStr.size() == 2) and
+          (maybeIp->isV4() or maybeIp->str() == ipStr)) {
+        return PrefixKey(key, node, network, areaIn);
+      }
+      return PrefixKey(std::string(node), network, areaIn);
+    }
+  }
+
+  // Regex matching reports the reason of failure
+  return fromStrRE2(key, areaIn);
+}
+
 folly::Expected<PrefixKey, std::string>
-PrefixKey::fromStr(const std::string& key, const std::string& areaIn) {
+PrefixKey::fromStrRE2(std::string_view key, const std::string& areaIn) {
   int plen{0};
   std::string node{};
   std::string ipStr{};
   folly::CIDRNetwork network;
 
-  auto pattV2 =
-      RE2::FullMatch(key, PrefixKey::getPrefixRE2V2(), &node, &ipStr, &plen);
+  auto pattV2 = RE2::FullMatch(
+      re2::StringPiece(key.data(), key.size()),
+      PrefixKey::getPrefixRE2V2(),
+      &node,
+      &ipStr,
+      &plen);
   if (not pattV2) {
     return folly::makeUnexpected(
         fmt::format("Invalid format for key: {}.", key));
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <string_view>
 #include <variant>
 
 #include <boost/serialization/strong_typedef.hpp>
@@ -29,8 +30,10 @@ namespace openr {
 using AdjacencyKey = std::
     pair<std::string /* remoteNodeName */, std::string /* localInterfaceName*/>;
 using NodeAndArea = std::pair<std::string, std::string>;
+// Entries are shared with the routes computed from them. Replace rather than
+// mutate them on change.
 using PrefixEntries =
-    std::unordered_map<NodeAndArea, std::shared_ptr<thrift::PrefixEntry>>;
+    std::unordered_map<NodeAndArea, std::shared_ptr<const thrift::PrefixEntry>>;
 
 // markers for some of KvStore keys
 BOOST_STRONG_TYPEDEF(std::string, AdjacencyDbMarker);
@@ -213,7 +216,7 @@ struct PrefixEntry {
    * Prefix attributes that needs to be advertised to KvStore. Area may copy &
    * modify these attributes before advertisement.
    */
-  std::shared_ptr<thrift::PrefixEntry> tPrefixEntry;
+  std::shared_ptr<const thrift::PrefixEntry> tPrefixEntry;
   /**
    * Set of area IDs to which this prefix should be advertised. Leave empty to
    * advertise to all configured areas
@@ -245,7 +248,7 @@ struct PrefixEntry {
 
   PrefixEntry() = default;
   PrefixEntry(
-      std::shared_ptr<thrift::PrefixEntry>&& tPrefixEntryIn,
+      std::shared_ptr<const thrift::PrefixEntry>&& tPrefixEntryIn,
       std::unordered_set<std::string>&& dstAreas,
       std::optional<OpenrPolicyActionData> policyActionData = std::nullopt,
       OpenrPolicyMatchData policyMatchData = OpenrPolicyMatchData(),
@@ -258,7 +261,7 @@ struct PrefixEntry {
         preferredForRedistribution(preferredForRedistribution) {}
 
   PrefixEntry(
-      std::shared_ptr<thrift::PrefixEntry>&& tPrefixEntryIn,
+      std::shared_ptr<const thrift::PrefixEntry>&& tPrefixEntryIn,
       std::unordered_set<std::string>&& dstAreas,
       std::optional<std::unordered_set<thrift::NextHopThrift>> nexthops)
       : tPrefixEntry(std::move(tPrefixEntryIn)),
@@ -428,6 +431,26 @@ struct InterfaceInfo {
  */
 using InterfaceDatabase = std::vector<InterfaceInfo>;
 
+/**
+ * Process-wide intern table of node names. Maps every node name to a stable
+ * ID, which is cheaper to hash and compare than the name. IDs are never
+ * released, as the number of nodes in the network is bounded.
+ *
+ * NOTE: Thread-safe. Every thread caches the names it has looked up, so that
+ * lookups of known names don't take the process-wide lock.
+ */
+class NodeNameTable {
+ public:
+  // ID of the node name, assigned on first use
+  static uint32_t getId(std::string_view name);
+
+  // Name of the node ID. ID must have been assigned by getId().
+  static std::string const& getName(uint32_t id);
+
+  // Number of interned node names
+  static size_t size();
+};
+
 /**
  * PrefixKey class to form and parse a PrefixKey. PrefixKey can be instantiated
  * by passing parameters to form a key, or by passing the key string to parse
@@ -442,9 +465,15 @@ class PrefixKey {
       folly::CIDRNetwork const& prefix,
       const std::string& area);
 
-  // construct PrefixKey object from a give key string
+  // construct PrefixKey object from a give key string. Key is tokenized in a
+  // single pass, falling back to regex matching if that fails.
   static folly::Expected<PrefixKey, std::string> fromStr(
-      const std::string& key,
+      std::string_view key,
+      const std::string& area = Constants::kDefaultArea.toString());
+
+  // construct PrefixKey object from a give key string by regex matching only
+  static folly::Expected<PrefixKey, std::string> fromStrRE2(
+      std::string_view key,
       const std::string& area = Constants::kDefaultArea.toString());
 
   static const RE2&
@@ -469,6 +498,12 @@ class PrefixKey {
     return nodeAndArea_.first;
   }
 
+  // return interned ID of node name
+  inline uint32_t
+  getNodeId() const {
+    return nodeId_;
+  }
+
   // return prefix sub type
   inline std::string const&
   getPrefixArea() const {
@@ -489,13 +524,24 @@ class PrefixKey {
 
   bool
   operator==(openr::PrefixKey const& other) const {
-    return prefix_ == other.prefix_ && nodeAndArea_ == other.nodeAndArea_;
+    return nodeId_ == other.nodeId_ && prefix_ == other.prefix_ &&
+        nodeAndArea_.second == other.nodeAndArea_.second;
   }
 
  private:
+  // constructor using the key string already parsed into node and prefix
+  PrefixKey(
+      std::string_view key,
+      std::string_view node,
+      folly::CIDRNetwork const& prefix,
+      const std::string& area);
+
   // node name
   NodeAndArea const nodeAndArea_;
 
+  // interned ID of node name
+  uint32_t const nodeId_;
+
   // IP address
   folly::CIDRNetwork const prefix_;
 
@@ -510,7 +556,7 @@ struct std::hash<openr::PrefixKey> {
   size_t
   operator()(openr::PrefixKey const& prefixKey) const {
     return folly::hash::hash_combine(
-        prefixKey.getNodeName(),
+        prefixKey.getNodeId(),
         prefixKey.getCIDRNetwork(),
         prefixKey.getPrefixArea());
   }
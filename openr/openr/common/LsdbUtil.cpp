@@ -9,6 +9,7 @@
 #include <openr/common/Constants.h>
 #include <openr/common/LsdbUtil.h>
 #include <openr/common/MplsUtil.h>
+#include <thrift/lib/cpp/util/EnumUtils.h>
 
 namespace openr {
 
@@ -58,6 +59,30 @@ addPerfEvent(
   perfEvents.events()->emplace_back(std::move(event));
 }
 
+void
+addPerfEvent(
+    thrift::PerfEvents& perfEvents,
+    const std::string& nodeName,
+    thrift::PerfEventType type) noexcept {
+  thrift::PerfEvent event = createPerfEvent(
+      nodeName,
+      apache::thrift::util::enumNameSafe(type),
+      getUnixTimeStampMs());
+  event.type() = type;
+  perfEvents.events()->emplace_back(std::move(event));
+}
+
+thrift::PerfEventType
+getPerfEventType(const thrift::PerfEvent& perfEvent) noexcept {
+  if (*perfEvent.type() != thrift::PerfEventType::UNKNOWN) {
+    return *perfEvent.type();
+  }
+  thrift::PerfEventType type{thrift::PerfEventType::UNKNOWN};
+  apache::thrift::TEnumTraits<thrift::PerfEventType>::findValue(
+      perfEvent.eventDescr()->c_str(), &type);
+  return type;
+}
+
 std::vector<std::string>
 sprintPerfEvents(const thrift::PerfEvents& perfEvents) noexcept {
   const auto& events = *perfEvents.events();
@@ -370,6 +395,54 @@ findDeltaRoutes(
   return routeDbDelta;
 }
 
+thrift::RouteDatabaseDelta
+mergeRouteDatabaseDeltas(std::vector<thrift::RouteDatabaseDelta>&& deltas) {
+  thrift::RouteDatabaseDelta mergedDelta;
+
+  // Last route of every prefix and label, std::nullopt if deleted
+  std::map<thrift::IpPrefix, std::optional<thrift::UnicastRoute>>
+      unicastRoutes;
+  std::map<int32_t, std::optional<thrift::MplsRoute>> mplsRoutes;
+  for (auto& delta : deltas) {
+    for (auto& route : *delta.unicastRoutesToUpdate()) {
+      auto prefix = *route.dest();
+      unicastRoutes[prefix] = std::move(route);
+    }
+    for (auto& prefix : *delta.unicastRoutesToDelete()) {
+      unicastRoutes[prefix] = std::nullopt;
+    }
+    for (auto& route : *delta.mplsRoutesToUpdate()) {
+      auto label = *route.topLabel();
+      mplsRoutes[label] = std::move(route);
+    }
+    for (auto label : *delta.mplsRoutesToDelete()) {
+      mplsRoutes[label] = std::nullopt;
+    }
+    if (delta.perfEvents().has_value()) {
+      mergedDelta.perfEvents() = std::move(delta.perfEvents().value());
+    }
+    if (delta.seqNum().has_value()) {
+      mergedDelta.seqNum() = *delta.seqNum();
+    }
+  }
+
+  for (auto& [prefix, route] : unicastRoutes) {
+    if (route.has_value()) {
+      mergedDelta.unicastRoutesToUpdate()->emplace_back(std::move(*route));
+    } else {
+      mergedDelta.unicastRoutesToDelete()->emplace_back(prefix);
+    }
+  }
+  for (auto& [label, route] : mplsRoutes) {
+    if (route.has_value()) {
+      mergedDelta.mplsRoutesToUpdate()->emplace_back(std::move(*route));
+    } else {
+      mergedDelta.mplsRoutesToDelete()->emplace_back(label);
+    }
+  }
+  return mergedDelta;
+}
+
 bool
 hasBestRoutesInArea(
     const std::string& area,
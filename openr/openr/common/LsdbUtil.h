@@ -36,6 +36,21 @@ void addPerfEvent(
     const std::string& nodeName,
     const std::string& eventDescr) noexcept;
 
+/**
+ * Add event with numeric type, described by the name of the type
+ */
+void addPerfEvent(
+    thrift::PerfEvents& perfEvents,
+    const std::string& nodeName,
+    thrift::PerfEventType type) noexcept;
+
+/**
+ * Type of the event. Falls back to `eventDescr` for events originated by older
+ * versions, which don't set the type.
+ */
+thrift::PerfEventType getPerfEventType(
+    const thrift::PerfEvent& perfEvent) noexcept;
+
 std::vector<std::string> sprintPerfEvents(
     const thrift::PerfEvents& perfEvents) noexcept;
 
@@ -111,6 +126,14 @@ thrift::RouteDatabaseDelta findDeltaRoutes(
     const thrift::RouteDatabase& newRouteDb,
     const thrift::RouteDatabase& oldRouteDb);
 
+/**
+ * Merge consecutive route database deltas into a single delta having the same
+ * effect when applied, i.e. the last update or delete of every prefix and
+ * label wins. Perf events and sequence number of the last delta are retained.
+ */
+thrift::RouteDatabaseDelta mergeRouteDatabaseDeltas(
+    std::vector<thrift::RouteDatabaseDelta>&& deltas);
+
 /**
  * Check if there are any best routes in that area by given 1. an area, 2.
  * prefixEntries, and 3. set of NodeAndArea
@@ -14,6 +14,7 @@
 #include <openr/common/Util.h>
 #include <openr/ctrl-server/OpenrCtrlHandler.h>
 #include <openr/fib/Fib.h>
+#include <openr/monitor/CpuProfiler.h>
 #include <openr/watchdog/Watchdog.h>
 
 namespace openr {
@@ -42,6 +43,7 @@ startEventBase(
   allThreads.emplace_back(std::thread([evb = evb.get(), name]() noexcept {
     XLOG(INFO) << fmt::format("Starting {} thread ...", name);
     folly::setThreadName(name);
+    CpuProfiler::registerThread(name);
     evb->run();
     XLOG(INFO) << fmt::format("[Exit] Successfully stopped {} thread.", name);
   }));
@@ -6,8 +6,10 @@
  */
 
 #include <folly/fibers/FiberManagerMap.h>
+#include <folly/io/async/EventBaseObserver.h>
 #include <folly/logging/xlog.h>
 
+#include <openr/common/Flags.h>
 #include <openr/common/OpenrEventBase.h>
 
 namespace openr {
@@ -56,18 +58,41 @@ OpenrEventBase::OpenrEventHandler::handlerReady(uint16_t events) noexcept {
   }
 }
 
+class OpenrEventBase::LoopObserver : public folly::EventBaseObserver {
+ public:
+  explicit LoopObserver(OpenrEventBase* evb) : evb_(evb) {}
+
+  uint32_t
+  getSampleRate() const override {
+    return std::max(1, FLAGS_evb_loop_sample_rate);
+  }
+
+  void
+  loopSample(int64_t busyTime, int64_t /* idleTime */) override {
+    evb_->recordLoopSample(std::chrono::microseconds(busyTime));
+  }
+
+ private:
+  OpenrEventBase* const evb_{nullptr};
+};
+
 OpenrEventBase::OpenrEventBase()
     : fiberManager_(folly::fibers::getFiberManager(evb_, getFmOptions())) {
   // Periodic timer to update eventbase's timestamp. This is used by Watchdog to
-  // identify stuck threads.
+  // identify stuck threads. Its delay past the expected fire time is recorded
+  // as loop lag.
   // update aliveness timestamp
   timestamp_.store(std::chrono::steady_clock::now().time_since_epoch().count());
   timeout_ = folly::AsyncTimeout::make(evb_, [this]() noexcept {
-    timestamp_.store(
-        std::chrono::steady_clock::now().time_since_epoch().count());
-    timeout_->scheduleTimeout(std::chrono::seconds(1));
+    const auto now = std::chrono::steady_clock::now();
+    timestamp_.store(now.time_since_epoch().count());
+    recordLoopLag(now);
+    expectedTimeout_ = now + Constants::kEvbLoopLagProbeInterval;
+    timeout_->scheduleTimeout(Constants::kEvbLoopLagProbeInterval);
   });
   timeout_->scheduleTimeout(0);
+
+  evb_.setObserver(std::make_shared<LoopObserver>(this));
 }
 
 OpenrEventBase::~OpenrEventBase() {}
@@ -85,6 +110,52 @@ OpenrEventBase::stop() {
   evb_.terminateLoopSoon();
 }
 
+OpenrEventBase::LoopStats
+OpenrEventBase::getLoopStats() const {
+  const auto now = std::chrono::steady_clock::now();
+  auto state = loopState_.rlock();
+  LoopStats stats;
+  stats.loopLagUs = state->loopLagUs.get(now);
+  stats.busyTimeUs = state->busyTimeUs.get(now);
+  stats.numSlowLoops = state->numSlowLoops;
+  stats.slowLoops.assign(state->slowLoops.begin(), state->slowLoops.end());
+  return stats;
+}
+
+void
+OpenrEventBase::recordLoopLag(std::chrono::steady_clock::time_point now) {
+  // First fire only marks the start of the loop
+  if (not expectedTimeout_.has_value()) {
+    return;
+  }
+  const auto lag = std::chrono::duration_cast<std::chrono::microseconds>(
+      now - *expectedTimeout_);
+  loopState_.wlock()->loopLagUs.addValue(lag.count(), now);
+}
+
+void
+OpenrEventBase::recordLoopSample(std::chrono::microseconds busyTime) {
+  const auto now = std::chrono::steady_clock::now();
+  const bool isSlow =
+      busyTime >= std::chrono::milliseconds(FLAGS_evb_slow_loop_threshold_ms);
+  {
+    auto state = loopState_.wlock();
+    state->busyTimeUs.addValue(busyTime.count(), now);
+    if (isSlow) {
+      ++state->numSlowLoops;
+      state->slowLoops.emplace_back(
+          SlowLoop{std::chrono::system_clock::now(), busyTime});
+      if (state->slowLoops.size() > Constants::kEvbMaxSlowLoops) {
+        state->slowLoops.pop_front();
+      }
+    }
+  }
+  if (isSlow) {
+    XLOG(WARNING) << "Slow event loop iteration of " << evbName_ << ": "
+                  << busyTime.count() << "us";
+  }
+}
+
 bool
 OpenrEventBase::isRunning() const {
   return evb_.isRunning();
@@ -8,11 +8,17 @@
 #pragma once
 
 #include <csignal>
+#include <deque>
+#include <optional>
 
+#include <folly/Synchronized.h>
 #include <folly/fibers/FiberManager.h>
 #include <folly/io/async/AsyncSignalHandler.h>
 #include <folly/io/async/EventHandler.h>
 
+#include <openr/common/Constants.h>
+#include <openr/common/LatencyHistogram.h>
+
 namespace openr {
 
 using SocketCallback = folly::Function<void(uint16_t revents) noexcept>;
@@ -27,6 +33,28 @@ class EventBaseStopSignalHandler : public folly::AsyncSignalHandler {
 
 class OpenrEventBase {
  public:
+  // Loop iteration whose busy time exceeded the slow loop threshold
+  struct SlowLoop {
+    std::chrono::system_clock::time_point timestamp;
+    std::chrono::microseconds busyTime;
+  };
+
+  /**
+   * Event loop stats of the recent window, see `Constants::kRuntimeStatsWindow`
+   * - loopLagUs: delay of timer callbacks past their scheduled time, i.e. how
+   *   long a newly queued task waits for the loop
+   * - busyTimeUs: time spent running callbacks, fiber tasks and handlers in a
+   *   (sampled) loop iteration
+   */
+  struct LoopStats {
+    LatencyHistogram loopLagUs;
+    LatencyHistogram busyTimeUs;
+    // Total number of slow loop iterations since start
+    uint64_t numSlowLoops{0};
+    // Most recent slow loop iterations, oldest first
+    std::vector<SlowLoop> slowLoops;
+  };
+
   OpenrEventBase();
 
   virtual ~OpenrEventBase();
@@ -77,6 +105,11 @@ class OpenrEventBase {
         std::chrono::steady_clock::duration(timestamp_.load()));
   }
 
+  /**
+   * Get event loop stats. Thread-safe.
+   */
+  LoopStats getLoopStats() const;
+
   /**
    * Get number of fiber tasks injected
    */
@@ -153,6 +186,13 @@ class OpenrEventBase {
     const int events_{0};
   };
 
+  // Observer of busy time of event loop iterations
+  class LoopObserver;
+
+  // Invoked in evb thread
+  void recordLoopLag(std::chrono::steady_clock::time_point now);
+  void recordLoopSample(std::chrono::microseconds busyTime);
+
   // EventBase object for async event polling/scheduling
   folly::EventBase evb_;
 
@@ -167,6 +207,19 @@ class OpenrEventBase {
   std::atomic<std::chrono::steady_clock::duration::rep> timestamp_;
   std::unique_ptr<folly::AsyncTimeout> timeout_;
 
+  // Expected fire time of the timer, for measuring loop lag. Not set until
+  // the loop starts running.
+  std::optional<std::chrono::steady_clock::time_point> expectedTimeout_;
+
+  // Event loop stats, written in evb thread and read by Watchdog
+  struct LoopState {
+    WindowedLatencyHistogram loopLagUs{Constants::kRuntimeStatsWindow};
+    WindowedLatencyHistogram busyTimeUs{Constants::kRuntimeStatsWindow};
+    uint64_t numSlowLoops{0};
+    std::deque<SlowLoop> slowLoops;
+  };
+  folly::Synchronized<LoopState> loopState_;
+
   // Unique name to identify eventbase
   std::string evbName_;
 };
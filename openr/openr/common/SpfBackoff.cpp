@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <fb303/ServiceData.h>
+#include <fmt/format.h>
+#include <folly/logging/xlog.h>
+
+#include <openr/common/SpfBackoff.h>
+
+namespace fb303 = facebook::fb303;
+
+namespace openr {
+
+SpfBackoff::SpfBackoff(
+    folly::EventBase* eventBase,
+    std::chrono::milliseconds initialDelay,
+    std::chrono::milliseconds shortDelay,
+    std::chrono::milliseconds longDelay,
+    std::chrono::milliseconds timeToLearn,
+    std::chrono::milliseconds holdDown,
+    TimeoutCallback callback,
+    std::string counterPrefix)
+    : initialDelay_(initialDelay),
+      shortDelay_(shortDelay),
+      longDelay_(longDelay),
+      timeToLearn_(timeToLearn),
+      holdDown_(holdDown),
+      callback_(std::move(callback)),
+      counterPrefix_(std::move(counterPrefix)) {
+  CHECK(callback_);
+  CHECK_LE(initialDelay_.count(), shortDelay_.count());
+  CHECK_LE(shortDelay_.count(), longDelay_.count());
+
+  spfTimer_ = folly::AsyncTimeout::make(*eventBase, [this]() noexcept {
+    bumpCounter("runs");
+    callback_();
+  });
+  learnTimer_ = folly::AsyncTimeout::make(*eventBase, [this]() noexcept {
+    if (state_ == State::SHORT_WAIT) {
+      setState(State::LONG_WAIT);
+    }
+  });
+  holdDownTimer_ = folly::AsyncTimeout::make(*eventBase, [this]() noexcept {
+    learnTimer_->cancelTimeout();
+    setState(State::QUIET);
+  });
+
+  if (not counterPrefix_.empty()) {
+    for (const auto name :
+         {"events", "runs", "quiet", "short_wait", "long_wait"}) {
+      fb303::fbData->addStatExportType(
+          fmt::format("{}.{}", counterPrefix_, name), fb303::COUNT);
+    }
+    fb303::fbData->setCounter(
+        fmt::format("{}.state", counterPrefix_), static_cast<int>(state_));
+  }
+}
+
+void
+SpfBackoff::operator()() noexcept {
+  bumpCounter("events");
+
+  std::chrono::milliseconds delay;
+  switch (state_) {
+  case State::QUIET:
+    setState(State::SHORT_WAIT);
+    learnTimer_->scheduleTimeout(timeToLearn_);
+    delay = initialDelay_;
+    break;
+  case State::SHORT_WAIT:
+    delay = shortDelay_;
+    break;
+  case State::LONG_WAIT:
+    delay = longDelay_;
+    break;
+  }
+  holdDownTimer_->scheduleTimeout(holdDown_);
+
+  // Events are batched into already scheduled computation
+  if (spfTimer_->isScheduled()) {
+    return;
+  }
+  spfTimer_->scheduleTimeout(delay);
+}
+
+void
+SpfBackoff::cancelScheduledTimeout() noexcept {
+  spfTimer_->cancelTimeout();
+}
+
+void
+SpfBackoff::setState(State state) {
+  if (state_ == state) {
+    return;
+  }
+  XLOG(DBG2) << "SPF back-off state " << static_cast<int>(state_) << " -> "
+             << static_cast<int>(state);
+  state_ = state;
+
+  switch (state_) {
+  case State::QUIET:
+    bumpCounter("quiet");
+    break;
+  case State::SHORT_WAIT:
+    bumpCounter("short_wait");
+    break;
+  case State::LONG_WAIT:
+    bumpCounter("long_wait");
+    break;
+  }
+  if (not counterPrefix_.empty()) {
+    fb303::fbData->setCounter(
+        fmt::format("{}.state", counterPrefix_), static_cast<int>(state_));
+  }
+}
+
+void
+SpfBackoff::bumpCounter(const char* name) const {
+  if (counterPrefix_.empty()) {
+    return;
+  }
+  fb303::fbData->addStatValue(
+      fmt::format("{}.{}", counterPrefix_, name), 1, fb303::COUNT);
+}
+
+} // namespace openr
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include <folly/Function.h>
+#include <folly/io/async/AsyncTimeout.h>
+#include <folly/io/async/EventBase.h>
+
+namespace openr {
+
+/**
+ * This class schedules expensive computation (e.g. SPF and route computation)
+ * on events (e.g. topology changes) with the SPF back-off delay algorithm of
+ * RFC 8405.
+ *
+ * - QUIET: No event for `holdDown`. Computation is scheduled `initialDelay`
+ *   after an event, moving to SHORT_WAIT.
+ * - SHORT_WAIT: Computation is scheduled `shortDelay` after an event. Moves to
+ *   LONG_WAIT `timeToLearn` after leaving QUIET.
+ * - LONG_WAIT: Computation is scheduled `longDelay` after an event.
+ *
+ * Every event restarts the hold-down timer, on expiry of which state moves
+ * back to QUIET. Hence an isolated event is processed quickly, while
+ * computation happens at most once every `longDelay` during sustained churn.
+ * Events received while computation is scheduled are batched into it.
+ *
+ * Like AsyncDebounce, callback is invoked with `operator()()`, and scheduled
+ * computation can be cancelled with `cancelScheduledTimeout()`.
+ *
+ * If `counterPrefix` is set, following counters are exported:
+ * - <prefix>.state: current state
+ * - <prefix>.events: number of events
+ * - <prefix>.runs: number of computations
+ * - <prefix>.{quiet,short_wait,long_wait}: number of transitions into state
+ */
+class SpfBackoff final {
+ public:
+  enum class State {
+    QUIET = 0,
+    SHORT_WAIT = 1,
+    LONG_WAIT = 2,
+  };
+
+  using TimeoutCallback = folly::Function<void(void)>;
+
+  SpfBackoff(
+      folly::EventBase* eventBase,
+      std::chrono::milliseconds initialDelay,
+      std::chrono::milliseconds shortDelay,
+      std::chrono::milliseconds longDelay,
+      std::chrono::milliseconds timeToLearn,
+      std::chrono::milliseconds holdDown,
+      TimeoutCallback callback,
+      std::string counterPrefix = "");
+
+  ~SpfBackoff() = default;
+
+  /**
+   * Overload function operator. Reports an event and schedules computation
+   * with the delay of the current state, unless it is already scheduled.
+   */
+  void operator()() noexcept;
+
+  /**
+   * Cancel scheduled computation. State is not affected.
+   */
+  void cancelScheduledTimeout() noexcept;
+
+  bool
+  isScheduled() const {
+    return spfTimer_->isScheduled();
+  }
+
+  State
+  getState() const {
+    return state_;
+  }
+
+ private:
+  SpfBackoff(SpfBackoff const&) = delete;
+  SpfBackoff& operator=(SpfBackoff const&) = delete;
+
+  void setState(State state);
+
+  void bumpCounter(const char* name) const;
+
+  const std::chrono::milliseconds initialDelay_;
+  const std::chrono::milliseconds shortDelay_;
+  const std::chrono::milliseconds longDelay_;
+  const std::chrono::milliseconds timeToLearn_;
+  const std::chrono::milliseconds holdDown_;
+  TimeoutCallback callback_{nullptr};
+  const std::string counterPrefix_;
+
+  State state_{State::QUIET};
+
+  // Scheduled computation
+  std::unique_ptr<folly::AsyncTimeout> spfTimer_;
+  // Moves from SHORT_WAIT to LONG_WAIT
+  std::unique_ptr<folly::AsyncTimeout> learnTimer_;
+  // Moves back to QUIET
+  std::unique_ptr<folly::AsyncTimeout> holdDownTimer_;
+};
+
+} // namespace openr
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <folly/init/Init.h>
+#include <gtest/gtest.h>
+
+#include <openr/common/CoalescingStreamPublisher.h>
+
+using namespace openr;
+
+namespace {
+
+// Coalesce pending updates into their concatenation
+std::vector<std::string>
+concat(std::vector<std::string>&& updates) {
+  std::string merged;
+  for (const auto& update : updates) {
+    merged += update;
+  }
+  return {merged};
+}
+
+CoalescingStreamPublisher<std::string>::Options
+getOptions(bool dropSlowSubscriber) {
+  CoalescingStreamPublisher<std::string>::Options options;
+  options.name = "test";
+  options.highWatermark = 3;
+  options.dropSlowSubscriber = dropSlowSubscriber;
+  options.coalesce = concat;
+  return options;
+}
+
+// Consume the stream until it terminates
+std::pair<std::vector<std::string>, bool /* error */>
+consume(apache::thrift::ServerStream<std::string>&& stream) {
+  std::vector<std::string> received;
+  bool error{false};
+  std::move(stream).toClientStreamUnsafeDoNotUse().subscribeInline(
+      [&](folly::Try<std::string>&& t) {
+        if (t.hasValue()) {
+          received.emplace_back(std::move(*t));
+        } else if (t.hasException()) {
+          error = true;
+        }
+      });
+  return {received, error};
+}
+
+} // namespace
+
+/**
+ * Verify that pending updates of a slow subscriber are coalesced at the high
+ * watermark, and are delivered in order.
+ */
+TEST(CoalescingStreamPublisherTest, Coalesce) {
+  bool completed{false};
+  auto [stream, publisher] =
+      CoalescingStreamPublisher<std::string>::createPublisher(
+          getOptions(false), [&completed]() { completed = true; });
+
+  publisher.next("a");
+  publisher.next("b");
+  EXPECT_EQ(2, publisher.getNumPending());
+  // High watermark is reached
+  publisher.next("c");
+  EXPECT_EQ(1, publisher.getNumPending());
+  publisher.next("d");
+  EXPECT_EQ(2, publisher.getNumPending());
+  publisher.complete();
+  // Updates after completion are ignored
+  publisher.next("e");
+
+  auto [received, error] = consume(std::move(stream));
+  EXPECT_EQ(std::vector<std::string>({"abc", "d"}), received);
+  EXPECT_FALSE(error);
+  EXPECT_TRUE(completed);
+}
+
+/**
+ * Verify that slow subscriber is terminated with an error in drop mode.
+ */
+TEST(CoalescingStreamPublisherTest, DropSlowSubscriber) {
+  auto [stream, publisher] =
+      CoalescingStreamPublisher<std::string>::createPublisher(
+          getOptions(true), [] {});
+
+  publisher.next("a");
+  publisher.next("b");
+  publisher.next("c");
+  EXPECT_EQ(0, publisher.getNumPending());
+  publisher.next("d");
+
+  auto [received, error] = consume(std::move(stream));
+  EXPECT_TRUE(received.empty());
+  EXPECT_TRUE(error);
+}
+
+/**
+ * Verify that stream is terminated with the publisher, and completion callback
+ * is invoked even if stream was never consumed.
+ */
+TEST(CoalescingStreamPublisherTest, Destruction) {
+  {
+    auto [stream, publisher] =
+        CoalescingStreamPublisher<std::string>::createPublisher(
+            getOptions(false), [] {});
+    publisher.next("a");
+    {
+      // Pending updates are still delivered
+      auto destroyed = std::move(publisher);
+    }
+
+    auto [received, error] = consume(std::move(stream));
+    EXPECT_EQ(std::vector<std::string>({"a"}), received);
+    EXPECT_FALSE(error);
+  }
+
+  bool completed{false};
+  {
+    auto streamAndPublisher =
+        CoalescingStreamPublisher<std::string>::createPublisher(
+            getOptions(false), [&completed]() { completed = true; });
+  }
+  EXPECT_TRUE(completed);
+}
+
+int
+main(int argc, char* argv[]) {
+  // Parse command line flags
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv);
+  FLAGS_logtostderr = true;
+
+  // Run the tests
+  return RUN_ALL_TESTS();
+}
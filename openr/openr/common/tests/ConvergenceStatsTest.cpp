@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <fb303/ServiceData.h>
+#include <folly/init/Init.h>
+#include <gtest/gtest.h>
+
+#include <openr/common/ConvergenceStats.h>
+#include <thrift/lib/cpp/util/EnumUtils.h>
+
+using namespace openr;
+
+namespace {
+
+thrift::PerfEvent
+createEvent(thrift::PerfEventType type, int64_t unixTs) {
+  thrift::PerfEvent event;
+  event.nodeName() = "node1";
+  event.eventDescr() = apache::thrift::util::enumNameSafe(type);
+  event.type() = type;
+  event.unixTs() = unixTs;
+  return event;
+}
+
+} // namespace
+
+/**
+ * Verify that every value falls within the bounds of its bucket, and that
+ * bucket width is within 12.5% of its values.
+ */
+TEST(LatencyHistogramTest, Buckets) {
+  for (int64_t value = 0; value < (1 << 20); value += 7) {
+    const auto index = LatencyHistogram::getBucketIndex(value);
+    ASSERT_LT(index, LatencyHistogram::kNumBuckets);
+    const auto lower = LatencyHistogram::getBucketLowerBound(index);
+    const auto upper = LatencyHistogram::getBucketUpperBound(index);
+    EXPECT_LE(lower, value);
+    EXPECT_GE(upper, value);
+    EXPECT_LE(upper - lower, value / LatencyHistogram::kSubBuckets);
+  }
+
+  // Exact buckets for small values
+  EXPECT_EQ(15, LatencyHistogram::getBucketIndex(15));
+  EXPECT_EQ(16, LatencyHistogram::getBucketLowerBound(16));
+  EXPECT_EQ(17, LatencyHistogram::getBucketUpperBound(16));
+
+  // Out of range values are clamped
+  EXPECT_EQ(0, LatencyHistogram::getBucketIndex(-1));
+  EXPECT_EQ(
+      LatencyHistogram::kNumBuckets - 1,
+      LatencyHistogram::getBucketIndex(LatencyHistogram::kMaxValue + 1));
+}
+
+TEST(LatencyHistogramTest, Percentiles) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(0, histogram.getPercentile(50));
+
+  // 1..100ms
+  for (int64_t value = 1; value <= 100; ++value) {
+    histogram.addValue(value);
+  }
+  EXPECT_EQ(100, histogram.getCount());
+  EXPECT_EQ(1, histogram.getMin());
+  EXPECT_EQ(100, histogram.getMax());
+  EXPECT_EQ(50, histogram.getAvg());
+
+  // Percentile is the upper bound of its bucket
+  EXPECT_EQ(1, histogram.getPercentile(0));
+  EXPECT_EQ(51, histogram.getPercentile(50));
+  EXPECT_EQ(100, histogram.getPercentile(99));
+  EXPECT_EQ(100, histogram.getPercentile(100));
+
+  const auto stats = toLatencyStats(histogram);
+  EXPECT_EQ(100, *stats.count());
+  EXPECT_EQ(51, *stats.p50Ms());
+  int64_t count{0};
+  for (const auto& [upperBound, bucketCount] : *stats.buckets()) {
+    EXPECT_LT(0, bucketCount);
+    count += bucketCount;
+  }
+  EXPECT_EQ(100, count);
+}
+
+/**
+ * Verify that merged histogram is same as if all values were recorded into it.
+ */
+TEST(LatencyHistogramTest, Merge) {
+  LatencyHistogram histogram1, histogram2, expected;
+  for (int64_t value = 1; value <= 100; ++value) {
+    (value % 2 ? histogram1 : histogram2).addValue(value * 100);
+    expected.addValue(value * 100);
+  }
+  histogram1.merge(histogram2);
+  histogram1.merge(LatencyHistogram());
+  EXPECT_EQ(expected.getCount(), histogram1.getCount());
+  EXPECT_EQ(expected.getMin(), histogram1.getMin());
+  EXPECT_EQ(expected.getMax(), histogram1.getMax());
+  EXPECT_EQ(expected.getAvg(), histogram1.getAvg());
+  for (size_t i = 0; i < LatencyHistogram::kNumBuckets; ++i) {
+    EXPECT_EQ(expected.getBucketCount(i), histogram1.getBucketCount(i));
+  }
+
+  histogram1.clear();
+  EXPECT_EQ(0, histogram1.getCount());
+  EXPECT_EQ(0, histogram1.getMax());
+}
+
+/**
+ * Verify that windowed histogram covers current and previous window only.
+ */
+TEST(LatencyHistogramTest, Windowed) {
+  const std::chrono::seconds window{10};
+  WindowedLatencyHistogram histogram(window);
+  const auto start = std::chrono::steady_clock::now();
+
+  histogram.addValue(1, start);
+  histogram.addValue(2, start + std::chrono::seconds(1));
+  EXPECT_EQ(2, histogram.get(start + std::chrono::seconds(1)).getCount());
+
+  // Values of previous window are still reported
+  histogram.addValue(3, start + std::chrono::seconds(11));
+  auto recent = histogram.get(start + std::chrono::seconds(11));
+  EXPECT_EQ(3, recent.getCount());
+  EXPECT_EQ(1, recent.getMin());
+
+  // First window has expired
+  histogram.addValue(4, start + std::chrono::seconds(21));
+  recent = histogram.get(start + std::chrono::seconds(21));
+  EXPECT_EQ(2, recent.getCount());
+  EXPECT_EQ(3, recent.getMin());
+
+  // Nothing recorded recently
+  EXPECT_EQ(0, histogram.get(start + std::chrono::seconds(45)).getCount());
+  histogram.addValue(5, start + std::chrono::seconds(45));
+  EXPECT_EQ(1, histogram.get(start + std::chrono::seconds(45)).getCount());
+}
+
+/**
+ * Verify that stages are measured between typed perf events, and are exported
+ * as counters.
+ */
+TEST(ConvergenceStatsTest, Record) {
+  ConvergenceStats convergenceStats("test.convergence");
+
+  thrift::PerfEvents perfEvents;
+  perfEvents.events()->emplace_back(
+      createEvent(thrift::PerfEventType::ADJ_DB_UPDATED, 1000));
+  perfEvents.events()->emplace_back(
+      createEvent(thrift::PerfEventType::DECISION_RECEIVED, 1010));
+  perfEvents.events()->emplace_back(
+      createEvent(thrift::PerfEventType::DECISION_DEBOUNCE, 1020));
+  perfEvents.events()->emplace_back(
+      createEvent(thrift::PerfEventType::ROUTE_UPDATE, 1030));
+  perfEvents.events()->emplace_back(
+      createEvent(thrift::PerfEventType::FIB_ROUTE_DB_RECVD, 1031));
+  perfEvents.events()->emplace_back(
+      createEvent(thrift::PerfEventType::FIB_ROUTES_PROGRAMMED, 1035));
+  convergenceStats.record(perfEvents);
+
+  // Update originated locally has no flood stage
+  thrift::PerfEvents localEvents;
+  localEvents.events()->emplace_back(
+      createEvent(thrift::PerfEventType::DECISION_RECEIVED, 2000));
+  localEvents.events()->emplace_back(
+      createEvent(thrift::PerfEventType::ROUTE_UPDATE, 2003));
+  localEvents.events()->emplace_back(
+      createEvent(thrift::PerfEventType::FIB_ROUTES_PROGRAMMED, 2004));
+  convergenceStats.record(localEvents);
+
+  const auto stats = convergenceStats.toThrift();
+  ASSERT_EQ(4, stats.stages()->size());
+  EXPECT_EQ(1, *stats.stages()->at("flood").count());
+  EXPECT_EQ(10, *stats.stages()->at("flood").maxMs());
+  EXPECT_EQ(2, *stats.stages()->at("spf").count());
+  EXPECT_EQ(20, *stats.stages()->at("spf").maxMs());
+  EXPECT_EQ(3, *stats.stages()->at("spf").minMs());
+  EXPECT_EQ(2, *stats.stages()->at("fib_program").count());
+  EXPECT_EQ(5, *stats.stages()->at("fib_program").maxMs());
+  EXPECT_EQ(2, *stats.stages()->at("total").count());
+  EXPECT_EQ(35, *stats.stages()->at("total").maxMs());
+
+  auto counters = facebook::fb303::fbData->getCounters();
+  EXPECT_EQ(1, counters.at("test.convergence.flood_ms.count"));
+  EXPECT_EQ(10, counters.at("test.convergence.flood_ms.p50"));
+  EXPECT_EQ(35, counters.at("test.convergence.total_ms.p99"));
+}
+
+int
+main(int argc, char* argv[]) {
+  // Parse command line flags
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv);
+  FLAGS_logtostderr = true;
+
+  // Run the tests
+  return RUN_ALL_TESTS();
+}
@@ -180,6 +180,40 @@ TEST_F(OpenrEventBaseTestFixture, SocketFdPollTest) {
   EXPECT_TRUE(true);
 }
 
+/**
+ * Verify that a blocking callback is reported as a slow loop iteration, and
+ * delays timers by the time it blocks the loop.
+ */
+TEST_F(OpenrEventBaseTestFixture, LoopStats) {
+  auto stats = evb.getLoopStats();
+  EXPECT_EQ(0, stats.numSlowLoops);
+  EXPECT_TRUE(stats.slowLoops.empty());
+
+  const std::chrono::milliseconds blockTime{300};
+  evb.getEvb()->runInEventBaseThreadAndWait([&]() {
+    /* sleep override */
+    std::this_thread::sleep_for(blockTime);
+  });
+  // Let the lag probe fire after the blocked iteration
+  /* sleep override */
+  std::this_thread::sleep_for(
+      2 * Constants::kEvbLoopLagProbeInterval + std::chrono::milliseconds(50));
+
+  stats = evb.getLoopStats();
+  EXPECT_LE(1, stats.numSlowLoops);
+  ASSERT_FALSE(stats.slowLoops.empty());
+  EXPECT_LE(blockTime, stats.slowLoops.back().busyTime);
+  EXPECT_LE(
+      std::chrono::microseconds(blockTime).count(),
+      stats.busyTimeUs.getMax());
+  EXPECT_LE(
+      std::chrono::microseconds(
+          blockTime - Constants::kEvbLoopLagProbeInterval)
+          .count(),
+      stats.loopLagUs.getMax());
+  EXPECT_LT(0, stats.loopLagUs.getCount());
+}
+
 int
 main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
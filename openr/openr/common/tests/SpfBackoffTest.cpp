@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <memory>
+#include <vector>
+
+#include <gflags/gflags.h>
+#include <gtest/gtest.h>
+
+#include <folly/io/async/EventBase.h>
+#include <openr/common/SpfBackoff.h>
+
+namespace openr {
+
+namespace {
+
+const std::chrono::milliseconds kInitialDelay{10};
+const std::chrono::milliseconds kShortDelay{50};
+const std::chrono::milliseconds kLongDelay{200};
+const std::chrono::milliseconds kTimeToLearn{500};
+const std::chrono::milliseconds kHoldDown{1500};
+
+} // namespace
+
+/**
+ * Verify state transitions QUIET -> SHORT_WAIT -> LONG_WAIT -> QUIET, and
+ * that computation is delayed as per state.
+ *
+ * Every step is triggered from the computation of the previous one, and only
+ * lower bounds of delays are verified. Timers only need to keep their order,
+ * which holds on a loaded host as well.
+ */
+TEST(SpfBackoff, StateMachine) {
+  folly::EventBase evb;
+  std::unique_ptr<SpfBackoff> backoff;
+  // Time of the first event batched into the scheduled computation
+  std::chrono::steady_clock::time_point eventTime;
+  std::vector<std::chrono::steady_clock::duration> runDelays;
+
+  auto event = [&]() {
+    if (not backoff->isScheduled()) {
+      eventTime = std::chrono::steady_clock::now();
+    }
+    (*backoff)();
+  };
+
+  backoff = std::make_unique<SpfBackoff>(
+      &evb,
+      kInitialDelay,
+      kShortDelay,
+      kLongDelay,
+      kTimeToLearn,
+      kHoldDown,
+      [&]() noexcept {
+        runDelays.emplace_back(std::chrono::steady_clock::now() - eventTime);
+        switch (runDelays.size()) {
+        case 1:
+          // Events within time to learn are computed after short delay, and
+          // batched
+          evb.runInLoop([&]() {
+            EXPECT_EQ(SpfBackoff::State::SHORT_WAIT, backoff->getState());
+            event();
+            event();
+          });
+          break;
+        case 2:
+          // Time to learn expired, events are computed after long delay
+          evb.runAfterDelay(
+              [&]() {
+                EXPECT_EQ(SpfBackoff::State::LONG_WAIT, backoff->getState());
+                event();
+              },
+              kTimeToLearn.count());
+          break;
+        case 3:
+          // Hold-down expired, events are computed after initial delay
+          evb.runAfterDelay(
+              [&]() {
+                EXPECT_EQ(SpfBackoff::State::QUIET, backoff->getState());
+                event();
+                EXPECT_EQ(SpfBackoff::State::SHORT_WAIT, backoff->getState());
+              },
+              kHoldDown.count());
+          break;
+        case 4:
+          // Cancelled computation is not run, state is not affected
+          evb.runInLoop([&]() {
+            event();
+            backoff->cancelScheduledTimeout();
+            EXPECT_FALSE(backoff->isScheduled());
+            EXPECT_EQ(SpfBackoff::State::SHORT_WAIT, backoff->getState());
+            evb.runAfterDelay(
+                [&]() { evb.terminateLoopSoon(); }, kLongDelay.count());
+          });
+          break;
+        default:
+          ADD_FAILURE() << "Unexpected computation " << runDelays.size();
+        }
+      });
+  EXPECT_EQ(SpfBackoff::State::QUIET, backoff->getState());
+
+  // First event is computed after initial delay
+  evb.runInEventBaseThread([&]() {
+    event();
+    EXPECT_EQ(SpfBackoff::State::SHORT_WAIT, backoff->getState());
+    EXPECT_TRUE(backoff->isScheduled());
+  });
+
+  // Bound the test in case a computation is not run
+  evb.runAfterDelay([&]() { evb.terminateLoopSoon(); }, 30000);
+  evb.loopForever();
+
+  ASSERT_EQ(4, runDelays.size());
+  EXPECT_GE(runDelays.at(0), kInitialDelay);
+  EXPECT_GE(runDelays.at(1), kShortDelay);
+  EXPECT_GE(runDelays.at(2), kLongDelay);
+  EXPECT_GE(runDelays.at(3), kInitialDelay);
+}
+
+} // namespace openr
+
+int
+main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  google::InitGoogleLogging(argv[0]);
+  google::InstallFailureSignalHandler();
+  FLAGS_logtostderr = true;
+
+  return RUN_ALL_TESTS();
+}
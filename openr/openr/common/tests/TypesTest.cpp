@@ -5,6 +5,8 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <thread>
+
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
@@ -54,6 +56,117 @@ TEST(TypesTest, fromStrTest) {
   EXPECT_TRUE(PrefixKey::fromStr(invalidStrWithBadPrefixV2, areaId).hasError());
 }
 
+/**
+ * Verify that single-pass parsing of prefix keys yields the same keys, and
+ * fails on the same keys, as regex matching.
+ */
+TEST(TypesTest, fromStrParityTest) {
+  const std::string areaId = "default-area";
+  const std::vector<std::string> keys = {
+      "prefix:node-1:[1.1.1.1/32]",
+      "prefix:node_1.domain:[10.1.2.3/24]",
+      "prefix:node-1:[10.0.0.0/8]",
+      "prefix:node-1:[10.0.0.0/008]",
+      "prefix:node-1:[0.0.0.0/0]",
+      "prefix:node-1:[fc00::1/64]",
+      "prefix:node-1:[FC00:0:0::1/128]",
+      "prefix:node-1:[fc00:0::/64]",
+      "prefix:node-1:[fc00::/64]",
+      "prefix:node-1:[0.0.0.0/00]",
+      "prefix:node-1:[::ffff:1.2.3.4/96]",
+      "prefix:node-1:[::/0]",
+      // invalid keys
+      "",
+      "prefix:",
+      "prefix:node-1",
+      "prefix::[1.1.1.1/32]",
+      "prefix:node-1:[1.1.1.1/32",
+      "prefix:node-1:[1.1.1.1/32]:",
+      "prefix:node-1:[1.1.1.1/33]",
+      "prefix:node-1:[1.1.1.1/1234]",
+      "prefix:node-1:[1.1.1.1/]",
+      "prefix:node-1:[/32]",
+      "prefix:node-1:[1.1./32]",
+      "prefix:node-1:[fc00::1/129]",
+      "prefix:node-1:[1.1.1.1:32]",
+      "prefix:node 1:[1.1.1.1/32]",
+      "prefix:node:1:[1.1.1.1/32]",
+      "prefix:node-1:[1.1.1.1/-1]",
+      "adj:node-1:[1.1.1.1/32]",
+  };
+
+  for (const auto& key : keys) {
+    SCOPED_TRACE(key);
+    const auto expected = PrefixKey::fromStrRE2(key, areaId);
+    const auto result = PrefixKey::fromStr(key, areaId);
+    ASSERT_EQ(expected.hasError(), result.hasError());
+    if (result.hasError()) {
+      EXPECT_EQ(expected.error(), result.error());
+      continue;
+    }
+    EXPECT_EQ(expected.value(), result.value());
+    EXPECT_EQ(expected->getNodeName(), result->getNodeName());
+    EXPECT_EQ(expected->getCIDRNetwork(), result->getCIDRNetwork());
+    EXPECT_EQ(expected->getPrefixKeyV2(), result->getPrefixKeyV2());
+  }
+}
+
+/**
+ * Verify that node names are interned to stable IDs, shared by prefix keys of
+ * the same node.
+ */
+TEST(TypesTest, NodeNameTableTest) {
+  const auto id1 = NodeNameTable::getId("intern-node-1");
+  const auto id2 = NodeNameTable::getId("intern-node-2");
+  EXPECT_NE(id1, id2);
+  EXPECT_EQ(id1, NodeNameTable::getId(std::string("intern-node-1")));
+  EXPECT_EQ("intern-node-1", NodeNameTable::getName(id1));
+  EXPECT_EQ("intern-node-2", NodeNameTable::getName(id2));
+  EXPECT_LE(2, NodeNameTable::size());
+
+  const auto network = folly::IPAddress::createNetwork("10.0.0.0/8");
+  const PrefixKey key1("intern-node-1", network, "area1");
+  const PrefixKey key2("intern-node-1", network, "area2");
+  const PrefixKey key3("intern-node-2", network, "area1");
+  EXPECT_EQ(id1, key1.getNodeId());
+  EXPECT_EQ(id1, key2.getNodeId());
+  EXPECT_EQ(id2, key3.getNodeId());
+  EXPECT_FALSE(key1 == key2);
+  EXPECT_FALSE(key1 == key3);
+  EXPECT_EQ(key1, PrefixKey("intern-node-1", network, "area1"));
+  EXPECT_EQ(
+      std::hash<PrefixKey>()(key1),
+      std::hash<PrefixKey>()(PrefixKey("intern-node-1", network, "area1")));
+}
+
+/**
+ * Verify that threads resolving the same node names, each through its own
+ * cache, agree on their IDs.
+ */
+TEST(TypesTest, NodeNameTableConcurrentTest) {
+  const size_t kNumThreads = 8;
+  const size_t kNumNames = 100;
+  std::vector<std::vector<uint32_t>> ids(kNumThreads);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&ids, i]() {
+      for (size_t j = 0; j < kNumNames; ++j) {
+        const auto name = fmt::format("concurrent-node-{}", j);
+        const auto id = NodeNameTable::getId(name);
+        EXPECT_EQ(id, NodeNameTable::getId(name));
+        EXPECT_EQ(name, NodeNameTable::getName(id));
+        ids.at(i).emplace_back(id);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  for (size_t i = 1; i < kNumThreads; ++i) {
+    EXPECT_EQ(ids.at(0), ids.at(i));
+  }
+}
+
 TEST(TypesTest, RegexSetTest) {
   EXPECT_NO_THROW(RegexSet{{"prefix:good"}});
 
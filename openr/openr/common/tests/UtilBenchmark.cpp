@@ -8,6 +8,7 @@
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
 
+#include <openr/common/LsdbTypes.h>
 #include <openr/common/LsdbUtil.h>
 #include <openr/common/Types.h>
 
@@ -48,6 +49,51 @@ BENCHMARK_PARAM(BM_SelectRoutes, 64);
 BENCHMARK_PARAM(BM_SelectRoutes, 128);
 BENCHMARK_PARAM(BM_SelectRoutes, 256);
 
+/**
+ * Parse prefix keys of given number of nodes, each with 16 prefixes, either in
+ * a single pass or by regex matching. Every iteration parses one key, hence
+ * iters/sec reports keys/sec.
+ */
+void
+runPrefixKeyFromStr(uint32_t iters, size_t numNodes, bool useRE2) {
+  auto suspender = folly::BenchmarkSuspender();
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < numNodes; ++i) {
+    for (size_t j = 0; j < 16; ++j) {
+      keys.emplace_back(
+          PrefixKey(
+              fmt::format("node-{}", i),
+              folly::IPAddress::createNetwork(
+                  fmt::format("fc00:{}:{}::/64", i, j)),
+              Constants::kDefaultArea.toString())
+              .getPrefixKeyV2());
+    }
+  }
+  suspender.dismiss(); // Start measuring benchmark time
+
+  for (uint32_t i = 0; i < iters; ++i) {
+    const auto& key = keys[i % keys.size()];
+    auto maybePrefixKey =
+        useRE2 ? PrefixKey::fromStrRE2(key) : PrefixKey::fromStr(key);
+    folly::doNotOptimizeAway(maybePrefixKey);
+  }
+}
+
+void
+BM_PrefixKeyFromStr(uint32_t iters, size_t numNodes) {
+  runPrefixKeyFromStr(iters, numNodes, false /* useRE2 */);
+}
+
+void
+BM_PrefixKeyFromStrRE2(uint32_t iters, size_t numNodes) {
+  runPrefixKeyFromStr(iters, numNodes, true /* useRE2 */);
+}
+
+BENCHMARK_PARAM(BM_PrefixKeyFromStr, 100);
+BENCHMARK_RELATIVE_PARAM(BM_PrefixKeyFromStrRE2, 100);
+BENCHMARK_PARAM(BM_PrefixKeyFromStr, 1000);
+BENCHMARK_RELATIVE_PARAM(BM_PrefixKeyFromStrRE2, 1000);
+
 int
 main(int argc, char** argv) {
   folly::init(&argc, &argv);
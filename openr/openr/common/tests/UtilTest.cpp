@@ -470,6 +470,25 @@ TEST(UtilTest, addPerfEventTest) {
     EXPECT_EQ(*perfEvents.events()[1].nodeName(), "node2");
     EXPECT_EQ(*perfEvents.events()[1].eventDescr(), "LINK_DOWN");
   }
+
+  {
+    // Typed event is described by the name of its type
+    thrift::PerfEvents perfEvents;
+    addPerfEvent(perfEvents, "node1", thrift::PerfEventType::ROUTE_UPDATE);
+    addPerfEvent(perfEvents, "node1", "DECISION_DEBOUNCE");
+    addPerfEvent(perfEvents, "node1", "LINK_UP");
+    EXPECT_EQ(*perfEvents.events()[0].eventDescr(), "ROUTE_UPDATE");
+    EXPECT_EQ(
+        thrift::PerfEventType::ROUTE_UPDATE,
+        getPerfEventType(perfEvents.events()[0]));
+    // Type of untyped event is derived from its description
+    EXPECT_EQ(
+        thrift::PerfEventType::DECISION_DEBOUNCE,
+        getPerfEventType(perfEvents.events()[1]));
+    EXPECT_EQ(
+        thrift::PerfEventType::UNKNOWN,
+        getPerfEventType(perfEvents.events()[2]));
+  }
 }
 
 TEST(UtilTest, sprintPerfEventsTest) {
@@ -594,6 +613,43 @@ TEST(UtilTest, findDeltaRoutes) {
   EXPECT_EQ(res3.mplsRoutesToDelete()->at(0), 2);
 }
 
+TEST(UtilTest, mergeRouteDatabaseDeltas) {
+  std::vector<thrift::RouteDatabaseDelta> deltas(3);
+  // add prefix2, prefix3 and label 2
+  deltas.at(0).unicastRoutesToUpdate()->emplace_back(
+      createUnicastRoute(prefix2, {path1_2_1}));
+  deltas.at(0).unicastRoutesToUpdate()->emplace_back(
+      createUnicastRoute(prefix3, {path1_3_1}));
+  deltas.at(0).mplsRoutesToUpdate()->emplace_back(
+      createMplsRoute(2, {path1_2_1_swap}));
+  deltas.at(0).seqNum() = 1;
+  // update prefix2, delete prefix3 and label 2
+  deltas.at(1).unicastRoutesToUpdate()->emplace_back(
+      createUnicastRoute(prefix2, {path1_2_1, path1_2_2}));
+  deltas.at(1).unicastRoutesToDelete()->emplace_back(prefix3);
+  deltas.at(1).mplsRoutesToDelete()->emplace_back(2);
+  deltas.at(1).seqNum() = 2;
+  // re-add label 2, delete label 3
+  deltas.at(2).mplsRoutesToUpdate()->emplace_back(
+      createMplsRoute(2, {path1_2_2_swap}));
+  deltas.at(2).mplsRoutesToDelete()->emplace_back(3);
+  deltas.at(2).seqNum() = 3;
+
+  const auto delta = mergeRouteDatabaseDeltas(std::move(deltas));
+  EXPECT_EQ(
+      std::vector<thrift::UnicastRoute>(
+          {createUnicastRoute(prefix2, {path1_2_1, path1_2_2})}),
+      *delta.unicastRoutesToUpdate());
+  EXPECT_EQ(
+      std::vector<thrift::IpPrefix>({prefix3}),
+      *delta.unicastRoutesToDelete());
+  EXPECT_EQ(
+      std::vector<thrift::MplsRoute>({createMplsRoute(2, {path1_2_2_swap})}),
+      *delta.mplsRoutesToUpdate());
+  EXPECT_EQ(std::vector<int32_t>({3}), *delta.mplsRoutesToDelete());
+  EXPECT_EQ(3, delta.seqNum().value());
+}
+
 TEST(UtilTest, MplsActionValidate) {
   //
   // PHP
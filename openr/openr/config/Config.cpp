@@ -142,6 +142,34 @@ Config::checkDecisionConfig() const {
         *decisionConf.debounce_min_ms(),
         *decisionConf.debounce_max_ms()));
   }
+  if (*decisionConf.route_build_threads() < 1) {
+    throw std::invalid_argument(fmt::format(
+        "decision_config.route_build_threads ({}) should be >= 1",
+        *decisionConf.route_build_threads()));
+  }
+  if (*decisionConf.warm_start_max_age_s() < 0) {
+    throw std::invalid_argument(fmt::format(
+        "decision_config.warm_start_max_age_s ({}) should be >= 0",
+        *decisionConf.warm_start_max_age_s()));
+  }
+  if (auto backoffConf = decisionConf.spf_backoff_config()) {
+    if (*backoffConf->initial_delay_ms() < 0 ||
+        *backoffConf->initial_delay_ms() > *backoffConf->short_delay_ms() ||
+        *backoffConf->short_delay_ms() > *backoffConf->long_delay_ms()) {
+      throw std::invalid_argument(fmt::format(
+          "decision_config.spf_backoff_config delays should be 0 <= initial_delay_ms ({}) <= short_delay_ms ({}) <= long_delay_ms ({})",
+          *backoffConf->initial_delay_ms(),
+          *backoffConf->short_delay_ms(),
+          *backoffConf->long_delay_ms()));
+    }
+    if (*backoffConf->time_to_learn_ms() <= 0 ||
+        *backoffConf->hold_down_ms() <= *backoffConf->time_to_learn_ms()) {
+      throw std::invalid_argument(fmt::format(
+          "decision_config.spf_backoff_config should be 0 < time_to_learn_ms ({}) < hold_down_ms ({})",
+          *backoffConf->time_to_learn_ms(),
+          *backoffConf->hold_down_ms()));
+    }
+  }
 }
 
 void
@@ -435,6 +463,7 @@ Config::toThriftKvStoreConfig() const {
   if (auto selfAdjTimeoutMs = oldConfig.self_adjacency_timeout_ms()) {
     config.self_adjacency_timeout_ms() = *oldConfig.self_adjacency_timeout_ms();
   }
+  config.enable_per_area_event_base() = *oldConfig.enable_per_area_event_base();
   return config;
 }
 
@@ -141,6 +141,11 @@ class Config {
     return config_.v4_over_v6_nexthop().value_or(false);
   }
 
+  bool
+  isWarmStartEnabled() const {
+    return *config_.decision_config()->enable_warm_start();
+  }
+
   bool
   isDryrun() const {
     return config_.dryrun().value_or(false);
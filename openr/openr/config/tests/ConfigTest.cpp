@@ -6,6 +6,7 @@
  */
 
 #include <folly/FileUtil.h>
+#include <folly/json/json.h>
 #include <folly/testing/TestUtil.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
@@ -258,6 +259,27 @@ TEST(ConfigTest, PopulateInternalDb) {
     EXPECT_THROW((Config(confInvalidFloodMsgPerSec)), std::out_of_range);
   }
 
+  // Decision
+
+  // Exception: SPF back-off delays not in order, or hold-down <= time to learn
+  {
+    auto confInvalidBackoff = getBasicOpenrConfig();
+    confInvalidBackoff.decision_config()->spf_backoff_config() =
+        thrift::SpfBackoffConfig();
+    EXPECT_NO_THROW(auto c = Config(confInvalidBackoff));
+
+    confInvalidBackoff.decision_config()
+        ->spf_backoff_config()
+        ->short_delay_ms() = 10000;
+    EXPECT_THROW(auto c = Config(confInvalidBackoff), std::invalid_argument);
+
+    confInvalidBackoff.decision_config()->spf_backoff_config() =
+        thrift::SpfBackoffConfig();
+    confInvalidBackoff.decision_config()->spf_backoff_config()->hold_down_ms() =
+        100;
+    EXPECT_THROW(auto c = Config(confInvalidBackoff), std::invalid_argument);
+  }
+
   // Spark
 
   // Exception: neighbor_discovery_port <= 0 or > 65535
@@ -13,8 +13,10 @@ namespace fs = std::filesystem;
 
 #include <folly/ExceptionString.h>
 #include <folly/logging/xlog.h>
+#include <thrift/lib/cpp2/protocol/CompactProtocol.h>
 
 #include <openr/common/Constants.h>
+#include <openr/common/Flags.h>
 #include <openr/common/LsdbUtil.h>
 #include <openr/common/Util.h>
 #include <openr/monitor/LogSample.h>
@@ -23,6 +25,38 @@ namespace fb303 = facebook::fb303;
 
 namespace openr {
 
+namespace {
+
+std::vector<thrift::RouteDatabaseDelta>
+coalesceRouteDatabaseDeltas(std::vector<thrift::RouteDatabaseDelta>&& deltas) {
+  std::vector<thrift::RouteDatabaseDelta> coalescedDeltas;
+  coalescedDeltas.emplace_back(mergeRouteDatabaseDeltas(std::move(deltas)));
+  return coalescedDeltas;
+}
+
+// Options of per-subscriber stream queue
+template <typename T>
+typename CoalescingStreamPublisher<T>::Options
+getStreamOptions(
+    const std::string& name, std::vector<T> (*coalesce)(std::vector<T>&&)) {
+  typename CoalescingStreamPublisher<T>::Options options;
+  options.name = name;
+  options.highWatermark = FLAGS_ctrl_stream_high_watermark;
+  options.dropSlowSubscriber = FLAGS_ctrl_stream_drop_slow_subscriber;
+  options.coalesce = coalesce;
+  return options;
+}
+
+// Size of the stream delta, used to bound memory of replay buffers
+template <typename T>
+size_t
+getSerializedSize(const T& delta) {
+  apache::thrift::CompactProtocolWriter writer;
+  return delta.serializedSize(&writer);
+}
+
+} // namespace
+
 OpenrCtrlHandler::OpenrCtrlHandler(
     const std::string& nodeName,
     const std::unordered_set<std::string>& acceptablePeerCommonNames,
@@ -36,7 +70,8 @@ OpenrCtrlHandler::OpenrCtrlHandler(
     PrefixManager* prefixManager,
     Spark* spark,
     std::shared_ptr<const Config> config,
-    Dispatcher* dispatcher)
+    Dispatcher* dispatcher,
+    Watchdog* watchdog)
     : fb303::BaseService("openr"),
       nodeName_(nodeName),
       acceptablePeerCommonNames_(acceptablePeerCommonNames),
@@ -50,7 +85,10 @@ OpenrCtrlHandler::OpenrCtrlHandler(
       prefixManager_(prefixManager),
       spark_(spark),
       config_(config),
-      dispatcher_(dispatcher) {
+      dispatcher_(dispatcher),
+      watchdog_(watchdog),
+      fibSnapshotCache_("fib", ctrlEvb->getEvb()),
+      kvStoreSnapshotCache_("kvstore", ctrlEvb->getEvb()) {
   // We expect ctrl-evb not be running otherwise adding fiber task is not
   // thread safe.
   CHECK_NOTNULL(ctrlEvb);
@@ -100,14 +138,25 @@ OpenrCtrlHandler::OpenrCtrlHandler(
               break;
             }
 
-            // Publish the update to all active streams
-            fibPublishers_.withWLock([&maybeUpdate](auto& fibPublishers) {
-              if (fibPublishers.size()) {
-                const auto fibUpdate = maybeUpdate.value().toThrift();
-                for (auto& fibPublisher : fibPublishers) {
-                  fibPublisher.second.next(fibUpdate);
-                }
+            // Invalidate snapshot before publishing. Subscriber registered
+            // after this update will fetch the snapshot reflecting it.
+            fibSnapshotCache_.invalidate();
+
+            // Retain the update for resuming streams and publish it to all
+            // active streams. Skip building it if no stream can receive or
+            // resume it.
+            fibPublishers_.withWLock([&maybeUpdate, this](auto& fibPublishers) {
+              if (not fibReplayBuffer_.isRetaining(fibPublishers.size())) {
+                fibReplayBuffer_.skip();
+                return;
+              }
+              auto fibUpdate = maybeUpdate.value().toThrift();
+              fibUpdate.seqNum() = fibReplayBuffer_.getLastSeqNum() + 1;
+              for (auto& fibPublisher : fibPublishers) {
+                fibPublisher.second.next(fibUpdate);
               }
+              const auto bytes = getSerializedSize(fibUpdate);
+              fibReplayBuffer_.append(std::move(fibUpdate), bytes);
             });
 
             // Publish the detailed update to all active streams
@@ -171,7 +220,7 @@ OpenrCtrlHandler::closeKvStorePublishers() {
 // Refer to note on top of closeKvStorePublishers
 void
 OpenrCtrlHandler::closeFibPublishers() {
-  std::vector<apache::thrift::ServerStreamPublisher<thrift::RouteDatabaseDelta>>
+  std::vector<CoalescingStreamPublisher<thrift::RouteDatabaseDelta>>
       fibPublishers_close;
   fibPublishers_.withWLock([&fibPublishers_close](auto& fibPublishers) {
     for (auto& [_, fibPublisher] : fibPublishers) {
@@ -188,12 +237,22 @@ OpenrCtrlHandler::closeFibPublishers() {
 
 void
 OpenrCtrlHandler::processPublication(thrift::Publication&& pub) {
-  // publish via KvStorePublisher
+  // invalidate snapshots before publishing, see SnapshotCache
+  kvStoreSnapshotCache_.invalidate();
+
+  // retain for resuming streams and publish via KvStorePublisher
   kvStorePublishers_.withWLock([&](auto& kvStorePublishers_) {
+    if (not kvStoreReplayBuffer_.isRetaining(kvStorePublishers_.size())) {
+      kvStoreReplayBuffer_.skip();
+      return;
+    }
+    pub.seqNum() = kvStoreReplayBuffer_.getLastSeqNum() + 1;
+    kvStoreReplayBuffer_.append(pub, getSerializedSize(pub));
+    const auto firstSeqNum = kvStoreReplayBuffer_.getFirstSeqNum();
     for (auto& [_, publisher] : kvStorePublishers_) {
       publisher->last_message_time_ = std::chrono::system_clock::now();
       publisher->total_messages_++;
-      publisher->publish(pub);
+      publisher->publish(pub, firstSeqNum);
     }
   });
 
@@ -297,6 +356,12 @@ OpenrCtrlHandler::getEventLogs(std::vector<::std::string>& _return) {
   }
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::ProcessProfile>>
+OpenrCtrlHandler::semifuture_getProcessProfile() {
+  CHECK(monitor_);
+  return monitor_->getProcessProfile();
+}
+
 void
 OpenrCtrlHandler::getCounters(std::map<std::string, int64_t>& _return) {
   BaseService::getCounters(_return);
@@ -619,6 +684,20 @@ OpenrCtrlHandler::semifuture_getPerfDb() {
   return fib_->getPerfDb();
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::ConvergenceStats>>
+OpenrCtrlHandler::semifuture_getConvergenceStats() {
+  CHECK(fib_);
+  return fib_->getConvergenceStats();
+}
+
+folly::SemiFuture<std::unique_ptr<thrift::RuntimeStats>>
+OpenrCtrlHandler::semifuture_getRuntimeStats() {
+  if (not watchdog_) {
+    throw thrift::OpenrError("Watchdog is not enabled");
+  }
+  return watchdog_->getRuntimeStats();
+}
+
 //
 // Decision APIs
 //
@@ -910,6 +989,7 @@ OpenrCtrlHandler::semifuture_getSubscriberInfo(int64_t type) {
                   .time_since_epoch()
                   .count();
           subscriber.total_streamed_msgs() = publisher->total_messages_;
+          subscriber.pending_msgs() = publisher->getNumPending();
 
           subscribers.emplace_back(subscriber);
         }
@@ -946,43 +1026,86 @@ OpenrCtrlHandler::semifuture_getSubscriberInfo(int64_t type) {
   return sf;
 }
 
-apache::thrift::ServerStream<thrift::Publication>
+std::pair<apache::thrift::ServerStream<thrift::Publication>, int64_t>
 OpenrCtrlHandler::subscribeKvStoreFilter(
     std::unique_ptr<thrift::KeyDumpParams> filter,
-    std::unique_ptr<std::set<std::string>> selectAreas) {
+    std::unique_ptr<std::set<std::string>> selectAreas,
+    std::optional<int64_t> lastSeqNum) {
   // Get new client-ID (monotonically increasing)
   auto clientToken = publisherToken_++;
 
-  auto streamAndPublisher =
-      apache::thrift::ServerStream<thrift::Publication>::createPublisher(
-          [this, clientToken]() {
-            kvStorePublishers_.withWLock([&](auto& kvStorePublishers_) {
-              if (kvStorePublishers_.erase(clientToken)) {
-                XLOG(INFO) << "KvStore snoop stream-" << clientToken
-                           << " ended.";
-              } else {
-                XLOG(ERR) << "Can't remove unknown KvStore snoop stream-"
-                          << clientToken;
-              }
-              fb303::fbData->setCounter(
-                  "subscribers.kvstore", kvStorePublishers_.size());
+  // NOTE: Replay and registration must happen under the same lock as
+  // publishing, otherwise a publication could be missed or duplicated
+  return kvStorePublishers_.withWLock([&](auto& kvStorePublishers_) {
+    std::vector<const thrift::Publication*> missedPubs;
+    if (lastSeqNum.has_value()) {
+      auto maybeMissedPubs =
+          kvStoreReplayBuffer_.getDeltasSince(lastSeqNum.value());
+      if (not maybeMissedPubs.has_value()) {
+        fb303::fbData->addStatValue(
+            "ctrl.stream_resume.kvstore.failure", 1, fb303::COUNT);
+        throw thrift::OpenrError(fmt::format(
+            "Can't resume KvStore stream from sequence number {}. Retained "
+            "sequence numbers: [{}, {}]",
+            lastSeqNum.value(),
+            kvStoreReplayBuffer_.getFirstSeqNum(),
+            kvStoreReplayBuffer_.getLastSeqNum()));
+      }
+      fb303::fbData->addStatValue(
+          "ctrl.stream_resume.kvstore.success", 1, fb303::COUNT);
+      missedPubs = std::move(maybeMissedPubs).value();
+    }
+
+    auto streamAndPublisher =
+        CoalescingStreamPublisher<thrift::Publication>::createPublisher(
+            getStreamOptions<thrift::Publication>(
+                "kvstore", mergePublications),
+            [this, clientToken]() {
+              kvStorePublishers_.withWLock([&](auto& kvStorePublishers_) {
+                if (kvStorePublishers_.erase(clientToken)) {
+                  XLOG(INFO) << "KvStore snoop stream-" << clientToken
+                             << " ended.";
+                  kvStoreReplayBuffer_.markStreamActivity();
+                } else {
+                  XLOG(ERR) << "Can't remove unknown KvStore snoop stream-"
+                            << clientToken;
+                }
+                fb303::fbData->setCounter(
+                    "subscribers.kvstore", kvStorePublishers_.size());
+              });
             });
-          });
 
-  kvStorePublishers_.withWLock([&](auto& kvStorePublishers_) {
     assert(kvStorePublishers_.count(clientToken) == 0);
     XLOG(INFO) << "KvStore snoop stream-" << clientToken
-               << " started for areas: " << folly::join(", ", *selectAreas);
+               << " started for areas: " << folly::join(", ", *selectAreas)
+               << ", replaying " << missedPubs.size() << " publications";
     auto kvStorePublisher = std::make_unique<KvStorePublisher>(
         *selectAreas,
         std::move(*filter),
         std::move(streamAndPublisher.second),
         std::chrono::steady_clock::now(),
         0);
+    kvStorePublisher->setLastSeqNum(
+        lastSeqNum.value_or(kvStoreReplayBuffer_.getLastSeqNum()));
+    for (const auto* pub : missedPubs) {
+      kvStorePublisher->publish(*pub, kvStoreReplayBuffer_.getFirstSeqNum());
+    }
     kvStorePublishers_.emplace(clientToken, std::move(kvStorePublisher));
     fb303::fbData->setCounter("subscribers.kvstore", kvStorePublishers_.size());
+    return std::make_pair(
+        std::move(streamAndPublisher.first),
+        kvStoreReplayBuffer_.getLastSeqNum());
   });
-  return std::move(streamAndPublisher.first);
+}
+
+apache::thrift::ServerStream<thrift::Publication>
+OpenrCtrlHandler::resumeAreaKvStores(
+    std::unique_ptr<thrift::KeyDumpParams> filter,
+    std::unique_ptr<std::set<std::string>> selectAreas,
+    int64_t lastSeqNum) {
+  return subscribeKvStoreFilter(
+             std::move(filter), std::move(selectAreas), lastSeqNum)
+      .first;
 }
 
 folly::SemiFuture<apache::thrift::ResponseAndServerStream<
@@ -1020,71 +1143,142 @@ folly::SemiFuture<apache::thrift::ResponseAndServerStream<
 OpenrCtrlHandler::semifuture_subscribeAndGetAreaKvStores(
     std::unique_ptr<thrift::KeyDumpParams> dumpParams,
     std::unique_ptr<std::set<std::string>> selectAreas) {
-  auto dumpParamsCopy = std::make_unique<thrift::KeyDumpParams>(*dumpParams);
-  auto selectAreasCopy = std::make_unique<std::set<std::string>>(*selectAreas);
-  return kvStore_
-      ->semifuture_dumpKvStoreKeys(
-          std::move(*dumpParams), std::move(*selectAreas))
-      .defer([stream = subscribeKvStoreFilter(
-                  std::move(dumpParamsCopy), std::move(selectAreasCopy))](
-                 folly::Try<std::unique_ptr<std::vector<thrift::Publication>>>&&
-                     pubs) mutable {
-        pubs.throwUnlessValue();
-        for (auto& pub : *pubs.value()) {
-          // Set the publication timestamp
-          pub.timestamp_ms() = getUnixTimeStampMs();
-        }
-        return apache::thrift::ResponseAndServerStream<
-            std::vector<thrift::Publication>,
-            thrift::Publication>{std::move(*pubs.value()), std::move(stream)};
-      });
+  // Register stream before fetching the snapshot, otherwise publications
+  // between the snapshot and the registration would be lost
+  auto [stream, seqNum] = subscribeKvStoreFilter(
+      std::make_unique<thrift::KeyDumpParams>(*dumpParams),
+      std::make_unique<std::set<std::string>>(*selectAreas));
+
+  // Requests with identical dump parameters and areas share the snapshot
+  apache::thrift::CompactSerializer serializer;
+  auto key = writeThriftObjStr(*dumpParams, serializer);
+  for (const auto& area : *selectAreas) {
+    key.append(1, '\0').append(area);
+  }
+
+  return kvStoreSnapshotCache_
+      .get(
+          key,
+          [this,
+           dumpParams = std::move(dumpParams),
+           selectAreas = std::move(selectAreas)]() mutable {
+            return kvStore_
+                ->semifuture_dumpKvStoreKeys(
+                    std::move(*dumpParams), std::move(*selectAreas))
+                .deferValue(
+                    [](std::unique_ptr<std::vector<thrift::Publication>>&&
+                           pubs) { return std::move(*pubs); });
+          })
+      .deferValue(
+          [stream = std::move(stream), seqNum = seqNum](
+              std::shared_ptr<const std::vector<thrift::Publication>>&&
+                  snapshot) mutable {
+            // Copy from the shared snapshot on the request's executor
+            auto pubs = *snapshot;
+            for (auto& pub : pubs) {
+              // Set the publication timestamp
+              pub.timestamp_ms() = getUnixTimeStampMs();
+              // Snapshot reflects at least all publications streamed before
+              // the registration
+              pub.seqNum() = seqNum;
+            }
+            return apache::thrift::ResponseAndServerStream<
+                std::vector<thrift::Publication>,
+                thrift::Publication>{std::move(pubs), std::move(stream)};
+          });
 }
 
-apache::thrift::ServerStream<thrift::RouteDatabaseDelta>
-OpenrCtrlHandler::subscribeFib() {
+std::pair<apache::thrift::ServerStream<thrift::RouteDatabaseDelta>, int64_t>
+OpenrCtrlHandler::subscribeFib(std::optional<int64_t> lastSeqNum) {
   // Get new client-ID (monotonically increasing)
   auto clientToken = publisherToken_++;
 
-  auto streamAndPublisher =
-      apache::thrift::ServerStream<thrift::RouteDatabaseDelta>::createPublisher(
-          [this, clientToken]() {
-            fibPublishers_.withWLock([&clientToken](auto& fibPublishers) {
-              if (fibPublishers.erase(clientToken)) {
-                XLOG(INFO) << "Fib snoop stream-" << clientToken << " ended.";
-              } else {
-                XLOG(ERR) << "Can't remove unknown Fib snoop stream-"
-                          << clientToken;
-              }
-              fb303::fbData->setCounter(
-                  "subscribers.fib", fibPublishers.size());
+  // NOTE: Replay and registration must happen under the same lock as
+  // publishing, see subscribeKvStoreFilter
+  return fibPublishers_.withWLock([&](auto& fibPublishers) {
+    std::vector<const thrift::RouteDatabaseDelta*> missedDeltas;
+    if (lastSeqNum.has_value()) {
+      auto maybeMissedDeltas =
+          fibReplayBuffer_.getDeltasSince(lastSeqNum.value());
+      if (not maybeMissedDeltas.has_value()) {
+        fb303::fbData->addStatValue(
+            "ctrl.stream_resume.fib.failure", 1, fb303::COUNT);
+        throw thrift::OpenrError(fmt::format(
+            "Can't resume Fib stream from sequence number {}. Retained "
+            "sequence numbers: [{}, {}]",
+            lastSeqNum.value(),
+            fibReplayBuffer_.getFirstSeqNum(),
+            fibReplayBuffer_.getLastSeqNum()));
+      }
+      fb303::fbData->addStatValue(
+          "ctrl.stream_resume.fib.success", 1, fb303::COUNT);
+      missedDeltas = std::move(maybeMissedDeltas).value();
+    }
+
+    auto streamAndPublisher =
+        CoalescingStreamPublisher<thrift::RouteDatabaseDelta>::createPublisher(
+            getStreamOptions<thrift::RouteDatabaseDelta>(
+                "fib", coalesceRouteDatabaseDeltas),
+            [this, clientToken]() {
+              fibPublishers_.withWLock([&](auto& fibPublishers) {
+                if (fibPublishers.erase(clientToken)) {
+                  XLOG(INFO) << "Fib snoop stream-" << clientToken
+                             << " ended.";
+                  fibReplayBuffer_.markStreamActivity();
+                } else {
+                  XLOG(ERR) << "Can't remove unknown Fib snoop stream-"
+                            << clientToken;
+                }
+                fb303::fbData->setCounter(
+                    "subscribers.fib", fibPublishers.size());
+              });
             });
-          });
 
-  fibPublishers_.withWLock([&clientToken,
-                            &streamAndPublisher](auto& fibPublishers) {
     assert(fibPublishers.count(clientToken) == 0);
-    XLOG(INFO) << "Fib snoop stream-" << clientToken << " started.";
+    XLOG(INFO) << "Fib snoop stream-" << clientToken << " started, replaying "
+               << missedDeltas.size() << " deltas";
+    for (const auto* delta : missedDeltas) {
+      streamAndPublisher.second.next(*delta);
+    }
     fibPublishers.emplace(clientToken, std::move(streamAndPublisher.second));
     fb303::fbData->setCounter("subscribers.fib", fibPublishers.size());
+    return std::make_pair(
+        std::move(streamAndPublisher.first), fibReplayBuffer_.getLastSeqNum());
   });
+}
 
-  return std::move(streamAndPublisher.first);
+apache::thrift::ServerStream<thrift::RouteDatabaseDelta>
+OpenrCtrlHandler::resumeFib(int64_t lastSeqNum) {
+  CHECK(fib_);
+  return subscribeFib(lastSeqNum).first;
 }
 
 folly::SemiFuture<apache::thrift::ResponseAndServerStream<
     thrift::RouteDatabase,
     thrift::RouteDatabaseDelta>>
 OpenrCtrlHandler::semifuture_subscribeAndGetFib() {
-  auto stream = subscribeFib();
-  return semifuture_getRouteDb().defer(
-      [stream = std::move(stream)](
-          folly::Try<std::unique_ptr<thrift::RouteDatabase>>&& db) mutable {
-        db.throwUnlessValue();
-        return apache::thrift::ResponseAndServerStream<
-            thrift::RouteDatabase,
-            thrift::RouteDatabaseDelta>{
-            std::move(*db.value()), std::move(stream)};
-      });
+  CHECK(fib_);
+  // Register stream before fetching the snapshot, see SnapshotCache
+  auto [stream, seqNum] = subscribeFib();
+  return fibSnapshotCache_
+      .get(
+          "",
+          [this]() {
+            return fib_->getRouteDb().deferValue(
+                [](std::unique_ptr<thrift::RouteDatabase>&& db) {
+                  return std::move(*db);
+                });
+          })
+      .deferValue(
+          [stream = std::move(stream), seqNum = seqNum](
+              std::shared_ptr<const thrift::RouteDatabase>&& db) mutable {
+            auto response = *db;
+            response.seqNum() = seqNum;
+            return apache::thrift::ResponseAndServerStream<
+                thrift::RouteDatabase,
+                thrift::RouteDatabaseDelta>{
+                std::move(response), std::move(stream)};
+          });
 }
 
 apache::thrift::ServerStream<thrift::RouteDatabaseDeltaDetail>
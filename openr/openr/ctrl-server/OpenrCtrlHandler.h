@@ -8,9 +8,12 @@
 #pragma once
 
 #include <fb303/BaseService.h>
+#include <openr/common/CoalescingStreamPublisher.h>
 #include <openr/common/Types.h>
 #include <openr/config-store/PersistentStore.h>
 #include <openr/config/Config.h>
+#include <openr/ctrl-server/SnapshotCache.h>
+#include <openr/ctrl-server/StreamReplayBuffer.h>
 #include <openr/decision/Decision.h>
 #include <openr/dispatcher/Dispatcher.h>
 #include <openr/fib/Fib.h>
@@ -23,6 +26,7 @@
 #include <openr/monitor/Monitor.h>
 #include <openr/prefix-manager/PrefixManager.h>
 #include <openr/spark/Spark.h>
+#include <openr/watchdog/Watchdog.h>
 
 namespace openr {
 
@@ -61,7 +65,8 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
       PrefixManager* prefixManager,
       Spark* spark,
       std::shared_ptr<const Config> config,
-      Dispatcher* dispatcher = nullptr);
+      Dispatcher* dispatcher = nullptr,
+      Watchdog* watchdog = nullptr);
 
   ~OpenrCtrlHandler() override;
 
@@ -114,6 +119,9 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
 
   void getEventLogs(std::vector<::std::string>& _return) override;
 
+  folly::SemiFuture<std::unique_ptr<thrift::ProcessProfile>>
+  semifuture_getProcessProfile() override;
+
   //
   // PrefixManager APIs
   //
@@ -203,6 +211,12 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
   folly::SemiFuture<std::unique_ptr<thrift::PerfDatabase>>
   semifuture_getPerfDb() override;
 
+  folly::SemiFuture<std::unique_ptr<thrift::ConvergenceStats>>
+  semifuture_getConvergenceStats() override;
+
+  folly::SemiFuture<std::unique_ptr<thrift::RuntimeStats>>
+  semifuture_getRuntimeStats() override;
+
   //
   // Decision APIs
   //
@@ -360,12 +374,20 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
 
   // Stream API's
   // Intentionally not use SemiFuture as stream is async by nature and we will
-  // immediately create and return the stream handler
-  apache::thrift::ServerStream<thrift::Publication> subscribeKvStoreFilter(
+  // immediately create and return the stream handler.
+  //
+  // Returns the stream along with the sequence number of the last update
+  // published before the registration. If `lastSeqNum` is set, updates
+  // following it are replayed on the stream first. Throws thrift::OpenrError
+  // if they are no longer retained.
+  std::pair<apache::thrift::ServerStream<thrift::Publication>, int64_t>
+  subscribeKvStoreFilter(
       std::unique_ptr<thrift::KeyDumpParams> filter,
-      std::unique_ptr<std::set<std::string>> selectAreas);
+      std::unique_ptr<std::set<std::string>> selectAreas,
+      std::optional<int64_t> lastSeqNum = std::nullopt);
 
-  apache::thrift::ServerStream<thrift::RouteDatabaseDelta> subscribeFib();
+  std::pair<apache::thrift::ServerStream<thrift::RouteDatabaseDelta>, int64_t>
+  subscribeFib(std::optional<int64_t> lastSeqNum = std::nullopt);
 
   apache::thrift::ServerStream<thrift::RouteDatabaseDeltaDetail>
   subscribeFibDetail();
@@ -398,6 +420,14 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
       thrift::RouteDatabaseDeltaDetail>>
   semifuture_subscribeAndGetFibDetail() override;
 
+  apache::thrift::ServerStream<thrift::Publication> resumeAreaKvStores(
+      std::unique_ptr<thrift::KeyDumpParams> filter,
+      std::unique_ptr<std::set<std::string>> selectAreas,
+      int64_t lastSeqNum) override;
+
+  apache::thrift::ServerStream<thrift::RouteDatabaseDelta> resumeFib(
+      int64_t lastSeqNum) override;
+
   // Long poll support
   folly::SemiFuture<bool> semifuture_longPollKvStoreAdj(
       std::unique_ptr<thrift::KeyVals> snapshot) override;
@@ -603,6 +633,7 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
   Spark* spark_{nullptr};
   std::shared_ptr<const Config> config_;
   Dispatcher* dispatcher_{nullptr};
+  Watchdog* watchdog_{nullptr};
 
   // Publisher token (monotonically increasing) for all publishers
   std::atomic<int64_t> publisherToken_{0};
@@ -612,16 +643,35 @@ class OpenrCtrlHandler final : public thrift::OpenrCtrlCppSvIf,
       std::unordered_map<int64_t, std::unique_ptr<KvStorePublisher>>>
       kvStorePublishers_;
 
+  // Recent publications for resuming kvstore streams.
+  // NOTE: Guarded by `kvStorePublishers_` lock
+  StreamReplayBuffer<thrift::Publication> kvStoreReplayBuffer_{
+      Constants::kCtrlStreamReplayBufferSize,
+      Constants::kCtrlStreamReplayBufferMaxBytes,
+      Constants::kCtrlStreamReplayRetention};
+
   // Active Fib streaming publishers
   folly::Synchronized<std::unordered_map<
       int64_t,
-      apache::thrift::ServerStreamPublisher<thrift::RouteDatabaseDelta>>>
+      CoalescingStreamPublisher<thrift::RouteDatabaseDelta>>>
       fibPublishers_;
 
+  // Recent deltas for resuming Fib streams.
+  // NOTE: Guarded by `fibPublishers_` lock
+  StreamReplayBuffer<thrift::RouteDatabaseDelta> fibReplayBuffer_{
+      Constants::kCtrlStreamReplayBufferSize,
+      Constants::kCtrlStreamReplayBufferMaxBytes,
+      Constants::kCtrlStreamReplayRetention};
+
   // Active Fib Detail streaming publishers
   folly::Synchronized<std::unordered_map<int64_t, FibStreamSubscriber>>
       fibDetailSubscribers_;
 
+  // Snapshots shared by `subscribeAndGet*` requests. Invalidated on every
+  // published update.
+  SnapshotCache<thrift::RouteDatabase> fibSnapshotCache_;
+  SnapshotCache<std::vector<thrift::Publication>> kvStoreSnapshotCache_;
+
   // pending longPoll requests from clients, which consists of
   // 1). promise; 2). timestamp when req received on server
   std::atomic<int64_t> pendingRequestId_{0};
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <fb303/ServiceData.h>
+#include <fmt/format.h>
+#include <folly/Executor.h>
+#include <folly/Function.h>
+#include <folly/Synchronized.h>
+#include <folly/futures/Future.h>
+#include <folly/futures/SharedPromise.h>
+
+namespace openr {
+
+/**
+ * Versioned cache of immutable module state snapshots (e.g. Fib route
+ * database), shared by concurrent `subscribeAndGet*` requests.
+ *
+ * A reconnecting fleet of stream clients would otherwise trigger one full
+ * snapshot copy per client on the module's event base. Instead, the first
+ * request for a key fetches the snapshot from the module, and all subsequent
+ * requests, including the ones arriving while the fetch is in flight, share
+ * the same immutable snapshot until the cache is invalidated.
+ *
+ * Owner must `invalidate()` the cache on every update published to stream
+ * subscribers. Subscribers must be registered with the stream before they
+ * request the snapshot. Every update is then either delivered as a delta or
+ * already reflected in the snapshot, hence there is no gap.
+ *
+ * Exports counters
+ * - ctrl.snapshot_cache.<name>.hit
+ * - ctrl.snapshot_cache.<name>.miss
+ */
+template <typename T>
+class SnapshotCache final {
+ public:
+  using Snapshot = std::shared_ptr<const T>;
+  using Fetcher = folly::Function<folly::SemiFuture<T>()>;
+
+  /**
+   * @param name: name of the cache, used in counters
+   * @param executor: executor on which snapshot is installed on completion of
+   *                  the fetch
+   */
+  SnapshotCache(const std::string& name, folly::Executor* executor)
+      : hitCounter_(fmt::format("ctrl.snapshot_cache.{}.hit", name)),
+        missCounter_(fmt::format("ctrl.snapshot_cache.{}.miss", name)),
+        executor_(executor) {
+    CHECK_NOTNULL(executor_);
+    facebook::fb303::fbData->addStatExportType(
+        hitCounter_, facebook::fb303::COUNT);
+    facebook::fb303::fbData->addStatExportType(
+        missCounter_, facebook::fb303::COUNT);
+  }
+
+  /**
+   * Get snapshot for `key`. Invokes `fetch` only if there is no valid or
+   * in-flight snapshot for the key.
+   */
+  folly::SemiFuture<Snapshot>
+  get(const std::string& key, Fetcher fetch) {
+    std::shared_ptr<folly::SharedPromise<Snapshot>> promise;
+    bool miss{false};
+    auto future = state_->withWLock([&](auto& state) {
+      auto& entry = state.entries[key];
+      if (not entry) {
+        entry = std::make_shared<folly::SharedPromise<Snapshot>>();
+        miss = true;
+      }
+      promise = entry;
+      return entry->getSemiFuture();
+    });
+
+    facebook::fb303::fbData->addStatValue(
+        miss ? missCounter_ : hitCounter_, 1, facebook::fb303::COUNT);
+    if (not miss) {
+      return future;
+    }
+
+    // Fetch snapshot. Fetch failure is propagated to all waiters and the
+    // entry is dropped to let the next request retry.
+    folly::futures::detachOn(
+        folly::getKeepAliveToken(executor_),
+        fetch().deferTry([state = state_, key, promise = std::move(promise)](
+                             folly::Try<T>&& result) {
+          if (result.hasException()) {
+            state->withWLock([&](auto& state) {
+              auto it = state.entries.find(key);
+              if (it != state.entries.end() and it->second == promise) {
+                state.entries.erase(it);
+              }
+            });
+            promise->setException(std::move(result).exception());
+            return;
+          }
+          promise->setValue(
+              std::make_shared<const T>(std::move(result).value()));
+        }));
+    return future;
+  }
+
+  /**
+   * Invalidate all snapshots. Snapshots handed out earlier stay valid for
+   * their holders.
+   */
+  void
+  invalidate() {
+    state_->withWLock([](auto& state) {
+      ++state.version;
+      state.entries.clear();
+    });
+  }
+
+  // Version of the cache, incremented on every invalidation
+  uint64_t
+  getVersion() const {
+    return state_->rlock()->version;
+  }
+
+ private:
+  struct State {
+    uint64_t version{0};
+    std::unordered_map<
+        std::string,
+        std::shared_ptr<folly::SharedPromise<Snapshot>>>
+        entries;
+  };
+
+  const std::string hitCounter_;
+  const std::string missCounter_;
+  folly::Executor* executor_{nullptr};
+
+  // NOTE: State is shared with in-flight fetches, which may outlive the cache
+  std::shared_ptr<folly::Synchronized<State>> state_{
+      std::make_shared<folly::Synchronized<State>>()};
+};
+
+} // namespace openr
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <glog/logging.h>
+
+namespace openr {
+
+/**
+ * Bounded buffer of the most recent deltas published on a stream, indexed by
+ * monotonically increasing sequence number. Allows a reconnecting client to
+ * receive only the deltas it missed instead of a full snapshot.
+ *
+ * Buffer is bounded both by number of deltas and by their total serialized
+ * size. A delta larger than the size bound is never retained.
+ *
+ * Deltas only need to be retained while a stream may resume, i.e. while
+ * streams are active and for `retention` after the last one ended. Owner
+ * should `skip()` sequence numbers otherwise, see `isRetaining()`.
+ *
+ * Sequence numbers start at the wall clock time in microseconds. They keep
+ * increasing across restarts of the process, and a sequence number of a
+ * previous incarnation is never mistaken for a current one.
+ *
+ * NOTE: Not thread-safe. Owner must serialize access, and append deltas under
+ * the same lock that publishes them to subscribers.
+ */
+template <typename T>
+class StreamReplayBuffer final {
+ public:
+  StreamReplayBuffer(
+      size_t capacity,
+      size_t maxBytes,
+      std::chrono::steady_clock::duration retention =
+          std::chrono::steady_clock::duration::zero())
+      : capacity_(capacity),
+        maxBytes_(maxBytes),
+        retention_(retention),
+        lastSeqNum_(std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::system_clock::now().time_since_epoch())
+                        .count()) {
+    CHECK_GT(capacity_, 0);
+  }
+
+  /**
+   * Retain the delta with the next sequence number, i.e. `getLastSeqNum() + 1`,
+   * evicting the oldest deltas until both bounds are met. Returns the assigned
+   * sequence number.
+   *
+   * @param bytes - serialized size of the delta
+   */
+  int64_t
+  append(T delta, size_t bytes) {
+    if (bytes > maxBytes_) {
+      return skip();
+    }
+    while (deltas_.size() == capacity_ or bytes_ + bytes > maxBytes_) {
+      bytes_ -= deltas_.front().second;
+      deltas_.pop_front();
+    }
+    deltas_.emplace_back(std::move(delta), bytes);
+    bytes_ += bytes;
+    return ++lastSeqNum_;
+  }
+
+  /**
+   * Assign the next sequence number without retaining the delta. All retained
+   * deltas are dropped, as none of the streams could be resumed across the
+   * skipped one. Returns the assigned sequence number.
+   */
+  int64_t
+  skip() {
+    deltas_.clear();
+    bytes_ = 0;
+    return ++lastSeqNum_;
+  }
+
+  /**
+   * Record that a stream started or ended. Deltas are retained for
+   * `retention` after the last call.
+   */
+  void
+  markStreamActivity() {
+    lastStreamActivity_ = std::chrono::steady_clock::now();
+  }
+
+  /**
+   * Whether the next delta should be retained, i.e. there are active streams
+   * or the last stream ended less than `retention` ago.
+   */
+  bool
+  isRetaining(size_t numStreams) const {
+    return numStreams > 0 or
+        std::chrono::steady_clock::now() < lastStreamActivity_ + retention_;
+  }
+
+  // Sequence number of the last appended delta
+  int64_t
+  getLastSeqNum() const {
+    return lastSeqNum_;
+  }
+
+  // Sequence number of the oldest retained delta, `getLastSeqNum() + 1` if
+  // buffer is empty
+  int64_t
+  getFirstSeqNum() const {
+    return lastSeqNum_ - static_cast<int64_t>(deltas_.size()) + 1;
+  }
+
+  /**
+   * Deltas with sequence number greater than `seqNum`, in order. Returns
+   * std::nullopt if any of them has been evicted or if `seqNum` was never
+   * assigned.
+   *
+   * NOTE: Returned pointers are invalidated by subsequent `append` or `skip`.
+   */
+  std::optional<std::vector<const T*>>
+  getDeltasSince(int64_t seqNum) const {
+    const int64_t firstSeqNum = getFirstSeqNum();
+    if (seqNum > lastSeqNum_ or seqNum < firstSeqNum - 1) {
+      return std::nullopt;
+    }
+    std::vector<const T*> deltas;
+    deltas.reserve(lastSeqNum_ - seqNum);
+    for (auto it = deltas_.begin() + (seqNum - firstSeqNum + 1);
+         it != deltas_.end();
+         ++it) {
+      deltas.emplace_back(&it->first);
+    }
+    return deltas;
+  }
+
+  size_t
+  size() const {
+    return deltas_.size();
+  }
+
+  // Total serialized size of retained deltas
+  size_t
+  bytes() const {
+    return bytes_;
+  }
+
+ private:
+  const size_t capacity_{0};
+  const size_t maxBytes_{0};
+  const std::chrono::steady_clock::duration retention_;
+  int64_t lastSeqNum_{0};
+  size_t bytes_{0};
+  std::chrono::steady_clock::time_point lastStreamActivity_{
+      std::chrono::steady_clock::time_point::min()};
+  // Retained deltas along with their serialized size
+  std::deque<std::pair<T, size_t>> deltas_;
+};
+
+} // namespace openr
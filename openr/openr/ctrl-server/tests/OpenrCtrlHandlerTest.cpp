@@ -440,6 +440,11 @@ TEST_F(OpenrCtrlFixture, RouteApis) {
 TEST_F(OpenrCtrlFixture, PerfApis) {
   auto db = handler_->semifuture_getPerfDb().get();
   EXPECT_EQ(nodeName_, *db->thisNodeName());
+
+  auto stats = handler_->semifuture_getConvergenceStats().get();
+  EXPECT_EQ(nodeName_, *stats->thisNodeName());
+  EXPECT_EQ(4, stats->stages()->size());
+  EXPECT_EQ(1, stats->stages()->count("total"));
 }
 
 TEST_F(OpenrCtrlFixture, DrainStateApis) {
@@ -2701,6 +2706,84 @@ TEST_F(OpenrCtrlFixture, SubscribeAndGetKvStore) {
 #pragma endregion Cleanup
 }
 
+// Verify that a reconnecting client resumes KvStore stream from its last seen
+// sequence number and receives publications missed while disconnected.
+TEST_F(OpenrCtrlFixture, ResumeKvStoreStream) {
+  const std::string key{"resume-key"};
+
+  // Subscriber remaining connected, used to learn when publication has been
+  // processed by the handler
+  std::atomic<int> received{0};
+  auto responseAndSubscription =
+      handler_
+          ->semifuture_subscribeAndGetAreaKvStores(
+              std::make_unique<thrift::KeyDumpParams>(),
+              std::make_unique<std::set<std::string>>(kSpineOnlySet))
+          .get();
+  ASSERT_TRUE(responseAndSubscription.response.begin()->seqNum().has_value());
+  const auto snapshotSeqNum =
+      *responseAndSubscription.response.begin()->seqNum();
+  auto subscription =
+      std::move(responseAndSubscription.stream)
+          .toClientStreamUnsafeDoNotUse()
+          .subscribeExTry(folly::getEventBase(), [&received, key](auto&& t) {
+            if (t.hasValue() and t->keyVals()->count(key)) {
+              received++;
+            }
+          });
+
+  // Publication missed by the reconnecting client
+  kvStoreWrapper_->setKey(
+      kSpineAreaId, key, createThriftValue(1, "node1", std::string("value1")));
+  while (received < 1) {
+    std::this_thread::yield();
+  }
+
+  // Resume from the snapshot. Missed publication is replayed.
+  std::atomic<int> replayed{0};
+  auto resumeSubscription =
+      handler_
+          ->resumeAreaKvStores(
+              std::make_unique<thrift::KeyDumpParams>(),
+              std::make_unique<std::set<std::string>>(kSpineOnlySet),
+              snapshotSeqNum)
+          .toClientStreamUnsafeDoNotUse()
+          .subscribeExTry(
+              folly::getEventBase(),
+              [&replayed, key, snapshotSeqNum](auto&& t) {
+                if (not t.hasValue() or not t->keyVals()->count(key)) {
+                  return;
+                }
+                ASSERT_TRUE(t->seqNum().has_value());
+                EXPECT_LT(snapshotSeqNum, *t->seqNum());
+                EXPECT_EQ(1, *t->keyVals()->at(key).version());
+                replayed++;
+              });
+  while (replayed < 1) {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(2, handler_->getNumKvStorePublishers());
+
+  // Sequence number which was never assigned can't be resumed
+  EXPECT_THROW(
+      handler_->resumeAreaKvStores(
+          std::make_unique<thrift::KeyDumpParams>(),
+          std::make_unique<std::set<std::string>>(kSpineOnlySet),
+          0),
+      thrift::OpenrError);
+  EXPECT_EQ(2, handler_->getNumKvStorePublishers());
+
+  subscription.cancel();
+  std::move(subscription).detach();
+  resumeSubscription.cancel();
+  std::move(resumeSubscription).detach();
+
+  // Wait until publishers are destroyed
+  while (handler_->getNumKvStorePublishers() != 0) {
+    std::this_thread::yield();
+  }
+}
+
 int
 main(int argc, char* argv[]) {
   // Parse command line flags
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <fb303/ServiceData.h>
+#include <folly/executors/ManualExecutor.h>
+#include <folly/init/Init.h>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <openr/ctrl-server/SnapshotCache.h>
+
+using namespace openr;
+
+namespace {
+const std::string kKey{"key"};
+} // namespace
+
+class SnapshotCacheFixture : public ::testing::Test {
+ protected:
+  // Fetcher returning a future fulfilled by the test
+  SnapshotCache<std::string>::Fetcher
+  createFetcher() {
+    return [this]() {
+      ++numFetches_;
+      promises_.emplace_back();
+      return promises_.back().getSemiFuture();
+    };
+  }
+
+  folly::ManualExecutor executor_;
+  SnapshotCache<std::string> cache_{"test", &executor_};
+  std::vector<folly::Promise<std::string>> promises_;
+  int numFetches_{0};
+};
+
+/**
+ * Verify that concurrent requests share one in-flight fetch and that
+ * subsequent requests are served from the cache.
+ */
+TEST_F(SnapshotCacheFixture, ShareSnapshot) {
+  auto counters = facebook::fb303::fbData->getCounters();
+  const auto missBefore = counters.at("ctrl.snapshot_cache.test.miss.count");
+  const auto hitBefore = counters.at("ctrl.snapshot_cache.test.hit.count");
+
+  auto future1 = cache_.get(kKey, createFetcher());
+  auto future2 = cache_.get(kKey, createFetcher());
+  EXPECT_EQ(1, numFetches_);
+  EXPECT_FALSE(future1.isReady());
+  EXPECT_FALSE(future2.isReady());
+
+  promises_.at(0).setValue("snapshot");
+  executor_.drain();
+
+  auto snapshot1 = std::move(future1).get();
+  auto snapshot2 = std::move(future2).get();
+  EXPECT_EQ("snapshot", *snapshot1);
+  // Same immutable object is shared across requests
+  EXPECT_EQ(snapshot1.get(), snapshot2.get());
+
+  auto snapshot3 = cache_.get(kKey, createFetcher()).get();
+  EXPECT_EQ(1, numFetches_);
+  EXPECT_EQ(snapshot1.get(), snapshot3.get());
+
+  // Different key is fetched independently
+  auto future4 = cache_.get("other", createFetcher());
+  EXPECT_EQ(2, numFetches_);
+  promises_.at(1).setValue("other");
+  executor_.drain();
+  EXPECT_EQ("other", *std::move(future4).get());
+
+  // check stats were updated
+  counters = facebook::fb303::fbData->getCounters();
+  EXPECT_EQ(missBefore + 2, counters.at("ctrl.snapshot_cache.test.miss.count"));
+  EXPECT_EQ(hitBefore + 2, counters.at("ctrl.snapshot_cache.test.hit.count"));
+}
+
+/**
+ * Verify that invalidation triggers a new fetch while keeping the snapshots
+ * handed out earlier, including the in-flight ones, valid.
+ */
+TEST_F(SnapshotCacheFixture, Invalidate) {
+  auto future1 = cache_.get(kKey, createFetcher());
+  EXPECT_EQ(0, cache_.getVersion());
+
+  cache_.invalidate();
+  EXPECT_EQ(1, cache_.getVersion());
+
+  // In-flight fetch is not shared after invalidation
+  auto future2 = cache_.get(kKey, createFetcher());
+  EXPECT_EQ(2, numFetches_);
+
+  promises_.at(0).setValue("old");
+  promises_.at(1).setValue("new");
+  executor_.drain();
+  EXPECT_EQ("old", *std::move(future1).get());
+  EXPECT_EQ("new", *std::move(future2).get());
+
+  // Completion of stale fetch must not overwrite the current snapshot
+  EXPECT_EQ("new", *cache_.get(kKey, createFetcher()).get());
+  EXPECT_EQ(2, numFetches_);
+}
+
+/**
+ * Verify that fetch failure is propagated to all waiters and the next request
+ * retries the fetch.
+ */
+TEST_F(SnapshotCacheFixture, FetchError) {
+  auto future1 = cache_.get(kKey, createFetcher());
+  auto future2 = cache_.get(kKey, createFetcher());
+  promises_.at(0).setException(std::runtime_error("fetch failed"));
+  executor_.drain();
+
+  EXPECT_THROW(std::move(future1).get(), std::runtime_error);
+  EXPECT_THROW(std::move(future2).get(), std::runtime_error);
+
+  auto future3 = cache_.get(kKey, createFetcher());
+  EXPECT_EQ(2, numFetches_);
+  promises_.at(1).setValue("snapshot");
+  executor_.drain();
+  EXPECT_EQ("snapshot", *std::move(future3).get());
+}
+
+int
+main(int argc, char* argv[]) {
+  // Parse command line flags
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv);
+  FLAGS_logtostderr = true;
+
+  // Run the tests
+  return RUN_ALL_TESTS();
+}
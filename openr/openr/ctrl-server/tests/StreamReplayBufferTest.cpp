@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <thread>
+
+#include <folly/init/Init.h>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+
+#include <openr/ctrl-server/StreamReplayBuffer.h>
+
+using namespace openr;
+
+namespace {
+const size_t kMaxBytes{100};
+
+std::vector<int>
+toValues(const std::vector<const int*>& deltas) {
+  std::vector<int> values;
+  for (const auto* delta : deltas) {
+    values.emplace_back(*delta);
+  }
+  return values;
+}
+} // namespace
+
+/**
+ * Verify sequence number assignment and replay of retained deltas.
+ */
+TEST(StreamReplayBufferTest, AppendAndReplay) {
+  StreamReplayBuffer<int> buffer(3, kMaxBytes);
+  const auto initSeqNum = buffer.getLastSeqNum();
+  EXPECT_LT(0, initSeqNum);
+  EXPECT_EQ(initSeqNum + 1, buffer.getFirstSeqNum());
+
+  // Client which has seen everything gets no deltas
+  auto deltas = buffer.getDeltasSince(initSeqNum);
+  ASSERT_TRUE(deltas.has_value());
+  EXPECT_TRUE(deltas->empty());
+
+  EXPECT_EQ(initSeqNum + 1, buffer.append(10, 1));
+  EXPECT_EQ(initSeqNum + 2, buffer.append(20, 1));
+  EXPECT_EQ(initSeqNum + 2, buffer.getLastSeqNum());
+  EXPECT_EQ(2, buffer.size());
+
+  deltas = buffer.getDeltasSince(initSeqNum);
+  ASSERT_TRUE(deltas.has_value());
+  EXPECT_EQ(std::vector<int>({10, 20}), toValues(*deltas));
+
+  deltas = buffer.getDeltasSince(initSeqNum + 1);
+  ASSERT_TRUE(deltas.has_value());
+  EXPECT_EQ(std::vector<int>({20}), toValues(*deltas));
+
+  // Sequence number in the future was never assigned
+  EXPECT_FALSE(buffer.getDeltasSince(initSeqNum + 3).has_value());
+}
+
+/**
+ * Verify that replay fails once a missed delta has been evicted.
+ */
+TEST(StreamReplayBufferTest, Eviction) {
+  StreamReplayBuffer<int> buffer(2, kMaxBytes);
+  const auto initSeqNum = buffer.getLastSeqNum();
+  buffer.append(10, 1);
+  buffer.append(20, 1);
+  buffer.append(30, 1);
+  EXPECT_EQ(2, buffer.size());
+  EXPECT_EQ(initSeqNum + 2, buffer.getFirstSeqNum());
+
+  // Delta with sequence number `initSeqNum + 1` has been evicted
+  EXPECT_FALSE(buffer.getDeltasSince(initSeqNum).has_value());
+
+  auto deltas = buffer.getDeltasSince(initSeqNum + 1);
+  ASSERT_TRUE(deltas.has_value());
+  EXPECT_EQ(std::vector<int>({20, 30}), toValues(*deltas));
+}
+
+/**
+ * Verify that deltas are evicted to bound their total size, and that a delta
+ * exceeding the bound is not retained.
+ */
+TEST(StreamReplayBufferTest, ByteBound) {
+  StreamReplayBuffer<int> buffer(10, kMaxBytes);
+  const auto initSeqNum = buffer.getLastSeqNum();
+  buffer.append(10, 40);
+  buffer.append(20, 40);
+  EXPECT_EQ(80, buffer.bytes());
+
+  // Oldest delta is evicted to fit the new one
+  buffer.append(30, 40);
+  EXPECT_EQ(2, buffer.size());
+  EXPECT_EQ(80, buffer.bytes());
+  EXPECT_FALSE(buffer.getDeltasSince(initSeqNum).has_value());
+  auto deltas = buffer.getDeltasSince(initSeqNum + 1);
+  ASSERT_TRUE(deltas.has_value());
+  EXPECT_EQ(std::vector<int>({20, 30}), toValues(*deltas));
+
+  // Oversized delta gets a sequence number but isn't retained. None of the
+  // deltas before it can be resumed from.
+  EXPECT_EQ(initSeqNum + 4, buffer.append(40, kMaxBytes + 1));
+  EXPECT_EQ(0, buffer.size());
+  EXPECT_EQ(0, buffer.bytes());
+  EXPECT_FALSE(buffer.getDeltasSince(initSeqNum + 3).has_value());
+  deltas = buffer.getDeltasSince(initSeqNum + 4);
+  ASSERT_TRUE(deltas.has_value());
+  EXPECT_TRUE(deltas->empty());
+}
+
+/**
+ * Verify that skipped sequence numbers make retained deltas unresumable.
+ */
+TEST(StreamReplayBufferTest, Skip) {
+  StreamReplayBuffer<int> buffer(10, kMaxBytes);
+  const auto initSeqNum = buffer.getLastSeqNum();
+  buffer.append(10, 1);
+  EXPECT_EQ(initSeqNum + 2, buffer.skip());
+  EXPECT_EQ(0, buffer.size());
+  EXPECT_FALSE(buffer.getDeltasSince(initSeqNum).has_value());
+  EXPECT_FALSE(buffer.getDeltasSince(initSeqNum + 1).has_value());
+
+  buffer.append(30, 1);
+  auto deltas = buffer.getDeltasSince(initSeqNum + 2);
+  ASSERT_TRUE(deltas.has_value());
+  EXPECT_EQ(std::vector<int>({30}), toValues(*deltas));
+}
+
+/**
+ * Verify that deltas are retained only while streams are active and within
+ * the retention after the last one ended.
+ */
+TEST(StreamReplayBufferTest, Retention) {
+  StreamReplayBuffer<int> noRetention(10, kMaxBytes);
+  EXPECT_FALSE(noRetention.isRetaining(0));
+  EXPECT_TRUE(noRetention.isRetaining(1));
+  noRetention.markStreamActivity();
+  EXPECT_FALSE(noRetention.isRetaining(0));
+
+  StreamReplayBuffer<int> buffer(10, kMaxBytes, std::chrono::hours(1));
+  // No stream has ever been active
+  EXPECT_FALSE(buffer.isRetaining(0));
+  EXPECT_TRUE(buffer.isRetaining(1));
+  // Last stream just ended
+  buffer.markStreamActivity();
+  EXPECT_TRUE(buffer.isRetaining(0));
+}
+
+/**
+ * Verify that sequence numbers of a previous incarnation are not resumable.
+ */
+TEST(StreamReplayBufferTest, Restart) {
+  auto previous = std::make_unique<StreamReplayBuffer<int>>(10, kMaxBytes);
+  previous->append(10, 1);
+  const auto lastSeqNum = previous->getLastSeqNum();
+  previous.reset();
+
+  // Sequence numbers are derived from wall clock in microseconds
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  StreamReplayBuffer<int> buffer(10, kMaxBytes);
+  EXPECT_LT(lastSeqNum, buffer.getLastSeqNum());
+  EXPECT_FALSE(buffer.getDeltasSince(lastSeqNum).has_value());
+}
+
+int
+main(int argc, char* argv[]) {
+  // Parse command line flags
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv);
+  FLAGS_logtostderr = true;
+
+  // Run the tests
+  return RUN_ALL_TESTS();
+}
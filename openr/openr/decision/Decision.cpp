@@ -6,8 +6,13 @@
  */
 
 #include <fstream>
+#include <map>
+#include <optional>
 
 #include <fb303/ServiceData.h>
+#include <folly/FileUtil.h>
+#include <folly/ScopeGuard.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
 #include <folly/futures/Future.h>
 #include <folly/logging/xlog.h>
 #include <utility>
@@ -67,6 +72,13 @@ DecisionPendingUpdates::addEvent(std::string const& eventDescription) {
   }
 }
 
+void
+DecisionPendingUpdates::addEvent(thrift::PerfEventType type) {
+  if (perfEvents_) {
+    addPerfEvent(*perfEvents_, myNodeName_, type);
+  }
+}
+
 std::optional<thrift::PerfEvents>
 DecisionPendingUpdates::moveOutEvents() {
   std::optional<thrift::PerfEvents> events = std::move(perfEvents_);
@@ -90,7 +102,8 @@ DecisionPendingUpdates::addUpdate(
     // if we don't have any perf events for this batch and this update also
     // doesn't have anything, let's start building the event list from now
     perfEvents_ = perfEvents ? *perfEvents : thrift::PerfEvents{};
-    addPerfEvent(*perfEvents_, myNodeName_, "DECISION_RECEIVED");
+    addPerfEvent(
+        *perfEvents_, myNodeName_, thrift::PerfEventType::DECISION_RECEIVED);
   }
 }
 } // namespace detail
@@ -125,6 +138,11 @@ Decision::Decision(
           std::chrono::milliseconds(
               *config->getConfig().decision_config()->save_rib_policy_max_ms()),
           [this]() noexcept { saveRibPolicy(); }),
+      saveRouteSnapshotDebounced_(
+          getEvb(),
+          Constants::kRouteSnapshotSaveMinBackoff,
+          Constants::kRouteSnapshotSaveMaxBackoff,
+          [this]() noexcept { saveRouteSnapshot(); }),
       unblockInitialRoutesTimeout_(folly::AsyncTimeout::make(
           *getEvb(),
           std::bind_front(&Decision::forceInitialRoutesBuild, this))) {
@@ -134,7 +152,26 @@ Decision::Decision(
       config->isV4Enabled(),
       config->isSegmentRoutingEnabled(),
       config->isBestRouteSelectionEnabled(),
-      config->isV4OverV6NexthopEnabled());
+      config->isV4OverV6NexthopEnabled(),
+      *config->getConfig().decision_config()->route_build_threads());
+
+  if (auto backoffConf =
+          config->getConfig().decision_config()->spf_backoff_config()) {
+    rebuildRoutesBackoff_ = std::make_unique<SpfBackoff>(
+        getEvb(),
+        std::chrono::milliseconds(*backoffConf->initial_delay_ms()),
+        std::chrono::milliseconds(*backoffConf->short_delay_ms()),
+        std::chrono::milliseconds(*backoffConf->long_delay_ms()),
+        std::chrono::milliseconds(*backoffConf->time_to_learn_ms()),
+        std::chrono::milliseconds(*backoffConf->hold_down_ms()),
+        [this]() noexcept { rebuildRoutes("DECISION_SPF_BACKOFF"); },
+        "decision.spf_backoff");
+  }
+
+  if (config->isWarmStartEnabled()) {
+    routeSnapshotExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        1, std::make_shared<folly::NamedThreadFactory>("DecisionSnapshot"));
+  }
 
   if (config->isVipServiceEnabled()) {
     // Static unicast routes will be generated by PrefixManager for received
@@ -185,51 +222,39 @@ Decision::Decision(
       try {
         folly::variant_match(
             std::move(maybePub).value(),
-            [this](thrift::Publication&& pub) {
-              processPublication(std::move(pub));
-              // Compute routes with exponential backoff timer if needed
+            [this, &q](thrift::Publication&& pub) {
+              // Drain publications queued meanwhile, up to the initialization
+              // event if any, and process them as one batch
+              std::vector<thrift::Publication> pubs;
+              pubs.emplace_back(std::move(pub));
+              std::optional<thrift::InitializationEvent> event;
+              while (not event.has_value() and q.size() > 0 and
+                     pubs.size() < Constants::kDecisionMaxPublicationBatch) {
+                auto maybeNext = q.get(); // perform read
+                if (maybeNext.hasError()) {
+                  break;
+                }
+                folly::variant_match(
+                    std::move(maybeNext).value(),
+                    [&pubs](thrift::Publication&& nextPub) {
+                      pubs.emplace_back(std::move(nextPub));
+                    },
+                    [&event](thrift::InitializationEvent&& nextEvent) {
+                      event = nextEvent;
+                    });
+              }
+
+              processPublications(std::move(pubs));
+              // Compute routes with backoff timer if needed
               if (pendingUpdates_.needsRouteUpdate()) {
-                rebuildRoutesDebounced_();
+                scheduleRebuildRoutes();
+              }
+              if (event.has_value()) {
+                processInitializationEvent(event.value());
               }
             },
             [this](thrift::InitializationEvent&& event) {
-              /*
-               * NOTE: Eventually only 1 signal will be used in decision
-               * to convey both kvstore and self adjacency syncs is done.
-               * In future kvstore will make sure that self adjacencies
-               * synced only after peer kvstore synced
-               *
-               * For now, defining each signal is a stepping stone towards
-               * that goal. For now both signals are independent of each
-               * other, no ordering is enforeced by kvstore
-               */
-              CHECK(
-                  (event == thrift::InitializationEvent::KVSTORE_SYNCED) ||
-                  (event == thrift::InitializationEvent::ADJACENCY_DB_SYNCED))
-                  << fmt::format(
-                         "Unexpected initialization event: {}",
-                         apache::thrift::util::enumNameSafe(event));
-
-              if (event == thrift::InitializationEvent::KVSTORE_SYNCED) {
-                // Received all initial KvStore publications.
-                XLOG(INFO) << "[Initialization] All initial publications are "
-                              "received from KvStore.";
-                initialKvStoreSynced_ = true;
-                triggerInitialBuildRoutes();
-                auto timeout = *config_->getConfig()
-                                    .decision_config()
-                                    ->unblock_initial_routes_ms();
-                XLOG(DBG1) << fmt::format(
-                    "Initial kv store synced. Waiting {}ms for initial routes to be computed.",
-                    timeout);
-                unblockInitialRoutesTimeout_->scheduleTimeout(
-                    std::chrono::milliseconds(timeout));
-              } else {
-                // Received all locally originated adjacency keys
-                XLOG(INFO)
-                    << "[Initialization] Received all locally originated adjacency keys";
-                initialSelfAdjSynced_ = true;
-              }
+              processInitializationEvent(event);
             });
       } catch (const std::exception& e) {
 #ifndef NO_FOLLY_EXCEPTION_TRACER
@@ -270,6 +295,9 @@ Decision::Decision(
   // Read rib policy from saved file.
   addFiberTask([this]() mutable noexcept {
     XLOG(DBG1) << "Starting rib-policy task";
+    // Warm-start routes are published ahead of initial route computation,
+    // which is blocked until rib policy is read.
+    readRouteSnapshot();
     readRibPolicy();
 
     initialRibPolicyRead_ = true;
@@ -280,13 +308,19 @@ Decision::Decision(
   // Create RibPolicy timer to process routes on policy expiry
   ribPolicyTimer_ = folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
     XLOG(WARNING) << "RibPolicy is expired";
-    pendingUpdates_.setNeedsFullRebuild();
-    rebuildRoutes("RIB_POLICY_EXPIRED");
+    rebuildRoutesForRibPolicyChange(ribPolicy_.get(), "RIB_POLICY_EXPIRED");
   });
 
   // Initialize some stat keys
   fb303::fbData->addStatExportType(
       "decision.rib_policy_processing.time_ms", fb303::AVG);
+  fb303::fbData->addStatExportType(
+      "decision.rib_policy.recomputed_routes", fb303::SUM);
+  fb303::fbData->addStatExportType(
+      "decision.route_snapshot.save_ms", fb303::AVG);
+  fb303::fbData->addStatExportType(
+      "decision.publications_coalesced", fb303::SUM);
+  fb303::fbData->addStatExportType("decision.keys_deduplicated", fb303::SUM);
 }
 
 Decision::~Decision() {
@@ -303,6 +337,11 @@ Decision::stop() {
 
   // Invoke stop method of super class
   OpenrEventBase::stop();
+
+  // Wait for route snapshot being written
+  if (routeSnapshotExecutor_) {
+    routeSnapshotExecutor_->join();
+  }
   XLOG(DBG1) << "[Exit] Successfully stopped Decision eventbase.";
 }
 
@@ -460,10 +499,10 @@ Decision::clearRibPolicy() {
       error.message() = "No RIB policy configured";
       p.setException(error);
     } else {
+      auto oldRibPolicy = std::move(ribPolicy_);
       ribPolicy_ = nullptr;
-      // Trigger route computation
-      pendingUpdates_.setNeedsFullRebuild();
-      rebuildRoutes("RIB_POLICY_CLEARED");
+      // Trigger route computation for routes selected by cleared policy
+      rebuildRoutesForRibPolicyChange(oldRibPolicy.get(), "RIB_POLICY_CLEARED");
       p.setValue();
     }
   });
@@ -501,14 +540,15 @@ Decision::setRibPolicy(thrift::RibPolicy const& ribPolicyThrift) {
         // Update local policy instance
         XLOG(INFO) << "Updating RibPolicy with new instance. Validity "
                    << durationLeft.count() << "ms";
+        auto oldRibPolicy = std::move(ribPolicy_);
         ribPolicy_ = std::move(ribPolicy);
 
         // Schedule timer for processing routes on expiry
         ribPolicyTimer_->scheduleTimeout(durationLeft);
 
-        // Trigger route computation
-        pendingUpdates_.setNeedsFullRebuild();
-        rebuildRoutes("RIB_POLICY_UPDATE");
+        // Trigger route computation for routes selected by old or new policy
+        rebuildRoutesForRibPolicyChange(
+            oldRibPolicy.get(), "RIB_POLICY_UPDATE");
 
         // Save rib policy to file.
         saveRibPolicyDebounced_();
@@ -707,6 +747,124 @@ Decision::readRibPolicy() {
       ttlDurationSec);
 }
 
+void
+Decision::saveRouteSnapshot() {
+  CHECK(routeSnapshotExecutor_);
+
+  // Previous snapshot is still being written. Retry on next debounce.
+  if (routeSnapshotSaveInProgress_.exchange(true)) {
+    saveRouteSnapshotDebounced_();
+    return;
+  }
+
+  // NOTE: Only the copy of route database is taken on Decision thread.
+  // Conversion, serialization and file write run on the snapshot executor.
+  const auto start = std::chrono::steady_clock::now();
+  routeSnapshotExecutor_->add([this, routeDb = routeDb_, start]() noexcept {
+    SCOPE_EXIT {
+      routeSnapshotSaveInProgress_ = false;
+    };
+
+    const auto snapshot = routeDb.toSnapshot(myNodeName_);
+    const auto snapshotStr =
+        apache::thrift::CompactSerializer::serialize<std::string>(snapshot);
+    try {
+      // Write to temporary file and rename, so that a crash while saving
+      // leaves the previous snapshot intact
+      folly::writeFileAtomic(FLAGS_route_snapshot_file, snapshotStr);
+    } catch (std::exception const& e) {
+      XLOG(ERR) << "Could not save route snapshot to "
+                << FLAGS_route_snapshot_file
+                << ". Error: " << folly::exceptionStr(e);
+      return;
+    }
+    updateCounters(
+        "decision.route_snapshot.save_ms",
+        start,
+        std::chrono::steady_clock::now());
+    XLOG(DBG1) << fmt::format(
+        "Saved route snapshot of {} unicast and {} mpls routes to {}",
+        snapshot.unicastRoutes()->size(),
+        snapshot.mplsRoutes()->size(),
+        FLAGS_route_snapshot_file);
+  });
+}
+
+void
+Decision::readRouteSnapshot() {
+  if (not config_->isWarmStartEnabled()) {
+    return;
+  }
+
+  std::string snapshotStr;
+  if (not folly::readFile(FLAGS_route_snapshot_file.c_str(), snapshotStr)) {
+    XLOG(INFO) << "[Initialization] Could not open route snapshot file "
+               << FLAGS_route_snapshot_file << ". Skipping warm-start.";
+    return;
+  }
+
+  thrift::RouteDatabaseSnapshot snapshot;
+  try {
+    snapshot = apache::thrift::CompactSerializer::deserialize<
+        thrift::RouteDatabaseSnapshot>(snapshotStr);
+  } catch (std::exception const& e) {
+    XLOG(ERR) << "[Initialization] Could not parse route snapshot file "
+              << FLAGS_route_snapshot_file
+              << ". Error: " << folly::exceptionStr(e);
+    return;
+  }
+
+  // Validate snapshot
+  const auto nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                         std::chrono::system_clock::now().time_since_epoch())
+                         .count();
+  const auto ageSec = (nowMs - *snapshot.timestampMs()) / 1000;
+  const auto maxAgeSec =
+      *config_->getConfig().decision_config()->warm_start_max_age_s();
+  if (*snapshot.version() != DecisionRouteDb::kSnapshotVersion) {
+    XLOG(INFO) << "[Initialization] Skip route snapshot of version "
+               << *snapshot.version();
+    return;
+  }
+  if (*snapshot.thisNodeName() != myNodeName_) {
+    XLOG(INFO) << "[Initialization] Skip route snapshot of node "
+               << *snapshot.thisNodeName();
+    return;
+  }
+  if (ageSec < 0 or ageSec > maxAgeSec) {
+    XLOG(INFO) << fmt::format(
+        "[Initialization] Skip route snapshot of age {}s. Max age {}s.",
+        ageSec,
+        maxAgeSec);
+    return;
+  }
+
+  // Prime route database. Computed routes will be diffed against it.
+  routeDb_ = DecisionRouteDb::fromSnapshot(snapshot);
+  warmStarted_ = true;
+
+  DecisionRouteUpdate update;
+  update.type = DecisionRouteUpdate::FULL_SYNC;
+  update.warmStart = true;
+  update.unicastRoutesToUpdate = routeDb_.unicastRoutes;
+  update.mplsRoutesToUpdate = routeDb_.mplsRoutes;
+
+  fb303::fbData->setCounter(
+      "decision.warm_start.routes",
+      update.unicastRoutesToUpdate.size() +
+          update.mplsRoutesToUpdate.size());
+  fb303::fbData->setCounter("decision.warm_start.snapshot_age_s", ageSec);
+  XLOG(INFO) << fmt::format(
+      "[Initialization] Warm-start with {} unicast and {} mpls routes from "
+      "snapshot of age {}s",
+      update.unicastRoutesToUpdate.size(),
+      update.mplsRoutesToUpdate.size(),
+      ageSec);
+
+  // send `DecisionRouteUpdate` to Fib/PrefixMgr
+  routeUpdatesQueue_.push(std::move(update));
+}
+
 void
 Decision::updateKeyInLsdb(
     const std::string& area,
@@ -818,6 +976,46 @@ Decision::deleteKeyFromLsdb(
   }
 }
 
+void
+Decision::processInitializationEvent(thrift::InitializationEvent event) {
+  /*
+   * NOTE: Eventually only 1 signal will be used in decision
+   * to convey both kvstore and self adjacency syncs is done.
+   * In future kvstore will make sure that self adjacencies
+   * synced only after peer kvstore synced
+   *
+   * For now, defining each signal is a stepping stone towards
+   * that goal. For now both signals are independent of each
+   * other, no ordering is enforeced by kvstore
+   */
+  CHECK(
+      (event == thrift::InitializationEvent::KVSTORE_SYNCED) ||
+      (event == thrift::InitializationEvent::ADJACENCY_DB_SYNCED))
+      << fmt::format(
+             "Unexpected initialization event: {}",
+             apache::thrift::util::enumNameSafe(event));
+
+  if (event == thrift::InitializationEvent::KVSTORE_SYNCED) {
+    // Received all initial KvStore publications.
+    XLOG(INFO) << "[Initialization] All initial publications are "
+                  "received from KvStore.";
+    initialKvStoreSynced_ = true;
+    triggerInitialBuildRoutes();
+    auto timeout =
+        *config_->getConfig().decision_config()->unblock_initial_routes_ms();
+    XLOG(DBG1) << fmt::format(
+        "Initial kv store synced. Waiting {}ms for initial routes to be computed.",
+        timeout);
+    unblockInitialRoutesTimeout_->scheduleTimeout(
+        std::chrono::milliseconds(timeout));
+  } else {
+    // Received all locally originated adjacency keys
+    XLOG(INFO)
+        << "[Initialization] Received all locally originated adjacency keys";
+    initialSelfAdjSynced_ = true;
+  }
+}
+
 void
 Decision::processPublication(thrift::Publication&& thriftPub) {
   CHECK(not thriftPub.area()->empty());
@@ -845,6 +1043,76 @@ Decision::processPublication(thrift::Publication&& thriftPub) {
   }
 }
 
+void
+Decision::processPublications(std::vector<thrift::Publication>&& thriftPubs) {
+  if (thriftPubs.size() == 1) {
+    processPublication(std::move(thriftPubs.front()));
+    return;
+  }
+  fb303::fbData->addStatValue(
+      "decision.publications_coalesced", thriftPubs.size() - 1, fb303::SUM);
+
+  // Latest update of every key per area. Unset value marks an expired key.
+  std::map<
+      std::string /* area */,
+      std::unordered_map<std::string, std::optional<thrift::Value>>>
+      areaKeyVals;
+  size_t numKeysDeduplicated{0};
+  for (auto& thriftPub : thriftPubs) {
+    CHECK(not thriftPub.area()->empty());
+    auto& keyVals = areaKeyVals[*thriftPub.area()];
+    for (auto& [key, rawVal] : *thriftPub.keyVals()) {
+      // Skip TTL update, it doesn't affect LSDB
+      if (not rawVal.value().has_value()) {
+        continue;
+      }
+      auto [it, inserted] = keyVals.try_emplace(key, std::nullopt);
+      if (not inserted) {
+        ++numKeysDeduplicated;
+        // Keep newer version, e.g. on publications from previous sync
+        if (it->second.has_value() and
+            *it->second->version() > *rawVal.version()) {
+          continue;
+        }
+      }
+      it->second = std::move(rawVal);
+    }
+    for (auto const& key : *thriftPub.expiredKeys()) {
+      auto [it, inserted] = keyVals.try_emplace(key, std::nullopt);
+      if (not inserted) {
+        ++numKeysDeduplicated;
+        it->second.reset();
+      }
+    }
+  }
+  fb303::fbData->addStatValue(
+      "decision.keys_deduplicated", numKeysDeduplicated, fb303::SUM);
+
+  // Apply adjacency updates first, so that prefix updates are processed
+  // against the latest topology
+  for (auto const& isAdjPass : {true, false}) {
+    for (auto const& [area, keyVals] : areaKeyVals) {
+      auto it = areaLinkStates_.find(area);
+      if (it == areaLinkStates_.end()) {
+        it = areaLinkStates_.emplace(area, LinkState(area, myNodeName_)).first;
+      }
+      auto& areaLinkState = it->second;
+
+      for (auto const& [key, maybeVal] : keyVals) {
+        const bool isAdjKey = key.find(Constants::kAdjDbMarker.toString()) == 0;
+        if (isAdjKey != isAdjPass) {
+          continue;
+        }
+        if (maybeVal.has_value()) {
+          updateKeyInLsdb(area, areaLinkState, key, maybeVal.value());
+        } else {
+          deleteKeyFromLsdb(area, areaLinkState, key);
+        }
+      }
+    }
+  }
+}
+
 void
 Decision::processStaticRoutesUpdate(DecisionRouteUpdate&& routeUpdate) {
   /*
@@ -870,7 +1138,7 @@ Decision::processStaticRoutesUpdate(DecisionRouteUpdate&& routeUpdate) {
   pendingUpdates_.applyPrefixStateChange(
       std::move(changedPrefixes), thrift::PrefixDatabase().perfEvents());
 
-  rebuildRoutesDebounced_();
+  scheduleRebuildRoutes();
 
   auto prefixType = routeUpdate.prefixType;
   if (prefixType.has_value() and
@@ -885,6 +1153,24 @@ Decision::processStaticRoutesUpdate(DecisionRouteUpdate&& routeUpdate) {
   }
 }
 
+void
+Decision::scheduleRebuildRoutes() {
+  if (rebuildRoutesBackoff_) {
+    (*rebuildRoutesBackoff_)();
+  } else {
+    rebuildRoutesDebounced_();
+  }
+}
+
+void
+Decision::cancelScheduledRebuildRoutes() {
+  if (rebuildRoutesBackoff_) {
+    rebuildRoutesBackoff_->cancelScheduledTimeout();
+  } else {
+    rebuildRoutesDebounced_.cancelScheduledTimeout();
+  }
+}
+
 void
 Decision::rebuildRoutes(std::string const& event) {
   // Do NOT trigger initial route computation until all conditions are met.
@@ -909,22 +1195,39 @@ Decision::rebuildRoutes(std::string const& event) {
   if (pendingUpdates_.needsFullRebuild()) {
     // if only static routes gets updated, we still need to update routes
     // because there maybe routes depended on static routes.
-    auto maybeRouteDb =
-        spfSolver_->buildRouteDb(myNodeName_, areaLinkStates_, prefixState_);
+    // Route build records routes changed relative to `routeDb_` as `update`
+    auto maybeRouteDb = spfSolver_->buildRouteDb(
+        myNodeName_, areaLinkStates_, prefixState_, &routeDb_, &update);
     XLOG_IF(WARNING, !maybeRouteDb)
         << "SEVERE: full route rebuild resulted in no routes";
     auto db = maybeRouteDb.has_value() ? std::move(maybeRouteDb).value()
                                        : DecisionRouteDb{};
+    if (not maybeRouteDb.has_value()) {
+      update = routeDb_.calculateFullUpdate(db);
+    }
     if (ribPolicy_) {
       auto start = std::chrono::steady_clock::now();
-      ribPolicy_->applyPolicy(db.unicastRoutes);
+      auto const changes = ribPolicy_->applyPolicy(db.unicastRoutes);
+      // Route build compared routes before policy. Compare routes
+      // transformed by policy again.
+      for (auto const& prefix : changes.updatedRoutes) {
+        auto const& route = db.unicastRoutes.at(prefix);
+        auto const search = routeDb_.unicastRoutes.find(prefix);
+        if (search != routeDb_.unicastRoutes.end() and
+            search->second.isSameRoute(route)) {
+          update.unicastRoutesToUpdate.erase(prefix);
+        } else {
+          update.addRouteToUpdate(route);
+        }
+      }
       updateCounters(
           "decision.rib_policy_processing.time_ms",
           start,
           std::chrono::steady_clock::now());
     }
-    // update `DecisionRouteDb` cache and return delta as `update`
-    update = routeDb_.calculateUpdate(std::move(db));
+    if (FLAGS_decision_verify_route_delta) {
+      update = routeDb_.verifyUpdate(db, std::move(update));
+    }
     update.type = DecisionRouteUpdate::FULL_SYNC;
   } else {
     // process prefixes update from `prefixState_`
@@ -950,13 +1253,89 @@ Decision::rebuildRoutes(std::string const& event) {
     }
   }
 
+  // First computed routes replace the warm-start routes. Report how many of
+  // the warm-start routes turned out to be stale.
+  if (std::exchange(warmStarted_, false)) {
+    fb303::fbData->setCounter(
+        "decision.warm_start.stale_routes",
+        update.unicastRoutesToUpdate.size() +
+            update.unicastRoutesToDelete.size() +
+            update.mplsRoutesToUpdate.size() +
+            update.mplsRoutesToDelete.size());
+  }
+
   routeDb_.update(update);
-  pendingUpdates_.addEvent("ROUTE_UPDATE");
+  pendingUpdates_.addEvent(thrift::PerfEventType::ROUTE_UPDATE);
   update.perfEvents = pendingUpdates_.moveOutEvents();
   pendingUpdates_.reset();
 
   // send `DecisionRouteUpdate` to Fib/PrefixMgr
   routeUpdatesQueue_.push(std::move(update));
+
+  if (config_->isWarmStartEnabled()) {
+    saveRouteSnapshotDebounced_();
+  }
+}
+
+void
+Decision::rebuildRoutesForRibPolicyChange(
+    RibPolicy const* oldRibPolicy, std::string const& event) {
+  // Pending full rebuild (including initial one) will apply the current policy
+  // on all routes.
+  if (not unblockInitialRoutesBuild() or pendingUpdates_.needsFullRebuild()) {
+    pendingUpdates_.setNeedsFullRebuild();
+    rebuildRoutes(event);
+    return;
+  }
+
+  XLOG(INFO) << "Decision: processing RibPolicy change. " << event;
+  auto start = std::chrono::steady_clock::now();
+  RibPolicy const* newRibPolicy =
+      (ribPolicy_ and ribPolicy_->isActive()) ? ribPolicy_.get() : nullptr;
+
+  // Only routes selected by old or new policy can change. Matching doesn't
+  // depend on next-hops, hence it can be evaluated on post-policy routes.
+  std::vector<folly::CIDRNetwork> affectedPrefixes;
+  for (auto const& [prefix, entry] : routeDb_.unicastRoutes) {
+    if ((oldRibPolicy and oldRibPolicy->match(entry)) or
+        (newRibPolicy and newRibPolicy->match(entry))) {
+      affectedPrefixes.emplace_back(prefix);
+    }
+  }
+
+  DecisionRouteUpdate update;
+  for (auto const& prefix : affectedPrefixes) {
+    auto maybeRibEntry = spfSolver_->createRouteForPrefixOrGetStaticRoute(
+        myNodeName_, areaLinkStates_, prefixState_, prefix);
+    if (not maybeRibEntry) {
+      update.unicastRoutesToDelete.emplace_back(prefix);
+      continue;
+    }
+    if (newRibPolicy) {
+      newRibPolicy->applyAction(*maybeRibEntry);
+    }
+    // Skip routes unchanged by policy replacement
+    if (routeDb_.unicastRoutes.at(prefix) != *maybeRibEntry) {
+      update.addRouteToUpdate(std::move(maybeRibEntry).value());
+    }
+  }
+  fb303::fbData->addStatValue(
+      "decision.rib_policy.recomputed_routes",
+      affectedPrefixes.size(),
+      fb303::SUM);
+  updateCounters(
+      "decision.rib_policy_processing.time_ms",
+      start,
+      std::chrono::steady_clock::now());
+
+  routeDb_.update(update);
+
+  // send `DecisionRouteUpdate` to Fib/PrefixMgr
+  routeUpdatesQueue_.push(std::move(update));
+
+  if (config_->isWarmStartEnabled()) {
+    saveRouteSnapshotDebounced_();
+  }
 }
 
 bool
@@ -1016,7 +1395,7 @@ Decision::triggerInitialBuildRoutes() {
 
   // Trigger initial RIB computation, after receiving routes of all expected
   // prefix types and inital publications from KvStore.
-  rebuildRoutesDebounced_.cancelScheduledTimeout();
+  cancelScheduledRebuildRoutes();
   pendingUpdates_.setNeedsFullRebuild();
   rebuildRoutes("INITIALIZATION");
   logInitializationEvent("Decision", thrift::InitializationEvent::RIB_COMPUTED);
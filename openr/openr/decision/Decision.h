@@ -7,7 +7,10 @@
 
 #pragma once
 
+#include <atomic>
+
 #include <folly/IPAddress.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/futures/Future.h>
 #include <folly/io/async/AsyncTimeout.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
@@ -15,6 +18,7 @@
 #include <openr/common/AsyncDebounce.h>
 #include <openr/common/AsyncThrottle.h>
 #include <openr/common/OpenrEventBase.h>
+#include <openr/common/SpfBackoff.h>
 #include <openr/common/Types.h>
 #include <openr/common/Util.h>
 #include <openr/config/Config.h>
@@ -74,6 +78,7 @@ class DecisionPendingUpdates {
   void reset();
 
   void addEvent(std::string const& eventDescription);
+  void addEvent(thrift::PerfEventType type);
 
   std::optional<thrift::PerfEvents> const&
   perfEvents() const {
@@ -229,6 +234,16 @@ class Decision : public OpenrEventBase {
    */
   void processPublication(thrift::Publication&& thriftPub);
 
+  /*
+   * Process a batch of publications drained from KvStore at once. Updates of
+   * the same key are coalesced, only the latest (by version) is applied.
+   * Adjacency updates of all areas are applied before prefix updates.
+   */
+  void processPublications(std::vector<thrift::Publication>&& thriftPubs);
+
+  // Process initialization event from KvStore
+  void processInitializationEvent(thrift::InitializationEvent event);
+
   void updateKeyInLsdb(
       const std::string& area,
       LinkState& areaLinkState,
@@ -257,6 +272,22 @@ class Decision : public OpenrEventBase {
    */
   void rebuildRoutes(std::string const& event);
 
+  /*
+   * Schedule rebuildRoutes with SPF back-off if configured, otherwise with
+   * exponential debounce. And cancel scheduled one.
+   */
+  void scheduleRebuildRoutes();
+  void cancelScheduledRebuildRoutes();
+
+  /*
+   * Targeted route recomputation on RibPolicy replacement, removal or expiry.
+   * Only routes selected by either old or current policy are rebuilt and the
+   * current policy is applied on them. Falls back to full rebuild if one is
+   * pending anyway.
+   */
+  void rebuildRoutesForRibPolicyChange(
+      RibPolicy const* oldRibPolicy, std::string const& event);
+
   /*
    * Return true if all conditions of initial routes build are fulfilled.
    */
@@ -278,6 +309,13 @@ class Decision : public OpenrEventBase {
   // Read persisted Rib policy from file
   void readRibPolicy();
 
+  // Save computed routes to file for warm-start. Routes are copied on the
+  // Decision thread and written by routeSnapshotExecutor_.
+  void saveRouteSnapshot();
+
+  // Read persisted routes from file and publish them for warm-start
+  void readRouteSnapshot();
+
   // Force initial routes build if it's not done yet.
   void forceInitialRoutesBuild() noexcept;
 
@@ -326,6 +364,12 @@ class Decision : public OpenrEventBase {
    */
   AsyncDebounce<std::chrono::milliseconds> rebuildRoutesDebounced_;
 
+  /**
+   * SPF back-off trigger for rebuildRoutes of RFC 8405, used in place of
+   * rebuildRoutesDebounced_ if `spf_backoff_config` is set.
+   */
+  std::unique_ptr<SpfBackoff> rebuildRoutesBackoff_{nullptr};
+
   /*
    * Baton for synchronization between ProcessPeerUpdates and ProcessPublication
    * fibers.
@@ -351,6 +395,28 @@ class Decision : public OpenrEventBase {
    */
   AsyncDebounce<std::chrono::milliseconds> saveRibPolicyDebounced_;
 
+  /**
+   * Debounced trigger for saveRouteSnapshot invoked on route updates.
+   */
+  AsyncDebounce<std::chrono::milliseconds> saveRouteSnapshotDebounced_;
+
+  /**
+   * Single thread executor serializing and writing route snapshots, so that
+   * saving large route databases doesn't block route computation. Created
+   * only if warm-start is enabled.
+   */
+  std::unique_ptr<folly::CPUThreadPoolExecutor> routeSnapshotExecutor_{
+      nullptr};
+
+  // Flag to indicate that a route snapshot is being written by the executor
+  std::atomic<bool> routeSnapshotSaveInProgress_{false};
+
+  /*
+   * Boolean flag indicating whether routeDb_ holds routes of warm-start
+   * snapshot which are not yet replaced by computed routes.
+   */
+  bool warmStarted_{false};
+
   /*
    * Boolean flag indicating whether KvStore synced signal is received in OpenR
    * initialization procedure.
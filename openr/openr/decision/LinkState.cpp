@@ -5,6 +5,8 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
+
 #include <fb303/ServiceData.h>
 #include <folly/logging/xlog.h>
 #include <openr/common/LsdbUtil.h>
@@ -203,8 +205,13 @@ Link::directionalToString(const std::string& fromNode) const {
       getIfaceFromNode(getOtherNodeName(fromNode)));
 }
 
-LinkState::LinkState(const std::string& area, const std::string& myNodeName)
-    : area_(area), myNodeName_(myNodeName) {}
+LinkState::LinkState(
+    const std::string& area,
+    const std::string& myNodeName,
+    size_t kthPathsCacheSize)
+    : area_(area),
+      myNodeName_(myNodeName),
+      kthPathResults_(std::max<size_t>(kthPathsCacheSize, 1)) {}
 
 size_t
 LinkState::LinkPtrHash::operator()(const std::shared_ptr<Link>& l) const {
@@ -671,35 +678,44 @@ LinkState::getMetricFromAToB(
   return std::nullopt;
 }
 
-std::vector<LinkState::Path> const&
+std::vector<LinkState::Path>
 LinkState::getKthPaths(
     const std::string& src, const std::string& dest, size_t k) const {
   CHECK_GE(k, 1);
   std::tuple<std::string, std::string, size_t> key(src, dest, k);
   auto entryIter = kthPathResults_.find(key);
-  if (kthPathResults_.end() == entryIter) {
-    LinkSet linksToIgnore;
-    for (size_t i = 1; i < k; ++i) {
-      for (auto const& path : getKthPaths(src, dest, i)) {
-        for (auto const& link : path) {
-          linksToIgnore.insert(link);
-        }
+  if (kthPathResults_.end() != entryIter) {
+    fb303::fbData->addStatValue(
+        "decision.kth_paths_cache.hit", 1, fb303::COUNT);
+    return entryIter->second;
+  }
+  fb303::fbData->addStatValue("decision.kth_paths_cache.miss", 1, fb303::COUNT);
+
+  LinkSet linksToIgnore;
+  for (size_t i = 1; i < k; ++i) {
+    for (auto const& path : getKthPaths(src, dest, i)) {
+      for (auto const& link : path) {
+        linksToIgnore.insert(link);
       }
     }
-    std::vector<LinkState::Path> paths;
-    auto const& res = linksToIgnore.empty() ? getSpfResult(src, true)
-                                            : runSpf(src, true, linksToIgnore);
-    if (res.count(dest)) {
-      LinkSet visitedLinks;
-      auto path = traceOnePath(src, dest, res, visitedLinks);
-      while (path && !path->empty()) {
-        paths.push_back(std::move(*path));
-        path = traceOnePath(src, dest, res, visitedLinks);
-      }
+  }
+  std::vector<LinkState::Path> paths;
+  // First paths of all destinations share memoized SPF result of src
+  std::optional<SpfResult> partialRes;
+  if (not linksToIgnore.empty()) {
+    partialRes = runSpf(src, true, linksToIgnore, dest);
+  }
+  auto const& res = partialRes ? *partialRes : getSpfResult(src, true);
+  if (res.count(dest)) {
+    LinkSet visitedLinks;
+    auto path = traceOnePath(src, dest, res, visitedLinks);
+    while (path && !path->empty()) {
+      paths.push_back(std::move(*path));
+      path = traceOnePath(src, dest, res, visitedLinks);
     }
-    entryIter = kthPathResults_.emplace(key, std::move(paths)).first;
   }
-  return entryIter->second;
+  kthPathResults_.set(std::move(key), paths);
+  return paths;
 }
 
 LinkState::SpfResult const&
@@ -721,8 +737,10 @@ LinkState::SpfResult
 LinkState::runSpf(
     const std::string& thisNodeName,
     bool useLinkMetric,
-    const LinkState::LinkSet& linksToIgnore) const {
+    const LinkState::LinkSet& linksToIgnore,
+    const std::optional<std::string>& dest) const {
   LinkState::SpfResult result;
+  std::optional<LinkStateMetric> destMetric;
 
   fb303::fbData->addStatValue("decision.spf_runs", 1, fb303::COUNT);
   const auto startTime = std::chrono::steady_clock::now();
@@ -730,6 +748,10 @@ LinkState::runSpf(
   DijkstraQ<DijkstraQSpfNode> q;
   q.insertNode(thisNodeName, 0);
   while (auto node = q.extractMin()) {
+    if (destMetric and node->metric() > *destMetric) {
+      // all shortest paths towards dest are found
+      break;
+    }
     // we've found this node's shortest paths. record it
     auto emplaceRc = result.emplace(node->nodeName, std::move(node->result));
     CHECK(emplaceRc.second);
@@ -737,6 +759,9 @@ LinkState::runSpf(
     auto const& recordedNodeName = emplaceRc.first->first;
     auto const recordedNodeMetric = emplaceRc.first->second.metric();
     auto const& recordedNodeNextHops = emplaceRc.first->second.nextHops();
+    if (dest and recordedNodeName == *dest) {
+      destMetric = recordedNodeMetric;
+    }
 
     if (isNodeOverloaded(recordedNodeName) and
         recordedNodeName != thisNodeName) {
@@ -7,6 +7,8 @@
 
 #pragma once
 
+#include <folly/container/EvictingCacheMap.h>
+
 #include <openr/common/Constants.h>
 #include <openr/if/gen-cpp2/Network_types.h>
 #include <openr/if/gen-cpp2/Types_types.h>
@@ -263,7 +265,10 @@ class Link {
 
 class LinkState {
  public:
-  explicit LinkState(const std::string& area, const std::string& myNodeName);
+  explicit LinkState(
+      const std::string& area,
+      const std::string& myNodeName,
+      size_t kthPathsCacheSize = Constants::kKthPathsCacheSize);
 
   struct LinkPtrHash {
     size_t operator()(const std::shared_ptr<Link>& l) const;
@@ -379,13 +384,22 @@ class LinkState {
   // For k = 1, the above algorithm is perfomered considering all links in the
   // network.
   // For k > 1, the algorithm is performed considering all links except links on
-  // paths in the set {p in getKthPaths(src, dest, i) | 1 <= i < k}.
-  std::vector<LinkState::Path> const& getKthPaths(
+  // paths in the set {p in getKthPaths(src, dest, i) | 1 <= i < k}, and SPF
+  // stops once all nodes as close as dest are settled.
+  //
+  // Results are memoized in an LRU cache bounded to `kthPathsCacheSize`
+  // entries, hence returned by value.
+  std::vector<LinkState::Path> getKthPaths(
       const std::string& src, const std::string& dest, size_t k) const;
 
+  size_t
+  getKthPathsCacheSize() const {
+    return kthPathResults_.size();
+  }
+
  private:
-  // memoization structure for getKthPaths()
-  mutable std::unordered_map<
+  // memoization structure for getKthPaths(), in LRU order
+  mutable folly::EvictingCacheMap<
       std::tuple<std::string /* src */, std::string /* dest */, size_t /* k */>,
       std::vector<LinkState::Path>>
       kthPathResults_;
@@ -539,13 +553,17 @@ class LinkState {
    *                         will consider the graph unweighted.
    * @param: linksToIgnore - optionally specify a set of links to not use when
    *                         running SPF. By default, this is an empty set.
+   * @param: dest - optionally stop once all nodes at most as far as dest are
+   *                found, i.e. once all shortest paths towards dest are known.
+   *                Result is partial then.
    *
    * @return: SpfResult - a map of node -> NodeSpfResult obj mapping
    */
   SpfResult runSpf(
       const std::string& src,
       bool useLinkMetric,
-      const LinkSet& linksToIgnore = {}) const;
+      const LinkSet& linksToIgnore = {},
+      const std::optional<std::string>& dest = std::nullopt) const;
 
   /*
    * Util method to create Link object:
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <openr/decision/NextHopGroup.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include <folly/SharedMutex.h>
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+#include <folly/hash/Hash.h>
+
+namespace openr {
+
+namespace {
+
+/**
+ * Interning table. Maps hash of the next-hop set to the groups with that hash.
+ * Groups are weakly referenced; the last owner removes the group from table.
+ */
+using InternTable = folly::F14FastMap<
+    size_t /* hash */,
+    std::vector<std::weak_ptr<const void>>>;
+
+/**
+ * Interning table is sharded by hash of the next-hop set, so that route build
+ * shards running in parallel don't serialize on a single lock. Lookup of an
+ * existing group, the common case, only takes the shard lock in shared mode.
+ */
+constexpr size_t kNumInternTableShards = 64;
+
+using InternTableShard = folly::Synchronized<InternTable, folly::SharedMutex>;
+
+std::array<InternTableShard, kNumInternTableShards>&
+getInternTableShards() {
+  // NOTE: Intentionally leaked to stay valid during static destruction
+  static auto* shards =
+      new std::array<InternTableShard, kNumInternTableShards>();
+  return *shards;
+}
+
+InternTableShard&
+getInternTableShard(size_t hash) {
+  return getInternTableShards()
+      [folly::hash::twang_mix64(hash) % kNumInternTableShards];
+}
+
+size_t
+hashNextHops(const NextHopGroup::NextHopSet& nexthops) {
+  // Order independent combination of next-hop hashes
+  size_t hash = nexthops.size();
+  for (auto const& nexthop : nexthops) {
+    hash += std::hash<thrift::NextHopThrift>()(nexthop) * 0x9e3779b97f4a7c15ULL;
+  }
+  return hash;
+}
+
+} // namespace
+
+NextHopGroup::NextHopGroup() {
+  // NOTE: Empty group is shared by all default constructed instances and is
+  // never released
+  static const auto* kEmptyGroup =
+      new std::shared_ptr<const Group>(std::make_shared<const Group>());
+  group_ = *kEmptyGroup;
+}
+
+NextHopGroup::NextHopGroup(NextHopSet nexthops) {
+  if (nexthops.empty()) {
+    *this = NextHopGroup();
+    return;
+  }
+  group_ = intern(std::move(nexthops));
+}
+
+NextHopGroup::NextHopGroup(
+    std::initializer_list<thrift::NextHopThrift> nexthops)
+    : NextHopGroup(NextHopSet(nexthops)) {}
+
+NextHopGroup::size_type
+NextHopGroup::erase(const thrift::NextHopThrift& nexthop) {
+  if (not count(nexthop)) {
+    return 0;
+  }
+  auto nexthops = get();
+  nexthops.erase(nexthop);
+  *this = NextHopGroup(std::move(nexthops));
+  return 1;
+}
+
+std::shared_ptr<const NextHopGroup::Group>
+NextHopGroup::intern(NextHopSet&& nexthops) {
+  const auto hash = hashNextHops(nexthops);
+  auto& shard = getInternTableShard(hash);
+
+  // NOTE: Groups locked while looking up the bucket must be released after
+  // the shard lock, as releasing the last reference acquires the shard lock.
+  std::vector<std::shared_ptr<const Group>> candidates;
+
+  // Fast path: look up existing group under shared lock
+  {
+    auto lockedTable = shard.rlock();
+    auto it = lockedTable->find(hash);
+    if (it != lockedTable->end()) {
+      for (auto const& weakGroup : it->second) {
+        auto group = std::static_pointer_cast<const Group>(weakGroup.lock());
+        if (group and group->nexthops == nexthops) {
+          return group;
+        }
+        candidates.emplace_back(std::move(group));
+      }
+    }
+  }
+
+  // Slow path: look up again under exclusive lock, as the group may have been
+  // interned by another thread in the meantime
+  auto lockedTable = shard.wlock();
+  auto& bucket = (*lockedTable)[hash];
+  for (auto const& weakGroup : bucket) {
+    auto group = std::static_pointer_cast<const Group>(weakGroup.lock());
+    if (group and group->nexthops == nexthops) {
+      return group;
+    }
+    candidates.emplace_back(std::move(group));
+  }
+
+  // Create new group. Deleter removes expired entries of the bucket before
+  // releasing the group. NOTE: Bucket may hold an expired entry for a brief
+  // period between last reference release and deleter acquiring the lock.
+  std::shared_ptr<const Group> group(
+      new Group{std::move(nexthops), hash}, [](const Group* g) {
+        {
+          auto lockedTable = getInternTableShard(g->hash).wlock();
+          auto it = lockedTable->find(g->hash);
+          if (it != lockedTable->end()) {
+            auto& groups = it->second;
+            groups.erase(
+                std::remove_if(
+                    groups.begin(),
+                    groups.end(),
+                    [](auto const& weakGroup) { return weakGroup.expired(); }),
+                groups.end());
+            if (groups.empty()) {
+              lockedTable->erase(it);
+            }
+          }
+        }
+        delete g;
+      });
+  bucket.emplace_back(group);
+  return group;
+}
+
+size_t
+NextHopGroup::getNumInternedGroups() {
+  size_t numGroups{0};
+  for (auto& shard : getInternTableShards()) {
+    auto lockedTable = shard.rlock();
+    for (auto const& [_, groups] : *lockedTable) {
+      numGroups += groups.size();
+    }
+  }
+  return numGroups;
+}
+
+} // namespace openr
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <unordered_set>
+
+#include <openr/common/NetworkUtil.h>
+#include <openr/if/gen-cpp2/Network_types.h>
+
+namespace openr {
+
+/**
+ * Immutable, interned and reference counted set of next-hops.
+ *
+ * In Clos fabrics a large number of routes share a small number of identical
+ * ECMP groups. All NextHopGroup instances with the same set of next-hops share
+ * a single underlying set, hence
+ * - memory is proportional to the number of distinct groups instead of
+ *   number of routes
+ * - equality check is a pointer comparison
+ * - copying is a reference count increment
+ *
+ * NextHopGroup exposes the const interface of
+ * `std::unordered_set<thrift::NextHopThrift>`. Mutation (`emplace`, `erase`)
+ * is copy-on-write and re-interns the resulting set.
+ *
+ * Interning table is process wide and thread-safe, as groups are shared
+ * across modules (Decision, Fib, PrefixManager) running on different threads.
+ * It is sharded by hash and looked up under a shared lock, so concurrent
+ * route build shards don't contend on it. Groups are removed from the table
+ * when the last reference is released.
+ */
+class NextHopGroup {
+ public:
+  using NextHopSet = std::unordered_set<thrift::NextHopThrift>;
+  using value_type = NextHopSet::value_type;
+  using size_type = NextHopSet::size_type;
+  using const_iterator = NextHopSet::const_iterator;
+  using iterator = const_iterator;
+
+  // Empty group
+  NextHopGroup();
+
+  // Intern the given set of next-hops
+  /* implicit */ NextHopGroup(NextHopSet nexthops);
+  /* implicit */ NextHopGroup(
+      std::initializer_list<thrift::NextHopThrift> nexthops);
+
+  const NextHopSet&
+  get() const {
+    return group_->nexthops;
+  }
+
+  /* implicit */ operator const NextHopSet&() const {
+    return get();
+  }
+
+  const_iterator
+  begin() const {
+    return get().begin();
+  }
+
+  const_iterator
+  end() const {
+    return get().end();
+  }
+
+  const_iterator
+  cbegin() const {
+    return get().cbegin();
+  }
+
+  const_iterator
+  cend() const {
+    return get().cend();
+  }
+
+  size_type
+  size() const {
+    return get().size();
+  }
+
+  bool
+  empty() const {
+    return get().empty();
+  }
+
+  size_type
+  count(const thrift::NextHopThrift& nexthop) const {
+    return get().count(nexthop);
+  }
+
+  const_iterator
+  find(const thrift::NextHopThrift& nexthop) const {
+    return get().find(nexthop);
+  }
+
+  // Hash of the next-hop set. Independent of the iteration order.
+  size_t
+  hash() const {
+    return group_->hash;
+  }
+
+  /**
+   * Copy-on-write mutators. Re-intern the modified set.
+   */
+  template <typename... Args>
+  bool
+  emplace(Args&&... args) {
+    auto nexthops = get();
+    const bool inserted =
+        nexthops.emplace(std::forward<Args>(args)...).second;
+    if (inserted) {
+      *this = NextHopGroup(std::move(nexthops));
+    }
+    return inserted;
+  }
+
+  size_type erase(const thrift::NextHopThrift& nexthop);
+
+  // Interned groups are unique per set of next-hops
+  friend bool
+  operator==(const NextHopGroup& lhs, const NextHopGroup& rhs) {
+    return lhs.group_ == rhs.group_;
+  }
+
+  friend bool
+  operator!=(const NextHopGroup& lhs, const NextHopGroup& rhs) {
+    return lhs.group_ != rhs.group_;
+  }
+
+  /**
+   * Number of distinct next-hop groups alive in the process
+   */
+  static size_t getNumInternedGroups();
+
+ private:
+  struct Group {
+    NextHopSet nexthops;
+    size_t hash{0};
+  };
+
+  static std::shared_ptr<const Group> intern(NextHopSet&& nexthops);
+
+  std::shared_ptr<const Group> group_;
+};
+
+} // namespace openr
+
+namespace std {
+
+/**
+ * Make NextHopGroup hashable
+ */
+template <>
+struct hash<openr::NextHopGroup> {
+  size_t
+  operator()(openr::NextHopGroup const& group) const {
+    return group.hash();
+  }
+};
+
+} // namespace std
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -14,6 +15,7 @@
 
 #include <folly/IPAddress.h>
 #include <openr/common/NetworkUtil.h>
+#include <openr/decision/NextHopGroup.h>
 #include <openr/if/gen-cpp2/OpenrCtrl.h>
 #include <openr/if/gen-cpp2/Types_types.h>
 
@@ -21,15 +23,15 @@ namespace openr {
 
 struct RibEntry {
   // TODO: should this be map<area, nexthops>?
-  std::unordered_set<thrift::NextHopThrift> nexthops;
+  // NOTE: Next-hop groups are interned and shared across routes. Comparison
+  // of next-hops is a pointer comparison.
+  NextHopGroup nexthops;
 
   // igp cost of all routes (ecmp) or of lowest cost route (if ucmp)
   unsigned int igpCost;
 
   // constructor
-  explicit RibEntry(
-      std::unordered_set<thrift::NextHopThrift> nexthops,
-      unsigned int igpCost = 0)
+  explicit RibEntry(NextHopGroup nexthops, unsigned int igpCost = 0)
       : nexthops(std::move(nexthops)), igpCost(igpCost) {}
 
   RibEntry() = default;
@@ -50,19 +52,23 @@ struct RibUnicastEntry : RibEntry {
   // RibPolicyStatement that matches to this route.
   std::optional<thrift::RouteCounterID> counterID{std::nullopt};
   bool localRouteConsidered{false};
+  // Entry of PrefixState `bestPrefixEntry` is copied from, if any. Entries of
+  // PrefixState are const and replaced on change, hence routes copied
+  // from the same entry have the same `bestPrefixEntry` except for the drain
+  // metric and weight set on top of it. Must be reset if `bestPrefixEntry` is
+  // modified otherwise.
+  std::shared_ptr<const thrift::PrefixEntry> bestPrefixEntrySource{nullptr};
 
   // constructor
   explicit RibUnicastEntry() = default;
   explicit RibUnicastEntry(const folly::CIDRNetwork& prefix) : prefix(prefix) {}
 
-  RibUnicastEntry(
-      const folly::CIDRNetwork& prefix,
-      std::unordered_set<thrift::NextHopThrift> nexthops)
+  RibUnicastEntry(const folly::CIDRNetwork& prefix, NextHopGroup nexthops)
       : RibEntry(std::move(nexthops)), prefix(prefix) {}
 
   RibUnicastEntry(
       const folly::CIDRNetwork& prefix,
-      std::unordered_set<thrift::NextHopThrift> nexthops,
+      NextHopGroup nexthops,
       thrift::PrefixEntry bestPrefixEntryThrift,
       const std::string& bestArea,
       bool doNotInstall = false,
@@ -91,6 +97,28 @@ struct RibUnicastEntry : RibEntry {
     return !(*this == other);
   }
 
+  /*
+   * Same as `operator==`, with cheap comparisons first. Deep comparison of
+   * `bestPrefixEntry` is skipped if both are copied from the same PrefixState
+   * entry (see `bestPrefixEntrySource`).
+   */
+  bool
+  isSameRoute(const RibUnicastEntry& other) const {
+    if (nexthops != other.nexthops || doNotInstall != other.doNotInstall ||
+        localRouteConsidered != other.localRouteConsidered ||
+        counterID != other.counterID || prefix != other.prefix) {
+      return false;
+    }
+    if (bestPrefixEntrySource &&
+        bestPrefixEntrySource == other.bestPrefixEntrySource) {
+      return *bestPrefixEntry.metrics()->drain_metric() ==
+          *other.bestPrefixEntry.metrics()->drain_metric() &&
+          bestPrefixEntry.weight().to_optional() ==
+          other.bestPrefixEntry.weight().to_optional();
+    }
+    return bestPrefixEntry == other.bestPrefixEntry;
+  }
+
   // TODO: rename this func
   thrift::UnicastRoute
   toThrift() const {
@@ -119,8 +147,7 @@ struct RibMplsEntry : RibEntry {
 
   // constructor
   explicit RibMplsEntry() = default;
-  RibMplsEntry(
-      int32_t label, std::unordered_set<thrift::NextHopThrift> nexthops)
+  RibMplsEntry(int32_t label, NextHopGroup nexthops)
       : RibEntry(std::move(nexthops)), label(label) {}
 
   static RibMplsEntry
@@ -186,13 +213,15 @@ struct RibMplsEntry : RibEntry {
     }
 
     // Filter nexthop that do not match selected MPLS action
-    for (auto it = nexthops.begin(); it != nexthops.end();) {
-      if (mplsActionCode != *it->mplsAction()->action()) {
-        it = nexthops.erase(it);
-      } else {
-        ++it;
+    NextHopGroup::NextHopSet filteredNexthops;
+    for (auto const& nextHop : nexthops) {
+      if (mplsActionCode == *nextHop.mplsAction()->action()) {
+        filteredNexthops.emplace(nextHop);
       }
     }
+    if (filteredNexthops.size() != nexthops.size()) {
+      nexthops = NextHopGroup(std::move(filteredNexthops));
+    }
   }
 };
 } // namespace openr
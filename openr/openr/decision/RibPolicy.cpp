@@ -29,10 +29,13 @@ RibPolicyStatement::RibPolicyStatement(const thrift::RibPolicyStatement& stmt)
   }
 
   // Verify that at-least one match criteria must be specified
-  if (not stmt.matcher()->prefixes() && not stmt.matcher()->tags()) {
+  if (not stmt.matcher()->prefixes() && not stmt.matcher()->tags() &&
+      not stmt.matcher()->prefix_ranges()) {
     thrift::OpenrError error;
     *error.message() =
-        "Missing policy_statement.matcher.prefixes or policy_statement.matcher.tags attribute";
+        "Missing policy_statement.matcher.prefixes, "
+        "policy_statement.matcher.prefix_ranges or "
+        "policy_statement.matcher.tags attribute";
     throw error;
   }
 
@@ -42,6 +45,28 @@ RibPolicyStatement::RibPolicyStatement(const thrift::RibPolicyStatement& stmt)
       prefixSet_.insert(toIPNetwork(tPrefix));
     }
   }
+  if (stmt.matcher()->prefix_ranges()) {
+    for (const auto& tRange : *stmt.matcher()->prefix_ranges()) {
+      PrefixRange range;
+      range.prefix = toIPNetwork(*tRange.prefix());
+      const int16_t maxLen = range.prefix.first.bitCount();
+      const int16_t ge = tRange.ge().value_or(range.prefix.second);
+      const int16_t le = tRange.le().value_or(ge);
+      if (ge < range.prefix.second or le < ge or le > maxLen) {
+        thrift::OpenrError error;
+        *error.message() = fmt::format(
+            "Invalid policy_statement.matcher.prefix_ranges entry {} ge {} "
+            "le {}",
+            folly::IPAddress::networkToString(range.prefix),
+            ge,
+            le);
+        throw error;
+      }
+      range.ge = ge;
+      range.le = le;
+      prefixRanges_.emplace_back(std::move(range));
+    }
+  }
   if (stmt.matcher()->tags()) {
     for (const auto& tTag : *stmt.matcher()->tags()) {
       tagSet_.insert(tTag);
@@ -61,6 +86,17 @@ RibPolicyStatement::toThrift() const {
       stmt.matcher()->prefixes()->emplace_back(toIpPrefix(prefix));
     }
   }
+  if (!prefixRanges_.empty()) {
+    stmt.matcher()->prefix_ranges() =
+        std::vector<thrift::RibRoutePrefixRange>();
+    for (auto const& range : prefixRanges_) {
+      thrift::RibRoutePrefixRange tRange;
+      tRange.prefix() = toIpPrefix(range.prefix);
+      tRange.ge() = range.ge;
+      tRange.le() = range.le;
+      stmt.matcher()->prefix_ranges()->emplace_back(std::move(tRange));
+    }
+  }
   if (!tagSet_.empty()) {
     stmt.matcher()->tags() = std::vector<std::string>();
     for (auto const& tag : tagSet_) {
@@ -71,9 +107,19 @@ RibPolicyStatement::toThrift() const {
   return stmt;
 } // namespace openr
 
+bool
+RibPolicyStatement::PrefixRange::contains(
+    folly::CIDRNetwork const& network) const {
+  if (network.second < ge or network.second > le or
+      network.first.family() != prefix.first.family()) {
+    return false;
+  }
+  return network.first.mask(prefix.second) == prefix.first;
+}
+
 bool
 RibPolicyStatement::match(const RibUnicastEntry& route) const {
-  if (tagSet_.empty() && prefixSet_.empty()) {
+  if (tagSet_.empty() && prefixSet_.empty() && prefixRanges_.empty()) {
     return false;
   }
 
@@ -95,11 +141,16 @@ RibPolicyStatement::match(const RibUnicastEntry& route) const {
   // Attempt to match the route on prefix if populated in the RibPolicy
   // statement
   bool prefixMatch{false};
-  if (prefixSet_.empty()) {
+  if (prefixSet_.empty() && prefixRanges_.empty()) {
     prefixMatch = true;
   } else {
     // Find a match with at least one prefix in the RibPolicyStatement
     prefixMatch = prefixSet_.count(route.prefix) > 0;
+    for (auto it = prefixRanges_.begin();
+         not prefixMatch and it != prefixRanges_.end();
+         ++it) {
+      prefixMatch = it->contains(route.prefix);
+    }
   }
 
   // Verify both tag and prefix matchers are successful
@@ -111,7 +162,11 @@ RibPolicyStatement::applyAction(RibUnicastEntry& route) const {
   if (not match(route)) {
     return false;
   }
+  return transform(route);
+}
 
+bool
+RibPolicyStatement::transform(RibUnicastEntry& route) const {
   // Assign RibPolicyStatement route counter ID to the route
   route.counterID = counterID_;
 
@@ -160,6 +215,125 @@ RibPolicyStatement::applyAction(RibUnicastEntry& route) const {
   return true;
 }
 
+//
+// RibPolicyMatcher
+//
+
+namespace detail {
+
+RibPolicyMatcher::RibPolicyMatcher(
+    std::vector<RibPolicyStatement> const& policyStatements)
+    : numWords_((policyStatements.size() + 63) / 64),
+      anyPrefixBitmap_(numWords_, 0),
+      anyTagBitmap_(numWords_, 0) {
+  for (uint32_t idx = 0; idx < policyStatements.size(); ++idx) {
+    auto const& statement = policyStatements.at(idx);
+    const bool hasPrefixes = not statement.getPrefixSet().empty() or
+        not statement.getPrefixRanges().empty();
+    const bool hasTags = not statement.getTagSet().empty();
+
+    // Statement without any criteria never matches. Keep it out of all indices
+    if (not hasPrefixes and not hasTags) {
+      continue;
+    }
+
+    if (hasPrefixes) {
+      for (auto const& prefix : statement.getPrefixSet()) {
+        addRange(
+            idx,
+            RibPolicyStatement::PrefixRange{
+                prefix,
+                static_cast<uint8_t>(prefix.second),
+                static_cast<uint8_t>(prefix.second)});
+      }
+      for (auto const& range : statement.getPrefixRanges()) {
+        addRange(idx, range);
+      }
+    } else {
+      setBit(anyPrefixBitmap_, idx);
+    }
+
+    if (hasTags) {
+      for (auto const& tag : statement.getTagSet()) {
+        tagIndex_[tag].emplace_back(idx);
+      }
+    } else {
+      setBit(anyTagBitmap_, idx);
+    }
+  }
+}
+
+void
+RibPolicyMatcher::addRange(
+    uint32_t statementIdx, RibPolicyStatement::PrefixRange const& range) {
+  auto& trie = range.prefix.first.isV4() ? v4Trie_ : v6Trie_;
+  uint32_t node = 0;
+  for (uint8_t depth = 0; depth < range.prefix.second; ++depth) {
+    const auto bit = range.prefix.first.getNthMSBit(depth) ? 1 : 0;
+    if (trie[node].children[bit] == 0) {
+      trie[node].children[bit] = trie.size();
+      trie.emplace_back();
+    }
+    node = trie[node].children[bit];
+  }
+  trie[node].ranges.emplace_back(
+      RangeEntry{statementIdx, range.ge, range.le});
+}
+
+RibPolicyMatcher::MatchedStatements
+RibPolicyMatcher::match(const RibUnicastEntry& route) const {
+  MatchedStatements matched;
+  if (numWords_ == 0) {
+    return matched;
+  }
+
+  // Walk trie along the bits of route prefix. Every node on the path covers
+  // the route prefix, hence only prefix length needs to be checked against
+  // the range.
+  Bitmap prefixBitmap = anyPrefixBitmap_;
+  auto const& [addr, len] = route.prefix;
+  auto const& trie = addr.isV4() ? v4Trie_ : v6Trie_;
+  uint32_t node = 0;
+  for (uint8_t depth = 0;; ++depth) {
+    for (auto const& entry : trie[node].ranges) {
+      if (entry.ge <= len and len <= entry.le) {
+        setBit(prefixBitmap, entry.statementIdx);
+      }
+    }
+    if (depth >= len) {
+      break;
+    }
+    node = trie[node].children[addr.getNthMSBit(depth) ? 1 : 0];
+    if (node == 0) {
+      break;
+    }
+  }
+
+  // Lookup tags in the inverted index
+  Bitmap tagBitmap = anyTagBitmap_;
+  for (auto const& tag : *route.bestPrefixEntry.tags()) {
+    auto it = tagIndex_.find(tag);
+    if (it == tagIndex_.end()) {
+      continue;
+    }
+    for (auto const idx : it->second) {
+      setBit(tagBitmap, idx);
+    }
+  }
+
+  // Statements selecting the route must match on both prefix and tag
+  for (size_t word = 0; word < numWords_; ++word) {
+    auto bits = prefixBitmap[word] & tagBitmap[word];
+    while (bits) {
+      matched.push_back(word * 64 + __builtin_ctzll(bits));
+      bits &= bits - 1;
+    }
+  }
+  return matched;
+}
+
+} // namespace detail
+
 //
 // RibPolicy
 //
@@ -178,6 +352,9 @@ RibPolicy::RibPolicy(thrift::RibPolicy const& policy)
   for (auto const& statement : *policy.statements()) {
     policyStatements_.emplace_back(statement);
   }
+
+  // Compile match criteria of all statements
+  matcher_ = detail::RibPolicyMatcher(policyStatements_);
 }
 
 thrift::RibPolicy
@@ -210,18 +387,15 @@ RibPolicy::isActive() const {
 
 bool
 RibPolicy::match(const RibUnicastEntry& route) const {
-  for (auto const& statement : policyStatements_) {
-    if (statement.match(route)) {
-      return true;
-    }
-  }
-  return false;
+  return not matcher_.match(route).empty();
 }
 
 bool
 RibPolicy::applyAction(RibUnicastEntry& route) const {
-  for (auto const& statement : policyStatements_) {
-    if (statement.applyAction(route)) {
+  // Statements are evaluated in order. Move on to the next selecting statement
+  // if the transformation fails.
+  for (auto const idx : matcher_.match(route)) {
+    if (policyStatements_.at(idx).transform(route)) {
       return true;
     }
   }
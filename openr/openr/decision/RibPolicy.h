@@ -7,6 +7,9 @@
 
 #include <chrono>
 
+#include <folly/container/F14Map.h>
+#include <folly/small_vector.h>
+
 #include <openr/common/NetworkUtil.h>
 #include <openr/decision/RibEntry.h>
 #include <openr/if/gen-cpp2/Network_types.h>
@@ -42,6 +45,42 @@ class RibPolicyStatement {
    */
   bool applyAction(RibUnicastEntry& route) const;
 
+  /**
+   * Transform route without evaluating the match criteria. Caller must ensure
+   * that the route is selected by this statement.
+   *
+   * @returns boolean indicating if route is transformed or not.
+   */
+  bool transform(RibUnicastEntry& route) const;
+
+  /**
+   * Prefix range selecting routes covered by `prefix` with prefix length
+   * within [ge, le]. Exact prefix matchers are represented with ge = le =
+   * prefix length.
+   */
+  struct PrefixRange {
+    folly::CIDRNetwork prefix;
+    uint8_t ge{0};
+    uint8_t le{0};
+
+    bool contains(folly::CIDRNetwork const& network) const;
+  };
+
+  const std::unordered_set<folly::CIDRNetwork>&
+  getPrefixSet() const {
+    return prefixSet_;
+  }
+
+  const std::vector<PrefixRange>&
+  getPrefixRanges() const {
+    return prefixRanges_;
+  }
+
+  const std::unordered_set<std::string>&
+  getTagSet() const {
+    return tagSet_;
+  }
+
  private:
   const std::string name_;
 
@@ -50,6 +89,9 @@ class RibPolicyStatement {
   // qualified)
   std::unordered_set<folly::CIDRNetwork> prefixSet_;
 
+  // Prefix ranges. Route is selected if it is covered by any of the ranges.
+  std::vector<PrefixRange> prefixRanges_;
+
   // Tag set. Unordered set for efficient lookup.
   std::unordered_set<std::string> tagSet_;
 
@@ -60,6 +102,77 @@ class RibPolicyStatement {
   const std::optional<thrift::RouteCounterID> counterID_;
 };
 
+namespace detail {
+
+/**
+ * Compiled match criteria of the statements of a RibPolicy.
+ *
+ * - Prefixes and prefix ranges are compiled into a binary trie per address
+ *   family. A lookup walks the bits of the route prefix and collects the
+ *   ranges of all covering trie nodes, hence cost is bounded by prefix length
+ *   instead of number of statements.
+ * - Tags are compiled into an inverted index of tag to statements.
+ *
+ * Both lookups produce a bitmap of statements (bit `i` refers to the `i`th
+ * statement). AND of the two bitmaps yields the statements selecting the
+ * route, in the order of evaluation.
+ */
+class RibPolicyMatcher {
+ public:
+  using MatchedStatements = folly::small_vector<uint32_t, 4>;
+
+  RibPolicyMatcher() = default;
+  explicit RibPolicyMatcher(
+      std::vector<RibPolicyStatement> const& policyStatements);
+
+  /**
+   * Returns indices of all statements selecting the route, in ascending order.
+   */
+  MatchedStatements match(const RibUnicastEntry& route) const;
+
+ private:
+  using Bitmap = folly::small_vector<uint64_t, 8>;
+
+  struct RangeEntry {
+    uint32_t statementIdx{0};
+    uint8_t ge{0};
+    uint8_t le{0};
+  };
+
+  struct TrieNode {
+    // Index of child nodes in the trie. 0 indicates no child (root can't be a
+    // child of any node)
+    std::array<uint32_t, 2> children{{0, 0}};
+    std::vector<RangeEntry> ranges;
+  };
+
+  void addRange(
+      uint32_t statementIdx, RibPolicyStatement::PrefixRange const& range);
+
+  static void
+  setBit(Bitmap& bitmap, uint32_t idx) {
+    bitmap[idx / 64] |= (uint64_t{1} << (idx % 64));
+  }
+
+  // Number of 64-bit words in statement bitmaps
+  size_t numWords_{0};
+
+  // Trie per address family. Root node is always present at index 0.
+  std::vector<TrieNode> v4Trie_{1};
+  std::vector<TrieNode> v6Trie_{1};
+
+  // Statements with tag criteria but no prefix criteria. They match any prefix
+  Bitmap anyPrefixBitmap_;
+
+  // Statements with prefix criteria but no tag criteria. They match any tag
+  Bitmap anyTagBitmap_;
+
+  // Tag to statement indices
+  folly::F14FastMap<std::string, std::vector<uint32_t>> tagIndex_;
+};
+
+} // namespace detail
+
 /**
  * Represents `thrift::RibPolicy`. Defines efficient data structures for
  * efficient processing of policy. Provides APIs for easier code intengration
@@ -117,6 +230,9 @@ class RibPolicy {
   // List of policy statements
   std::vector<RibPolicyStatement> policyStatements_;
 
+  // Compiled match criteria of `policyStatements_`
+  detail::RibPolicyMatcher matcher_;
+
   // Validity
   const std::chrono::steady_clock::time_point validUntilTs_;
 };
@@ -53,6 +53,11 @@ struct DecisionRouteUpdate {
   // Optional perf events associated with this route update
   std::optional<thrift::PerfEvents> perfEvents{std::nullopt};
 
+  // Set if routes are loaded from persisted snapshot on warm-start rather than
+  // computed. Such routes are replaced by the computed routes with subsequent
+  // route update.
+  bool warmStart{false};
+
   bool
   empty() const {
     return (
@@ -5,7 +5,12 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
+
 #include <fb303/ServiceData.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
+#include <folly/hash/Hash.h>
 #include <folly/logging/xlog.h>
 
 #include <openr/common/LsdbUtil.h>
@@ -18,35 +23,69 @@ namespace fb303 = facebook::fb303;
 
 namespace openr {
 
+namespace {
+// Minimum number of prefixes per shard for parallel route build. Smaller
+// route databases are built sequentially as scheduling overhead dominates.
+const size_t kMinPrefixesPerRouteBuildShard = 1000;
+
+// Compare route deltas regardless of order of deletions
+bool
+isSameUpdate(DecisionRouteUpdate const& lhs, DecisionRouteUpdate const& rhs) {
+  return lhs.unicastRoutesToUpdate == rhs.unicastRoutesToUpdate &&
+      lhs.mplsRoutesToUpdate == rhs.mplsRoutesToUpdate &&
+      std::unordered_set<folly::CIDRNetwork>(
+          lhs.unicastRoutesToDelete.begin(), lhs.unicastRoutesToDelete.end()) ==
+      std::unordered_set<folly::CIDRNetwork>(
+          rhs.unicastRoutesToDelete.begin(),
+          rhs.unicastRoutesToDelete.end()) &&
+      std::unordered_set<int32_t>(
+          lhs.mplsRoutesToDelete.begin(), lhs.mplsRoutesToDelete.end()) ==
+      std::unordered_set<int32_t>(
+          rhs.mplsRoutesToDelete.begin(), rhs.mplsRoutesToDelete.end());
+}
+
+// Record route built for `prefix`, if any, into `update` unless unchanged
+// relative to `prevRouteDb`. Returns true if `prevRouteDb` has a route for
+// `prefix`.
+bool
+recordUnicastRoute(
+    DecisionRouteDb const& prevRouteDb,
+    folly::CIDRNetwork const& prefix,
+    std::optional<RibUnicastEntry> const& route,
+    DecisionRouteUpdate& update) {
+  auto const search = prevRouteDb.unicastRoutes.find(prefix);
+  const bool found = search != prevRouteDb.unicastRoutes.end();
+  if (route.has_value()) {
+    if (not found or not search->second.isSameRoute(*route)) {
+      update.addRouteToUpdate(*route);
+    }
+  } else if (found) {
+    update.unicastRoutesToDelete.emplace_back(prefix);
+  }
+  return found;
+}
+} // namespace
+
 DecisionRouteUpdate
-DecisionRouteDb::calculateUpdate(DecisionRouteDb&& newDb) const {
+DecisionRouteDb::calculateFullUpdate(DecisionRouteDb const& newDb) const {
   DecisionRouteUpdate delta;
-
-  // unicastRoutesToUpdate
-  for (auto& [prefix, entry] : newDb.unicastRoutes) {
+  for (auto const& [prefix, entry] : newDb.unicastRoutes) {
     const auto& search = unicastRoutes.find(prefix);
     if (search == unicastRoutes.end() || search->second != entry) {
-      // new prefix, or prefix entry changed
-      delta.addRouteToUpdate(std::move(entry));
+      delta.addRouteToUpdate(RibUnicastEntry(entry));
     }
   }
-
-  // unicastRoutesToDelete
   for (auto const& [prefix, _] : unicastRoutes) {
     if (!newDb.unicastRoutes.count(prefix)) {
       delta.unicastRoutesToDelete.emplace_back(prefix);
     }
   }
-
-  // mplsRoutesToUpdate
-  for (auto& [label, entry] : newDb.mplsRoutes) {
+  for (auto const& [label, entry] : newDb.mplsRoutes) {
     const auto& search = mplsRoutes.find(label);
     if (search == mplsRoutes.end() || search->second != entry) {
-      delta.addMplsRouteToUpdate(std::move(entry));
+      delta.addMplsRouteToUpdate(RibMplsEntry(entry));
     }
   }
-
-  // mplsRoutesToDelete
   for (auto const& [label, _] : mplsRoutes) {
     if (!newDb.mplsRoutes.count(label)) {
       delta.mplsRoutesToDelete.emplace_back(label);
@@ -55,6 +94,23 @@ DecisionRouteDb::calculateUpdate(DecisionRouteDb&& newDb) const {
   return delta;
 }
 
+DecisionRouteUpdate
+DecisionRouteDb::verifyUpdate(
+    DecisionRouteDb const& newDb, DecisionRouteUpdate&& delta) const {
+  auto fullDelta = calculateFullUpdate(newDb);
+  if (isSameUpdate(delta, fullDelta)) {
+    return std::move(delta);
+  }
+  XLOG(ERR) << "Route delta mismatch. Computed "
+            << delta.unicastRoutesToUpdate.size() << " updates and "
+            << delta.unicastRoutesToDelete.size()
+            << " deletions, full comparison of routes yields "
+            << fullDelta.unicastRoutesToUpdate.size() << " updates and "
+            << fullDelta.unicastRoutesToDelete.size() << " deletions.";
+  fb303::fbData->addStatValue("decision.route_delta_mismatch", 1, fb303::COUNT);
+  return fullDelta;
+}
+
 void
 DecisionRouteDb::update(DecisionRouteUpdate const& update) {
   for (auto const& prefix : update.unicastRoutesToDelete) {
@@ -71,17 +127,75 @@ DecisionRouteDb::update(DecisionRouteUpdate const& update) {
   }
 }
 
+thrift::RouteDatabaseSnapshot
+DecisionRouteDb::toSnapshot(const std::string& nodeName) const {
+  thrift::RouteDatabaseSnapshot snapshot;
+  snapshot.version() = kSnapshotVersion;
+  snapshot.thisNodeName() = nodeName;
+  snapshot.timestampMs() =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count();
+  snapshot.unicastRoutes()->reserve(unicastRoutes.size());
+  for (auto const& [_, entry] : unicastRoutes) {
+    auto& tEntry = snapshot.unicastRoutes()->emplace_back();
+    tEntry.route() = entry.toThrift();
+    tEntry.bestPrefixEntry() = entry.bestPrefixEntry;
+    tEntry.bestArea() = entry.bestArea;
+    tEntry.igpCost() = entry.igpCost;
+    tEntry.doNotInstall() = entry.doNotInstall;
+    tEntry.localRouteConsidered() = entry.localRouteConsidered;
+  }
+  snapshot.mplsRoutes()->reserve(mplsRoutes.size());
+  for (auto const& [_, entry] : mplsRoutes) {
+    snapshot.mplsRoutes()->emplace_back(entry.toThrift());
+  }
+  return snapshot;
+}
+
+DecisionRouteDb
+DecisionRouteDb::fromSnapshot(thrift::RouteDatabaseSnapshot const& snapshot) {
+  DecisionRouteDb routeDb;
+  routeDb.unicastRoutes.reserve(snapshot.unicastRoutes()->size());
+  for (auto const& tEntry : *snapshot.unicastRoutes()) {
+    auto const& tRoute = *tEntry.route();
+    RibUnicastEntry entry(
+        toIPNetwork(*tRoute.dest()),
+        std::unordered_set<thrift::NextHopThrift>(
+            tRoute.nextHops()->begin(), tRoute.nextHops()->end()),
+        *tEntry.bestPrefixEntry(),
+        *tEntry.bestArea(),
+        *tEntry.doNotInstall(),
+        *tEntry.igpCost(),
+        tEntry.bestPrefixEntry()->weight().to_optional(),
+        *tEntry.localRouteConsidered());
+    entry.counterID = tRoute.counterID().to_optional();
+    routeDb.addUnicastRoute(std::move(entry));
+  }
+  for (auto const& tMpls : *snapshot.mplsRoutes()) {
+    routeDb.addMplsRoute(RibMplsEntry::fromThrift(tMpls));
+  }
+  return routeDb;
+}
+
 SpfSolver::SpfSolver(
     const std::string& myNodeName,
     bool enableV4,
     bool enableNodeSegmentLabel,
     bool enableBestRouteSelection,
-    bool v4OverV6Nexthop)
+    bool v4OverV6Nexthop,
+    size_t routeBuildThreads)
     : myNodeName_(myNodeName),
       enableV4_(enableV4),
       enableNodeSegmentLabel_(enableNodeSegmentLabel),
       enableBestRouteSelection_(enableBestRouteSelection),
       v4OverV6Nexthop_(v4OverV6Nexthop) {
+  if (routeBuildThreads > 1) {
+    routeBuildExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        routeBuildThreads,
+        std::make_shared<folly::NamedThreadFactory>("DecisionRouteBuild"));
+  }
+
   // Initialize stat keys
   fb303::fbData->addStatExportType("decision.adj_db_update", fb303::COUNT);
   fb303::fbData->addStatExportType(
@@ -162,7 +276,35 @@ SpfSolver::createRouteForPrefix(
     const std::string& myNodeName,
     std::unordered_map<std::string, LinkState> const& areaLinkStates,
     PrefixState const& prefixState,
-    folly::CIDRNetwork const& prefix) {
+    folly::CIDRNetwork const& prefix,
+    SpfAreaResultsCache* spfAreaResultsCache) {
+  std::optional<RouteSelectionResult> routeSelectionResult;
+  auto maybeRoute = computeRouteForPrefix(
+      myNodeName,
+      areaLinkStates,
+      prefixState,
+      prefix,
+      routeSelectionResult,
+      spfAreaResultsCache);
+
+  // Update best route selection cache for the prefix
+  if (routeSelectionResult.has_value()) {
+    bestRoutesCache_.insert_or_assign(
+        prefix, std::move(routeSelectionResult).value());
+  } else {
+    bestRoutesCache_.erase(prefix);
+  }
+  return maybeRoute;
+}
+
+std::optional<RibUnicastEntry>
+SpfSolver::computeRouteForPrefix(
+    const std::string& myNodeName,
+    std::unordered_map<std::string, LinkState> const& areaLinkStates,
+    PrefixState const& prefixState,
+    folly::CIDRNetwork const& prefix,
+    std::optional<RouteSelectionResult>& routeSelectionResultOut,
+    SpfAreaResultsCache* spfAreaResultsCache) const {
   fb303::fbData->addStatValue("decision.get_route_for_prefix", 1, fb303::COUNT);
 
   // Sanity check for V4 prefixes
@@ -181,9 +323,6 @@ SpfSolver::createRouteForPrefix(
   }
   auto const& allPrefixEntries = search->second;
 
-  // Clear best route selection in prefix state
-  bestRoutesCache_.erase(prefix);
-
   //
   // Create list of prefix-entries from reachable nodes only
   // NOTE: We're copying prefix-entries and it can be expensive. Using
@@ -243,8 +382,8 @@ SpfSolver::createRouteForPrefix(
     return std::nullopt;
   }
 
-  // Set best route selection in prefix state
-  bestRoutesCache_.insert_or_assign(prefix, routeSelectionResult);
+  // Set best route selection for the prefix
+  routeSelectionResultOut = routeSelectionResult;
 
   /*
    * ATTN:
@@ -276,7 +415,7 @@ SpfSolver::createRouteForPrefix(
    *   - Only use the next-hop set if it has the shortest metric;
    *   - Combine shortest metric next-hops from all areas;
    */
-  std::unordered_set<thrift::NextHopThrift> totalNextHops;
+  std::vector<NextHopGroup> areaNextHops;
   Metric shortestMetric = std::numeric_limits<Metric>::max();
   for (const auto& area : areaWithBestRoutes) {
     const auto& linkState = areaLinkStates.find(area);
@@ -287,17 +426,33 @@ SpfSolver::createRouteForPrefix(
     }
 
     auto spfAreaResults = selectBestPathsSpf(
-        myNodeName, prefix, routeSelectionResult, area, linkState->second);
+        myNodeName,
+        prefix,
+        routeSelectionResult,
+        area,
+        linkState->second,
+        spfAreaResultsCache);
 
     // Only use next-hops in areas with the shortest IGP metric
     if (shortestMetric >= spfAreaResults.bestMetric) {
       if (shortestMetric > spfAreaResults.bestMetric) {
         shortestMetric = spfAreaResults.bestMetric;
-        totalNextHops.clear();
+        areaNextHops.clear();
       }
-      totalNextHops.insert(
-          spfAreaResults.nextHops.begin(), spfAreaResults.nextHops.end());
+      areaNextHops.emplace_back(std::move(spfAreaResults.nextHops));
+    }
+  }
+
+  // Share the interned group as is if a single area has the shortest metric
+  NextHopGroup totalNextHops;
+  if (areaNextHops.size() == 1) {
+    totalNextHops = std::move(areaNextHops.front());
+  } else if (areaNextHops.size() > 1) {
+    NextHopGroup::NextHopSet nextHops;
+    for (auto const& group : areaNextHops) {
+      nextHops.insert(group.begin(), group.end());
     }
+    totalNextHops = std::move(nextHops);
   }
 
   return addBestPaths(
@@ -314,7 +469,10 @@ std::optional<DecisionRouteDb>
 SpfSolver::buildRouteDb(
     const std::string& myNodeName,
     std::unordered_map<std::string, LinkState> const& areaLinkStates,
-    PrefixState const& prefixState) {
+    PrefixState const& prefixState,
+    DecisionRouteDb const* prevRouteDb,
+    DecisionRouteUpdate* routeDelta) {
+  CHECK_EQ(prevRouteDb == nullptr, routeDelta == nullptr);
   bool nodeExist{false};
   for (const auto& [_, linkState] : areaLinkStates) {
     nodeExist |= linkState.hasNode(myNodeName);
@@ -327,24 +485,36 @@ SpfSolver::buildRouteDb(
   fb303::fbData->addStatValue("decision.route_build_runs", 1, fb303::COUNT);
 
   DecisionRouteDb routeDb{};
+  std::optional<RouteBuildDelta> delta;
+  if (prevRouteDb) {
+    delta.emplace(RouteBuildDelta{*prevRouteDb, *routeDelta});
+  }
 
   // Clear best route selection cache
   bestRoutesCache_.clear();
 
-  // Create IPv4, IPv6 routes (includes IP -> MPLS routes)
-  for (const auto& [prefix, _] : prefixState.prefixes()) {
-    if (auto maybeRoute = createRouteForPrefix(
-            myNodeName, areaLinkStates, prefixState, prefix)) {
-      routeDb.addUnicastRoute(std::move(maybeRoute).value());
-    }
+  if (routeBuildExecutor_) {
+    computeSpfResults(myNodeName, areaLinkStates);
   }
 
+  // Create IPv4, IPv6 routes (includes IP -> MPLS routes)
+  buildUnicastRoutes(
+      myNodeName,
+      areaLinkStates,
+      prefixState,
+      routeDb,
+      delta.has_value() ? &delta.value() : nullptr);
+
   // Create static unicast routes
   for (auto [prefix, ribUnicastEntry] : staticUnicastRoutes_) {
     if (routeDb.unicastRoutes.count(prefix)) {
       // ignore prefixes as prefixState has higher priority
       continue;
     }
+    if (delta.has_value()) {
+      delta->numVisitedUnicastRoutes += recordUnicastRoute(
+          delta->prevRouteDb, prefix, ribUnicastEntry, delta->update);
+    }
     routeDb.addUnicastRoute(RibUnicastEntry(ribUnicastEntry));
   }
 
@@ -352,95 +522,33 @@ SpfSolver::buildRouteDb(
   // Create MPLS routes for all nodeLabel
   //
   if (enableNodeSegmentLabel_) {
-    std::unordered_map<int32_t, std::pair<std::string, RibMplsEntry>>
-        labelToNode;
-    for (const auto& [area, linkState] : areaLinkStates) {
-      for (const auto& [_, adjDb] : linkState.getAdjacencyDatabases()) {
-        const auto topLabel = *adjDb.nodeLabel();
-        const auto& nodeName = *adjDb.thisNodeName();
-        // Top label is not set => Non-SR mode
-        if (topLabel == 0) {
-          XLOG(INFO) << "Ignoring node label " << topLabel << " of node "
-                     << nodeName << " in area " << area;
-          fb303::fbData->addStatValue(
-              "decision.skipped_mpls_route", 1, fb303::COUNT);
-          continue;
-        }
-        // If mpls label is not valid then ignore it
-        if (not isMplsLabelValid(topLabel)) {
-          XLOG(ERR) << "Ignoring invalid node label " << topLabel << " of node "
-                    << nodeName << " in area " << area;
-          fb303::fbData->addStatValue(
-              "decision.skipped_mpls_route", 1, fb303::COUNT);
-          continue;
-        }
-
-        // There can be a temporary collision in node label allocation.
-        // Usually happens when two segmented networks allocating labels from
-        // the same range join together. In case of such conflict we respect
-        // the node label of bigger node-ID
-        auto iter = labelToNode.find(topLabel);
-        if (iter != labelToNode.end()) {
-          XLOG(INFO) << "Found duplicate label " << topLabel << "from "
-                     << iter->second.first << " " << nodeName << " in area "
-                     << area;
-          fb303::fbData->addStatValue(
-              "decision.duplicate_node_label", 1, fb303::COUNT);
-          if (iter->second.first < nodeName) {
-            continue;
-          }
-        }
-
-        // Install POP_AND_LOOKUP for next layer
-        if (*adjDb.thisNodeName() == myNodeName) {
-          thrift::NextHopThrift nh;
-          nh.address() = toBinaryAddress(folly::IPAddressV6("::"));
-          nh.area() = area;
-          nh.mplsAction() =
-              createMplsAction(thrift::MplsActionCode::POP_AND_LOOKUP);
-          labelToNode.erase(topLabel);
-          labelToNode.emplace(
-              topLabel,
-              std::make_pair(myNodeName, RibMplsEntry(topLabel, {nh})));
-          continue;
-        }
+    buildNodeLabelRoutes(
+        myNodeName,
+        areaLinkStates,
+        routeDb,
+        delta.has_value() ? &delta.value() : nullptr);
+  }
 
-        // Get best nexthop towards the node
-        auto metricNhs = getNextHopsWithMetric(
-            myNodeName, {{adjDb.thisNodeName().value(), area}}, linkState);
-        if (metricNhs.second.empty()) {
-          XLOG(WARNING) << "No route to nodeLabel " << std::to_string(topLabel)
-                        << " of node " << nodeName;
-          fb303::fbData->addStatValue(
-              "decision.no_route_to_label", 1, fb303::COUNT);
-          continue;
+  // Delete routes of the previous route database left over, i.e. neither
+  // built nor found unreachable. These are only left if prefixes were
+  // withdrawn, or node labels disappeared since the previous build.
+  if (delta.has_value()) {
+    auto const& prefixes = prefixState.prefixes();
+    auto const& prevRoutes = delta->prevRouteDb;
+    if (delta->numVisitedUnicastRoutes < prevRoutes.unicastRoutes.size()) {
+      for (auto const& [prefix, _] : prevRoutes.unicastRoutes) {
+        if (not routeDb.unicastRoutes.count(prefix) and
+            not prefixes.count(prefix)) {
+          delta->update.unicastRoutesToDelete.emplace_back(prefix);
         }
-
-        // Create nexthops with appropriate MplsAction (PHP and SWAP). Note
-        // that all nexthops are valid for routing without loops. Fib is
-        // responsible for installing these routes by making sure it programs
-        // least cost nexthops first and of same action type (based on HW
-        // limitations)
-        labelToNode.erase(topLabel);
-        labelToNode.emplace(
-            topLabel,
-            std::make_pair(
-                adjDb.thisNodeName().value(),
-                RibMplsEntry(
-                    topLabel,
-                    getNextHopsThrift(
-                        myNodeName,
-                        {{adjDb.thisNodeName().value(), area}},
-                        false /* isV4 */,
-                        metricNhs,
-                        topLabel,
-                        area,
-                        linkState))));
       }
     }
-
-    for (auto& [_, nodeToEntry] : labelToNode) {
-      routeDb.addMplsRoute(std::move(nodeToEntry.second));
+    if (delta->numVisitedMplsRoutes < prevRoutes.mplsRoutes.size()) {
+      for (auto const& [label, _] : prevRoutes.mplsRoutes) {
+        if (not routeDb.mplsRoutes.count(label)) {
+          delta->update.mplsRoutesToDelete.emplace_back(label);
+        }
+      }
     }
   }
 
@@ -452,12 +560,297 @@ SpfSolver::buildRouteDb(
   return routeDb;
 } // buildRouteDb
 
+void
+SpfSolver::computeSpfResults(
+    const std::string& myNodeName,
+    std::unordered_map<std::string, LinkState> const& areaLinkStates) const {
+  CHECK(routeBuildExecutor_);
+  std::vector<folly::Future<folly::Unit>> areaFutures;
+  areaFutures.reserve(areaLinkStates.size());
+  for (auto const& areaLinkState : areaLinkStates) {
+    auto const* linkState = &areaLinkState.second;
+    areaFutures.emplace_back(
+        folly::via(routeBuildExecutor_.get(), [linkState, &myNodeName]() {
+          linkState->getSpfResult(myNodeName);
+        }));
+  }
+  folly::collect(std::move(areaFutures)).get();
+}
+
+void
+SpfSolver::buildUnicastRoutes(
+    const std::string& myNodeName,
+    std::unordered_map<std::string, LinkState> const& areaLinkStates,
+    PrefixState const& prefixState,
+    DecisionRouteDb& routeDb,
+    RouteBuildDelta* delta) {
+  auto const& prefixes = prefixState.prefixes();
+  const size_t numShards = routeBuildExecutor_
+      ? std::min(
+            routeBuildExecutor_->numThreads(),
+            prefixes.size() / kMinPrefixesPerRouteBuildShard)
+      : 1;
+
+  // Sequential route build
+  if (numShards <= 1) {
+    SpfAreaResultsCache spfAreaResultsCache;
+    for (const auto& [prefix, _] : prefixes) {
+      auto maybeRoute = createRouteForPrefix(
+          myNodeName,
+          areaLinkStates,
+          prefixState,
+          prefix,
+          &spfAreaResultsCache);
+      if (delta) {
+        delta->numVisitedUnicastRoutes += recordUnicastRoute(
+            delta->prevRouteDb, prefix, maybeRoute, delta->update);
+      }
+      if (maybeRoute.has_value()) {
+        routeDb.addUnicastRoute(std::move(maybeRoute).value());
+      }
+    }
+    return;
+  }
+
+  // SPF results of all areas are memoized upfront by `computeSpfResults`, so
+  // shards only perform lookups.
+
+  // Shard prefixes in the iteration order of prefix state. Shard results are
+  // merged in the same order, hence the route database and best route
+  // selection cache are identical to the sequential build.
+  std::vector<folly::CIDRNetwork const*> allPrefixes;
+  allPrefixes.reserve(prefixes.size());
+  for (const auto& [prefix, _] : prefixes) {
+    allPrefixes.emplace_back(&prefix);
+  }
+
+  struct ShardResult {
+    std::vector<RibUnicastEntry> routes;
+    std::vector<std::pair<folly::CIDRNetwork, RouteSelectionResult>>
+        routeSelectionResults;
+    // Changed routes of the shard, if recorded
+    DecisionRouteUpdate update;
+    size_t numVisitedRoutes{0};
+  };
+  std::vector<ShardResult> shardResults(numShards);
+  std::vector<folly::Future<folly::Unit>> shardFutures;
+  shardFutures.reserve(numShards);
+  const size_t shardSize = (allPrefixes.size() + numShards - 1) / numShards;
+  for (size_t shard = 0; shard < numShards; ++shard) {
+    const size_t begin = shard * shardSize;
+    const size_t end = std::min(begin + shardSize, allPrefixes.size());
+    shardFutures.emplace_back(
+        folly::via(routeBuildExecutor_.get(), [&, begin, end, shard]() {
+          auto& result = shardResults.at(shard);
+          // Per shard, as shards run concurrently
+          SpfAreaResultsCache spfAreaResultsCache;
+          for (size_t i = begin; i < end; ++i) {
+            auto const& prefix = *allPrefixes.at(i);
+            std::optional<RouteSelectionResult> routeSelectionResult;
+            auto maybeRoute = computeRouteForPrefix(
+                myNodeName,
+                areaLinkStates,
+                prefixState,
+                prefix,
+                routeSelectionResult,
+                &spfAreaResultsCache);
+            if (routeSelectionResult.has_value()) {
+              result.routeSelectionResults.emplace_back(
+                  prefix, std::move(routeSelectionResult).value());
+            }
+            if (delta) {
+              result.numVisitedRoutes += recordUnicastRoute(
+                  delta->prevRouteDb, prefix, maybeRoute, result.update);
+            }
+            if (maybeRoute.has_value()) {
+              result.routes.emplace_back(std::move(maybeRoute).value());
+            }
+          }
+        }));
+  }
+  // Propagates the exception (if any) of the shards
+  folly::collect(std::move(shardFutures)).get();
+
+  // Merge shard results
+  routeDb.unicastRoutes.reserve(prefixes.size());
+  for (auto& result : shardResults) {
+    for (auto& route : result.routes) {
+      routeDb.addUnicastRoute(std::move(route));
+    }
+    for (auto& [prefix, routeSelectionResult] : result.routeSelectionResults) {
+      bestRoutesCache_.insert_or_assign(
+          prefix, std::move(routeSelectionResult));
+    }
+    if (delta) {
+      delta->update.unicastRoutesToUpdate.merge(
+          result.update.unicastRoutesToUpdate);
+      delta->update.unicastRoutesToDelete.insert(
+          delta->update.unicastRoutesToDelete.end(),
+          result.update.unicastRoutesToDelete.begin(),
+          result.update.unicastRoutesToDelete.end());
+      delta->numVisitedUnicastRoutes += result.numVisitedRoutes;
+    }
+  }
+}
+
+void
+SpfSolver::buildNodeLabelRoutes(
+    const std::string& myNodeName,
+    std::unordered_map<std::string, LinkState> const& areaLinkStates,
+    DecisionRouteDb& routeDb,
+    RouteBuildDelta* delta) const {
+  // Merge in order of areas, so that label conflicts across areas are
+  // resolved the same way regardless of the order of computation
+  std::vector<std::string const*> areas;
+  areas.reserve(areaLinkStates.size());
+  for (auto const& [area, _] : areaLinkStates) {
+    areas.emplace_back(&area);
+  }
+  std::sort(areas.begin(), areas.end(), [](auto const* a, auto const* b) {
+    return *a < *b;
+  });
+
+  // Compute node label routes of every area, in parallel if route build
+  // threads are configured
+  std::vector<std::vector<NodeLabelRoute>> areaRoutes(areas.size());
+  if (routeBuildExecutor_ and areas.size() > 1) {
+    std::vector<folly::Future<folly::Unit>> areaFutures;
+    areaFutures.reserve(areas.size());
+    for (size_t i = 0; i < areas.size(); ++i) {
+      areaFutures.emplace_back(
+          folly::via(routeBuildExecutor_.get(), [&, i]() {
+            areaRoutes.at(i) = getAreaNodeLabelRoutes(
+                myNodeName, *areas.at(i), areaLinkStates.at(*areas.at(i)));
+          }));
+    }
+    folly::collect(std::move(areaFutures)).get();
+  } else {
+    for (size_t i = 0; i < areas.size(); ++i) {
+      areaRoutes.at(i) = getAreaNodeLabelRoutes(
+          myNodeName, *areas.at(i), areaLinkStates.at(*areas.at(i)));
+    }
+  }
+
+  std::unordered_map<int32_t, std::pair<std::string, RibMplsEntry>>
+      labelToNode;
+  for (size_t i = 0; i < areas.size(); ++i) {
+    for (auto& [topLabel, nodeName, route] : areaRoutes.at(i)) {
+      // There can be a temporary collision in node label allocation.
+      // Usually happens when two segmented networks allocating labels from
+      // the same range join together. In case of such conflict we respect
+      // the node label of bigger node-ID
+      auto iter = labelToNode.find(topLabel);
+      if (iter != labelToNode.end()) {
+        XLOG(INFO) << "Found duplicate label " << topLabel << "from "
+                   << iter->second.first << " " << nodeName << " in area "
+                   << *areas.at(i);
+        fb303::fbData->addStatValue(
+            "decision.duplicate_node_label", 1, fb303::COUNT);
+        if (iter->second.first < nodeName) {
+          continue;
+        }
+      }
+      if (not route.has_value()) {
+        continue;
+      }
+      labelToNode.erase(topLabel);
+      labelToNode.emplace(
+          topLabel, std::make_pair(nodeName, std::move(route).value()));
+    }
+  }
+
+  for (auto& [label, nodeToEntry] : labelToNode) {
+    auto& route = nodeToEntry.second;
+    if (delta) {
+      auto const search = delta->prevRouteDb.mplsRoutes.find(label);
+      if (search == delta->prevRouteDb.mplsRoutes.end()) {
+        delta->update.addMplsRouteToUpdate(route);
+      } else {
+        ++delta->numVisitedMplsRoutes;
+        if (search->second != route) {
+          delta->update.addMplsRouteToUpdate(route);
+        }
+      }
+    }
+    routeDb.addMplsRoute(std::move(route));
+  }
+}
+
+std::vector<SpfSolver::NodeLabelRoute>
+SpfSolver::getAreaNodeLabelRoutes(
+    const std::string& myNodeName,
+    const std::string& area,
+    const LinkState& linkState) const {
+  std::vector<NodeLabelRoute> routes;
+  for (const auto& [_, adjDb] : linkState.getAdjacencyDatabases()) {
+    const auto topLabel = *adjDb.nodeLabel();
+    const auto& nodeName = *adjDb.thisNodeName();
+    // Top label is not set => Non-SR mode
+    if (topLabel == 0) {
+      XLOG(INFO) << "Ignoring node label " << topLabel << " of node "
+                 << nodeName << " in area " << area;
+      fb303::fbData->addStatValue(
+          "decision.skipped_mpls_route", 1, fb303::COUNT);
+      continue;
+    }
+    // If mpls label is not valid then ignore it
+    if (not isMplsLabelValid(topLabel)) {
+      XLOG(ERR) << "Ignoring invalid node label " << topLabel << " of node "
+                << nodeName << " in area " << area;
+      fb303::fbData->addStatValue(
+          "decision.skipped_mpls_route", 1, fb303::COUNT);
+      continue;
+    }
+
+    auto& route = routes.emplace_back(NodeLabelRoute{topLabel, nodeName});
+
+    // Install POP_AND_LOOKUP for next layer
+    if (nodeName == myNodeName) {
+      thrift::NextHopThrift nh;
+      nh.address() = toBinaryAddress(folly::IPAddressV6("::"));
+      nh.area() = area;
+      nh.mplsAction() =
+          createMplsAction(thrift::MplsActionCode::POP_AND_LOOKUP);
+      route.route = RibMplsEntry(topLabel, {nh});
+      continue;
+    }
+
+    // Get best nexthop towards the node
+    auto metricNhs =
+        getNextHopsWithMetric(myNodeName, {{nodeName, area}}, linkState);
+    if (metricNhs.second.empty()) {
+      XLOG(WARNING) << "No route to nodeLabel " << std::to_string(topLabel)
+                    << " of node " << nodeName;
+      fb303::fbData->addStatValue(
+          "decision.no_route_to_label", 1, fb303::COUNT);
+      continue;
+    }
+
+    // Create nexthops with appropriate MplsAction (PHP and SWAP). Note
+    // that all nexthops are valid for routing without loops. Fib is
+    // responsible for installing these routes by making sure it programs
+    // least cost nexthops first and of same action type (based on HW
+    // limitations)
+    route.route = RibMplsEntry(
+        topLabel,
+        getNextHopsThrift(
+            myNodeName,
+            {{nodeName, area}},
+            false /* isV4 */,
+            metricNhs,
+            topLabel,
+            area,
+            linkState));
+  }
+  return routes;
+}
+
 RouteSelectionResult
 SpfSolver::selectBestRoutes(
     std::string const& myNodeName,
     folly::CIDRNetwork const& prefix,
     PrefixEntries& prefixEntries,
-    std::unordered_map<std::string, LinkState> const& areaLinkStates) {
+    std::unordered_map<std::string, LinkState> const& areaLinkStates) const {
   CHECK(prefixEntries.size()) << "No prefixes for best route selection";
   RouteSelectionResult ret;
 
@@ -495,7 +888,7 @@ SpfSolver::selectBestRoutes(
 
 std::optional<int64_t>
 SpfSolver::getMinNextHopThreshold(
-    RouteSelectionResult nodes, PrefixEntries const& prefixEntries) {
+    RouteSelectionResult nodes, PrefixEntries const& prefixEntries) const {
   std::optional<int64_t> maxMinNexthopForPrefix = std::nullopt;
   for (const auto& nodeArea : nodes.allNodeAreas) {
     const auto& prefixEntry = prefixEntries.at(nodeArea);
@@ -550,13 +943,38 @@ SpfSolver::isNodeDrained(
       linkState.getNodeMetricIncrement(node) != 0;
 }
 
+size_t
+SpfSolver::SpfAreaResultsKeyHash::operator()(
+    const SpfAreaResultsKey& key) const {
+  auto seed = folly::hash::hash_combine(key.area, key.isV4);
+  for (auto const& [node, area] : key.dstNodeAreas) {
+    seed = folly::hash::hash_combine(seed, node, area);
+  }
+  return seed;
+}
+
 SpfSolver::SpfAreaResults
 SpfSolver::selectBestPathsSpf(
     std::string const& myNodeName,
     folly::CIDRNetwork const& prefix,
     RouteSelectionResult const& routeSelectionResult,
     const std::string& area,
-    const LinkState& linkState) {
+    const LinkState& linkState,
+    SpfAreaResultsCache* spfAreaResultsCache) const {
+  std::optional<SpfAreaResultsKey> key;
+  if (spfAreaResultsCache) {
+    key = SpfAreaResultsKey{
+        area, prefix.first.isV4(), routeSelectionResult.allNodeAreas};
+    auto it = spfAreaResultsCache->find(*key);
+    if (it != spfAreaResultsCache->end()) {
+      if (it->second.bestMetric == std::numeric_limits<Metric>::max()) {
+        fb303::fbData->addStatValue(
+            "decision.no_route_to_prefix", 1, fb303::COUNT);
+      }
+      return it->second;
+    }
+  }
+
   /*
    * [Next hop Calculation]
    *
@@ -577,18 +995,20 @@ SpfSolver::selectBestPathsSpf(
     XLOG(DBG3) << "No route to prefix "
                << folly::IPAddress::networkToString(prefix);
     fb303::fbData->addStatValue("decision.no_route_to_prefix", 1, fb303::COUNT);
-    return result;
+  } else {
+    result.nextHops = getNextHopsThrift(
+        myNodeName,
+        routeSelectionResult.allNodeAreas,
+        prefix.first.isV4(), /* isV4Prefix */
+        nextHopsWithMetric,
+        std::nullopt /* swapLabel */,
+        area,
+        linkState);
   }
 
-  result.nextHops = getNextHopsThrift(
-      myNodeName,
-      routeSelectionResult.allNodeAreas,
-      prefix.first.isV4(), /* isV4Prefix */
-      nextHopsWithMetric,
-      std::nullopt /* swapLabel */,
-      area,
-      linkState);
-
+  if (key.has_value()) {
+    spfAreaResultsCache->emplace(std::move(key).value(), result);
+  }
   return result;
 }
 
@@ -598,9 +1018,9 @@ SpfSolver::addBestPaths(
     const folly::CIDRNetwork& prefix,
     const RouteSelectionResult& routeSelectionResult,
     const PrefixEntries& prefixEntries,
-    std::unordered_set<thrift::NextHopThrift>&& nextHops,
+    NextHopGroup nextHops,
     const Metric shortestMetric,
-    const bool localPrefixConsidered) {
+    const bool localPrefixConsidered) const {
   // Check if next-hop list is empty
   if (nextHops.empty()) {
     return std::nullopt;
@@ -627,7 +1047,7 @@ SpfSolver::addBestPaths(
   }
 
   // Create RibUnicastEntry and add it the list
-  return RibUnicastEntry(
+  RibUnicastEntry route(
       prefix,
       std::move(nextHops),
       std::move(entry),
@@ -636,6 +1056,9 @@ SpfSolver::addBestPaths(
       shortestMetric,
       std::nullopt, /* ucmp weight */
       localPrefixConsidered);
+  route.bestPrefixEntrySource =
+      prefixEntries.at(routeSelectionResult.bestNodeArea);
+  return route;
 }
 
 /*
@@ -649,7 +1072,7 @@ BestNextHopMetrics
 SpfSolver::getNextHopsWithMetric(
     const std::string& myNodeName,
     const std::set<NodeAndArea>& dstNodeAreas,
-    const LinkState& linkState) {
+    const LinkState& linkState) const {
   // build up next hop nodes that are along a shortest path to the prefix
   std::unordered_map<
       std::string /* nextHopNodeName */,
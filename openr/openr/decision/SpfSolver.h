@@ -8,9 +8,14 @@
 #pragma once
 
 #include <chrono>
+#include <optional>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
 
 #include <openr/decision/LinkState.h>
 #include <openr/decision/PrefixState.h>
@@ -71,14 +76,29 @@ class DecisionRouteDb {
       unicastRoutes;
   std::unordered_map<int32_t /* label */, RibMplsEntry> mplsRoutes;
 
-  // calculate the delta between this and newDb. Note, this method is const;
-  // We are not actually updating here. We may mutate the DecisionRouteUpdate in
-  // some way before calling update with it
-  DecisionRouteUpdate calculateUpdate(DecisionRouteDb&& newDb) const;
+  // calculate the delta between this and newDb with full comparison of routes.
+  // Note, this method is const; We are not actually updating here. We may
+  // mutate the DecisionRouteUpdate in some way before calling update with it
+  DecisionRouteUpdate calculateFullUpdate(DecisionRouteDb const& newDb) const;
+
+  // verify delta recorded by the route build of newDb against
+  // `calculateFullUpdate`. Mismatches are logged and counted, and the full
+  // delta is returned instead.
+  DecisionRouteUpdate verifyUpdate(
+      DecisionRouteDb const& newDb, DecisionRouteUpdate&& delta) const;
 
   // update the state of this with the DecisionRouteUpdate passed
   void update(DecisionRouteUpdate const& update);
 
+  // Version of the `thrift::RouteDatabaseSnapshot` format. Bump it on changes
+  // that make older snapshots unusable for warm-start.
+  static constexpr int32_t kSnapshotVersion{1};
+
+  // Convert to/from snapshot persisted across restarts for warm-start
+  thrift::RouteDatabaseSnapshot toSnapshot(const std::string& nodeName) const;
+  static DecisionRouteDb fromSnapshot(
+      thrift::RouteDatabaseSnapshot const& snapshot);
+
   thrift::RouteDatabase
   toThrift() const {
     thrift::RouteDatabase tRouteDb;
@@ -118,7 +138,8 @@ class SpfSolver {
       bool enableV4,
       bool enableNodeSegmentLabel,
       bool enableBestRouteSelection = false,
-      bool v4OverV6Nexthop = false);
+      bool v4OverV6Nexthop = false,
+      size_t routeBuildThreads = 1);
   ~SpfSolver();
 
   //
@@ -133,10 +154,16 @@ class SpfSolver {
   // Build route database using given prefix and link states for a given
   // router, myNodeName
   // Returns std::nullopt if myNodeName doesn't have any prefix database
+  //
+  // If `prevRouteDb` and `routeDelta` are provided, routes added, changed or
+  // removed relative to `prevRouteDb` are recorded into `routeDelta` while
+  // routes are built.
   std::optional<DecisionRouteDb> buildRouteDb(
       const std::string& myNodeName,
       std::unordered_map<std::string, LinkState> const& areaLinkStates,
-      PrefixState const& prefixState);
+      PrefixState const& prefixState,
+      DecisionRouteDb const* prevRouteDb = nullptr,
+      DecisionRouteUpdate* routeDelta = nullptr);
 
   std::optional<RibUnicastEntry> createRouteForPrefixOrGetStaticRoute(
       const std::string& myNodeName,
@@ -162,9 +189,34 @@ class SpfSolver {
     // metric of the shortest path within the area
     LinkStateMetric bestMetric{0};
     // selected next-hops within the area
-    std::unordered_set<thrift::NextHopThrift> nextHops;
+    NextHopGroup nextHops;
+  };
+
+  /*
+   * Next-hops within an area depend only on the selected nodes and the SPF
+   * result of the area, not on the prefix. Within a route build, they are
+   * computed once per set of selected nodes. All prefixes announced by the
+   * same nodes then share the same interned next-hop group.
+   */
+  struct SpfAreaResultsKey {
+    std::string area;
+    bool isV4{false};
+    std::set<NodeAndArea> dstNodeAreas;
+
+    bool
+    operator==(const SpfAreaResultsKey& other) const {
+      return area == other.area && isV4 == other.isV4 &&
+          dstNodeAreas == other.dstNodeAreas;
+    }
+  };
+
+  struct SpfAreaResultsKeyHash {
+    size_t operator()(const SpfAreaResultsKey& key) const;
   };
 
+  using SpfAreaResultsCache = std::
+      unordered_map<SpfAreaResultsKey, SpfAreaResults, SpfAreaResultsKeyHash>;
+
   /*
    * [Route Selection]:
    *
@@ -181,7 +233,7 @@ class SpfSolver {
       std::string const& myNodeName,
       folly::CIDRNetwork const& prefix,
       PrefixEntries& prefixEntries,
-      std::unordered_map<std::string, LinkState> const& areaLinkStates);
+      std::unordered_map<std::string, LinkState> const& areaLinkStates) const;
 
   /*
    * [Route Calculation]: shortest path forwarding
@@ -195,26 +247,103 @@ class SpfSolver {
       folly::CIDRNetwork const& prefix,
       RouteSelectionResult const& routeSelectionResult,
       const std::string& area,
-      const LinkState& linkState);
+      const LinkState& linkState,
+      SpfAreaResultsCache* spfAreaResultsCache = nullptr) const;
 
   std::optional<RibUnicastEntry> addBestPaths(
       const std::string& myNodeName,
       const folly::CIDRNetwork& prefix,
       const RouteSelectionResult& routeSelectionResult,
       const PrefixEntries& prefixEntries,
-      std::unordered_set<thrift::NextHopThrift>&& nextHops,
+      NextHopGroup nextHops,
       const openr::LinkStateMetric shortestMetric,
-      const bool localPrefixConsidered);
+      const bool localPrefixConsidered) const;
 
   std::optional<RibUnicastEntry> createRouteForPrefix(
       const std::string& myNodeName,
       std::unordered_map<std::string, LinkState> const& areaLinkStates,
       PrefixState const& prefixState,
-      folly::CIDRNetwork const& prefix);
+      folly::CIDRNetwork const& prefix,
+      SpfAreaResultsCache* spfAreaResultsCache = nullptr);
+
+  /*
+   * Compute route for the prefix without touching `bestRoutesCache_`. Best
+   * route selection result is returned via `routeSelectionResult` if the
+   * prefix has reachable announcements. Per area next-hops are looked up in
+   * and added to `spfAreaResultsCache` if provided.
+   *
+   * ATTN: This is safe to be called concurrently for different prefixes as
+   * long as SPF results of `myNodeName` are already memoized in
+   * `areaLinkStates` (see `buildRouteDb`), and callers don't share caches.
+   */
+  std::optional<RibUnicastEntry> computeRouteForPrefix(
+      const std::string& myNodeName,
+      std::unordered_map<std::string, LinkState> const& areaLinkStates,
+      PrefixState const& prefixState,
+      folly::CIDRNetwork const& prefix,
+      std::optional<RouteSelectionResult>& routeSelectionResult,
+      SpfAreaResultsCache* spfAreaResultsCache = nullptr) const;
+
+  /*
+   * Node label route towards a node of an area. Route is not set if the node
+   * is not reachable.
+   */
+  struct NodeLabelRoute {
+    int32_t label{0};
+    std::string nodeName;
+    std::optional<RibMplsEntry> route;
+  };
+
+  /*
+   * Run SPF from `myNodeName` in every area, concurrently across route build
+   * threads. Areas are independent until best route selection across them.
+   *
+   * ATTN: LinkState memoizes SPF results lazily and is not thread-safe. Route
+   * build across threads must only look up the results memoized here.
+   */
+  void computeSpfResults(
+      const std::string& myNodeName,
+      std::unordered_map<std::string, LinkState> const& areaLinkStates) const;
+
+  /*
+   * Routes changed by a route build relative to the previous route database.
+   * Routes of the previous database visited by the build, i.e. built again or
+   * found unreachable, are counted. The previous database is only searched
+   * for left over routes to delete if not all of its routes were visited.
+   */
+  struct RouteBuildDelta {
+    DecisionRouteDb const& prevRouteDb;
+    DecisionRouteUpdate& update;
+    size_t numVisitedUnicastRoutes{0};
+    size_t numVisitedMplsRoutes{0};
+  };
+
+  // Build unicast routes for all prefixes of `prefixState` into `routeDb`.
+  // Changed routes are recorded into `delta` if provided.
+  void buildUnicastRoutes(
+      const std::string& myNodeName,
+      std::unordered_map<std::string, LinkState> const& areaLinkStates,
+      PrefixState const& prefixState,
+      DecisionRouteDb& routeDb,
+      RouteBuildDelta* delta = nullptr);
+
+  // Build MPLS routes for node labels of all areas into `routeDb`. Changed
+  // routes are recorded into `delta` if provided.
+  void buildNodeLabelRoutes(
+      const std::string& myNodeName,
+      std::unordered_map<std::string, LinkState> const& areaLinkStates,
+      DecisionRouteDb& routeDb,
+      RouteBuildDelta* delta = nullptr) const;
+
+  // Node label routes towards nodes of the area, in order of nodes
+  std::vector<NodeLabelRoute> getAreaNodeLabelRoutes(
+      const std::string& myNodeName,
+      const std::string& area,
+      const LinkState& linkState) const;
 
   // helper to get min nexthop for a prefix, used in selectKsp2
   std::optional<int64_t> getMinNextHopThreshold(
-      RouteSelectionResult nodes, PrefixEntries const& prefixEntries);
+      RouteSelectionResult nodes, PrefixEntries const& prefixEntries) const;
 
   // [hard-drain]
   PrefixEntries filterHardDrainedNodes(
@@ -235,7 +364,7 @@ class SpfSolver {
   BestNextHopMetrics getNextHopsWithMetric(
       const std::string& srcNodeName,
       const std::set<NodeAndArea>& dstNodeAreas,
-      const LinkState& linkState);
+      const LinkState& linkState) const;
 
   // This function converts best nexthop nodes to best nexthop adjacencies
   // which can then be passed to FIB for programming. It considers and
@@ -274,5 +403,10 @@ class SpfSolver {
   // prefixes with v6 nexthops to Fib module for programming. Else it will just
   // use v4 over v4 nexthop.
   const bool v4OverV6Nexthop_{false};
+
+  // Executor for running SPF of areas and building routes of prefix shards
+  // and areas in parallel. Not set if routes are built sequentially
+  // (route_build_threads = 1).
+  std::unique_ptr<folly::CPUThreadPoolExecutor> routeBuildExecutor_;
 };
 } // namespace openr
@@ -46,6 +46,20 @@ BENCHMARK_COUNTERS_PARAM(BM_DecisionGridAdjUpdates, counters, 1000, SP_ECMP, 1);
 BENCHMARK_COUNTERS_PARAM(
     BM_DecisionGridAdjUpdates, counters, 10000, SP_ECMP, 1);
 
+/*
+ * BM_DecisionGridPublicationBurst:
+ * @first param - integer: num of nodes in a grid topology
+ * @second param - integer: num of publications per burst
+ *
+ * Measures convergence time under bursts of publications of the same key.
+ */
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_DecisionGridPublicationBurst, counters, 100_100, 100, 100);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_DecisionGridPublicationBurst, counters, 1000_100, 1000, 100);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_DecisionGridPublicationBurst, counters, 1000_1000, 1000, 1000);
+
 /*
  * BM_DecisionGridPrefixUpdates:
  * @first param - integer: num of nodes in a grid topology
@@ -381,6 +395,99 @@ BENCHMARK_COUNTERS_PARAM3(
     100,
     100,
     SP_ECMP);
+
+//
+// Route build time with 1/2/4/8 route build threads. Grid of 100 nodes.
+//
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SpfSolverBuildRouteDb, counters, 100_100k_1, 100, 100000, 1);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SpfSolverBuildRouteDb, counters, 100_100k_2, 100, 100000, 2);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SpfSolverBuildRouteDb, counters, 100_100k_4, 100, 100000, 4);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SpfSolverBuildRouteDb, counters, 100_100k_8, 100, 100000, 8);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SpfSolverBuildRouteDb, counters, 100_1M_1, 100, 1000000, 1);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SpfSolverBuildRouteDb, counters, 100_1M_2, 100, 1000000, 2);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SpfSolverBuildRouteDb, counters, 100_1M_4, 100, 1000000, 4);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SpfSolverBuildRouteDb, counters, 100_1M_8, 100, 1000000, 8);
+
+//
+// Route build time with prefixes announced by 1/4/16 nodes of a grid of 1k
+// nodes (anycast).
+//
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SpfSolverBuildRouteDbAnycast, counters, 1k_500k_1, 1000, 500000, 1);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SpfSolverBuildRouteDbAnycast, counters, 1k_500k_4, 1000, 500000, 4);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SpfSolverBuildRouteDbAnycast, counters, 1k_500k_16, 1000, 500000, 16);
+
+//
+// Route build time with 1/4/8 route build threads. 8 areas of 2k nodes.
+//
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SpfSolverBuildRouteDbMultiArea,
+    counters,
+    8_2k_100k_1,
+    8,
+    2000,
+    100000,
+    1);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SpfSolverBuildRouteDbMultiArea,
+    counters,
+    8_2k_100k_4,
+    8,
+    2000,
+    100000,
+    4);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SpfSolverBuildRouteDbMultiArea,
+    counters,
+    8_2k_100k_8,
+    8,
+    2000,
+    100000,
+    8);
+
+//
+// Second edge-disjoint paths towards every node of a grid of 1k/10k nodes,
+// with cache fitting all results, or a small fraction of them.
+//
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_LinkStateKthPaths, counters, 1k_2_10k, 1000, 2, 10000);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_LinkStateKthPaths, counters, 1k_2_100, 1000, 2, 100);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_LinkStateKthPaths, counters, 10k_2_100k, 10000, 2, 100000);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_LinkStateKthPaths, counters, 10k_2_1k, 10000, 2, 1000);
+
+//
+// Memory footprint of routes sharing few ECMP groups (Clos fabric).
+//
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_RibUnicastEntryMemory, counters, 100k_32_16, 100000, 32, 16);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_RibUnicastEntryMemory, counters, 500k_32_16, 500000, 32, 16);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_RibUnicastEntryMemory, counters, 500k_32_64, 500000, 32, 64);
+
+//
+// Route build of 100k prefixes with 100/10k changed prefixes, recording route
+// delta, with and without verification against full comparison of routes.
+//
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SpfSolverBuildRouteDelta, counters, 100k_100, 100000, 100, false);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SpfSolverBuildRouteDelta, counters, 100k_10k, 100000, 10000, false);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_SpfSolverBuildRouteDelta, counters, 100k_100_verify, 100000, 100, true);
 } // namespace openr
 
 int
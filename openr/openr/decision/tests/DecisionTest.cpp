@@ -8,6 +8,7 @@
 #include <cstdio>
 
 #include <fb303/ServiceData.h>
+#include <folly/FileUtil.h>
 #include <folly/IPAddress.h>
 #include <folly/IPAddressV4.h>
 #include <folly/IPAddressV6.h>
@@ -1764,6 +1765,133 @@ TEST_F(DecisionTestFixture, SaveReadStaleRibPolicy) {
   decisionThread->join();
 }
 
+/**
+ * Test warm-start of Decision from persisted route snapshot.
+ *
+ * Test covers
+ * - Compute initial routes and wait for route snapshot to be saved
+ * - Create a new Decision instance which publishes routes of the snapshot
+ *   ahead of initial route computation
+ * - Setup topology with an additional prefix to trigger route computation
+ * - Verify that only the difference to the snapshot routes is published
+ */
+class DecisionWarmStartTestFixture : public DecisionTestFixture {
+ protected:
+  void
+  SetUp() override {
+    // Override default route snapshot file with file based on thread id.
+    FLAGS_route_snapshot_file = fmt::format(
+        "/dev/shm/openr_route_snapshot.bin.{}",
+        std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    remove(FLAGS_route_snapshot_file.c_str());
+
+    DecisionTestFixture::SetUp();
+  }
+
+  void
+  TearDown() override {
+    DecisionTestFixture::TearDown();
+    remove(FLAGS_route_snapshot_file.c_str());
+  }
+
+  openr::thrift::OpenrConfig
+  createConfig() override {
+    auto tConfig = DecisionTestFixture::createConfig();
+    tConfig.decision_config()->enable_warm_start() = true;
+    return tConfig;
+  }
+};
+
+TEST_F(DecisionWarmStartTestFixture, WarmStartFromRouteSnapshot) {
+  // Compute initial routes. No snapshot exists, hence no warm-start.
+  sendKvPublication(createThriftPublication(
+      {{"adj:1", createAdjValue(serializer, "1", 1, {adj12}, false, 1)},
+       {"adj:2", createAdjValue(serializer, "2", 1, {adj21}, false, 2)},
+       {"prefix:1", createPrefixValue("1", 1, {addr1})},
+       {"prefix:2", createPrefixValue("2", 1, {addr2})}},
+      {},
+      {},
+      {}));
+  auto initialUpdate = recvRouteUpdates();
+  EXPECT_FALSE(initialUpdate.warmStart);
+  ASSERT_EQ(1, initialUpdate.unicastRoutesToUpdate.size());
+
+  // Wait for route snapshot to be saved. File is written atomically.
+  std::string snapshotStr;
+  while (not folly::readFile(FLAGS_route_snapshot_file.c_str(), snapshotStr)) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+
+  // Restart Decision
+  messaging::ReplicateQueue<PeerEvent> peerUpdatesQueue;
+  messaging::ReplicateQueue<KvStorePublication> kvStoreUpdatesQueue;
+  messaging::ReplicateQueue<DecisionRouteUpdate> staticRouteUpdatesQueue;
+  messaging::ReplicateQueue<DecisionRouteUpdate> routeUpdatesQueue;
+  auto routeUpdatesQueueReader = routeUpdatesQueue.getReader();
+  auto decision = std::make_unique<Decision>(
+      config,
+      peerUpdatesQueue.getReader(),
+      kvStoreUpdatesQueue.getReader(),
+      staticRouteUpdatesQueue.getReader(),
+      routeUpdatesQueue);
+  auto decisionThread =
+      std::make_unique<std::thread>([&]() { decision->run(); });
+  decision->waitUntilRunning();
+
+  // Expect routes of snapshot ahead of initial route computation
+  {
+    auto maybeRouteDb = routeUpdatesQueueReader.get();
+    ASSERT_FALSE(maybeRouteDb.hasError());
+    auto update = maybeRouteDb.value();
+    EXPECT_TRUE(update.warmStart);
+    EXPECT_EQ(DecisionRouteUpdate::FULL_SYNC, update.type);
+    EXPECT_EQ(
+        initialUpdate.unicastRoutesToUpdate, update.unicastRoutesToUpdate);
+    EXPECT_EQ(initialUpdate.mplsRoutesToUpdate, update.mplsRoutesToUpdate);
+    EXPECT_EQ(
+        update.unicastRoutesToUpdate.size() + update.mplsRoutesToUpdate.size(),
+        fb303::fbData->getCounters()["decision.warm_start.routes"]);
+  }
+
+  // Publish initial peers, topology and prefixes. Node2 advertises an
+  // additional prefix.
+  thrift::PeersMap peers;
+  peers.emplace("2", thrift::PeerSpec());
+  peerUpdatesQueue.push(
+      PeerEvent{{kTestingAreaName, AreaPeerEvent(peers, {} /*peersToDel*/)}});
+  kvStoreUpdatesQueue.push(createThriftPublication(
+      {{"adj:1", createAdjValue(serializer, "1", 1, {adj12}, false, 1)},
+       {"adj:2", createAdjValue(serializer, "2", 1, {adj21}, false, 2)},
+       {"prefix:1", createPrefixValue("1", 1, {addr1})},
+       {"prefix:2", createPrefixValue("2", 1, {addr2, addr3})}},
+      {},
+      {},
+      {}));
+  kvStoreUpdatesQueue.push(thrift::InitializationEvent::KVSTORE_SYNCED);
+
+  // Expect only the difference to snapshot routes
+  {
+    auto maybeRouteDb = routeUpdatesQueueReader.get();
+    ASSERT_FALSE(maybeRouteDb.hasError());
+    auto update = maybeRouteDb.value();
+    EXPECT_FALSE(update.warmStart);
+    ASSERT_EQ(1, update.unicastRoutesToUpdate.size());
+    EXPECT_EQ(1, update.unicastRoutesToUpdate.count(toIPNetwork(addr3)));
+    EXPECT_EQ(0, update.unicastRoutesToDelete.size());
+    EXPECT_EQ(0, update.mplsRoutesToUpdate.size());
+    EXPECT_EQ(0, update.mplsRoutesToDelete.size());
+    EXPECT_EQ(
+        1, fb303::fbData->getCounters()["decision.warm_start.stale_routes"]);
+  }
+
+  kvStoreUpdatesQueue.close();
+  staticRouteUpdatesQueue.close();
+  routeUpdatesQueue.close();
+  peerUpdatesQueue.close();
+  decision->stop();
+  decisionThread->join();
+}
+
 // The following topology is used:
 //
 //         100
@@ -2770,6 +2898,120 @@ TEST_F(InitialRibBuildTestFixture, PrefixWithVipRoutes) {
   evb.run();
 }
 
+/**
+ * Test fixture for testing batched intake of KvStore publications. Peers are
+ * published by the test case, hence publications queued before are drained as
+ * one batch.
+ */
+class PublicationBatchTestFixture : public DecisionTestFixture {
+  void
+  publishInitialPeers() override {
+    // Do not publish peers information. Test case below will handle that.
+  }
+};
+
+/*
+ * Verify that publications queued meanwhile are coalesced by key,
+ * - latest update of a key is applied
+ * - stale version of a key is ignored
+ * - key expired after an update is deleted
+ */
+TEST_F(PublicationBatchTestFixture, CoalescePublications) {
+  const auto [prefixKey1, prefixValue1] = createPrefixKeyValue("2", 1, addr1);
+  kvStoreUpdatesQueue.push(createThriftPublication(
+      {{"adj:1", createAdjValue(serializer, "1", 1, {adj12}, false, 1)},
+       {"adj:2", createAdjValue(serializer, "2", 1, {adj21}, false, 2)},
+       {prefixKey1, prefixValue1}},
+      {},
+      {},
+      {}));
+  kvStoreUpdatesQueue.push(createThriftPublication(
+      {{"adj:2", createAdjValue(serializer, "2", 2, {adj21}, false, 2)},
+       createPrefixKeyValue("2", 1, addr2)},
+      {},
+      {},
+      {}));
+  // Stale adjacency of node 2 would disconnect it
+  kvStoreUpdatesQueue.push(createThriftPublication(
+      {{"adj:2", createAdjValue(serializer, "2", 1, {}, false, 2)}},
+      {prefixKey1},
+      {},
+      {}));
+  kvStoreUpdatesQueue.push(thrift::InitializationEvent::KVSTORE_SYNCED);
+
+  // Unblock processing of publications
+  thrift::PeersMap peers;
+  peers.emplace("2", thrift::PeerSpec());
+  PeerEvent peerEvent{
+      {kTestingAreaName, AreaPeerEvent(peers, {} /*peersToDel*/)}};
+  peerUpdatesQueue.push(std::move(peerEvent));
+
+  // Initial routes only have route of addr2
+  auto routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.size());
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.count(toIPNetwork(addr2)));
+  EXPECT_EQ(2, routeDbDelta.mplsRoutesToUpdate.size());
+
+  auto counters = fb303::fbData->getCounters();
+  EXPECT_EQ(2, counters.at("decision.publications_coalesced.sum"));
+  // adj:2 twice, prefix key of addr1 once
+  EXPECT_EQ(3, counters.at("decision.keys_deduplicated.sum"));
+}
+
+/**
+ * Test fixture for testing route computation scheduled with SPF back-off.
+ * Time to learn and hold-down are long enough not to expire during the test.
+ */
+class DecisionSpfBackoffTestFixture : public DecisionTestFixture {
+ protected:
+  openr::thrift::OpenrConfig
+  createConfig() override {
+    auto tConfig = DecisionTestFixture::createConfig();
+    thrift::SpfBackoffConfig backoffConfig;
+    backoffConfig.initial_delay_ms() = 10;
+    backoffConfig.short_delay_ms() = 50;
+    backoffConfig.long_delay_ms() = 200;
+    backoffConfig.time_to_learn_ms() = 10000;
+    backoffConfig.hold_down_ms() = 20000;
+    tConfig.decision_config()->spf_backoff_config() = std::move(backoffConfig);
+    return tConfig;
+  }
+};
+
+/*
+ * Verify that route updates after the initial route computation are computed
+ * by SPF back-off, which moves out of QUIET on the first topology change.
+ */
+TEST_F(DecisionSpfBackoffTestFixture, RebuildRoutes) {
+  sendKvPublication(createThriftPublication(
+      {{"adj:1", createAdjValue(serializer, "1", 1, {adj12}, false, 1)},
+       {"adj:2", createAdjValue(serializer, "2", 1, {adj21}, false, 2)},
+       createPrefixKeyValue("1", 1, addr1),
+       createPrefixKeyValue("2", 1, addr2)},
+      {},
+      {},
+      {}));
+  auto routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.size());
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.count(toIPNetwork(addr2)));
+
+  // New prefix of node 2 is computed by SPF back-off
+  sendKvPublication(createThriftPublication(
+      {createPrefixKeyValue("2", 1, addr3)}, {}, {}, {}));
+  routeDbDelta = recvRouteUpdates();
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.size());
+  EXPECT_EQ(1, routeDbDelta.unicastRoutesToUpdate.count(toIPNetwork(addr3)));
+
+  auto counters = fb303::fbData->getCounters();
+  EXPECT_LE(1, counters.at("decision.spf_backoff.events.count"));
+  EXPECT_LE(1, counters.at("decision.spf_backoff.runs.count"));
+  EXPECT_EQ(1, counters.at("decision.spf_backoff.short_wait.count"));
+  EXPECT_EQ(0, counters.at("decision.spf_backoff.long_wait.count"));
+  EXPECT_EQ(
+      static_cast<int>(SpfBackoff::State::SHORT_WAIT),
+      counters.at("decision.spf_backoff.state"));
+}
+
 /**
  * Test fixture for testing Decision module with V4 over V6 nexthop feature.
  */
@@ -305,6 +305,50 @@ TEST(LinkStateTest, getKthPaths) {
   }
 }
 
+/**
+ * Verify that k-th paths memoized in a bounded cache are evicted in LRU order
+ * and recomputed identically.
+ */
+TEST(LinkStateTest, getKthPathsBoundedCache) {
+  // ring of 6 nodes, metric is hop count
+  auto ring = openr::getLinkState({
+      {1, {2, 6}},
+      {2, {1, 3}},
+      {3, {2, 4}},
+      {4, {3, 5}},
+      {5, {4, 6}},
+      {6, {5, 1}},
+  });
+  openr::LinkState linkState(
+      kTestingAreaName, kTestingNodeName, 2 /* kthPathsCacheSize */);
+  for (auto const& [_, adjDb] : ring.getAdjacencyDatabases()) {
+    linkState.updateAdjacencyDatabase(adjDb, kTestingAreaName);
+  }
+
+  // {dest, k} -> sizes of paths
+  const std::vector<std::tuple<std::string, size_t, std::vector<size_t>>>
+      expected = {
+          {"2", 1, {1}},
+          {"2", 2, {5}},
+          {"3", 1, {2}},
+          {"3", 2, {4}},
+          {"4", 1, {3, 3}},
+          {"4", 2, {}},
+      };
+  for (int round = 0; round < 2; ++round) {
+    for (auto const& [dest, k, sizes] : expected) {
+      auto paths = linkState.getKthPaths("1", dest, k);
+      std::vector<size_t> pathSizes;
+      for (auto const& path : paths) {
+        pathSizes.push_back(path.size());
+      }
+      EXPECT_EQ(sizes, pathSizes) << dest << " " << k;
+      EXPECT_GE(2, linkState.getKthPathsCacheSize());
+    }
+  }
+  EXPECT_EQ(2, linkState.getKthPathsCacheSize());
+}
+
 int
 main(int argc, char* argv[]) {
   // Parse command line flags
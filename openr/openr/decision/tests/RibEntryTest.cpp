@@ -5,6 +5,10 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <array>
+#include <atomic>
+#include <thread>
+
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
@@ -93,6 +97,81 @@ TEST(RibEntryTest, RibMplsEntry_filterNexthopsToUniqueAction) {
       std::unordered_set<thrift::NextHopThrift>({path1_3_1_php}));
 }
 
+TEST(RibEntryTest, NextHopGroupInterning) {
+  const auto numGroups = NextHopGroup::getNumInternedGroups();
+  {
+    // Same set of next-hops share single group regardless of insertion order
+    NextHopGroup group1({path1_2_1_swap, path1_3_1_swap});
+    NextHopGroup group2(std::unordered_set<thrift::NextHopThrift>(
+        {path1_3_1_swap, path1_2_1_swap}));
+    EXPECT_EQ(group1, group2);
+    EXPECT_EQ(&group1.get(), &group2.get());
+    EXPECT_EQ(group1.hash(), group2.hash());
+    EXPECT_EQ(numGroups + 1, NextHopGroup::getNumInternedGroups());
+
+    // Routes referencing the same group compare equal
+    RibUnicastEntry entry1(
+        folly::IPAddress::createNetwork("fc00::/64"), group1);
+    RibUnicastEntry entry2(
+        folly::IPAddress::createNetwork("fc00::/64"),
+        {path1_3_1_swap, path1_2_1_swap});
+    EXPECT_EQ(entry1, entry2);
+
+    // Copy-on-write modification doesn't affect other references
+    entry2.nexthops.emplace(path1_2_2_swap);
+    EXPECT_NE(entry1, entry2);
+    EXPECT_EQ(2, entry1.nexthops.size());
+    EXPECT_EQ(3, entry2.nexthops.size());
+    EXPECT_EQ(numGroups + 2, NextHopGroup::getNumInternedGroups());
+
+    entry2.nexthops.erase(path1_2_2_swap);
+    EXPECT_EQ(entry1, entry2);
+
+    // Empty group is not interned
+    EXPECT_TRUE(NextHopGroup().empty());
+    EXPECT_EQ(NextHopGroup(), NextHopGroup({}));
+  }
+
+  // Released groups are removed from interning table
+  EXPECT_EQ(numGroups, NextHopGroup::getNumInternedGroups());
+}
+
+TEST(RibEntryTest, NextHopGroupConcurrentInterning) {
+  const auto numGroups = NextHopGroup::getNumInternedGroups();
+  constexpr size_t kNumThreads = 8;
+  constexpr size_t kNumIterations = 1000;
+
+  // Threads concurrently intern and release the same sets of next-hops
+  std::array<std::atomic<const NextHopGroup::NextHopSet*>, kNumThreads>
+      sharedSets{};
+  std::atomic<size_t> numInterned{0};
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&, i]() {
+      std::optional<NextHopGroup> group;
+      for (size_t j = 0; j < kNumIterations; ++j) {
+        group = NextHopGroup({path1_2_1_swap, path1_3_1_swap});
+        NextHopGroup other({path1_2_2_swap, path1_3_1_swap});
+        EXPECT_NE(*group, other);
+      }
+      sharedSets.at(i) = &group->get();
+      ++numInterned;
+
+      // Hold the group until all threads have interned it
+      while (numInterned.load() < kNumThreads) {
+        std::this_thread::yield();
+      }
+      EXPECT_EQ(&group->get(), sharedSets.at(0).load());
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // Released groups are removed from interning table
+  EXPECT_EQ(numGroups, NextHopGroup::getNumInternedGroups());
+}
+
 } // namespace openr
 
 int
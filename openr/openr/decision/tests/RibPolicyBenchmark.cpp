@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <openr/common/LsdbUtil.h>
+#include <openr/decision/RibPolicy.h>
+
+namespace {
+// Number of /64 routes covered by a single /32 prefix range statement
+const size_t kRoutesPerRange = 64;
+// Number of routes updated for incremental policy application
+const size_t kNumUpdatedRoutes = 1000;
+} // namespace
+
+namespace openr {
+
+/**
+ * Create `numStatements` statements. Even statements select routes by /32
+ * prefix range, odd statements select routes by tag.
+ */
+thrift::RibPolicy
+createRibPolicy(size_t numStatements) {
+  thrift::RibPolicy policy;
+  policy.ttl_secs() = 3600;
+  for (size_t i = 0; i < numStatements; ++i) {
+    thrift::RibPolicyStatement stmt;
+    stmt.name() = fmt::format("stmt-{}", i);
+    if (i % 2 == 0) {
+      thrift::RibRoutePrefixRange range;
+      range.prefix() = toIpPrefix(fmt::format("fc00:{:x}::/32", i));
+      range.le() = 64;
+      stmt.matcher()->prefix_ranges() =
+          std::vector<thrift::RibRoutePrefixRange>({range});
+    } else {
+      stmt.matcher()->tags() =
+          std::vector<std::string>({fmt::format("TAG:{}", i)});
+    }
+    stmt.action()->set_weight() = thrift::RibRouteActionWeight{};
+    stmt.action()->set_weight()->default_weight() = 1;
+    stmt.action()->set_weight()->area_to_weight()->emplace(
+        "area1", (i % 100) + 1);
+    policy.statements()->emplace_back(std::move(stmt));
+  }
+  return policy;
+}
+
+/**
+ * Create `numRoutes` /64 routes spread across the prefix ranges and tags of
+ * `createRibPolicy(numStatements)`.
+ */
+std::unordered_map<folly::CIDRNetwork, RibUnicastEntry>
+createRoutes(size_t numRoutes, size_t numStatements) {
+  const auto nh = createNextHop(
+      toBinaryAddress("fe80::1"), "iface1", 0, std::nullopt, "area1");
+  std::unordered_map<folly::CIDRNetwork, RibUnicastEntry> routes;
+  routes.reserve(numRoutes);
+  for (size_t i = 0; i < numRoutes; ++i) {
+    const size_t stmtIdx = (i / kRoutesPerRange) % numStatements;
+    auto prefix = folly::IPAddress::createNetwork(fmt::format(
+        "fc00:{:x}:{:x}:{:x}::/64", stmtIdx & ~size_t{1}, i >> 16, i & 0xffff));
+    RibUnicastEntry entry(prefix, {nh});
+    entry.bestPrefixEntry.tags()->emplace(
+        fmt::format("TAG:{}", stmtIdx | size_t{1}));
+    routes.emplace(prefix, std::move(entry));
+  }
+  return routes;
+}
+
+/**
+ * Benchmark for compiling policy with `numStatements` statements.
+ */
+void
+BM_RibPolicyCompile(uint32_t iters, size_t numStatements) {
+  auto suspender = folly::BenchmarkSuspender();
+  const auto thriftPolicy = createRibPolicy(numStatements);
+  suspender.dismiss(); // Start measuring benchmark time
+
+  for (uint32_t i = 0; i < iters; ++i) {
+    auto policy = RibPolicy(thriftPolicy);
+    folly::doNotOptimizeAway(policy);
+  }
+}
+
+/**
+ * Benchmark for applying policy on full route database, i.e. full route
+ * rebuild.
+ */
+void
+BM_RibPolicyApplyPolicy(
+    uint32_t iters, size_t numStatements, size_t numRoutes) {
+  auto suspender = folly::BenchmarkSuspender();
+  const auto policy = RibPolicy(createRibPolicy(numStatements));
+  const auto routes = createRoutes(numRoutes, numStatements);
+
+  for (uint32_t i = 0; i < iters; ++i) {
+    auto routesCopy = routes;
+    suspender.dismiss(); // Start measuring benchmark time
+    auto change = policy.applyPolicy(routesCopy);
+    suspender.rehire(); // Stop measuring time again
+    CHECK_EQ(numRoutes, change.updatedRoutes.size());
+  }
+}
+
+/**
+ * Benchmark for applying policy on routes of an incremental route update.
+ */
+void
+BM_RibPolicyApplyPolicyIncremental(
+    uint32_t iters, size_t numStatements, size_t numRoutes) {
+  auto suspender = folly::BenchmarkSuspender();
+  const auto policy = RibPolicy(createRibPolicy(numStatements));
+  const auto routes = createRoutes(numRoutes, numStatements);
+  std::unordered_map<folly::CIDRNetwork, RibUnicastEntry> updatedRoutes;
+  for (auto it = routes.begin();
+       it != routes.end() and updatedRoutes.size() < kNumUpdatedRoutes;
+       ++it) {
+    updatedRoutes.emplace(*it);
+  }
+
+  for (uint32_t i = 0; i < iters; ++i) {
+    auto routesCopy = updatedRoutes;
+    suspender.dismiss(); // Start measuring benchmark time
+    auto change = policy.applyPolicy(routesCopy);
+    suspender.rehire(); // Stop measuring time again
+    CHECK_EQ(updatedRoutes.size(), change.updatedRoutes.size());
+  }
+}
+
+BENCHMARK_PARAM(BM_RibPolicyCompile, 100);
+BENCHMARK_PARAM(BM_RibPolicyCompile, 1000);
+BENCHMARK_PARAM(BM_RibPolicyCompile, 10000);
+
+BENCHMARK_NAMED_PARAM(BM_RibPolicyApplyPolicy, 100_10k, 100, 10000);
+BENCHMARK_NAMED_PARAM(BM_RibPolicyApplyPolicy, 1k_100k, 1000, 100000);
+BENCHMARK_NAMED_PARAM(BM_RibPolicyApplyPolicy, 10k_100k, 10000, 100000);
+BENCHMARK_NAMED_PARAM(BM_RibPolicyApplyPolicy, 10k_500k, 10000, 500000);
+
+BENCHMARK_NAMED_PARAM(
+    BM_RibPolicyApplyPolicyIncremental, 10k_100k, 10000, 100000);
+BENCHMARK_NAMED_PARAM(
+    BM_RibPolicyApplyPolicyIncremental, 10k_500k, 10000, 500000);
+
+} // namespace openr
+
+int
+main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -204,6 +204,96 @@ TEST(RibPolicyStatement, Match) {
   }
 }
 
+TEST(RibPolicyStatement, MatchPrefixRange) {
+  thrift::RibRoutePrefixRange range;
+  range.prefix() = toIpPrefix("10.0.0.0/8");
+  range.ge() = 16;
+  range.le() = 24;
+  auto thriftStatement =
+      createPolicyStatement(std::nullopt, std::nullopt, 1, {{"test-area", 2}});
+  thriftStatement.matcher()->prefix_ranges() =
+      std::vector<thrift::RibRoutePrefixRange>({range});
+  auto policyStatement = RibPolicyStatement(thriftStatement);
+
+  // Verify match within range
+  EXPECT_TRUE(policyStatement.match(
+      RibUnicastEntry(folly::IPAddress::createNetwork("10.1.0.0/16"))));
+  EXPECT_TRUE(policyStatement.match(
+      RibUnicastEntry(folly::IPAddress::createNetwork("10.1.2.0/24"))));
+
+  // Verify no match for prefix length out of range
+  EXPECT_FALSE(policyStatement.match(
+      RibUnicastEntry(folly::IPAddress::createNetwork("10.0.0.0/8"))));
+  EXPECT_FALSE(policyStatement.match(
+      RibUnicastEntry(folly::IPAddress::createNetwork("10.1.2.128/25"))));
+
+  // Verify no match for prefix not covered by range
+  EXPECT_FALSE(policyStatement.match(
+      RibUnicastEntry(folly::IPAddress::createNetwork("11.1.0.0/16"))));
+  EXPECT_FALSE(policyStatement.match(
+      RibUnicastEntry(folly::IPAddress::createNetwork("fc00::/16"))));
+
+  // Verify range is retained in thrift representation
+  EXPECT_EQ(
+      *thriftStatement.matcher()->prefix_ranges(),
+      *policyStatement.toThrift().matcher()->prefix_ranges());
+
+  // Verify invalid range is rejected
+  range.le() = 12;
+  thriftStatement.matcher()->prefix_ranges() =
+      std::vector<thrift::RibRoutePrefixRange>({range});
+  EXPECT_THROW((RibPolicyStatement(thriftStatement)), thrift::OpenrError);
+}
+
+/**
+ * Verifies that compiled matcher of RibPolicy selects the same statement as
+ * in-order evaluation of statements, with prefixes, prefix ranges and tags
+ * mixed across statements.
+ */
+TEST(RibPolicy, CompiledMatch) {
+  const auto nh1 = createNextHop(
+      toBinaryAddress("fe80::1"), "iface1", 0, std::nullopt, "area1");
+
+  // stmt1: exact prefix + tag
+  auto stmt1 = createPolicyStatement(
+      std::vector<thrift::IpPrefix>{toIpPrefix("fc00:1::/64")},
+      std::vector<std::string>{"TAG1"},
+      1,
+      {{"area1", 11}});
+  // stmt2: prefix range (fc00::/16 le 128)
+  thrift::RibRoutePrefixRange range;
+  range.prefix() = toIpPrefix("fc00::/16");
+  range.le() = 128;
+  auto stmt2 =
+      createPolicyStatement(std::nullopt, std::nullopt, 1, {{"area1", 22}});
+  stmt2.matcher()->prefix_ranges() =
+      std::vector<thrift::RibRoutePrefixRange>({range});
+  // stmt3: tag only
+  auto stmt3 = createPolicyStatement(
+      std::nullopt, std::vector<std::string>{"TAG3"}, 1, {{"area1", 33}});
+  auto policy = RibPolicy(createPolicy({stmt1, stmt2, stmt3}, 10));
+
+  auto getWeight = [&](std::string const& prefix,
+                       std::optional<std::string> const& tag) {
+    RibUnicastEntry entry(folly::IPAddress::createNetwork(prefix), {nh1});
+    if (tag) {
+      entry.bestPrefixEntry.tags()->insert(*tag);
+    }
+    EXPECT_EQ(policy.match(entry), policy.applyAction(entry));
+    return *entry.nexthops.begin()->weight();
+  };
+
+  // stmt1 has precedence over stmt2
+  EXPECT_EQ(11, getWeight("fc00:1::/64", "TAG1"));
+  // stmt1 doesn't match without tag. stmt2 is selected
+  EXPECT_EQ(22, getWeight("fc00:1::/64", std::nullopt));
+  EXPECT_EQ(22, getWeight("fc00:2::/96", "TAG3"));
+  // Only stmt3 matches
+  EXPECT_EQ(33, getWeight("fd00::/64", "TAG3"));
+  // Nothing matches
+  EXPECT_EQ(0, getWeight("fd00::/64", "TAG1"));
+}
+
 TEST(RibPolicy, ApiTest) {
   std::vector<thrift::IpPrefix> prefixes{toIpPrefix("10.0.0.0/8")};
   std::vector<std::string> tags{"TAG1"};
@@ -6,6 +6,9 @@
  */
 
 #include <openr/decision/tests/RoutingBenchmarkUtils.h>
+
+#include <fb303/ServiceData.h>
+
 #include <openr/if/gen-cpp2/OpenrConfig_types.h>
 #include <openr/tests/mocks/PrefixGenerator.h>
 
@@ -290,6 +293,77 @@ createGrid(const int n, const int numPrefixes) {
   return std::make_pair(std::move(adjDbs), std::move(prefixDbs));
 }
 
+std::unordered_map<
+    std::string,
+    std::pair<
+        std::unordered_map<std::string, thrift::AdjacencyDatabase>,
+        std::unordered_map<std::string, thrift::PrefixDatabase>>>
+createMultiAreaGrid(const int numOfAreas, const int n, const int numPrefixes) {
+  LOG(INFO) << "areas: " << numOfAreas << ", grid: " << n << " by " << n;
+  LOG(INFO) << " number of prefixes " << numPrefixes;
+  std::unordered_map<
+      std::string,
+      std::pair<
+          std::unordered_map<std::string, thrift::AdjacencyDatabase>,
+          std::unordered_map<std::string, thrift::PrefixDatabase>>>
+      areas;
+  PrefixGenerator prefixGenerator;
+
+  for (int area = 0; area < numOfAreas; ++area) {
+    auto& [adjDbs, prefixDbs] = areas[fmt::format("area{}", area)];
+    // Corner of every grid is the local node 0
+    auto getNodeId = [&](int row, int col) -> uint32_t {
+      return row == 0 and col == 0 ? 0 : area * n * n + row * n + col;
+    };
+
+    for (int row = 0; row < n; ++row) {
+      for (int col = 0; col < n; ++col) {
+        const auto nodeId = getNodeId(row, col);
+        const auto nodeName = fmt::format("{}", nodeId);
+        // Add adjs
+        std::vector<thrift::Adjacency> adjs;
+        for (auto [otherRow, otherCol] :
+             {std::make_pair(row, col + 1),
+              std::make_pair(row, col - 1),
+              std::make_pair(row - 1, col),
+              std::make_pair(row + 1, col)}) {
+          if (otherRow < 0 or otherRow >= n or otherCol < 0 or
+              otherCol >= n) {
+            continue;
+          }
+          const auto otherId = getNodeId(otherRow, otherCol);
+          createAdjacencyEntry(
+              otherId,
+              getIfName(nodeId, otherId),
+              adjs,
+              getIfName(otherId, nodeId));
+        }
+        adjDbs.emplace(
+            fmt::format("adj:{}", nodeName),
+            createAdjDb(nodeName, adjs, nodeId + 1));
+
+        // prefixes of nodes other than the local node
+        if (nodeId == 0) {
+          continue;
+        }
+        for (const auto& prefix :
+             prefixGenerator.ipv6PrefixGenerator(numPrefixes, kBitMaskLen)) {
+          auto [key, db] = createPrefixKeyAndDb(
+              nodeName,
+              createPrefixEntry(
+                  prefix,
+                  thrift::PrefixType::LOOPBACK,
+                  "",
+                  thrift::PrefixForwardingType::IP,
+                  thrift::PrefixForwardingAlgorithm::SP_ECMP));
+          prefixDbs.emplace(key.getPrefixKeyV2(), std::move(db));
+        }
+      }
+    }
+  }
+  return areas;
+}
+
 /**
  * Create Adjacencies for spine switches.
  * Each spine switch has numOfPods connections,
@@ -687,6 +761,61 @@ BM_DecisionGridAdjUpdates(
   suspender.rehire(); // Stop measuring time again
 }
 
+void
+BM_DecisionGridPublicationBurst(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    uint32_t numOfSws,
+    uint32_t numOfPublications) {
+  auto suspender = folly::BenchmarkSuspender();
+  const std::string nodeName{"1"};
+  auto decisionWrapper = std::make_shared<DecisionWrapper>(nodeName);
+  int n = std::sqrt(numOfSws);
+  auto [adjs, prefixes] = createGrid(n, 1);
+
+  sendRecvInitialUpdate(
+      decisionWrapper, nodeName, std::move(adjs), std::move(prefixes));
+
+  // Node flapping in every burst
+  const int row = folly::Random::rand32() % n;
+  const int col = folly::Random::rand32() % n;
+  const auto burstNodeName = fmt::format("{}", row * n + col);
+  const auto burstNodeAdjs = createGridAdjacencys(row, col, n);
+  int64_t version{2};
+
+  for (uint32_t i = 0; i < iters; i++) {
+    // Overload bit alternates within the burst, ends with flipped state
+    const bool overloadBit = i % 2 == 0;
+    std::vector<thrift::Publication> pubs;
+    for (uint32_t j = 0; j < numOfPublications; j++) {
+      thrift::Publication pub;
+      pub.area() = kTestingAreaName;
+      pub.keyVals() = {
+          {fmt::format("adj:{}", burstNodeName),
+           decisionWrapper->createAdjValue(
+               burstNodeName,
+               version++,
+               burstNodeAdjs,
+               std::nullopt,
+               overloadBit == ((numOfPublications - j) % 2 == 1))}};
+      pubs.emplace_back(std::move(pub));
+    }
+
+    suspender.dismiss(); // Start measuring benchmark time
+    for (auto const& pub : pubs) {
+      decisionWrapper->sendKvPublication(pub);
+    }
+    decisionWrapper->recvMyRouteDb();
+    suspender.rehire(); // Stop measuring time again
+  }
+
+  auto fb303Counters = facebook::fb303::fbData->getCounters();
+  counters["publications_coalesced"] =
+      fb303Counters["decision.publications_coalesced.sum"];
+  counters["keys_deduplicated"] =
+      fb303Counters["decision.keys_deduplicated.sum"];
+}
+
 void
 BM_DecisionGridPrefixUpdates(
     folly::UserCounters& counters,
@@ -862,4 +991,325 @@ BM_DecisionFabricPrefixUpdates(
     }
   }
 }
+
+void
+BM_SpfSolverBuildRouteDb(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    uint32_t numOfSws,
+    uint32_t numOfPrefixes,
+    uint32_t numOfThreads) {
+  auto suspender = folly::BenchmarkSuspender();
+  const std::string nodeName{"0"};
+  const int n = std::sqrt(numOfSws);
+  auto [adjs, prefixes] = createGrid(n, numOfPrefixes / (n * n));
+
+  std::unordered_map<std::string, LinkState> areaLinkStates;
+  areaLinkStates.emplace(
+      kTestingAreaName, LinkState(kTestingAreaName, nodeName));
+  auto& linkState = areaLinkStates.at(kTestingAreaName);
+  for (auto const& [_, adjDb] : adjs) {
+    linkState.updateAdjacencyDatabase(adjDb, kTestingAreaName);
+  }
+  PrefixState prefixState;
+  for (auto const& [_, prefixDb] : prefixes) {
+    for (auto const& entry : *prefixDb.prefixEntries()) {
+      prefixState.updatePrefix(
+          PrefixKey(
+              *prefixDb.thisNodeName(),
+              toIPNetwork(*entry.prefix()),
+              kTestingAreaName),
+          entry);
+    }
+  }
+
+  SpfSolver spfSolver(
+      nodeName,
+      false /* enableV4 */,
+      false /* enableNodeSegmentLabel */,
+      false /* enableBestRouteSelection */,
+      false /* v4OverV6Nexthop */,
+      numOfThreads);
+
+  for (uint32_t i = 0; i < iters; i++) {
+    suspender.dismiss(); // Start measuring benchmark time
+    auto routeDb =
+        spfSolver.buildRouteDb(nodeName, areaLinkStates, prefixState);
+    suspender.rehire(); // Stop measuring time again
+    CHECK(routeDb.has_value());
+    counters["num_of_routes"] = routeDb->unicastRoutes.size();
+  }
+}
+
+void
+BM_SpfSolverBuildRouteDbAnycast(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    uint32_t numOfSws,
+    uint32_t numOfPrefixes,
+    uint32_t numOfOriginators) {
+  auto suspender = folly::BenchmarkSuspender();
+  const std::string nodeName{"0"};
+  const int n = std::sqrt(numOfSws);
+  const auto adjs = createGrid(n, 0).first;
+
+  std::unordered_map<std::string, LinkState> areaLinkStates;
+  areaLinkStates.emplace(
+      kTestingAreaName, LinkState(kTestingAreaName, nodeName));
+  auto& linkState = areaLinkStates.at(kTestingAreaName);
+  for (auto const& [_, adjDb] : adjs) {
+    linkState.updateAdjacencyDatabase(adjDb, kTestingAreaName);
+  }
+
+  // Every prefix is announced by `numOfOriginators` consecutive nodes,
+  // starting at a different node for every prefix
+  PrefixGenerator prefixGenerator;
+  const auto prefixes =
+      prefixGenerator.ipv6PrefixGenerator(numOfPrefixes, kBitMaskLen);
+  PrefixState prefixState;
+  for (size_t i = 0; i < prefixes.size(); ++i) {
+    const auto entry = createPrefixEntry(
+        prefixes.at(i),
+        thrift::PrefixType::LOOPBACK,
+        "",
+        thrift::PrefixForwardingType::IP,
+        thrift::PrefixForwardingAlgorithm::SP_ECMP);
+    for (uint32_t j = 0; j < numOfOriginators; ++j) {
+      // Skip local node, as its prefixes are not programmed
+      const auto node = 1 + (i + j) % (n * n - 1);
+      prefixState.updatePrefix(
+          PrefixKey(
+              fmt::format("{}", node),
+              toIPNetwork(prefixes.at(i)),
+              kTestingAreaName),
+          entry);
+    }
+  }
+
+  SpfSolver spfSolver(
+      nodeName,
+      false /* enableV4 */,
+      false /* enableNodeSegmentLabel */,
+      false /* enableBestRouteSelection */,
+      false /* v4OverV6Nexthop */);
+
+  for (uint32_t i = 0; i < iters; i++) {
+    suspender.dismiss(); // Start measuring benchmark time
+    auto routeDb =
+        spfSolver.buildRouteDb(nodeName, areaLinkStates, prefixState);
+    suspender.rehire(); // Stop measuring time again
+    CHECK(routeDb.has_value());
+    counters["num_of_routes"] = routeDb->unicastRoutes.size();
+    counters["num_of_nexthop_groups"] = NextHopGroup::getNumInternedGroups();
+  }
+}
+
+void
+BM_SpfSolverBuildRouteDbMultiArea(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    uint32_t numOfAreas,
+    uint32_t numOfSwsPerArea,
+    uint32_t numOfPrefixes,
+    uint32_t numOfThreads) {
+  auto suspender = folly::BenchmarkSuspender();
+  const std::string nodeName{"0"};
+  const int n = std::sqrt(numOfSwsPerArea);
+  const auto areas =
+      createMultiAreaGrid(numOfAreas, n, numOfPrefixes / (numOfAreas * n * n));
+
+  PrefixState prefixState;
+  for (auto const& [area, areaDbs] : areas) {
+    for (auto const& [_, prefixDb] : areaDbs.second) {
+      for (auto const& entry : *prefixDb.prefixEntries()) {
+        prefixState.updatePrefix(
+            PrefixKey(
+                *prefixDb.thisNodeName(), toIPNetwork(*entry.prefix()), area),
+            entry);
+      }
+    }
+  }
+
+  SpfSolver spfSolver(
+      nodeName,
+      false /* enableV4 */,
+      true /* enableNodeSegmentLabel */,
+      false /* enableBestRouteSelection */,
+      false /* v4OverV6Nexthop */,
+      numOfThreads);
+
+  for (uint32_t i = 0; i < iters; i++) {
+    // Fresh link states, as SPF results are memoized
+    std::unordered_map<std::string, LinkState> areaLinkStates;
+    for (auto const& [area, areaDbs] : areas) {
+      auto& linkState =
+          areaLinkStates.emplace(area, LinkState(area, nodeName)).first->second;
+      for (auto const& [_, adjDb] : areaDbs.first) {
+        linkState.updateAdjacencyDatabase(adjDb, area);
+      }
+    }
+
+    suspender.dismiss(); // Start measuring benchmark time
+    auto routeDb =
+        spfSolver.buildRouteDb(nodeName, areaLinkStates, prefixState);
+    suspender.rehire(); // Stop measuring time again
+    CHECK(routeDb.has_value());
+    counters["num_of_routes"] = routeDb->unicastRoutes.size();
+    counters["num_of_mpls_routes"] = routeDb->mplsRoutes.size();
+  }
+}
+
+void
+BM_LinkStateKthPaths(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    uint32_t numOfSws,
+    uint32_t k,
+    uint32_t kthPathsCacheSize) {
+  auto suspender = folly::BenchmarkSuspender();
+  const std::string nodeName{"0"};
+  const int n = std::sqrt(numOfSws);
+  const auto adjs = createGrid(n, 0).first;
+
+  for (uint32_t i = 0; i < iters; i++) {
+    // Start from empty cache on every iteration
+    LinkState linkState(kTestingAreaName, nodeName, kthPathsCacheSize);
+    for (auto const& [_, adjDb] : adjs) {
+      linkState.updateAdjacencyDatabase(adjDb, kTestingAreaName);
+    }
+    // First paths share SPF result of the source
+    linkState.getSpfResult(nodeName);
+
+    size_t numOfPaths{0};
+    suspender.dismiss(); // Start measuring benchmark time
+    for (auto const& [dest, _] : adjs) {
+      numOfPaths += linkState.getKthPaths(nodeName, dest, k).size();
+    }
+    suspender.rehire(); // Stop measuring time again
+    counters["num_of_paths"] = numOfPaths;
+    counters["cache_size"] = linkState.getKthPathsCacheSize();
+  }
+}
+
+void
+BM_RibUnicastEntryMemory(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    uint32_t numOfRoutes,
+    uint32_t numOfNextHopGroups,
+    uint32_t numOfNextHops) {
+  auto suspender = folly::BenchmarkSuspender();
+  SystemMetrics sysMetrics;
+  bool record = true;
+
+  // Build distinct sets of next-hops. Routes are created from copies of these
+  // sets, mimicking SpfSolver computing same next-hops for each prefix.
+  std::vector<std::unordered_set<thrift::NextHopThrift>> nexthopSets;
+  for (uint32_t i = 0; i < numOfNextHopGroups; i++) {
+    auto& nexthops = nexthopSets.emplace_back();
+    for (uint32_t j = 0; j < numOfNextHops; j++) {
+      nexthops.emplace(createNextHop(
+          toBinaryAddress(fmt::format("fe80::{:x}:{:x}", i + 1, j + 1)),
+          fmt::format("iface{}", j),
+          10,
+          std::nullopt,
+          kTestingAreaName));
+    }
+  }
+
+  for (uint32_t i = 0; i < iters; i++) {
+    std::optional<size_t> memBefore;
+    if (record) {
+      memBefore = sysMetrics.getRSSMemBytes();
+    }
+
+    suspender.dismiss(); // Start measuring benchmark time
+    std::unordered_map<folly::CIDRNetwork, RibUnicastEntry> routes;
+    routes.reserve(numOfRoutes);
+    for (uint32_t j = 0; j < numOfRoutes; j++) {
+      const auto prefix = folly::IPAddress::createNetwork(
+          fmt::format("fc00:{:x}:{:x}::/64", j >> 16, j & 0xffff));
+      routes.emplace(
+          prefix,
+          RibUnicastEntry(prefix, nexthopSets.at(j % numOfNextHopGroups)));
+    }
+    suspender.rehire(); // Stop measuring time again
+
+    if (record) {
+      auto memAfter = sysMetrics.getRSSMemBytes();
+      if (memBefore.has_value() and memAfter.has_value() and
+          memAfter.value() > memBefore.value()) {
+        counters["memory_per_100k_routes(KB)"] =
+            (memAfter.value() - memBefore.value()) * 100000 / numOfRoutes /
+            1024;
+      }
+      counters["interned_nexthop_groups"] =
+          NextHopGroup::getNumInternedGroups();
+      record = false;
+    }
+  }
+}
+
+void
+BM_SpfSolverBuildRouteDelta(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    uint32_t numOfPrefixes,
+    uint32_t numOfChangedPrefixes,
+    bool verifyRouteDelta) {
+  auto suspender = folly::BenchmarkSuspender();
+  const std::string nodeName{"0"};
+  const auto adjs = createGrid(2, 0).first;
+
+  std::unordered_map<std::string, LinkState> areaLinkStates;
+  areaLinkStates.emplace(
+      kTestingAreaName, LinkState(kTestingAreaName, nodeName));
+  auto& linkState = areaLinkStates.at(kTestingAreaName);
+  for (auto const& [_, adjDb] : adjs) {
+    linkState.updateAdjacencyDatabase(adjDb, kTestingAreaName);
+  }
+
+  PrefixGenerator prefixGenerator;
+  const auto prefixes =
+      prefixGenerator.ipv6PrefixGenerator(numOfPrefixes, kBitMaskLen);
+  PrefixState prefixState;
+  for (auto const& prefix : prefixes) {
+    prefixState.updatePrefix(
+        PrefixKey("1", toIPNetwork(prefix), kTestingAreaName),
+        createPrefixEntry(prefix, thrift::PrefixType::LOOPBACK));
+  }
+
+  SpfSolver spfSolver(
+      nodeName,
+      false /* enableV4 */,
+      false /* enableNodeSegmentLabel */,
+      false /* enableBestRouteSelection */,
+      false /* v4OverV6Nexthop */);
+  auto routeDb =
+      spfSolver.buildRouteDb(nodeName, areaLinkStates, prefixState).value();
+
+  for (uint32_t i = 0; i < iters; i++) {
+    // Change prefix entries, with a different tag in every iteration
+    for (uint32_t j = 0; j < numOfChangedPrefixes; j++) {
+      auto entry =
+          createPrefixEntry(prefixes.at(j), thrift::PrefixType::LOOPBACK);
+      entry.tags()->emplace(fmt::format("changed-{}", i));
+      prefixState.updatePrefix(
+          PrefixKey("1", toIPNetwork(prefixes.at(j)), kTestingAreaName),
+          entry);
+    }
+
+    DecisionRouteUpdate update;
+    suspender.dismiss(); // Start measuring benchmark time
+    auto newRouteDb = spfSolver.buildRouteDb(
+        nodeName, areaLinkStates, prefixState, &routeDb, &update);
+    if (verifyRouteDelta) {
+      update = routeDb.verifyUpdate(newRouteDb.value(), std::move(update));
+    }
+    suspender.rehire(); // Stop measuring time again
+    CHECK_EQ(numOfChangedPrefixes, update.size());
+    counters["num_of_updates"] = update.size();
+    routeDb.update(update);
+  }
+}
 } // namespace openr
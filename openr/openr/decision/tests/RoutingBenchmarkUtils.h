@@ -305,6 +305,18 @@ std::pair<
     std::unordered_map<std::string, thrift::PrefixDatabase>>
 createGrid(const int n, const int numPrefixes);
 
+/**
+ * Create `numOfAreas` areas, each a grid of n * n nodes with `numPrefixes`
+ * prefixes per node. Local node "0" is the corner of every grid, and names of
+ * other nodes are unique across areas.
+ */
+std::unordered_map<
+    std::string /* area */,
+    std::pair<
+        std::unordered_map<std::string, thrift::AdjacencyDatabase>,
+        std::unordered_map<std::string, thrift::PrefixDatabase>>>
+createMultiAreaGrid(const int numOfAreas, const int n, const int numPrefixes);
+
 /**
  * Create Adjacencies for spine switches.
  * Each spine switch has numOfPods connections,
@@ -424,6 +436,17 @@ void BM_DecisionGridAdjUpdates(
     thrift::PrefixForwardingAlgorithm forwardingAlgorithm,
     uint32_t numberOfPrefixes);
 
+/**
+ * Send bursts of `numOfPublications` adjacency publications of the same node,
+ * toggling its overload bit, and measure time until routes converge to the
+ * last publication of the burst.
+ */
+void BM_DecisionGridPublicationBurst(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    uint32_t numOfSws,
+    uint32_t numOfPublications);
+
 //
 // Benchmark test for fabric topology.
 //
@@ -445,5 +468,92 @@ void BM_DecisionFabricPrefixUpdates(
     uint32_t numOfUpdatePrefixes,
     thrift::PrefixForwardingAlgorithm forwardingAlgorithm);
 
+//
+// Benchmark test for route build (SpfSolver::buildRouteDb) on grid topology.
+//
+
+/**
+ * Build routes for `numOfPrefixes` prefixes spread across nodes of the grid
+ * using `numOfThreads` route build threads.
+ */
+void BM_SpfSolverBuildRouteDb(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    uint32_t numOfSws,
+    uint32_t numOfPrefixes,
+    uint32_t numOfThreads);
+
+/**
+ * Build routes for `numOfPrefixes` prefixes, each announced by
+ * `numOfOriginators` nodes of the grid (anycast), on a single thread. Routes
+ * have ECMP next-hops towards the set of originators.
+ */
+void BM_SpfSolverBuildRouteDbAnycast(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    uint32_t numOfSws,
+    uint32_t numOfPrefixes,
+    uint32_t numOfOriginators);
+
+/**
+ * Build routes for `numOfPrefixes` prefixes spread across nodes of
+ * `numOfAreas` grids of `numOfSwsPerArea` nodes using `numOfThreads` route
+ * build threads. SPF of every area is run from scratch on every iteration.
+ */
+void BM_SpfSolverBuildRouteDbMultiArea(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    uint32_t numOfAreas,
+    uint32_t numOfSwsPerArea,
+    uint32_t numOfPrefixes,
+    uint32_t numOfThreads);
+
+//
+// Benchmark test for k-th shortest paths (LinkState::getKthPaths).
+//
+
+/**
+ * Compute paths 1..k from node "0" towards every node of the grid, as KSP2
+ * route build does, with cache of `kthPathsCacheSize` results per area.
+ */
+void BM_LinkStateKthPaths(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    uint32_t numOfSws,
+    uint32_t k,
+    uint32_t kthPathsCacheSize);
+
+//
+// Benchmark test for route memory footprint.
+//
+
+/**
+ * Create `numOfRoutes` unicast routes spread across `numOfNextHopGroups`
+ * distinct ECMP groups of `numOfNextHops` next-hops each, and report resident
+ * memory per 100k routes along with the number of interned next-hop groups.
+ */
+void BM_RibUnicastEntryMemory(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    uint32_t numOfRoutes,
+    uint32_t numOfNextHopGroups,
+    uint32_t numOfNextHops);
+
+//
+// Benchmark test for route delta of full route builds.
+//
+
+/**
+ * Build routes of `numOfPrefixes` prefixes, recording the delta relative to
+ * the previous build, after `numOfChangedPrefixes` prefix entries changed.
+ * Delta is optionally verified with full comparison of routes.
+ */
+void BM_SpfSolverBuildRouteDelta(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    uint32_t numOfPrefixes,
+    uint32_t numOfChangedPrefixes,
+    bool verifyRouteDelta);
+
 const auto SP_ECMP = thrift::PrefixForwardingAlgorithm::SP_ECMP;
 } // namespace openr
@@ -1168,6 +1168,341 @@ TEST(Decision, BestRouteSelection) {
   }
 }
 
+//
+// Verify that routes built in parallel over prefix shards are identical to
+// the routes built sequentially, including best route selection cache.
+//
+TEST(SpfSolver, ParallelRouteBuild) {
+  std::string nodeName("1");
+  SpfSolver sequentialSpfSolver(
+      nodeName,
+      false /* enableV4 */,
+      true /* enable segment label */,
+      true /* enableBestRouteSelection */);
+  SpfSolver parallelSpfSolver(
+      nodeName,
+      false /* enableV4 */,
+      true /* enable segment label */,
+      true /* enableBestRouteSelection */,
+      false /* v4OverV6Nexthop */,
+      4 /* routeBuildThreads */);
+
+  //
+  // Setup adjacencies
+  // 2 <--> 1 <--> 3
+  //
+  std::unordered_map<std::string, LinkState> areaLinkStates;
+  areaLinkStates.emplace(
+      kTestingAreaName, LinkState(kTestingAreaName, nodeName));
+  auto& linkState = areaLinkStates.at(kTestingAreaName);
+  linkState.updateAdjacencyDatabase(
+      createAdjDb("1", {adj12, adj13}, 1), kTestingAreaName);
+  linkState.updateAdjacencyDatabase(
+      createAdjDb("2", {adj21}, 2), kTestingAreaName);
+  linkState.updateAdjacencyDatabase(
+      createAdjDb("3", {adj31}, 3), kTestingAreaName);
+
+  //
+  // Setup prefixes. Enough for multiple shards with a mix of
+  // - routes via node2
+  // - ECMP routes via node2 and node3
+  // - prefixes also advertised by node1 (no route, best route selection only)
+  //
+  const size_t numPrefixes = 5000;
+  std::vector<thrift::PrefixEntry> node1Prefixes, node2Prefixes, node3Prefixes;
+  for (size_t i = 0; i < numPrefixes; ++i) {
+    const auto prefixEntry =
+        createPrefixEntry(toIpPrefix(fmt::format("fc00:{:x}::/64", i)));
+    node2Prefixes.emplace_back(prefixEntry);
+    if (i % 3 == 0) {
+      node3Prefixes.emplace_back(prefixEntry);
+    }
+    if (i % 7 == 0) {
+      node1Prefixes.emplace_back(prefixEntry);
+    }
+  }
+  PrefixState prefixState;
+  updatePrefixDatabase(prefixState, createPrefixDb("1", node1Prefixes));
+  updatePrefixDatabase(prefixState, createPrefixDb("2", node2Prefixes));
+  updatePrefixDatabase(prefixState, createPrefixDb("3", node3Prefixes));
+
+  auto sequentialRouteDb =
+      sequentialSpfSolver.buildRouteDb(nodeName, areaLinkStates, prefixState);
+  auto parallelRouteDb =
+      parallelSpfSolver.buildRouteDb(nodeName, areaLinkStates, prefixState);
+  ASSERT_TRUE(sequentialRouteDb.has_value());
+  ASSERT_TRUE(parallelRouteDb.has_value());
+  EXPECT_EQ(
+      numPrefixes - node1Prefixes.size(),
+      sequentialRouteDb->unicastRoutes.size());
+  EXPECT_EQ(sequentialRouteDb->unicastRoutes, parallelRouteDb->unicastRoutes);
+  EXPECT_EQ(sequentialRouteDb->mplsRoutes, parallelRouteDb->mplsRoutes);
+
+  auto const& sequentialCache = sequentialSpfSolver.getBestRoutesCache();
+  auto const& parallelCache = parallelSpfSolver.getBestRoutesCache();
+  EXPECT_EQ(numPrefixes, sequentialCache.size());
+  ASSERT_EQ(sequentialCache.size(), parallelCache.size());
+  for (auto const& [prefix, bestRoutes] : sequentialCache) {
+    ASSERT_EQ(1, parallelCache.count(prefix));
+    EXPECT_EQ(bestRoutes.allNodeAreas, parallelCache.at(prefix).allNodeAreas);
+    EXPECT_EQ(bestRoutes.bestNodeArea, parallelCache.at(prefix).bestNodeArea);
+  }
+}
+
+//
+// Verify that routes built with SPF and node label routes of areas computed in
+// parallel are identical to the routes built sequentially, including on
+// prefixes advertised across areas and node labels conflicting across areas.
+//
+TEST(SpfSolver, ParallelMultiAreaRouteBuild) {
+  std::string nodeName("1");
+  const std::string areaA{"areaA"};
+  const std::string areaB{"areaB"};
+  SpfSolver sequentialSpfSolver(
+      nodeName,
+      false /* enableV4 */,
+      true /* enable segment label */,
+      true /* enableBestRouteSelection */);
+  SpfSolver parallelSpfSolver(
+      nodeName,
+      false /* enableV4 */,
+      true /* enable segment label */,
+      true /* enableBestRouteSelection */,
+      false /* v4OverV6Nexthop */,
+      4 /* routeBuildThreads */);
+
+  //
+  // Setup adjacencies. Node label of 3 conflicts with the one of 2.
+  // areaA: 2 <--> 1
+  // areaB: 1 <--> 3
+  //
+  std::unordered_map<std::string, LinkState> areaLinkStates;
+  areaLinkStates.emplace(areaA, LinkState(areaA, nodeName));
+  areaLinkStates.emplace(areaB, LinkState(areaB, nodeName));
+  auto& linkStateA = areaLinkStates.at(areaA);
+  linkStateA.updateAdjacencyDatabase(createAdjDb("1", {adj12}, 1), areaA);
+  linkStateA.updateAdjacencyDatabase(createAdjDb("2", {adj21}, 2), areaA);
+  auto& linkStateB = areaLinkStates.at(areaB);
+  linkStateB.updateAdjacencyDatabase(createAdjDb("1", {adj13}, 1), areaB);
+  linkStateB.updateAdjacencyDatabase(createAdjDb("3", {adj31}, 2), areaB);
+
+  //
+  // Setup prefixes. Node2 advertises all prefixes in areaA, node3 advertises
+  // some of them in areaB.
+  //
+  const size_t numPrefixes = 5000;
+  std::vector<thrift::PrefixEntry> node2Prefixes, node3Prefixes;
+  for (size_t i = 0; i < numPrefixes; ++i) {
+    const auto prefixEntry =
+        createPrefixEntry(toIpPrefix(fmt::format("fc00:{:x}::/64", i)));
+    node2Prefixes.emplace_back(prefixEntry);
+    if (i % 3 == 0) {
+      node3Prefixes.emplace_back(prefixEntry);
+    }
+  }
+  PrefixState prefixState;
+  updatePrefixDatabase(prefixState, createPrefixDb("2", node2Prefixes), areaA);
+  updatePrefixDatabase(prefixState, createPrefixDb("3", node3Prefixes), areaB);
+
+  auto sequentialRouteDb =
+      sequentialSpfSolver.buildRouteDb(nodeName, areaLinkStates, prefixState);
+  auto parallelRouteDb =
+      parallelSpfSolver.buildRouteDb(nodeName, areaLinkStates, prefixState);
+  ASSERT_TRUE(sequentialRouteDb.has_value());
+  ASSERT_TRUE(parallelRouteDb.has_value());
+  EXPECT_EQ(numPrefixes, sequentialRouteDb->unicastRoutes.size());
+  EXPECT_EQ(sequentialRouteDb->unicastRoutes, parallelRouteDb->unicastRoutes);
+
+  // Node label routes of local node and of node2, which has smaller name
+  EXPECT_EQ(2, sequentialRouteDb->mplsRoutes.size());
+  EXPECT_EQ(sequentialRouteDb->mplsRoutes, parallelRouteDb->mplsRoutes);
+  for (auto const& nh : parallelRouteDb->mplsRoutes.at(2).nexthops) {
+    EXPECT_EQ(areaA, *nh.area());
+  }
+
+  // Routes are identical on repeated builds
+  auto repeatedRouteDb =
+      parallelSpfSolver.buildRouteDb(nodeName, areaLinkStates, prefixState);
+  ASSERT_TRUE(repeatedRouteDb.has_value());
+  EXPECT_EQ(parallelRouteDb->unicastRoutes, repeatedRouteDb->unicastRoutes);
+  EXPECT_EQ(parallelRouteDb->mplsRoutes, repeatedRouteDb->mplsRoutes);
+}
+
+/**
+ * Verify that routes of prefixes announced by the same nodes share next-hop
+ * group computed once per route build, and that they are identical to routes
+ * computed per prefix.
+ */
+TEST(SpfSolver, SharedNextHopsPerSelectedNodes) {
+  std::string nodeName("1");
+  const std::string areaA{"areaA"};
+  const std::string areaB{"areaB"};
+  SpfSolver spfSolver(
+      nodeName,
+      false /* enableV4 */,
+      false /* enable segment label */,
+      true /* enableBestRouteSelection */);
+
+  //
+  // Setup adjacencies with equal metrics.
+  // areaA: 2 <--> 1
+  // areaB: 1 <--> 3
+  //
+  std::unordered_map<std::string, LinkState> areaLinkStates;
+  areaLinkStates.emplace(areaA, LinkState(areaA, nodeName));
+  areaLinkStates.emplace(areaB, LinkState(areaB, nodeName));
+  auto& linkStateA = areaLinkStates.at(areaA);
+  linkStateA.updateAdjacencyDatabase(createAdjDb("1", {adj12}, 1), areaA);
+  linkStateA.updateAdjacencyDatabase(createAdjDb("2", {adj21}, 2), areaA);
+  auto& linkStateB = areaLinkStates.at(areaB);
+  linkStateB.updateAdjacencyDatabase(createAdjDb("1", {adj13}, 1), areaB);
+  linkStateB.updateAdjacencyDatabase(createAdjDb("3", {adj31}, 2), areaB);
+
+  //
+  // Node2 advertises all prefixes, node3 advertises some of them as well.
+  //
+  const size_t numPrefixes = 100;
+  std::vector<thrift::PrefixEntry> node2Prefixes, node3Prefixes;
+  for (size_t i = 0; i < numPrefixes; ++i) {
+    const auto prefixEntry =
+        createPrefixEntry(toIpPrefix(fmt::format("fc00:{:x}::/64", i)));
+    node2Prefixes.emplace_back(prefixEntry);
+    if (i % 2 == 0) {
+      node3Prefixes.emplace_back(prefixEntry);
+    }
+  }
+  PrefixState prefixState;
+  updatePrefixDatabase(prefixState, createPrefixDb("2", node2Prefixes), areaA);
+  updatePrefixDatabase(prefixState, createPrefixDb("3", node3Prefixes), areaB);
+
+  auto routeDb = spfSolver.buildRouteDb(nodeName, areaLinkStates, prefixState);
+  ASSERT_TRUE(routeDb.has_value());
+  ASSERT_EQ(numPrefixes, routeDb->unicastRoutes.size());
+
+  const auto& node2NextHops =
+      routeDb->unicastRoutes.at(toIPNetwork(*node2Prefixes.at(1).prefix()))
+          .nexthops;
+  const auto& anycastNextHops =
+      routeDb->unicastRoutes.at(toIPNetwork(*node3Prefixes.at(0).prefix()))
+          .nexthops;
+  EXPECT_EQ(1, node2NextHops.size());
+  // Next-hops of both areas are combined
+  EXPECT_EQ(2, anycastNextHops.size());
+
+  for (size_t i = 0; i < numPrefixes; ++i) {
+    const auto prefix = toIPNetwork(*node2Prefixes.at(i).prefix());
+    const auto& route = routeDb->unicastRoutes.at(prefix);
+    EXPECT_EQ(i % 2 ? node2NextHops : anycastNextHops, route.nexthops);
+
+    auto expectedRoute = spfSolver.createRouteForPrefixOrGetStaticRoute(
+        nodeName, areaLinkStates, prefixState, prefix);
+    ASSERT_TRUE(expectedRoute.has_value());
+    EXPECT_EQ(expectedRoute.value(), route);
+  }
+}
+
+/**
+ * Verify that route build records routes changed relative to the previous
+ * route database, same as full comparison of routes, for sequential and
+ * sharded route builds. Verification falls back to full comparison if the
+ * recorded delta is wrong.
+ */
+TEST(SpfSolver, RouteBuildDelta) {
+  std::string nodeName("1");
+  for (size_t routeBuildThreads : {1, 2}) {
+    SpfSolver spfSolver(
+        nodeName,
+        false /* enableV4 */,
+        true /* enable segment label */,
+        false /* enableBestRouteSelection */,
+        false /* v4OverV6Nexthop */,
+        routeBuildThreads);
+
+    std::unordered_map<std::string, LinkState> areaLinkStates;
+    areaLinkStates.emplace(
+        kTestingAreaName, LinkState(kTestingAreaName, nodeName));
+    auto& linkState = areaLinkStates.at(kTestingAreaName);
+    linkState.updateAdjacencyDatabase(
+        createAdjDb("1", {adj12}, 1), kTestingAreaName);
+    linkState.updateAdjacencyDatabase(
+        createAdjDb("2", {adj21}, 2), kTestingAreaName);
+
+    // Enough prefixes for route build across shards
+    std::vector<thrift::PrefixEntry> prefixEntries;
+    for (size_t i = 0; i < 3000; ++i) {
+      prefixEntries.emplace_back(
+          createPrefixEntry(toIpPrefix(fmt::format("fc00:{:x}::/64", i))));
+    }
+    PrefixState prefixState;
+    updatePrefixDatabase(prefixState, createPrefixDb("2", prefixEntries));
+
+    // Build routes, recording the delta relative to `routeDb`. Delta must be
+    // same as full comparison of routes.
+    auto buildRouteDelta = [&](DecisionRouteDb const& routeDb) {
+      DecisionRouteUpdate delta;
+      auto newRouteDb = spfSolver.buildRouteDb(
+          nodeName, areaLinkStates, prefixState, &routeDb, &delta);
+      auto fullDelta =
+          routeDb.calculateFullUpdate(newRouteDb.value_or(DecisionRouteDb{}));
+      EXPECT_EQ(fullDelta.unicastRoutesToUpdate, delta.unicastRoutesToUpdate);
+      EXPECT_THAT(
+          delta.unicastRoutesToDelete,
+          UnorderedElementsAreArray(fullDelta.unicastRoutesToDelete));
+      EXPECT_EQ(fullDelta.mplsRoutesToUpdate, delta.mplsRoutesToUpdate);
+      EXPECT_THAT(
+          delta.mplsRoutesToDelete,
+          UnorderedElementsAreArray(fullDelta.mplsRoutesToDelete));
+      return delta;
+    };
+
+    // Initial build, all routes are new
+    DecisionRouteDb routeDb;
+    auto delta = buildRouteDelta(routeDb);
+    EXPECT_EQ(3000, delta.unicastRoutesToUpdate.size());
+    EXPECT_EQ(2, delta.mplsRoutesToUpdate.size());
+    routeDb.update(delta);
+    for (auto const& [_, route] : routeDb.unicastRoutes) {
+      EXPECT_NE(nullptr, route.bestPrefixEntrySource);
+    }
+
+    // Unchanged routes
+    EXPECT_TRUE(buildRouteDelta(routeDb).empty());
+
+    // Updated prefix entry
+    const auto prefix = toIPNetwork(*prefixEntries.at(0).prefix());
+    prefixEntries.at(0).tags()->emplace("tag");
+    updatePrefixDatabase(prefixState, createPrefixDb("2", prefixEntries));
+    delta = buildRouteDelta(routeDb);
+    EXPECT_EQ(1, delta.size());
+    EXPECT_EQ(1, delta.unicastRoutesToUpdate.count(prefix));
+    routeDb.update(delta);
+
+    // Withdrawn prefix entry, left over in the previous route database
+    const auto withdrawnPrefix = toIPNetwork(*prefixEntries.back().prefix());
+    prefixEntries.pop_back();
+    updatePrefixDatabase(prefixState, createPrefixDb("2", prefixEntries));
+    delta = buildRouteDelta(routeDb);
+    EXPECT_EQ(1, delta.size());
+    EXPECT_THAT(delta.unicastRoutesToDelete, ElementsAre(withdrawnPrefix));
+    routeDb.update(delta);
+
+    // Unreachable node withdraws its routes and node label route
+    linkState.updateAdjacencyDatabase(
+        createAdjDb("2", {}, 2), kTestingAreaName);
+    delta = buildRouteDelta(routeDb);
+    EXPECT_EQ(2999, delta.unicastRoutesToDelete.size());
+    EXPECT_THAT(delta.mplsRoutesToDelete, ElementsAre(2));
+    EXPECT_TRUE(delta.unicastRoutesToUpdate.empty());
+
+    // Verification replaces a wrong delta with full comparison of routes
+    auto newRouteDb =
+        spfSolver.buildRouteDb(nodeName, areaLinkStates, prefixState).value();
+    delta = routeDb.verifyUpdate(newRouteDb, DecisionRouteUpdate{});
+    EXPECT_EQ(2999, delta.unicastRoutesToDelete.size());
+    EXPECT_THAT(delta.mplsRoutesToDelete, ElementsAre(2));
+  }
+}
+
 //
 // Test topology:
 // connected bidirectionally
@@ -1632,7 +1967,7 @@ class SimpleRingTopologyFixture
   verifyRouteInUpdateNoDelete(
       std::string nodeName, int32_t mplsLabel, const DecisionRouteDb& compDb) {
     // verify route DB change in node 1.
-    auto deltaRoutes = compDb.calculateUpdate(
+    auto deltaRoutes = compDb.calculateFullUpdate(
         spfSolver->buildRouteDb(nodeName, areaLinkStates, prefixState).value());
 
     EXPECT_EQ(deltaRoutes.mplsRoutesToUpdate.count(mplsLabel), 1);
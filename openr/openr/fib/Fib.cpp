@@ -259,6 +259,18 @@ Fib::getPerfDb() {
   return sf;
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::ConvergenceStats>>
+Fib::getConvergenceStats() {
+  folly::Promise<std::unique_ptr<thrift::ConvergenceStats>> p;
+  auto sf = p.getSemiFuture();
+  runInEventBaseThread([p = std::move(p), this]() mutable {
+    auto stats = convergenceStats_.toThrift();
+    stats.thisNodeName() = myNodeName_;
+    p.setValue(std::make_unique<thrift::ConvergenceStats>(std::move(stats)));
+  });
+  return sf;
+}
+
 std::vector<thrift::UnicastRoute>
 Fib::getUnicastRoutesFiltered(std::vector<std::string> prefixes) {
   // return and send the vector<thrift::UnicastRoute>
@@ -482,12 +494,15 @@ void
 Fib::processDecisionRouteUpdate(DecisionRouteUpdate&& routeUpdate) {
   // Process state transition event
   transitionRouteState(RouteState::RIB_UPDATE);
+  routeState_.isWarmStart = routeUpdate.warmStart;
 
   // Update perfEvents_ .. We replace existing perf events with new one as
   // convergence is going to be based on new data, not the old.
   if (routeUpdate.perfEvents.has_value()) {
     addPerfEvent(
-        routeUpdate.perfEvents.value(), myNodeName_, "FIB_ROUTE_DB_RECVD");
+        routeUpdate.perfEvents.value(),
+        myNodeName_,
+        thrift::PerfEventType::FIB_ROUTE_DB_RECVD);
   }
 
   // Before anything, get rid of doNotInstall routes
@@ -508,6 +523,11 @@ Fib::processDecisionRouteUpdate(DecisionRouteUpdate&& routeUpdate) {
   }
 
   updateRoutes(std::move(routeUpdate));
+  if (routeState_.isWarmStartSynced and not routeState_.isWarmStart and
+      routeState_.state == RouteState::SYNCED) {
+    // Computed routes are programmed incrementally on top of warm-start routes
+    completeWarmStartSync();
+  }
   if (routeState_.needsRetry()) {
     // Trigger initial Fib sync, or schedule retry routes timer if needed.
     retryRoutesSemaphore_.signal();
@@ -524,6 +544,26 @@ Fib::dumpPerfDb() const {
   return perfDb;
 }
 
+void
+Fib::logPerfEvents(thrift::PerfEvents& perfEvents) {
+  if (perfEvents.events()->empty()) {
+    return;
+  }
+  addPerfEvent(
+      perfEvents, myNodeName_, thrift::PerfEventType::FIB_ROUTES_PROGRAMMED);
+
+  const auto totalDuration = getTotalPerfEventsDuration(perfEvents);
+  XLOG(DBG1) << "Route convergence took " << totalDuration.count() << "ms";
+  fb303::fbData->addStatValue(
+      "fib.convergence_time_ms", totalDuration.count(), fb303::AVG);
+  convergenceStats_.record(perfEvents);
+
+  while (perfDb_.size() >= Constants::kPerfBufferSize) {
+    perfDb_.pop_front();
+  }
+  perfDb_.emplace_back(perfEvents);
+}
+
 void
 Fib::printUnicastRoutesAddUpdate(
     const std::vector<thrift::UnicastRoute>& unicastRoutesToUpdate) {
@@ -822,6 +862,11 @@ Fib::updateRoutes(
     success &= updateMplsRoutes(
         useDeleteDelay, currentTime, retryAt, routeUpdate, routeDbDelta);
   }
+  // Routes of the update have converged
+  if (success and routeUpdate.perfEvents.has_value()) {
+    logPerfEvents(routeUpdate.perfEvents.value());
+  }
+
   // Log statistics
   const auto elapsedTime = std::chrono::ceil<std::chrono::milliseconds>(
       std::chrono::steady_clock::now() - currentTime);
@@ -832,6 +877,12 @@ Fib::updateRoutes(
   fb303::fbData->addStatValue(
       "fib.num_of_route_updates", routeUpdate.size(), fb303::SUM);
 
+  // Routes programmed on top of synced warm-start routes are published by
+  // `completeWarmStartSync` along with all the other programmed routes
+  if (routeState_.isWarmStartSynced) {
+    return success;
+  }
+
   // Publish the route update. Clear MPLS routes if segment routing is disabled
   routeUpdate.type = DecisionRouteUpdate::INCREMENTAL;
   if (not enableSegmentRouting_) {
@@ -961,6 +1012,24 @@ Fib::syncRoutes() {
   XLOG(INFO) << "It took " << elapsedTime.count() << "ms to sync routes in FIB";
   fb303::fbData->setCounter("fib.route_sync.time_ms", elapsedTime.count());
 
+  // Routes of warm-start snapshot are synced. Publication of routes and initial
+  // sync are deferred until computed routes from Decision are programmed.
+  if (routeState_.isWarmStart) {
+    XLOG(INFO) << "Synced " << unicastRoutes.size()
+               << " unicast routes of warm-start snapshot";
+    fb303::fbData->setCounter(
+        "fib.warm_start.synced_routes", unicastRoutes.size());
+    fb303::fbData->setCounter(
+        "fib.warm_start.time_to_fib_ms",
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startTime_)
+            .count());
+    routeState_.isWarmStartSynced = true;
+    transitionRouteState(RouteState::FIB_SYNCED);
+    return true;
+  }
+  routeState_.isWarmStartSynced = false;
+
   // Publish route update. We'll do so only if sync is successful for both MPLS
   // and Unicast routes.
   // NOTE: even empty Fib sync will be published to fibRouteUpdatesQueue_.
@@ -973,12 +1042,50 @@ Fib::syncRoutes() {
   // Transition state on successful sync. Also record our first sync
   transitionRouteState(RouteState::FIB_SYNCED);
   if (not routeState_.isInitialSynced) {
-    routeState_.isInitialSynced = true;
-    logInitializationEvent("Fib", thrift::InitializationEvent::FIB_SYNCED);
+    logInitialSync(std::nullopt);
   }
   return true;
 }
 
+void
+Fib::completeWarmStartSync() {
+  routeState_.isWarmStartSynced = false;
+
+  // Publish all programmed routes. Routes pending (re-)programming are
+  // published once programmed.
+  DecisionRouteUpdate fibRouteUpdates;
+  fibRouteUpdates.type = DecisionRouteUpdate::FULL_SYNC;
+  for (auto const& [prefix, route] : routeState_.unicastRoutes) {
+    if (not routeState_.dirtyPrefixes.count(prefix)) {
+      fibRouteUpdates.unicastRoutesToUpdate.emplace(prefix, route);
+    }
+  }
+  if (enableSegmentRouting_) {
+    for (auto const& [label, route] : routeState_.mplsRoutes) {
+      if (not routeState_.dirtyLabels.count(label)) {
+        fibRouteUpdates.mplsRoutesToUpdate.emplace(label, route);
+      }
+    }
+  }
+  fibRouteUpdatesQueue_.push(std::move(fibRouteUpdates));
+
+  if (not routeState_.isInitialSynced) {
+    logInitialSync("Computed routes replaced warm-start routes");
+  }
+}
+
+void
+Fib::logInitialSync(std::optional<std::string> const& message) {
+  routeState_.isInitialSynced = true;
+  logInitializationEvent(
+      "Fib", thrift::InitializationEvent::FIB_SYNCED, message);
+  fb303::fbData->setCounter(
+      "fib.time_to_correct_fib_ms",
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - startTime_)
+          .count());
+}
+
 void
 Fib::retryRoutesTask(folly::fibers::Baton& stopSignal) noexcept {
   auto timeout = folly::AsyncTimeout::make(
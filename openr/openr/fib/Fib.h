@@ -11,6 +11,7 @@
 #include <folly/io/async/AsyncSocket.h>
 #include <folly/io/async/AsyncTimeout.h>
 
+#include <openr/common/ConvergenceStats.h>
 #include <openr/common/ExponentialBackoff.h>
 #include <openr/common/OpenrEventBase.h>
 #include <openr/config/Config.h>
@@ -108,6 +109,12 @@ class Fib final : public OpenrEventBase {
    */
   folly::SemiFuture<std::unique_ptr<thrift::PerfDatabase>> getPerfDb();
 
+  /**
+   * Retrieve latency distributions of convergence stages
+   */
+  folly::SemiFuture<std::unique_ptr<thrift::ConvergenceStats>>
+  getConvergenceStats();
+
   /**
    * API to get reader for fibUpdatesQueue
    */
@@ -128,6 +135,12 @@ class Fib final : public OpenrEventBase {
    */
   thrift::PerfDatabase dumpPerfDb() const;
 
+  /**
+   * Complete perf events of programmed route update. Record them in perfDb_
+   * and in convergence stats.
+   */
+  void logPerfEvents(thrift::PerfEvents& perfEvents);
+
   /**
    * Retrieve unicast routes with specified filters
    */
@@ -197,6 +210,18 @@ class Fib final : public OpenrEventBase {
    */
   bool syncRoutes();
 
+  /**
+   * Complete initial sync after computed routes replaced the synced routes of
+   * warm-start snapshot. Publishes all programmed routes as FULL_SYNC.
+   */
+  void completeWarmStartSync();
+
+  /**
+   * Record first programming of routes computed by Decision, i.e. time to
+   * first correct FIB, with or without warm-start.
+   */
+  void logInitialSync(std::optional<std::string> const& message);
+
   /**
    * Implements route re-programming logic, for failed routes and delayed route
    * deletion.
@@ -281,6 +306,14 @@ class Fib final : public OpenrEventBase {
     // Flag to indicate first sync
     bool isInitialSynced{false};
 
+    // Flag to indicate that routes are loaded from warm-start snapshot and not
+    // yet replaced by the routes computed by Decision
+    bool isWarmStart{false};
+
+    // Flag to indicate that routes of warm-start snapshot are synced. Initial
+    // sync is completed once computed routes are programmed incrementally.
+    bool isWarmStartSynced{false};
+
     /**
      * Does current route state needs (re-)programming of routes
      */
@@ -341,6 +374,9 @@ class Fib final : public OpenrEventBase {
   // Events to capture and indicate performance of protocol convergence.
   std::deque<thrift::PerfEvents> perfDb_;
 
+  // Latency distributions of convergence stages
+  ConvergenceStats convergenceStats_{"fib.convergence"};
+
   // Name of node on which OpenR is running
   const std::string myNodeName_;
 
@@ -385,6 +421,10 @@ class Fib final : public OpenrEventBase {
   // sync. (Fib streaming)
   messaging::ReplicateQueue<DecisionRouteUpdate>& fibRouteUpdatesQueue_;
 
+  // Time of Fib creation. Reference for time to first correct FIB.
+  const std::chrono::steady_clock::time_point startTime_{
+      std::chrono::steady_clock::now()};
+
   // Latest aliveSince heard from FibService. If the next one is different then
   // it means that FibAgent has restarted and we need to perform sync.
   int64_t latestAliveSince_{0};
@@ -1946,6 +1946,195 @@ TEST_F(FibTestFixture, RouteProgrammingWithPersistentFailure) {
   }
 }
 
+/**
+ * Routes of warm-start snapshot published by Decision ahead of computed routes
+ */
+DecisionRouteUpdate
+createWarmStartRouteUpdate() {
+  DecisionRouteUpdate routeUpdate;
+  routeUpdate.type = DecisionRouteUpdate::FULL_SYNC;
+  routeUpdate.warmStart = true;
+  routeUpdate.addRouteToUpdate(
+      RibUnicastEntry(toIPNetwork(prefix1), {path1_2_1}));
+  routeUpdate.addRouteToUpdate(
+      RibUnicastEntry(toIPNetwork(prefix2), {path1_2_1}));
+  routeUpdate.addMplsRouteToUpdate(RibMplsEntry(label1, {mpls_path1_2_1}));
+  return routeUpdate;
+}
+
+/**
+ * First computed routes, as diffed by Decision against the warm-start routes.
+ * Prefix1 is stale, Prefix2 is changed and Prefix3 is new.
+ */
+DecisionRouteUpdate
+createComputedRouteUpdate() {
+  DecisionRouteUpdate routeUpdate;
+  routeUpdate.type = DecisionRouteUpdate::FULL_SYNC;
+  routeUpdate.addRouteToUpdate(
+      RibUnicastEntry(toIPNetwork(prefix2), {path1_2_2}));
+  routeUpdate.addRouteToUpdate(
+      RibUnicastEntry(toIPNetwork(prefix3), {path1_2_1}));
+  routeUpdate.unicastRoutesToDelete.emplace_back(toIPNetwork(prefix1));
+  return routeUpdate;
+}
+
+/**
+ * Routes programmed once computed routes replaced the warm-start routes
+ */
+DecisionRouteUpdate
+createWarmStartExpectedPublication() {
+  DecisionRouteUpdate routeUpdate;
+  routeUpdate.type = DecisionRouteUpdate::FULL_SYNC;
+  routeUpdate.addRouteToUpdate(
+      RibUnicastEntry(toIPNetwork(prefix2), {path1_2_2}));
+  routeUpdate.addRouteToUpdate(
+      RibUnicastEntry(toIPNetwork(prefix3), {path1_2_1}));
+  routeUpdate.addMplsRouteToUpdate(RibMplsEntry(label1, {mpls_path1_2_1}));
+  return routeUpdate;
+}
+
+/**
+ * Test covers
+ * - Warm-start routes are synced, but neither published nor marked as
+ *   initial FIB sync
+ * - Computed routes are programmed incrementally on top of them and all
+ *   programmed routes are published as FULL_SYNC
+ * - Stale warm-start route is deleted after delete delay and published as
+ *   INCREMENTAL withdrawal
+ */
+TEST_F(FibTestFixture, WarmStartRoutesReplacedByComputedRoutes) {
+  fb303::fbData->resetAllData();
+  const auto fibSyncedKey = fmt::format(
+      Constants::kInitEventCounterFormat,
+      apache::thrift::util::enumNameSafe(
+          thrift::InitializationEvent::FIB_SYNCED));
+  std::vector<thrift::UnicastRoute> routes;
+  std::vector<thrift::MplsRoute> mplsRoutes;
+
+  //
+  // 1) Warm-start routes are synced
+  //
+  routeUpdatesQueue.push(createWarmStartRouteUpdate());
+  mockFibHandler_->waitForSyncFib();
+  mockFibHandler_->waitForSyncMplsFib();
+  mockFibHandler_->getRouteTableByClient(routes, kFibId);
+  EXPECT_EQ(2, routes.size());
+  mockFibHandler_->getMplsRouteTableByClient(mplsRoutes, kFibId);
+  EXPECT_EQ(1, mplsRoutes.size());
+
+  while (not fb303::fbData->hasCounter("fib.warm_start.synced_routes")) {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(2, fb303::fbData->getCounter("fib.warm_start.synced_routes"));
+  EXPECT_TRUE(fb303::fbData->hasCounter("fib.warm_start.time_to_fib_ms"));
+  EXPECT_FALSE(fb303::fbData->hasCounter(fibSyncedKey));
+  EXPECT_FALSE(fb303::fbData->hasCounter("fib.time_to_correct_fib_ms"));
+
+  //
+  // 2) Computed routes are programmed incrementally. First publication is the
+  //    FULL_SYNC of programmed routes, without the pending stale route.
+  //
+  routeUpdatesQueue.push(createComputedRouteUpdate());
+  mockFibHandler_->waitForUpdateUnicastRoutes();
+  mockFibHandler_->getRouteTableByClient(routes, kFibId);
+  EXPECT_EQ(3, routes.size());
+
+  auto publication = fibRouteUpdatesQueueReader.get().value();
+  EXPECT_TRUE(checkEqualDecisionRouteUpdate(
+      createWarmStartExpectedPublication(), publication));
+
+  while (not fb303::fbData->hasCounter(fibSyncedKey)) {
+    std::this_thread::yield();
+  }
+  EXPECT_TRUE(fb303::fbData->hasCounter("fib.time_to_correct_fib_ms"));
+
+  //
+  // 3) Stale route is deleted after delete delay
+  //
+  mockFibHandler_->waitForDeleteUnicastRoutes();
+  mockFibHandler_->getRouteTableByClient(routes, kFibId);
+  EXPECT_EQ(2, routes.size());
+  for (auto const& route : routes) {
+    EXPECT_NE(prefix1, *route.dest());
+  }
+
+  publication = fibRouteUpdatesQueueReader.get().value();
+  EXPECT_EQ(DecisionRouteUpdate::INCREMENTAL, publication.type);
+  EXPECT_EQ(0, publication.unicastRoutesToUpdate.size());
+  ASSERT_EQ(1, publication.unicastRoutesToDelete.size());
+  EXPECT_EQ(toIPNetwork(prefix1), publication.unicastRoutesToDelete.at(0));
+}
+
+/**
+ * Computed routes identical to the warm-start routes result in an empty
+ * update. It must still complete the initial sync.
+ */
+TEST_F(FibTestFixture, WarmStartRoutesConfirmedByEmptyUpdate) {
+  std::vector<thrift::UnicastRoute> routes;
+
+  routeUpdatesQueue.push(createWarmStartRouteUpdate());
+  mockFibHandler_->waitForSyncFib();
+  mockFibHandler_->waitForSyncMplsFib();
+
+  DecisionRouteUpdate emptyUpdate;
+  emptyUpdate.type = DecisionRouteUpdate::FULL_SYNC;
+  routeUpdatesQueue.push(std::move(emptyUpdate));
+
+  // Warm-start routes are published as FULL_SYNC of programmed routes
+  auto publication = fibRouteUpdatesQueueReader.get().value();
+  auto expected = createWarmStartRouteUpdate();
+  expected.warmStart = false;
+  EXPECT_TRUE(checkEqualDecisionRouteUpdate(expected, publication));
+
+  mockFibHandler_->getRouteTableByClient(routes, kFibId);
+  EXPECT_EQ(2, routes.size());
+}
+
+/**
+ * Computed routes arriving before warm-start routes are synced are merged
+ * into the pending sync. Initial sync then programs and publishes only the
+ * computed routes.
+ */
+TEST_F(FibTestFixture, WarmStartComputedRoutesBeforeSync) {
+  std::vector<thrift::UnicastRoute> routes;
+  std::vector<thrift::MplsRoute> mplsRoutes;
+
+  // Fail sync of warm-start routes
+  mockFibHandler_->setHandlerHealthyState(false);
+  routeUpdatesQueue.push(createWarmStartRouteUpdate());
+  mockFibHandler_->waitForUnhealthyException();
+
+  // Computed routes replace warm-start routes in pending sync
+  routeUpdatesQueue.push(createComputedRouteUpdate());
+  auto hasComputedRoutes = [&]() {
+    for (auto const& route : *getRouteDb().unicastRoutes()) {
+      if (*route.dest() == prefix3) {
+        return true;
+      }
+    }
+    return false;
+  };
+  while (not hasComputedRoutes()) {
+    std::this_thread::yield();
+  }
+
+  // Sync succeeds with computed routes only. Stale route is never programmed.
+  mockFibHandler_->setHandlerHealthyState(true);
+  mockFibHandler_->waitForSyncFib();
+  mockFibHandler_->waitForSyncMplsFib();
+  mockFibHandler_->getRouteTableByClient(routes, kFibId);
+  EXPECT_EQ(2, routes.size());
+  for (auto const& route : routes) {
+    EXPECT_NE(prefix1, *route.dest());
+  }
+  mockFibHandler_->getMplsRouteTableByClient(mplsRoutes, kFibId);
+  EXPECT_EQ(1, mplsRoutes.size());
+
+  auto publication = fibRouteUpdatesQueueReader.get().value();
+  EXPECT_TRUE(checkEqualDecisionRouteUpdate(
+      createWarmStartExpectedPublication(), publication));
+}
+
 TEST(FibTest, createFibClientRetryTest) {
   // Ensure that we could retry createFibClient without crashing
   folly::EventBase evb;
@@ -383,6 +383,14 @@ struct Publication {
    * in milliseconds since epoch
    */
   8: optional i64 timestamp_ms;
+
+  /**
+   * Optional sequence number of the publication on OpenrCtrl KvStore streams.
+   * Increases monotonically, including across restarts of the node. Snapshot
+   * responses carry the sequence number of the last publication reflected in
+   * them. Used to resume the stream with `resumeAreaKvStores`.
+   */
+  9: optional i64 seqNum;
 }
 
 /**
@@ -475,6 +483,8 @@ struct KvStoreConfig {
   15: i32 sync_initial_backoff_ms = 4000;
   16: i32 sync_max_backoff_ms = 256000;
   17: optional i32 self_adjacency_timeout_ms;
+  /** Run KvStoreDb of every area on its own event base and thread. */
+  18: bool enable_per_area_event_base = false;
 }
 
 /**
@@ -84,6 +84,13 @@ struct KvstoreConfig {
   8: i32 sync_initial_backoff_ms = 4000;
   9: i32 sync_max_backoff_ms = 256000;
   10: optional i32 self_adjacency_timeout_ms;
+  /**
+   * Run KvStore database of every area on its own event base and thread,
+   * instead of all on the KvStore event base. Sync or flood storms in an area
+   * then don't delay flooding and TTL refreshes in other areas. Meant for
+   * nodes with several large areas.
+   */
+  11: bool enable_per_area_event_base = false;
 }
 
 /*
@@ -109,6 +116,28 @@ enum RouteSelectionAlgorithm {
   PER_AREA_SHORTEST_DISTANCE = 2,
 }
 
+/**
+ * SPF back-off delay algorithm of RFC 8405 for route computation in Decision.
+ * First event after a quiet period is computed after `initial_delay_ms`.
+ * Events within `time_to_learn_ms` are computed after `short_delay_ms`, and
+ * later ones after `long_delay_ms` until no event is received for
+ * `hold_down_ms`.
+ */
+struct SpfBackoffConfig {
+  /** Delay of computation in QUIET state (in milliseconds). */
+  1: i32 initial_delay_ms = 50;
+  /** Delay of computation in SHORT_WAIT state (in milliseconds). */
+  2: i32 short_delay_ms = 200;
+  /** Delay of computation in LONG_WAIT state (in milliseconds). */
+  3: i32 long_delay_ms = 5000;
+  /** Time since leaving QUIET state after which state moves from SHORT_WAIT
+  to LONG_WAIT (in milliseconds). */
+  4: i32 time_to_learn_ms = 500;
+  /** Time without events after which state moves back to QUIET
+  (in milliseconds). */
+  5: i32 hold_down_ms = 10000;
+}
+
 struct DecisionConfig {
   /** Fast reaction time to update decision SPF upon receiving adj db update
   (in milliseconds). */
@@ -124,6 +153,21 @@ struct DecisionConfig {
   4: i32 save_rib_policy_max_ms = 60000;
   /** After initial KV store sync completes, wait for this timeout. If initial route computation is still blocked when the timeout expires, force initial route computation. */
   5: i32 unblock_initial_routes_ms = 120000;
+  /** Number of threads used to build routes from SPF results. SPF and node
+  label routes of areas run in parallel, and route selection and next-hop
+  computation of prefixes is sharded across these threads. Value of 1 builds
+  routes sequentially on the Decision thread. */
+  6: i32 route_build_threads = 1;
+  /** Persist computed routes to `--route_snapshot_file` and program them on
+  restart before initial route computation completes (warm-start). Routes are
+  replaced by the computed routes with an incremental update once initial
+  route computation completes. */
+  7: bool enable_warm_start = false;
+  /** Snapshots older than this (in seconds) are not used for warm-start. */
+  8: i32 warm_start_max_age_s = 300;
+  /** Schedule route computation with SPF back-off of RFC 8405 in place of
+  exponential debounce of `debounce_min_ms` and `debounce_max_ms`. */
+  9: optional SpfBackoffConfig spf_backoff_config;
 }
 
 struct LinkMonitorConfig {
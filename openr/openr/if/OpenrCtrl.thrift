@@ -81,6 +81,8 @@ struct StreamSubscriberInfo {
   3: i64 last_msg_sent_time;
   // Total number of messages streamed
   4: i64 total_streamed_msgs;
+  // Number of messages pending to be consumed by the subscriber
+  5: optional i64 pending_msgs;
 }
 
 //
@@ -113,6 +115,19 @@ struct AdjacenciesFilter {
 // RIB Policy related data structures
 //
 
+/**
+ * Prefix range for route selection. A route matches if it is covered by
+ * `prefix` and its prefix length is within [ge, le]. `ge` defaults to the
+ * length of `prefix` and `le` defaults to `ge`, which makes a range without
+ * bounds an exact prefix match. Setting `le` to the address width (32 or 128)
+ * selects `prefix` and all longer prefixes covered by it.
+ */
+struct RibRoutePrefixRange {
+  1: Network.IpPrefix prefix;
+  2: optional i16 ge;
+  3: optional i16 le;
+}
+
 /**
  * Matcher selects the routes. As of now supports selecting specified routes,
  * but can be expanded to select route by tags as well.
@@ -126,6 +141,10 @@ struct RibRouteMatcher {
 
   // Select route based on the tag. Specifying multiple tag match on any
   2: optional list<string> tags;
+
+  // Select route if it is covered by any of the prefix ranges. Prefixes and
+  // prefix ranges are OR'ed together.
+  3: optional list<RibRoutePrefixRange> prefix_ranges;
 }
 
 /**
@@ -464,6 +483,20 @@ service OpenrCtrl extends KvStore.KvStoreService {
 
   Types.PerfDatabase getPerfDb() throws (1: OpenrError error);
 
+  /**
+   * Get latency distributions of convergence stages. Percentiles are also
+   * exported as fb303 counters `fib.convergence.<stage>_ms.p50|p90|p99`.
+   */
+  Types.ConvergenceStats getConvergenceStats() throws (1: OpenrError error);
+
+  /**
+   * Get event loop lag and busy time of every module's event base, and
+   * enqueue to dequeue latency of every reader queue of inter-module queues.
+   * Percentiles are also exported as fb303 counters
+   * `watchdog.evb.<module>.*` and `messaging.rw_queue.<queue>-<id>.*`.
+   */
+  Types.RuntimeStats getRuntimeStats() throws (1: OpenrError error);
+
   //
   // Decision APIs
   //
@@ -701,6 +734,13 @@ service OpenrCtrl extends KvStore.KvStoreService {
   // Get log events
   list<string> getEventLogs() throws (1: OpenrError error);
 
+  /**
+   * Get CPU profile of every module's thread as folded stacks (requires
+   * --cpu_profiler_hz), and heap usage along with recent heap profile dumps
+   * (requires memory profiling in config and jemalloc).
+   */
+  Types.ProcessProfile getProcessProfile() throws (1: OpenrError error);
+
   // Get Openr Node Name
   string getMyNodeName();
 
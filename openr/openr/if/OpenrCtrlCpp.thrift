@@ -42,6 +42,25 @@ service OpenrCtrlCpp extends OpenrCtrl.OpenrCtrl {
     2: set<string> selectAreas,
   );
 
+  /**
+   * Resume KvStore stream after reconnection. Publications with sequence
+   * number greater than `lastSeqNum` are replayed on the stream, followed by
+   * subsequent updates. Throws if any of the missed publications is no longer
+   * retained, in which case client must fall back to
+   * `subscribeAndGetAreaKvStores`. Publications are retained for a few
+   * minutes after the last stream ended, up to a bounded number and size.
+   *
+   * Streams with `filter` or `selectAreas` only receive matching publications.
+   * To keep them resumable across unrelated publications, they also receive
+   * publications without key-values and expired keys, which only advance the
+   * sequence number.
+   */
+  stream<KvStore.Publication> resumeAreaKvStores(
+    1: KvStore.KeyDumpParams filter,
+    2: set<string> selectAreas,
+    3: i64 lastSeqNum,
+  ) throws (1: OpenrCtrl.OpenrError error);
+
   /**
    * Retrieve Fib snapshot and subscribe for subsequent updates.
    * No update between snapshot and fullstream will be lost,
@@ -53,4 +72,13 @@ service OpenrCtrlCpp extends OpenrCtrl.OpenrCtrl {
   OpenrCtrl.RouteDatabaseDetail, stream<
     OpenrCtrl.RouteDatabaseDeltaDetail
   > subscribeAndGetFibDetail();
+
+  /**
+   * Resume Fib stream after reconnection. Same semantics as
+   * `resumeAreaKvStores`, client must fall back to `subscribeAndGetFib` on
+   * error.
+   */
+  stream<Types.RouteDatabaseDelta> resumeFib(1: i64 lastSeqNum) throws (
+    1: OpenrCtrl.OpenrError error,
+  );
 }
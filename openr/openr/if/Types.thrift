@@ -73,6 +73,28 @@ enum LinkStatusEnum {
   UP = 1,
 }
 
+/**
+ * Numeric identifier of perf events marking the boundaries of convergence
+ * stages, from adjacency change to route programming. Name of the enum value
+ * is used as `eventDescr`.
+ */
+enum PerfEventType {
+  // Ad-hoc event identified by `eventDescr` only
+  UNKNOWN = 0,
+  // [LinkMonitor] adjacency database is updated and advertised
+  ADJ_DB_UPDATED = 1,
+  // [Decision] update is received from KvStore
+  DECISION_RECEIVED = 2,
+  // [Decision] debounced route computation is triggered
+  DECISION_DEBOUNCE = 3,
+  // [Decision] routes are computed and published
+  ROUTE_UPDATE = 4,
+  // [Fib] routes are received from Decision
+  FIB_ROUTE_DB_RECVD = 5,
+  // [Fib] routes are programmed by FibService
+  FIB_ROUTES_PROGRAMMED = 6,
+}
+
 /**
  * Event object to track the key attribute and timestamp used for performance
  * measurement.
@@ -81,6 +103,11 @@ struct PerfEvent {
   1: string nodeName;
   2: string eventDescr;
   3: i64 unixTs = 0;
+  /**
+   * Numeric identifier of the event. UNKNOWN for events originated by older
+   * versions, which are identified by `eventDescr`.
+   */
+  4: PerfEventType type = PerfEventType.UNKNOWN;
 }
 
 /**
@@ -470,6 +497,50 @@ struct RouteDatabase {
    * Label routes with forwarding information
    */
   5: list<Network.MplsRoute> mplsRoutes;
+
+  /**
+   * Sequence number of the last RouteDatabaseDelta reflected in this snapshot.
+   * Set only in `subscribeAndGetFib` response.
+   */
+  6: optional i64 seqNum;
+}
+
+/**
+ * Unicast route computed by Decision along with the route selection attributes
+ * which are not part of `UnicastRoute`. Element of `RouteDatabaseSnapshot`.
+ */
+struct RibUnicastEntrySnapshot {
+  1: Network.UnicastRoute route;
+  2: PrefixEntry bestPrefixEntry;
+  3: string bestArea;
+  4: i64 igpCost;
+  5: bool doNotInstall;
+  6: bool localRouteConsidered;
+}
+
+/**
+ * Snapshot of the route database computed by Decision. It is persisted across
+ * Open/R restarts and used to warm-start Decision and Fib.
+ */
+struct RouteDatabaseSnapshot {
+  /**
+   * Version of the snapshot format. Snapshots of other versions are ignored.
+   */
+  1: i32 version;
+
+  /**
+   * Name of the node which computed the routes
+   */
+  2: string thisNodeName;
+
+  /**
+   * Time in milliseconds since epoch when snapshot was taken
+   */
+  3: i64 timestampMs;
+
+  4: list<RibUnicastEntrySnapshot> unicastRoutes;
+
+  5: list<Network.MplsRoute> mplsRoutes;
 }
 
 /**
@@ -501,6 +572,13 @@ struct RouteDatabaseDelta {
    * to derive the convergence time
    */
   6: optional PerfEvents perfEvents;
+
+  /**
+   * Sequence number of the delta on OpenrCtrl Fib streams. Increases
+   * monotonically, including across restarts of the node. Used to resume the
+   * stream with `resumeFib`.
+   */
+  7: optional i64 seqNum;
 }
 
 /**
@@ -520,6 +598,142 @@ struct PerfDatabase {
   2: list<PerfEvents> eventInfo;
 }
 
+/**
+ * Latency distribution of a convergence stage, since process start.
+ */
+struct LatencyStats {
+  1: i64 count = 0;
+  2: i64 minMs = 0;
+  3: i64 maxMs = 0;
+  4: i64 avgMs = 0;
+  5: i64 p50Ms = 0;
+  6: i64 p90Ms = 0;
+  7: i64 p99Ms = 0;
+  /**
+   * Non-empty histogram buckets, upper bound (inclusive) in ms to number of
+   * samples. Bucket boundaries are fixed, and hence histograms of different
+   * nodes can be summed up to compute fleet-wide percentiles.
+   */
+  8: map<i64, i64> buckets;
+}
+
+/**
+ * Latency distributions of convergence stages, measured from the perf events
+ * of route updates programmed by Fib. Stages are
+ * - flood: ADJ_DB_UPDATED (originating node) -> DECISION_RECEIVED
+ * - spf: DECISION_RECEIVED -> ROUTE_UPDATE
+ * - fib_program: ROUTE_UPDATE -> FIB_ROUTES_PROGRAMMED
+ * - total: first event -> FIB_ROUTES_PROGRAMMED
+ */
+struct ConvergenceStats {
+  1: string thisNodeName;
+  2: map<string, LatencyStats> stages;
+}
+
+/**
+ * Event loop iteration of a module whose busy time exceeded the slow loop
+ * threshold.
+ */
+struct SlowLoop {
+  1: i64 unixTs = 0;
+  2: i64 busyTimeUs = 0;
+}
+
+/**
+ * Event loop health of a module's event base, over the recent window.
+ * - loopLag: delay of timers past their scheduled time, i.e. how long a newly
+ *   queued task waits for the loop
+ * - busyTime: time spent running callbacks and fiber tasks per loop iteration
+ */
+struct EventBaseStats {
+  1: string name;
+  2: i64 loopLagP50Us = 0;
+  3: i64 loopLagP99Us = 0;
+  4: i64 loopLagMaxUs = 0;
+  5: i64 busyTimeP50Us = 0;
+  6: i64 busyTimeP99Us = 0;
+  7: i64 busyTimeMaxUs = 0;
+  /**
+   * Number of slow loop iterations since start, and the most recent of them
+   */
+  8: i64 numSlowLoops = 0;
+  9: list<SlowLoop> slowLoops;
+  /**
+   * Number of callbacks queued from other threads, pending execution
+   */
+  10: i64 notificationQueueSize = 0;
+}
+
+/**
+ * Enqueue to dequeue latency of a reader queue of a ReplicateQueue, over the
+ * recent window.
+ */
+struct QueueLatencyStats {
+  1: string name;
+  2: i64 size = 0;
+  3: i64 reads = 0;
+  4: i64 writes = 0;
+  5: i64 latencyP50Us = 0;
+  6: i64 latencyP99Us = 0;
+  7: i64 latencyMaxUs = 0;
+}
+
+/**
+ * Runtime stats of all event bases and queues monitored by Watchdog
+ */
+struct RuntimeStats {
+  1: string thisNodeName;
+  2: list<EventBaseStats> eventBases;
+  3: list<QueueLatencyStats> queues;
+}
+
+/**
+ * CPU samples of a module's thread, over the last five to ten minutes.
+ */
+struct ModuleCpuProfile {
+  1: string module;
+  /**
+   * Number of samples taken, including dropped ones. Samples are dropped if
+   * they overflow the per-thread buffer, or the bounded number of distinct
+   * stacks per module.
+   */
+  2: i64 numSamples = 0;
+  3: i64 numDroppedSamples = 0;
+  /**
+   * Folded stacks, i.e. frames from root to leaf separated by ';', to number
+   * of samples. Can be rendered with flamegraph.pl.
+   */
+  4: map<string, i64> foldedStacks;
+}
+
+/**
+ * Heap usage reported by the allocator, along with most recent heap profile
+ * dumps, oldest first.
+ */
+struct HeapProfile {
+  1: i64 allocatedBytes = 0;
+  2: i64 activeBytes = 0;
+  3: i64 residentBytes = 0;
+  4: list<string> dumpFiles;
+}
+
+/**
+ * In-process CPU and heap profile
+ */
+struct ProcessProfile {
+  1: string thisNodeName;
+  /**
+   * Samples per second of CPU time of every thread, 0 if CPU profiler is
+   * disabled.
+   */
+  2: i32 cpuProfilerHz = 0;
+  3: list<ModuleCpuProfile> modules;
+  /**
+   * Set if allocator supports heap introspection, i.e. jemalloc
+   */
+  4: optional HeapProfile heap;
+}
+
 /**
  * Details about an interface in Open/R
  */
@@ -996,3 +1210,25 @@ struct SparkNeighbor {
    */
   13: i64 lastHeartbeatMsgSentTimeDelta = 0;
 }
+
+/**
+ * Binary representation of an event log sample, see `openr/monitor/LogSample.h`
+ * for details. Attributes are grouped by value type. Records are appended to
+ * the event log file length-prefixed with CompactSerializer.
+ */
+struct EventLogRecord {
+  /**
+   * Timestamp of the event in microseconds since epoch (system clock)
+   */
+  1: i64 timestampUs = 0;
+
+  2: map<string, i64> ints;
+
+  3: map<string, double> doubles;
+
+  4: map<string, string> strings;
+
+  5: map<string, list<string>> stringVectors;
+
+  6: map<string, set<string>> stringTagsets;
+}
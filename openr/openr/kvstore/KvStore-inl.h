@@ -8,11 +8,13 @@
 #include <fb303/ServiceData.h>
 #include <folly/io/async/SSLContext.h>
 #include <folly/logging/xlog.h>
+#include <folly/system/ThreadName.h>
 
 #include <openr/common/Constants.h>
 #include <openr/common/EventLogger.h>
 #include <openr/common/Types.h>
 #include <openr/if/gen-cpp2/KvStore_types.h>
+#include <openr/monitor/CpuProfiler.h>
 
 namespace fb303 = facebook::fb303;
 
@@ -30,9 +32,12 @@ KvStore<ClientType>::KvStore(
     : kvParams_(kvStoreConfig, kvStoreUpdatesQueue, logSampleQueue) {
   // Schedule periodic timer for counters submission
   counterUpdateTimer_ = folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
-    for (auto& [key, val] : getGlobalCounters()) {
-      fb303::fbData->setCounter(key, val);
-    }
+    collectGlobalCounters().via(getEvb()).thenValue(
+        [](std::map<std::string, int64_t>&& counters) {
+          for (auto& [key, val] : counters) {
+            fb303::fbData->setCounter(key, val);
+          }
+        });
     counterUpdateTimer_->scheduleTimeout(Constants::kCounterSubmitInterval);
   });
   counterUpdateTimer_->scheduleTimeout(Constants::kCounterSubmitInterval);
@@ -154,18 +159,83 @@ KvStore<ClientType>::KvStore(
   initGlobalCounters();
 
   // create KvStoreDb instances
+  const bool perAreaEvb = *kvStoreConfig.enable_per_area_event_base();
   for (auto const& area : areaIds) {
+    OpenrEventBase* evb = this;
+    std::function<void()> kvStoreSyncedCallback =
+        std::bind(&KvStore::initialKvStoreDbSynced, this);
+    std::function<void()> selfOriginatedKeysSyncedCallback =
+        std::bind(&KvStore::initialSelfOriginatedKeysSynced, this);
+    std::function<void(thrift::Publication&&)> publishUpdateCallback =
+        [this](thrift::Publication&& publication) {
+          kvParams_.kvStoreUpdatesQueue.push(std::move(publication));
+        };
+    if (perAreaEvb) {
+      auto areaEvb = std::make_unique<OpenrEventBase>();
+      areaEvb->setEvbName(fmt::format("kvstore.{}", area));
+      evb = areaEvb.get();
+      areaEvbs_.emplace(area, std::move(areaEvb));
+
+      // Initialization state of KvStore is only accessed on its event base
+      kvStoreSyncedCallback = [this]() {
+        runInEventBaseThread([this]() { initialKvStoreDbSynced(); });
+      };
+      selfOriginatedKeysSyncedCallback = [this]() {
+        runInEventBaseThread([this]() { initialSelfOriginatedKeysSynced(); });
+      };
+      // Updates queue is only pushed to from KvStore event base, which keeps
+      // publications ordered with initialization events
+      publishUpdateCallback = [this](thrift::Publication&& publication) {
+        runInEventBaseThread(
+            [this, publication = std::move(publication)]() mutable {
+              kvParams_.kvStoreUpdatesQueue.push(std::move(publication));
+            });
+      };
+    }
     kvStoreDb_.emplace(
         std::piecewise_construct,
         std::forward_as_tuple(area),
         std::forward_as_tuple(
-            this,
+            evb,
             kvParams_,
             area,
             *kvStoreConfig.node_name(),
-            std::bind(&KvStore::initialKvStoreDbSynced, this),
-            std::bind(&KvStore::initialSelfOriginatedKeysSynced, this)));
+            std::move(kvStoreSyncedCallback),
+            std::move(selfOriginatedKeysSyncedCallback),
+            std::move(publishUpdateCallback)));
   }
+
+  // KvStoreDbs are set up on their event bases before these start running,
+  // same as KvStoreDbs on the KvStore event base.
+  startAreaEventBases();
+}
+
+template <class ClientType>
+void
+KvStore<ClientType>::startAreaEventBases() {
+  for (auto& [_, areaEvb] : areaEvbs_) {
+    areaEvbThreads_.emplace_back([evb = areaEvb.get()]() noexcept {
+      const auto name = evb->getEvbName();
+      XLOG(INFO) << fmt::format("Starting {} thread ...", name);
+      folly::setThreadName(name);
+      CpuProfiler::registerThread(name);
+      evb->run();
+      XLOG(INFO) << fmt::format("[Exit] Successfully stopped {} thread.", name);
+    });
+    areaEvb->waitUntilRunning();
+  }
+}
+
+template <class ClientType>
+void
+KvStore<ClientType>::stopAreaEventBases() {
+  for (auto& [_, areaEvb] : areaEvbs_) {
+    areaEvb->stop();
+  }
+  for (auto& thread : areaEvbThreads_) {
+    thread.join();
+  }
+  areaEvbThreads_.clear();
 }
 
 template <class ClientType>
@@ -192,6 +262,10 @@ KvStore<ClientType>::stop() {
   // waits for all child fibers to complete
   folly::collectAll(kvStoreWorkers_.begin(), kvStoreWorkers_.end()).get();
 
+  // NOTE: Child fibers may wait on work run on event bases of areas. Stop
+  // them only once all fibers completed.
+  stopAreaEventBases();
+
   // NOTE: folly::AsyncTimeout and AsyncThrottle must be tear-down in evb loop
   getEvb()->runImmediatelyOrRunInEventBaseThreadAndWait(
       [this]() { counterUpdateTimer_.reset(); });
@@ -234,39 +308,102 @@ KvStore<ClientType>::getAreaDbOrThrow(
   return search->second;
 }
 
+template <class ClientType>
+OpenrEventBase*
+KvStore<ClientType>::getAreaEvb(std::string const& areaId) {
+  auto search = kvStoreDb_.find(areaId);
+  if (kvStoreDb_.end() != search) {
+    return search->second.getEvb();
+  }
+  // Fallback of getAreaDbOrThrow() to the single configured area
+  if (kvStoreDb_.size() == 1) {
+    return kvStoreDb_.begin()->second.getEvb();
+  }
+  return this;
+}
+
+template <class ClientType>
+template <typename Func>
+folly::SemiFuture<
+    folly::lift_unit_t<std::invoke_result_t<Func, KvStoreDb<ClientType>&>>>
+KvStore<ClientType>::runInAreaEventBase(
+    std::string const& areaId, std::string const& caller, Func&& func) {
+  using ResultT =
+      folly::lift_unit_t<std::invoke_result_t<Func, KvStoreDb<ClientType>&>>;
+  auto [p, f] = folly::makePromiseContract<ResultT>();
+  getAreaEvb(areaId)->runInEventBaseThread(
+      [this,
+       p = std::move(p),
+       areaId,
+       caller,
+       func = std::forward<Func>(func)]() mutable {
+        p.setWith([&]() { return func(getAreaDbOrThrow(areaId, caller)); });
+      });
+  return std::move(f);
+}
+
 template <class ClientType>
 void
 KvStore<ClientType>::processKeyValueRequest(KeyValueRequest&& kvRequest) {
   // get area across different variants of KeyValueRequest
-  const auto& area = std::visit(
+  const auto area = std::visit(
       [](auto&& request) -> AreaId { return request.getArea(); }, kvRequest);
 
-  try {
-    auto& kvStoreDb = getAreaDbOrThrow(area, "processKeyValueRequest");
-    if (auto pPersistKvRequest =
-            std::get_if<PersistKeyValueRequest>(&kvRequest)) {
-      kvStoreDb.persistSelfOriginatedKey(
-          pPersistKvRequest->getKey(), pPersistKvRequest->getValue());
-    } else if (
-        auto pSetKvRequest = std::get_if<SetKeyValueRequest>(&kvRequest)) {
-      kvStoreDb.setSelfOriginatedKey(
-          pSetKvRequest->getKey(),
-          pSetKvRequest->getValue(),
-          pSetKvRequest->getVersion());
-    } else if (
-        auto pClearKvRequest = std::get_if<ClearKeyValueRequest>(&kvRequest)) {
-      if (pClearKvRequest->getSetValue()) {
-        kvStoreDb.unsetSelfOriginatedKey(
-            pClearKvRequest->getKey(), pClearKvRequest->getValue());
-      } else {
-        kvStoreDb.eraseSelfOriginatedKey(pClearKvRequest->getKey());
-      }
+  if (areaEvbs_.empty()) {
+    // All areas run on KvStore event base, process request right away
+    try {
+      processAreaKeyValueRequest(
+          getAreaDbOrThrow(area, "processKeyValueRequest"),
+          std::move(kvRequest));
+    } catch (thrift::KvStoreError const&) {
+      XLOG(ERR) << " Failed to find area " << area.t << " in kvStoreDb_.";
+    }
+    return;
+  }
+
+  // Request is not awaited, so that a busy area doesn't hold back requests of
+  // other areas. Order of requests within an area is preserved.
+  runInAreaEventBase(
+      area,
+      "processKeyValueRequest",
+      [kvRequest = std::move(kvRequest)](
+          KvStoreDb<ClientType>& kvStoreDb) mutable {
+        processAreaKeyValueRequest(kvStoreDb, std::move(kvRequest));
+      })
+      .via(getEvb())
+      .thenError([area](const folly::exception_wrapper& ew) {
+        XLOG(ERR) << fmt::format(
+            "Failed to process key-value request in area {}. Exception: {}",
+            area.t,
+            ew.what());
+      });
+}
+
+template <class ClientType>
+void
+KvStore<ClientType>::processAreaKeyValueRequest(
+    KvStoreDb<ClientType>& kvStoreDb, KeyValueRequest&& kvRequest) {
+  if (auto pPersistKvRequest =
+          std::get_if<PersistKeyValueRequest>(&kvRequest)) {
+    kvStoreDb.persistSelfOriginatedKey(
+        pPersistKvRequest->getKey(), pPersistKvRequest->getValue());
+  } else if (
+      auto pSetKvRequest = std::get_if<SetKeyValueRequest>(&kvRequest)) {
+    kvStoreDb.setSelfOriginatedKey(
+        pSetKvRequest->getKey(),
+        pSetKvRequest->getValue(),
+        pSetKvRequest->getVersion());
+  } else if (
+      auto pClearKvRequest = std::get_if<ClearKeyValueRequest>(&kvRequest)) {
+    if (pClearKvRequest->getSetValue()) {
+      kvStoreDb.unsetSelfOriginatedKey(
+          pClearKvRequest->getKey(), pClearKvRequest->getValue());
     } else {
-      XLOG(ERR)
-          << "Error processing key value request. Request type not recognized.";
+      kvStoreDb.eraseSelfOriginatedKey(pClearKvRequest->getKey());
     }
-  } catch (thrift::KvStoreError const&) {
-    XLOG(ERR) << " Failed to find area " << area.t << " in kvStoreDb_.";
+  } else {
+    XLOG(ERR)
+        << "Error processing key value request. Request type not recognized.";
   }
 }
 
@@ -276,6 +413,16 @@ KvStore<ClientType>::getKvStoreUpdatesReader() {
   return kvParams_.kvStoreUpdatesQueue.getReader();
 }
 
+template <class ClientType>
+std::vector<OpenrEventBase*>
+KvStore<ClientType>::getAreaEvbs() const {
+  std::vector<OpenrEventBase*> evbs;
+  for (auto const& [_, areaEvb] : areaEvbs_) {
+    evbs.emplace_back(areaEvb.get());
+  }
+  return evbs;
+}
+
 template <class ClientType>
 void
 KvStore<ClientType>::processPeerUpdates(PeerEvent&& event) {
@@ -299,13 +446,20 @@ KvStore<ClientType>::processPeerUpdates(PeerEvent&& event) {
     // with no peers in the area is treated as syncing completed. Otherwise,
     // 'initialKvStoreDbSynced()' will not publish kvStoreSynced signal, and
     // downstream modules cannot proceed to complete initialization.
-    for (auto& [area, kvStoreDb] : kvStoreDb_) {
-      if (kvStoreDb.getPeerCnt() != 0) {
-        continue;
-      }
-      XLOG(INFO)
-          << fmt::format("[Initialization] Received 0 peers in area {}.", area);
-      kvStoreDb.processInitializationEvent();
+    for (auto& [area, _] : kvStoreDb_) {
+      runInAreaEventBase(
+          area,
+          "processPeerUpdates",
+          [](KvStoreDb<ClientType>& kvStoreDb) {
+            if (kvStoreDb.getPeerCnt() != 0) {
+              return;
+            }
+            XLOG(INFO) << fmt::format(
+                "[Initialization] Received 0 peers in area {}.",
+                kvStoreDb.getAreaId());
+            kvStoreDb.processInitializationEvent();
+          })
+          .get();
     }
   }
 }
@@ -316,26 +470,28 @@ KvStore<ClientType>::semifuture_getKvStoreKeyVals(
     std::string area, thrift::KeyGetParams keyGetParams) {
   folly::Promise<std::unique_ptr<thrift::Publication>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        keyGetParams = std::move(keyGetParams),
-                        area]() mutable {
-    XLOG(DBG3) << "Get key requested for AREA: " << area;
-    try {
-      auto& kvStoreDb = getAreaDbOrThrow(area, "getKvStoreKeyVals");
+  getAreaEvb(area)->runInEventBaseThread(
+      [this,
+       p = std::move(p),
+       keyGetParams = std::move(keyGetParams),
+       area]() mutable {
+        XLOG(DBG3) << "Get key requested for AREA: " << area;
+        try {
+          auto& kvStoreDb = getAreaDbOrThrow(area, "getKvStoreKeyVals");
 
-      auto thriftPub = kvStoreDb.getKeyVals(*keyGetParams.keys());
-      updatePublicationTtl(
-          kvStoreDb.getTtlCountdownQueue(),
-          kvParams_.ttlDecr,
-          thriftPub,
-          false);
+          auto thriftPub = kvStoreDb.getKeyVals(*keyGetParams.keys());
+          updatePublicationTtl(
+              kvStoreDb.getTtlCountdownQueue(),
+              kvParams_.ttlDecr,
+              thriftPub,
+              false);
 
-      p.setValue(std::make_unique<thrift::Publication>(std::move(thriftPub)));
-    } catch (thrift::KvStoreError const& e) {
-      p.setException(e);
-    }
-  });
+          p.setValue(
+              std::make_unique<thrift::Publication>(std::move(thriftPub)));
+        } catch (thrift::KvStoreError const& e) {
+          p.setException(e);
+        }
+      });
   return sf;
 }
 
@@ -345,21 +501,22 @@ KvStore<ClientType>::semifuture_dumpKvStoreSelfOriginatedKeys(
     std::string area) {
   folly::Promise<std::unique_ptr<SelfOriginatedKeyVals>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this, p = std::move(p), area]() mutable {
-    XLOG(DBG3) << "Dump self originated key-vals for AREA: " << area;
-    try {
-      auto& kvStoreDb =
-          getAreaDbOrThrow(area, "semifuture_dumpKvStoreSelfOriginatedKeys");
-      // track self origin key-val dump calls
-      fb303::fbData->addStatValue(
-          "kvstore.cmd_self_originated_key_dump", 1, fb303::COUNT);
+  getAreaEvb(area)->runInEventBaseThread(
+      [this, p = std::move(p), area]() mutable {
+        XLOG(DBG3) << "Dump self originated key-vals for AREA: " << area;
+        try {
+          auto& kvStoreDb = getAreaDbOrThrow(
+              area, "semifuture_dumpKvStoreSelfOriginatedKeys");
+          // track self origin key-val dump calls
+          fb303::fbData->addStatValue(
+              "kvstore.cmd_self_originated_key_dump", 1, fb303::COUNT);
 
-      auto keyVals = kvStoreDb.getSelfOriginatedKeyVals();
-      p.setValue(std::make_unique<SelfOriginatedKeyVals>(keyVals));
-    } catch (thrift::KvStoreError const& e) {
-      p.setException(e);
-    }
-  });
+          auto keyVals = kvStoreDb.getSelfOriginatedKeyVals();
+          p.setValue(std::make_unique<SelfOriginatedKeyVals>(keyVals));
+        } catch (thrift::KvStoreError const& e) {
+          p.setException(e);
+        }
+      });
   return sf;
 }
 
@@ -451,24 +608,58 @@ KvStore<ClientType>::getKvStoreAreaSummaryImpl(
   XLOG(INFO) << fmt::format("KvStore Summary requested for {}", area);
 
   std::vector<thrift::KvStoreAreaSummary> result;
-  for (auto& [area, kvStoreDb] : kvStoreDb_) {
-    thrift::KvStoreAreaSummary areaSummary;
-
-    areaSummary.area() = area;
-    auto kvDbCounters = kvStoreDb.getCounters();
-    areaSummary.keyValsCount() = kvDbCounters["kvstore.num_keys"];
-    areaSummary.peersMap() = kvStoreDb.dumpPeers();
-    areaSummary.keyValsBytes() = kvStoreDb.getKeyValsSize();
-
-    result.emplace_back(std::move(areaSummary));
+  for (auto& [_, kvStoreDb] : kvStoreDb_) {
+    result.emplace_back(getKvStoreAreaSummary(kvStoreDb));
   }
   return result;
 }
 
+template <class ClientType>
+thrift::KvStoreAreaSummary
+KvStore<ClientType>::getKvStoreAreaSummary(KvStoreDb<ClientType>& kvStoreDb) {
+  thrift::KvStoreAreaSummary areaSummary;
+
+  areaSummary.area() = kvStoreDb.getAreaId();
+  auto kvDbCounters = kvStoreDb.getCounters();
+  areaSummary.keyValsCount() = kvDbCounters["kvstore.num_keys"];
+  areaSummary.peersMap() = kvStoreDb.dumpPeers();
+  areaSummary.keyValsBytes() = kvStoreDb.getKeyValsSize();
+  return areaSummary;
+}
+
 template <class ClientType>
 folly::SemiFuture<std::unique_ptr<std::vector<thrift::Publication>>>
 KvStore<ClientType>::semifuture_dumpKvStoreKeys(
     thrift::KeyDumpParams keyDumpParams, std::set<std::string> selectAreas) {
+  if (not areaEvbs_.empty()) {
+    // Dump every area on its event base, in order of areas
+    std::vector<folly::SemiFuture<
+        std::unique_ptr<std::vector<thrift::Publication>>>>
+        areaFutures;
+    for (auto const& area : selectAreas) {
+      auto [p, f] = folly::makePromiseContract<
+          std::unique_ptr<std::vector<thrift::Publication>>>();
+      getAreaEvb(area)->runInEventBaseThread(
+          [this, p = std::move(p), keyDumpParams, area]() mutable {
+            p.setValue(dumpKvStoreKeysImpl(std::move(keyDumpParams), {area}));
+          });
+      areaFutures.emplace_back(std::move(f));
+    }
+    return folly::collect(std::move(areaFutures))
+        .deferValue([](std::vector<
+                        std::unique_ptr<std::vector<thrift::Publication>>>&&
+                           areaResults) {
+          auto result = std::make_unique<std::vector<thrift::Publication>>();
+          for (auto& areaResult : areaResults) {
+            std::move(
+                areaResult->begin(),
+                areaResult->end(),
+                std::back_inserter(*result));
+          }
+          return result;
+        });
+  }
+
   folly::Promise<std::unique_ptr<std::vector<thrift::Publication>>> p;
   auto sf = p.getSemiFuture();
   runInEventBaseThread([this,
@@ -508,18 +699,19 @@ KvStore<ClientType>::semifuture_dumpKvStoreHashes(
     std::string area, thrift::KeyDumpParams keyDumpParams) {
   folly::Promise<std::unique_ptr<thrift::Publication>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        keyDumpParams = std::move(keyDumpParams),
-                        area]() mutable {
-    try {
-      auto result =
-          dumpKvStoreHashesImpl(std::move(area), std::move(keyDumpParams));
-      p.setValue(std::make_unique<thrift::Publication>(std::move(result)));
-    } catch (thrift::KvStoreError const& e) {
-      p.setException(e);
-    }
-  });
+  getAreaEvb(area)->runInEventBaseThread(
+      [this,
+       p = std::move(p),
+       keyDumpParams = std::move(keyDumpParams),
+       area]() mutable {
+        try {
+          auto result =
+              dumpKvStoreHashesImpl(std::move(area), std::move(keyDumpParams));
+          p.setValue(std::make_unique<thrift::Publication>(std::move(result)));
+        } catch (thrift::KvStoreError const& e) {
+          p.setException(e);
+        }
+      });
   return sf;
 }
 
@@ -529,27 +721,30 @@ KvStore<ClientType>::semifuture_setKvStoreKeyVals(
     std::string area, thrift::KeySetParams keySetParams) {
   folly::Promise<folly::Unit> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        keySetParams = std::move(keySetParams),
-                        area]() mutable {
-    XLOG(DBG3) << fmt::format(
-        "Set key requested for AREA: {}, by sender: {}, at time: {}",
-        area,
-        (keySetParams.senderId().has_value() ? keySetParams.senderId().value()
-                                             : ""),
-        (keySetParams.timestamp_ms().has_value()
-             ? folly::to<std::string>(keySetParams.timestamp_ms().value())
-             : ""));
-    try {
-      auto& kvStoreDb = getAreaDbOrThrow(area, "setKvStoreKeyVals");
-      kvStoreDb.setKeyVals(std::move(keySetParams), false /* remote update */);
-      // ready to return
-      p.setValue();
-    } catch (thrift::KvStoreError const& e) {
-      p.setException(e);
-    }
-  });
+  getAreaEvb(area)->runInEventBaseThread(
+      [this,
+       p = std::move(p),
+       keySetParams = std::move(keySetParams),
+       area]() mutable {
+        XLOG(DBG3) << fmt::format(
+            "Set key requested for AREA: {}, by sender: {}, at time: {}",
+            area,
+            (keySetParams.senderId().has_value()
+                 ? keySetParams.senderId().value()
+                 : ""),
+            (keySetParams.timestamp_ms().has_value()
+                 ? folly::to<std::string>(keySetParams.timestamp_ms().value())
+                 : ""));
+        try {
+          auto& kvStoreDb = getAreaDbOrThrow(area, "setKvStoreKeyVals");
+          kvStoreDb.setKeyVals(
+              std::move(keySetParams), false /* remote update */);
+          // ready to return
+          p.setValue();
+        } catch (thrift::KvStoreError const& e) {
+          p.setException(e);
+        }
+      });
   return sf;
 }
 
@@ -559,28 +754,30 @@ KvStore<ClientType>::semifuture_setKvStoreKeyValues(
     std::string area, thrift::KeySetParams keySetParams) {
   folly::Promise<std::unique_ptr<thrift::SetKeyValsResult>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        keySetParams = std::move(keySetParams),
-                        area]() mutable {
-    XLOG(DBG3) << fmt::format(
-        "Set key requested for AREA: {}, by sender: {}, at time: {}",
-        area,
-        (keySetParams.senderId().has_value() ? keySetParams.senderId().value()
-                                             : ""),
-        (keySetParams.timestamp_ms().has_value()
-             ? folly::to<std::string>(keySetParams.timestamp_ms().value())
-             : ""));
-    try {
-      auto& kvStoreDb = getAreaDbOrThrow(area, "setKvStoreKeyVals");
-      auto r = kvStoreDb.setKeyVals(
-          std::move(keySetParams), false /* remote update */);
-      // ready to return
-      p.setValue(std::make_unique<thrift::SetKeyValsResult>(std::move(r)));
-    } catch (thrift::KvStoreError const& e) {
-      p.setException(e);
-    }
-  });
+  getAreaEvb(area)->runInEventBaseThread(
+      [this,
+       p = std::move(p),
+       keySetParams = std::move(keySetParams),
+       area]() mutable {
+        XLOG(DBG3) << fmt::format(
+            "Set key requested for AREA: {}, by sender: {}, at time: {}",
+            area,
+            (keySetParams.senderId().has_value()
+                 ? keySetParams.senderId().value()
+                 : ""),
+            (keySetParams.timestamp_ms().has_value()
+                 ? folly::to<std::string>(keySetParams.timestamp_ms().value())
+                 : ""));
+        try {
+          auto& kvStoreDb = getAreaDbOrThrow(area, "setKvStoreKeyVals");
+          auto r = kvStoreDb.setKeyVals(
+              std::move(keySetParams), false /* remote update */);
+          // ready to return
+          p.setValue(std::make_unique<thrift::SetKeyValsResult>(std::move(r)));
+        } catch (thrift::KvStoreError const& e) {
+          p.setException(e);
+        }
+      });
   return sf;
 }
 
@@ -590,7 +787,7 @@ KvStore<ClientType>::semifuture_injectThriftFailure(
     std::string area, std::string peerName) {
   folly::Promise<std::unique_ptr<bool>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread(
+  getAreaEvb(area)->runInEventBaseThread(
       [this, p = std::move(p), peerName = std::move(peerName), area]() mutable {
         try {
           bool r = true;
@@ -636,7 +833,7 @@ KvStore<ClientType>::semifuture_getKvStorePeerState(
     std::string const& area, std::string const& peerName) {
   folly::Promise<std::optional<thrift::KvStorePeerState>> promise;
   auto sf = promise.getSemiFuture();
-  runInEventBaseThread(
+  getAreaEvb(area)->runInEventBaseThread(
       [this, p = std::move(promise), peerName, area]() mutable {
         try {
           p.setValue(getAreaDbOrThrow(area, "semifuture_getKvStorePeerState")
@@ -663,7 +860,7 @@ KvStore<ClientType>::semifuture_getKvStorePeerStateEpochTimeMs(
     std::string const& area, std::string const& peerName) {
   folly::Promise<int64_t> promise;
   auto sf = promise.getSemiFuture();
-  runInEventBaseThread(
+  getAreaEvb(area)->runInEventBaseThread(
       [this, p = std::move(promise), peerName, area]() mutable {
         try {
           p.setValue(getAreaDbOrThrow(
@@ -691,7 +888,7 @@ KvStore<ClientType>::semifuture_getKvStorePeerStateElapsedTimeMs(
     std::string const& area, std::string const& peerName) {
   folly::Promise<int64_t> promise;
   auto sf = promise.getSemiFuture();
-  runInEventBaseThread(
+  getAreaEvb(area)->runInEventBaseThread(
       [this, p = std::move(promise), peerName, area]() mutable {
         try {
           p.setValue(getAreaDbOrThrow(
@@ -719,7 +916,7 @@ KvStore<ClientType>::semifuture_getKvStorePeerFlaps(
     std::string const& area, std::string const& peerName) {
   folly::Promise<int32_t> promise;
   auto sf = promise.getSemiFuture();
-  runInEventBaseThread(
+  getAreaEvb(area)->runInEventBaseThread(
       [this, p = std::move(promise), peerName, area]() mutable {
         try {
           p.setValue(getAreaDbOrThrow(area, "semifuture_getKvStorePeerFlaps")
@@ -736,16 +933,19 @@ folly::SemiFuture<std::unique_ptr<thrift::PeersMap>>
 KvStore<ClientType>::semifuture_getKvStorePeers(std::string area) {
   folly::Promise<std::unique_ptr<thrift::PeersMap>> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this, p = std::move(p), area]() mutable {
-    XLOG(DBG2) << fmt::format("Peer dump requested for AREA: {}", area);
-    try {
-      p.setValue(std::make_unique<thrift::PeersMap>(
-          getAreaDbOrThrow(area, "semifuture_getKvStorePeers").dumpPeers()));
-      fb303::fbData->addStatValue("kvstore.cmd_peer_dump", 1, fb303::COUNT);
-    } catch (thrift::KvStoreError const& e) {
-      p.setException(e);
-    }
-  });
+  getAreaEvb(area)->runInEventBaseThread(
+      [this, p = std::move(p), area]() mutable {
+        XLOG(DBG2) << fmt::format("Peer dump requested for AREA: {}", area);
+        try {
+          p.setValue(std::make_unique<thrift::PeersMap>(
+              getAreaDbOrThrow(area, "semifuture_getKvStorePeers")
+                  .dumpPeers()));
+          fb303::fbData->addStatValue(
+              "kvstore.cmd_peer_dump", 1, fb303::COUNT);
+        } catch (thrift::KvStoreError const& e) {
+          p.setException(e);
+        }
+      });
   return sf;
 }
 
@@ -753,6 +953,22 @@ template <class ClientType>
 folly::SemiFuture<std::unique_ptr<std::vector<thrift::KvStoreAreaSummary>>>
 KvStore<ClientType>::semifuture_getKvStoreAreaSummaryInternal(
     std::set<std::string> selectAreas) {
+  if (not areaEvbs_.empty()) {
+    // Summarize every area on its event base
+    std::vector<folly::SemiFuture<thrift::KvStoreAreaSummary>> areaFutures;
+    for (auto const& [area, _] : kvStoreDb_) {
+      areaFutures.emplace_back(runInAreaEventBase(
+          area, "getKvStoreAreaSummary", [](KvStoreDb<ClientType>& kvStoreDb) {
+            return getKvStoreAreaSummary(kvStoreDb);
+          }));
+    }
+    return folly::collect(std::move(areaFutures))
+        .deferValue([](std::vector<thrift::KvStoreAreaSummary>&& result) {
+          return std::make_unique<std::vector<thrift::KvStoreAreaSummary>>(
+              std::move(result));
+        });
+  }
+
   folly::Promise<std::unique_ptr<std::vector<thrift::KvStoreAreaSummary>>> p;
   auto sf = p.getSemiFuture();
   runInEventBaseThread(
@@ -770,30 +986,32 @@ KvStore<ClientType>::semifuture_addUpdateKvStorePeers(
     std::string area, thrift::PeersMap peersToAdd) {
   folly::Promise<folly::Unit> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        peersToAdd = std::move(peersToAdd),
-                        area]() mutable {
-    try {
-      auto str = folly::gen::from(peersToAdd) | folly::gen::get<0>() |
-          folly::gen::as<std::vector<std::string>>();
-
-      XLOG(INFO) << "Peer addition for: [" << folly::join(",", str)
-                 << "] in area: " << area;
-      auto& kvStoreDb =
-          getAreaDbOrThrow(area, "semifuture_addUpdateKvStorePeers");
-      if (peersToAdd.empty()) {
-        p.setException(thrift::KvStoreError(
-            "Empty peerNames from peer-add request, ignoring"));
-      } else {
-        fb303::fbData->addStatValue("kvstore.cmd_peer_add", 1, fb303::COUNT);
-        kvStoreDb.addThriftPeers(peersToAdd);
-        p.setValue();
-      }
-    } catch (thrift::KvStoreError const& e) {
-      p.setException(e);
-    }
-  });
+  getAreaEvb(area)->runInEventBaseThread(
+      [this,
+       p = std::move(p),
+       peersToAdd = std::move(peersToAdd),
+       area]() mutable {
+        try {
+          auto str = folly::gen::from(peersToAdd) | folly::gen::get<0>() |
+              folly::gen::as<std::vector<std::string>>();
+
+          XLOG(INFO) << "Peer addition for: [" << folly::join(",", str)
+                     << "] in area: " << area;
+          auto& kvStoreDb =
+              getAreaDbOrThrow(area, "semifuture_addUpdateKvStorePeers");
+          if (peersToAdd.empty()) {
+            p.setException(thrift::KvStoreError(
+                "Empty peerNames from peer-add request, ignoring"));
+          } else {
+            fb303::fbData->addStatValue(
+                "kvstore.cmd_peer_add", 1, fb303::COUNT);
+            kvStoreDb.addThriftPeers(peersToAdd);
+            p.setValue();
+          }
+        } catch (thrift::KvStoreError const& e) {
+          p.setException(e);
+        }
+      });
   return sf;
 }
 
@@ -803,26 +1021,29 @@ KvStore<ClientType>::semifuture_deleteKvStorePeers(
     std::string area, std::vector<std::string> peersToDel) {
   folly::Promise<folly::Unit> p;
   auto sf = p.getSemiFuture();
-  runInEventBaseThread([this,
-                        p = std::move(p),
-                        peersToDel = std::move(peersToDel),
-                        area]() mutable {
-    XLOG(INFO) << "Peer deletion for: [" << folly::join(",", peersToDel)
-               << "] in area: " << area;
-    try {
-      auto& kvStoreDb = getAreaDbOrThrow(area, "semifuture_deleteKvStorePeers");
-      if (peersToDel.empty()) {
-        p.setException(thrift::KvStoreError(
-            "Empty peerNames from peer-del request, ignoring"));
-      } else {
-        fb303::fbData->addStatValue("kvstore.cmd_per_del", 1, fb303::COUNT);
-        kvStoreDb.delThriftPeers(peersToDel);
-        p.setValue();
-      }
-    } catch (thrift::KvStoreError const& e) {
-      p.setException(e);
-    }
-  });
+  getAreaEvb(area)->runInEventBaseThread(
+      [this,
+       p = std::move(p),
+       peersToDel = std::move(peersToDel),
+       area]() mutable {
+        XLOG(INFO) << "Peer deletion for: [" << folly::join(",", peersToDel)
+                   << "] in area: " << area;
+        try {
+          auto& kvStoreDb =
+              getAreaDbOrThrow(area, "semifuture_deleteKvStorePeers");
+          if (peersToDel.empty()) {
+            p.setException(thrift::KvStoreError(
+                "Empty peerNames from peer-del request, ignoring"));
+          } else {
+            fb303::fbData->addStatValue(
+                "kvstore.cmd_per_del", 1, fb303::COUNT);
+            kvStoreDb.delThriftPeers(peersToDel);
+            p.setValue();
+          }
+        } catch (thrift::KvStoreError const& e) {
+          p.setException(e);
+        }
+      });
   return sf;
 }
 
@@ -897,6 +1118,9 @@ KvStore<ClientType>::initialSelfOriginatedKeysSynced() {
 template <class ClientType>
 folly::SemiFuture<std::map<std::string, int64_t>>
 KvStore<ClientType>::semifuture_getCounters() {
+  if (not areaEvbs_.empty()) {
+    return collectGlobalCounters();
+  }
   auto [p, f] = folly::makePromiseContract<std::map<std::string, int64_t>>();
   runInEventBaseThread([this, p = std::move(p)]() mutable { //
     p.setValue(getGlobalCounters());
@@ -904,6 +1128,34 @@ KvStore<ClientType>::semifuture_getCounters() {
   return std::move(f);
 }
 
+template <class ClientType>
+folly::SemiFuture<std::map<std::string, int64_t>>
+KvStore<ClientType>::collectGlobalCounters() {
+  if (areaEvbs_.empty()) {
+    return folly::makeSemiFuture(getGlobalCounters());
+  }
+
+  std::vector<folly::SemiFuture<std::map<std::string, int64_t>>> areaFutures;
+  for (auto const& [area, _] : kvStoreDb_) {
+    areaFutures.emplace_back(runInAreaEventBase(
+        area, "getCounters", [](KvStoreDb<ClientType>& kvStoreDb) {
+          return kvStoreDb.getCounters();
+        }));
+  }
+  return folly::collect(std::move(areaFutures))
+      .deferValue(
+          [](std::vector<std::map<std::string, int64_t>>&& areaCounters) {
+            // add up counters for same key from all kvStoreDb instances
+            std::map<std::string, int64_t> flatCounters;
+            for (auto const& kvDbCounters : areaCounters) {
+              for (auto const& [key, value] : kvDbCounters) {
+                flatCounters[key] += value;
+              }
+            }
+            return flatCounters;
+          });
+}
+
 template <class ClientType>
 std::map<std::string, int64_t>
 KvStore<ClientType>::getGlobalCounters() const {
@@ -1436,13 +1688,15 @@ KvStoreDb<ClientType>::KvStoreDb(
     const std::string& area,
     const std::string& nodeId,
     std::function<void()> initialKvStoreSyncedCallback,
-    std::function<void()> initialSelfOriginatedKeysSyncedCallback)
+    std::function<void()> initialSelfOriginatedKeysSyncedCallback,
+    std::function<void(thrift::Publication&&)> publishUpdateCallback)
     : kvParams_(kvParams),
       area_(area),
       areaTag_(fmt::format("[Area {}] ", area)),
       initialKvStoreSyncedCallback_(initialKvStoreSyncedCallback),
       initialSelfOriginatedKeysSyncedCallback_(
           initialSelfOriginatedKeysSyncedCallback),
+      publishUpdateCallback_(std::move(publishUpdateCallback)),
       evb_(evb) {
   if (kvParams_.floodRate) {
     floodLimiter_ = std::make_unique<folly::BasicTokenBucket<>>(
@@ -1638,31 +1892,27 @@ KvStoreDb<ClientType>::checkKeyTtl() noexcept {
   // total number of unexpected keys below ttl alert threshold
   auto cnt{0};
 
-  KvStoreFilters filter{
-      {Constants::kAdjDbMarker.toString()}, /* match "adj:" key only */
-      {}, /* originator match */
-      thrift::FilterOperator::OR /* matching type */};
-
-  for (auto const& [k, v] : kvStore_) {
-    if (not filter.keyMatch(k, v)) {
-      continue;
-    }
-    // ATTN: ttl is refreshed every keyTtl.count() / 4 by default.
-    // Increment the counter if the following condition fulfilled:
-    //
-    // 1. If keyTtl.count() is below the threshold of 1/2 keyTtl, this
-    // indicates that the ttl-refreshing sent from peer on timstamp of
-    // {3/4, 1/2} keyTtl are NOT received;
-    //
-    // 2. If the originator of this adj key is still connected to KvStore,
-    // this is a strong signal that flooding topo is in bad state;
-    if (*v.ttl() < kvParams_.keyTtl.count() / 2 and
-        thriftPeers_.count(*v.originatorId())) {
-      XLOG(ERR) << fmt::format(
-          "Ttl of {} drops below 50% threshold and going to expire", k);
-      cnt += 1;
-    }
-  }
+  // match "adj:" key only
+  kvStore_.forEachWithPrefix(
+      Constants::kAdjDbMarker.toString(),
+      [&](const KvStoreStorage::Entry& entry) {
+        // ATTN: ttl is refreshed every keyTtl.count() / 4 by default.
+        // Increment the counter if the following condition fulfilled:
+        //
+        // 1. If keyTtl.count() is below the threshold of 1/2 keyTtl, this
+        // indicates that the ttl-refreshing sent from peer on timstamp of
+        // {3/4, 1/2} keyTtl are NOT received;
+        //
+        // 2. If the originator of this adj key is still connected to KvStore,
+        // this is a strong signal that flooding topo is in bad state;
+        if (entry.ttl < kvParams_.keyTtl.count() / 2 and
+            thriftPeers_.count(kvStore_.getOriginatorId(entry))) {
+          XLOG(ERR) << fmt::format(
+              "Ttl of {} drops below 50% threshold and going to expire",
+              entry.key);
+          cnt += 1;
+        }
+      });
 
   // Expose number of about-to-expire adj keys into ODS counter
   fb303::fbData->addStatValue(
@@ -1688,9 +1938,8 @@ KvStoreDb<ClientType>::setSelfOriginatedKey(
 
   // Use one version number higher than currently in KvStore if not specified
   if (not version) {
-    auto it = kvStore_.find(key);
-    if (it != kvStore_.end()) {
-      thriftValue.version() = *it->second.version() + 1;
+    if (const auto* entry = kvStore_.find(key)) {
+      thriftValue.version() = entry->version + 1;
     } else {
       thriftValue.version() = 1;
     }
@@ -1747,15 +1996,15 @@ KvStoreDb<ClientType>::persistSelfOriginatedKey(
   //     Retrieve it from cached self-originated key-vals;
   if (selfOriginatedKeyIt == selfOriginatedKeyVals_.end()) {
     // Key is first-time persisted. Check if key is in KvStore.
-    auto keyIt = kvStore_.find(key);
-    if (keyIt == kvStore_.end()) {
+    const auto* entry = kvStore_.find(key);
+    if (not entry) {
       // Key is not in KvStore. Set initial version and ready to advertise.
       thriftValue.version() = 1;
       shouldAdvertise = true;
     } else {
       // Key is NOT persisted but can be found inside KvStore.
       // This can be keys advertised by our previous incarnation.
-      thriftValue = keyIt->second;
+      thriftValue = kvStore_.toThriftValue(*entry);
       // TTL update pub is never saved in kvstore. Value is not std::nullopt.
       DCHECK(thriftValue.value());
     }
@@ -1889,13 +2138,13 @@ KvStoreDb<ClientType>::unsetSelfOriginatedKey(
 
   // Check if key is in KvStore. If key doesn't exist in KvStore no need to
   // add it as "empty". This condition should not exist.
-  auto keyIt = kvStore_.find(key);
-  if (keyIt == kvStore_.end()) {
+  const auto* entry = kvStore_.find(key);
+  if (not entry) {
     return;
   }
 
   // Overwrite all values and increment version.
-  auto thriftValue = keyIt->second;
+  auto thriftValue = kvStore_.toThriftValue(*entry);
   thriftValue.originatorId() = kvParams_.nodeId;
   (*thriftValue.version())++;
   thriftValue.ttlVersion() = 0;
@@ -2118,9 +2367,10 @@ KvStoreDb<ClientType>::getKeyValsSize() const {
       kvStore_.size() * (sizeof(std::string) + sizeof(thrift::Value));
 
   // loop through all key/vals and add size of each KV entry
-  for (auto const& [key, value] : kvStore_) {
-    size += key.size() + value.originatorId()->size() + value.value()->size();
-  }
+  kvStore_.forEach([&](const KvStoreStorage::Entry& entry) {
+    size += entry.key.size() + kvStore_.getOriginatorId(entry).size() +
+        entry.value.size();
+  });
   size += fixed_size;
 
   return size;
@@ -2136,10 +2386,9 @@ KvStoreDb<ClientType>::getKeyVals(std::vector<std::string> const& keys) {
 
   for (auto const& key : keys) {
     // if requested key if found, respond with version and value
-    auto it = kvStore_.find(key);
-    if (it != kvStore_.end()) {
+    if (const auto* entry = kvStore_.find(key)) {
       // copy here
-      thriftPub.keyVals()[key] = it->second;
+      thriftPub.keyVals()[key] = kvStore_.toThriftValue(*entry);
     }
   }
   return thriftPub;
@@ -2580,6 +2829,9 @@ KvStoreDb<ClientType>::getCounters() const {
   // Add some more flat counters
   counters["kvstore.num_keys"] = kvStore_.size();
   counters["kvstore.num_peers"] = thriftPeers_.size();
+  counters["kvstore.key_arena_bytes"] = kvStore_.getArenaBytes();
+  counters["kvstore.key_arena_wasted_bytes"] = kvStore_.getArenaWastedBytes();
+  counters["kvstore.num_originators"] = kvStore_.getNumOriginators();
 
   /*
    * ATTN: counter with [Area] tag has two layers of counters. For instance,
@@ -2661,10 +2913,10 @@ KvStoreDb<ClientType>::cleanupTtlCountdownQueue() {
       // Nothing in queue worth evicting
       break;
     }
-    auto it = kvStore_.find(top.key);
-    if (it != kvStore_.end() and *it->second.version() == top.version and
-        *it->second.originatorId() == top.originatorId and
-        *it->second.ttlVersion() == top.ttlVersion) {
+    const auto* entry = kvStore_.find(top.key);
+    if (entry and entry->version == top.version and
+        kvStore_.getOriginatorId(*entry) == top.originatorId and
+        entry->ttlVersion == top.ttlVersion) {
       expiredKeys.emplace_back(top.key);
       XLOG(WARNING)
           << AreaTag()
@@ -2672,13 +2924,13 @@ KvStoreDb<ClientType>::cleanupTtlCountdownQueue() {
           << fmt::format(
                  "({}, {}, {}, {}, {}, {})",
                  top.key,
-                 *it->second.version(),
-                 *it->second.originatorId(),
-                 *it->second.ttlVersion(),
-                 *it->second.ttl(),
+                 entry->version,
+                 kvStore_.getOriginatorId(*entry),
+                 entry->ttlVersion,
+                 entry->ttl,
                  kvParams_.nodeId);
       logKvEvent("KEY_EXPIRE", top.key);
-      kvStore_.erase(it);
+      kvStore_.erase(top.key);
     }
     ttlCountdownQueue_.pop();
   }
@@ -2737,9 +2989,8 @@ KvStoreDb<ClientType>::floodBufferedUpdates() {
   for (const auto& [rootId, keys] : publicationBuffer_) {
     thrift::Publication publication{};
     for (const auto& key : keys) {
-      auto kvStoreIt = kvStore_.find(key);
-      if (kvStoreIt != kvStore_.end()) {
-        publication.keyVals()->emplace(make_pair(key, kvStoreIt->second));
+      if (const auto* entry = kvStore_.find(key)) {
+        publication.keyVals()->emplace(key, kvStore_.toThriftValue(*entry));
       } else {
         publication.expiredKeys()->emplace_back(key);
       }
@@ -2763,9 +3014,8 @@ KvStoreDb<ClientType>::finalizeFullSync(
   // build keyval to be sent
   thrift::Publication updates;
   for (const auto& key : keys) {
-    const auto& it = kvStore_.find(key);
-    if (it != kvStore_.end()) {
-      updates.keyVals()->emplace(key, it->second);
+    if (const auto* entry = kvStore_.find(key)) {
+      updates.keyVals()->emplace(key, kvStore_.toThriftValue(*entry));
     }
   }
 
@@ -2909,7 +3159,7 @@ KvStoreDb<ClientType>::floodPublication(
   publication.nodeIds()->emplace_back(kvParams_.nodeId);
 
   // Flood publication to internal subscribers
-  kvParams_.kvStoreUpdatesQueue.push(publication);
+  publishUpdateCallback_(thrift::Publication(publication));
   fb303::fbData->addStatValue("kvstore.num_updates", 1, fb303::COUNT);
 
   // Process potential update to self-originated key-vals
@@ -3326,7 +3576,7 @@ KvStore<ClientType>::co_getKvStoreKeyVals(
   try {
     auto result =
         co_await co_getKvStoreKeyValsInternal(area, std::move(keyGetParams))
-            .scheduleOn(getEvb());
+            .scheduleOn(getAreaEvb(area)->getEvb());
     co_return std::make_unique<thrift::Publication>(std::move(result));
   } catch (thrift::KvStoreError const& e) {
     XLOG(ERR) << fmt::format(
@@ -3361,7 +3611,7 @@ KvStore<ClientType>::co_setKvStoreKeyVals(
   try {
     auto result =
         co_await co_setKvStoreKeyValsInternal(area, std::move(keySetParams))
-            .scheduleOn(getEvb());
+            .scheduleOn(getAreaEvb(area)->getEvb());
   } catch (thrift::KvStoreError const& e) {
     XLOG(ERR) << fmt::format(
         "{} got exception: {} for area {}", __FUNCTION__, e.what(), area);
@@ -3385,7 +3635,7 @@ KvStore<ClientType>::co_setKvStoreKeyValues(
   try {
     auto result =
         co_await co_setKvStoreKeyValsInternal(area, std::move(keySetParams))
-            .scheduleOn(getEvb());
+            .scheduleOn(getAreaEvb(area)->getEvb());
     co_return std::make_unique<thrift::SetKeyValsResult>(result);
   } catch (thrift::KvStoreError const& e) {
     XLOG(ERR) << fmt::format(
@@ -3399,6 +3649,10 @@ template <class ClientType>
 folly::coro::Task<std::unique_ptr<std::vector<thrift::Publication>>>
 KvStore<ClientType>::co_dumpKvStoreKeys(
     thrift::KeyDumpParams keyDumpParams, std::set<std::string> selectAreas) {
+  if (not areaEvbs_.empty()) {
+    co_return co_await semifuture_dumpKvStoreKeys(
+        std::move(keyDumpParams), std::move(selectAreas));
+  }
   auto result = co_await co_dumpKvStoreKeysImpl(
                     std::move(keyDumpParams), std::move(selectAreas))
                     .scheduleOn(getEvb());
@@ -3409,9 +3663,10 @@ template <class ClientType>
 folly::coro::Task<std::unique_ptr<thrift::Publication>>
 KvStore<ClientType>::co_dumpKvStoreHashes(
     std::string area, thrift::KeyDumpParams keyDumpParams) {
+  auto* evb = getAreaEvb(area)->getEvb();
   auto result = co_await co_dumpKvStoreHashesImpl(
                     std::move(area), std::move(keyDumpParams))
-                    .scheduleOn(getEvb());
+                    .scheduleOn(evb);
   co_return std::make_unique<thrift::Publication>(result);
 }
 
@@ -3441,6 +3696,10 @@ template <class ClientType>
 folly::coro::Task<std::unique_ptr<std::vector<thrift::KvStoreAreaSummary>>>
 KvStore<ClientType>::co_getKvStoreAreaSummaryInternal(
     std::set<std::string> selectAreas) {
+  if (not areaEvbs_.empty()) {
+    co_return co_await semifuture_getKvStoreAreaSummaryInternal(
+        std::move(selectAreas));
+  }
   auto result = co_await co_getKvStoreAreaSummaryImpl(std::move(selectAreas))
                     .scheduleOn(getEvb());
   co_return std::make_unique<std::vector<thrift::KvStoreAreaSummary>>(result);
@@ -3451,8 +3710,11 @@ folly::coro::Task<std::unique_ptr<thrift::PeersMap>>
 KvStore<ClientType>::co_getKvStorePeers(std::string area) {
   XLOG(DBG2) << fmt::format("Peer dump requested for AREA: {}", area);
   fb303::fbData->addStatValue("kvstore.cmd_peer_dump", 1, fb303::COUNT);
-  auto result = getAreaDbOrThrow(area, "co_getKvStorePeers").dumpPeers();
-  co_return std::make_unique<thrift::PeersMap>(result);
+  auto result = co_await runInAreaEventBase(
+      area, "co_getKvStorePeers", [](KvStoreDb<ClientType>& kvStoreDb) {
+        return kvStoreDb.dumpPeers();
+      });
+  co_return std::make_unique<thrift::PeersMap>(std::move(result));
 }
 #endif // FOLLY_HAS_COROUTINES
 } // namespace openr
@@ -7,6 +7,9 @@
 
 #pragma once
 
+#include <thread>
+#include <type_traits>
+
 #include <folly/TokenBucket.h>
 #include <folly/gen/Base.h>
 #include <folly/io/async/AsyncTimeout.h>
@@ -41,7 +44,8 @@ class KvStoreDb {
       const std::string& area,
       const std::string& nodeId,
       std::function<void()> initialKvStoreSyncedCallback,
-      std::function<void()> initialSelfOriginatedKeysSyncedCallback);
+      std::function<void()> initialSelfOriginatedKeysSyncedCallback,
+      std::function<void(thrift::Publication&&)> publishUpdateCallback);
 
   ~KvStoreDb() = default;
 
@@ -78,13 +82,19 @@ class KvStoreDb {
     return isStopped_;
   }
 
+  // event base this KvStoreDb runs on
+  inline OpenrEventBase*
+  getEvb() const {
+    return evb_;
+  }
+
   // get all active (ttl-refreshable) self-originated key-vals
   SelfOriginatedKeyVals const&
   getSelfOriginatedKeyVals() const {
     return selfOriginatedKeyVals_;
   }
 
-  thrift::KeyVals const&
+  KvStoreStorage const&
   getKeyValueMap() const {
     return kvStore_;
   }
@@ -481,12 +491,13 @@ class KvStoreDb {
   std::unordered_map<std::string, KvStorePeer> thriftPeers_{};
 
   // Boolean flag indicating whether initial KvStoreDb sync with all peers
-  // completed in OpenR initialization procedure.
-  bool initialSyncCompleted_{false};
-  bool initialSelfOriginatedKeysSyncCompleted_{false};
+  // completed in OpenR initialization procedure. Read by KvStore from its own
+  // event base if KvStoreDb runs on a per-area event base.
+  std::atomic<bool> initialSyncCompleted_{false};
+  std::atomic<bool> initialSelfOriginatedKeysSyncCompleted_{false};
 
   // store keys mapped to (version, originatoId, value)
-  thrift::KeyVals kvStore_{};
+  KvStoreStorage kvStore_{};
 
   // TTL count down queue
   TtlCountdownQueue ttlCountdownQueue_;
@@ -544,6 +555,10 @@ class KvStoreDb {
   std::function<void()> initialKvStoreSyncedCallback_;
   std::function<void()> initialSelfOriginatedKeysSyncedCallback_;
 
+  // Callback function to publish updates to internal subscribers via
+  // kvStoreUpdatesQueue
+  std::function<void(thrift::Publication&&)> publishUpdateCallback_;
+
   // max parallel syncs allowed. It's initialized with '2' and doubles
   // up to a max value of kMaxFullSyncPendingCountThresholdfor each full sync
   // response received
@@ -570,6 +585,12 @@ class KvStoreDb {
  * thrift channel. The configuration is passed via constructor arguments.
  * This class instantiates individual KvStoreDb per area. Area config is
  * passed in the constructor.
+ *
+ * KvStoreDbs run on the KvStore event base, or each on its own event base and
+ * thread if `enable_per_area_event_base` is set. In the latter case, requests
+ * of an area are routed to the event base of its KvStoreDb, which preserves
+ * their order within the area, and requests spanning areas are fanned out to
+ * every area.
  */
 template <class ClientType>
 class KvStore final : public OpenrEventBase {
@@ -695,6 +716,10 @@ class KvStore final : public OpenrEventBase {
   // API to get reader for kvStoreUpdatesQueue
   messaging::RQueue<KvStorePublication> getKvStoreUpdatesReader();
 
+  // API to get event bases of areas, empty unless
+  // `enable_per_area_event_base` is set. Used to register them with Watchdog.
+  std::vector<OpenrEventBase*> getAreaEvbs() const;
+
   // API to fetch state of peerNode, used for unit-testing
   folly::SemiFuture<std::optional<thrift::KvStorePeerState>>
   semifuture_getKvStorePeerState(
@@ -776,6 +801,8 @@ class KvStore final : public OpenrEventBase {
    * Wrapper function to redirect request to update specific kvStoreDb
    */
   void processKeyValueRequest(KeyValueRequest&& kvRequest);
+  static void processAreaKeyValueRequest(
+      KvStoreDb<ClientType>& kvStoreDb, KeyValueRequest&& kvRequest);
 
   /*
    * [Counter]
@@ -796,6 +823,36 @@ class KvStore final : public OpenrEventBase {
   KvStoreDb<ClientType>& getAreaDbOrThrow(
       std::string const& areaId, std::string const& caller);
 
+  /*
+   * Event base of the KvStoreDb of the area, with the same fallback as
+   * getAreaDbOrThrow(). KvStore event base if KvStoreDbs run on it, or if the
+   * area is not configured.
+   */
+  OpenrEventBase* getAreaEvb(std::string const& areaId);
+
+  /*
+   * Run func with KvStoreDb of the area on its event base. Future fails with
+   * KvStoreError if the area is not configured.
+   */
+  template <typename Func>
+  folly::SemiFuture<
+      folly::lift_unit_t<std::invoke_result_t<Func, KvStoreDb<ClientType>&>>>
+  runInAreaEventBase(
+      std::string const& areaId, std::string const& caller, Func&& func);
+
+  // Start threads of per-area event bases
+  void startAreaEventBases();
+
+  // Stop threads of per-area event bases, once KvStoreDbs are stopped and
+  // fibers of KvStore completed
+  void stopAreaEventBases();
+
+  // Counters of all KvStoreDbs, collected on their event bases
+  folly::SemiFuture<std::map<std::string, int64_t>> collectGlobalCounters();
+
+  static thrift::KvStoreAreaSummary getKvStoreAreaSummary(
+      KvStoreDb<ClientType>& kvStoreDb);
+
   std::unique_ptr<std::vector<thrift::Publication>> dumpKvStoreKeysImpl(
       thrift::KeyDumpParams keyDumpParams, std::set<std::string> selectAreas);
 
@@ -817,7 +874,14 @@ class KvStore final : public OpenrEventBase {
   // kvstore parameters common to all kvstoreDB
   KvStoreParams kvParams_;
 
-  // map of area IDs and instance of KvStoreDb
+  // Event bases and threads of KvStoreDbs, one per area. Empty unless
+  // `enable_per_area_event_base` is set. Outlive KvStoreDbs.
+  std::unordered_map<std::string /* area ID */, std::unique_ptr<OpenrEventBase>>
+      areaEvbs_{};
+  std::vector<std::thread> areaEvbThreads_{};
+
+  // map of area IDs and instance of KvStoreDb. Not modified once constructed,
+  // hence safe to look up from event base of any area.
   std::unordered_map<std::string /* area ID */, KvStoreDb<ClientType>>
       kvStoreDb_{};
 
@@ -13,7 +13,7 @@ namespace openr {
 KvStorePublisher::KvStorePublisher(
     std::set<std::string> const& selectAreas,
     thrift::KeyDumpParams filter,
-    apache::thrift::ServerStreamPublisher<thrift::Publication>&& publisher,
+    CoalescingStreamPublisher<thrift::Publication>&& publisher,
     std::chrono::steady_clock::time_point subscription_time,
     int64_t total_messages)
     : selectAreas_(selectAreas),
@@ -43,8 +43,13 @@ KvStorePublisher::KvStorePublisher(
  * stream.
  */
 void
-KvStorePublisher::publish(const thrift::Publication& pub) {
+KvStorePublisher::publish(
+    const thrift::Publication& pub,
+    std::optional<int64_t> firstRetainedSeqNum) {
   if (not(selectAreas_.empty() || selectAreas_.count(*pub.area()))) {
+    if (firstRetainedSeqNum.has_value()) {
+      publishProgress(pub, *firstRetainedSeqNum);
+    }
     return;
   }
   if ((not filter_.keys().has_value() or (*filter_.keys()).empty()) and
@@ -56,7 +61,7 @@ KvStorePublisher::publish(const thrift::Publication& pub) {
     // key values of a publication and copy them.
     auto filteredPub = std::make_unique<thrift::Publication>(pub);
     filteredPub->timestamp_ms() = getUnixTimeStampMs();
-    publisher_.next(std::move(*filteredPub));
+    publishToStream(std::move(*filteredPub));
     return;
   }
 
@@ -74,13 +79,57 @@ KvStorePublisher::publish(const thrift::Publication& pub) {
     publication_filtered.tobeUpdatedKeys() = *pub.tobeUpdatedKeys();
   }
 
+  if (pub.seqNum()) {
+    publication_filtered.seqNum() = *pub.seqNum();
+  }
+
   if (publication_filtered.keyVals()->size() or
       publication_filtered.expiredKeys()->size()) {
     // There is at least one key value in the publication for the client
     // or there are some expiredKeys
     publication_filtered.timestamp_ms() = getUnixTimeStampMs();
-    publisher_.next(std::move(publication_filtered));
+    publishToStream(std::move(publication_filtered));
+  } else if (firstRetainedSeqNum.has_value()) {
+    publishProgress(pub, *firstRetainedSeqNum);
+  }
+}
+
+/**
+ * Publications filtered out for the subscriber don't advance its last seen
+ * sequence number. Once unrelated publications evict it from the replay
+ * buffer, the subscriber could no longer resume the stream although it hasn't
+ * missed anything. Hence, when the last seen sequence number falls in the
+ * older half of the retained ones, a publication without key-values carrying
+ * the sequence number of `pub` is sent instead.
+ */
+void
+KvStorePublisher::publishProgress(
+    const thrift::Publication& pub, int64_t firstRetainedSeqNum) {
+  if (not pub.seqNum().has_value() or not lastSeqNum_.has_value()) {
+    return;
+  }
+  const auto seqNum = *pub.seqNum();
+  const auto midSeqNum =
+      firstRetainedSeqNum + (seqNum - firstRetainedSeqNum) / 2;
+  if (*lastSeqNum_ >= midSeqNum) {
+    return;
+  }
+
+  thrift::Publication progress;
+  progress.area() = selectAreas_.empty() || selectAreas_.count(*pub.area())
+      ? *pub.area()
+      : *selectAreas_.begin();
+  progress.seqNum() = seqNum;
+  progress.timestamp_ms() = getUnixTimeStampMs();
+  publishToStream(std::move(progress));
+}
+
+void
+KvStorePublisher::publishToStream(thrift::Publication&& pub) {
+  if (pub.seqNum().has_value()) {
+    lastSeqNum_ = *pub.seqNum();
   }
+  publisher_.next(std::move(pub));
 }
 
 thrift::KeyVals
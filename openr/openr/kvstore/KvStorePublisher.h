@@ -7,9 +7,11 @@
 
 #pragma once
 
+#include <optional>
+
+#include <openr/common/CoalescingStreamPublisher.h>
 #include <openr/if/gen-cpp2/KvStore_types.h>
 #include <openr/kvstore/KvStoreUtil.h>
-#include <thrift/lib/cpp2/async/ServerPublisherStream.h>
 
 namespace openr {
 class KvStorePublisher {
@@ -17,15 +19,30 @@ class KvStorePublisher {
   KvStorePublisher(
       std::set<std::string> const& selectAreas,
       thrift::KeyDumpParams filter,
-      apache::thrift::ServerStreamPublisher<thrift::Publication>&& publisher,
+      CoalescingStreamPublisher<thrift::Publication>&& publisher,
       std::chrono::steady_clock::time_point subscription_time =
           std::chrono::steady_clock::now(),
       int64_t total_messages = 0);
 
   ~KvStorePublisher() = default;
 
-  // Invoked whenever there is change. Apply filter and publish changes
-  void publish(const thrift::Publication& pub);
+  /**
+   * Invoked whenever there is change. Apply filter and publish changes.
+   *
+   * @param firstRetainedSeqNum - oldest sequence number the stream can still
+   *   be resumed from. If set, a publication with no key-values is sent when
+   *   filtered out publications would otherwise leave the subscriber's last
+   *   seen sequence number behind it, see `publishProgress`.
+   */
+  void publish(
+      const thrift::Publication& pub,
+      std::optional<int64_t> firstRetainedSeqNum = std::nullopt);
+
+  // Sequence number of the last publication seen by the subscriber
+  void
+  setLastSeqNum(int64_t seqNum) {
+    lastSeqNum_ = seqNum;
+  }
 
   template <class... Args>
   void
@@ -33,16 +50,26 @@ class KvStorePublisher {
     std::move(publisher_).complete(std::forward<Args>(args)...);
   }
 
+  // Number of publications not yet consumed by the subscriber
+  size_t
+  getNumPending() const {
+    return publisher_.getNumPending();
+  }
+
  private:
   thrift::KeyVals getFilteredKeyVals(const thrift::KeyVals& origKeyVals);
   std::vector<std::string> getFilteredExpiredKeys(
       const std::vector<std::string>& origExpiredKeys);
+  void publishProgress(
+      const thrift::Publication& pub, int64_t firstRetainedSeqNum);
+  void publishToStream(thrift::Publication&& pub);
 
   // set of areas whose updates should be published. If empty, publish all
   std::set<std::string> selectAreas_;
   thrift::KeyDumpParams filter_;
   KvStoreFilters keyPrefixFilter_{{}, {}};
-  apache::thrift::ServerStreamPublisher<thrift::Publication> publisher_;
+  CoalescingStreamPublisher<thrift::Publication> publisher_;
+  std::optional<int64_t> lastSeqNum_;
 
  public:
   std::chrono::steady_clock::time_point subscription_time_;
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <openr/kvstore/KvStoreStorage.h>
+
+#include <cstring>
+
+#include <glog/logging.h>
+
+#include <openr/common/Util.h>
+
+namespace openr {
+
+const KvStoreStorage::Entry*
+KvStoreStorage::find(std::string_view key) const {
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  return &entries_[it->second];
+}
+
+const std::string&
+KvStoreStorage::getOriginatorId(const Entry& entry) const {
+  return originators_.at(entry.originator);
+}
+
+size_t
+KvStoreStorage::getNumKeysWithOriginator(
+    const std::string& originatorId) const {
+  auto it = originatorIndex_.find(originatorId);
+  if (it == originatorIndex_.end()) {
+    return 0;
+  }
+  return originatorSlots_[it->second].size();
+}
+
+thrift::Value
+KvStoreStorage::toThriftValue(const Entry& entry, bool withValue) const {
+  thrift::Value value;
+  value.version() = entry.version;
+  value.originatorId() = getOriginatorId(entry);
+  if (withValue) {
+    value.value() = entry.value;
+  }
+  value.ttl() = entry.ttl;
+  value.ttlVersion() = entry.ttlVersion;
+  value.hash() = entry.hash;
+  return value;
+}
+
+thrift::KeyVals
+KvStoreStorage::toThrift() const {
+  thrift::KeyVals keyVals;
+  forEach([&](const Entry& entry) {
+    keyVals.emplace(std::string(entry.key), toThriftValue(entry));
+  });
+  return keyVals;
+}
+
+void
+KvStoreStorage::set(std::string_view key, const thrift::Value& value) {
+  CHECK(value.value().has_value());
+
+  const auto originator = internOriginator(*value.originatorId());
+  uint32_t slot;
+  auto it = index_.find(key);
+  if (it != index_.end()) {
+    slot = it->second;
+    if (entries_[slot].originator != originator) {
+      originatorSlots_[entries_[slot].originator].erase(slot);
+      originatorSlots_[originator].emplace(slot);
+    }
+  } else {
+    if (not freeSlots_.empty()) {
+      slot = freeSlots_.back();
+      freeSlots_.pop_back();
+    } else {
+      slot = entries_.size();
+      entries_.emplace_back();
+    }
+    const auto storedKey = allocateKey(key);
+    entries_[slot].key = storedKey;
+    index_.emplace(storedKey, slot);
+    orderedIndex_.emplace(storedKey, slot);
+    originatorSlots_[originator].emplace(slot);
+  }
+
+  auto& entry = entries_[slot];
+  entry.version = *value.version();
+  entry.ttl = *value.ttl();
+  entry.ttlVersion = *value.ttlVersion();
+  entry.hash = value.hash().has_value()
+      ? *value.hash()
+      : generateHash(*value.version(), *value.originatorId(), value.value());
+  entry.originator = originator;
+  entry.value = *value.value();
+}
+
+bool
+KvStoreStorage::setTtl(std::string_view key, int64_t ttl, int64_t ttlVersion) {
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return false;
+  }
+  auto& entry = entries_[it->second];
+  entry.ttl = ttl;
+  entry.ttlVersion = ttlVersion;
+  return true;
+}
+
+bool
+KvStoreStorage::erase(std::string_view key) {
+  auto it = index_.find(key);
+  if (it == index_.end()) {
+    return false;
+  }
+  const auto slot = it->second;
+  auto& entry = entries_[slot];
+  index_.erase(it);
+  orderedIndex_.erase(entry.key);
+  originatorSlots_[entry.originator].erase(slot);
+  arenaWastedBytes_ += entry.key.size();
+  // Release value right away, slot is reused later
+  entry = Entry{};
+  freeSlots_.emplace_back(slot);
+
+  maybeCompactArena();
+  return true;
+}
+
+void
+KvStoreStorage::clear() {
+  chunks_.clear();
+  chunkUsed_ = 0;
+  arenaBytes_ = 0;
+  arenaWastedBytes_ = 0;
+  entries_.clear();
+  freeSlots_.clear();
+  index_.clear();
+  orderedIndex_.clear();
+  originators_.clear();
+  originatorIndex_.clear();
+  originatorSlots_.clear();
+}
+
+std::string_view
+KvStoreStorage::allocateKey(std::string_view key) {
+  if (key.empty()) {
+    return {};
+  }
+
+  char* data{nullptr};
+  if (key.size() > kArenaChunkSize) {
+    // Dedicated chunk, kept before the one being filled
+    Chunk chunk{std::make_unique<char[]>(key.size()), key.size()};
+    data = chunk.data.get();
+    chunks_.insert(
+        chunks_.empty() ? chunks_.end() : chunks_.end() - 1, std::move(chunk));
+    arenaBytes_ += key.size();
+  } else {
+    if (chunks_.empty() or chunkUsed_ + key.size() > chunks_.back().size) {
+      if (not chunks_.empty()) {
+        // Tail of the filled chunk is never used
+        arenaWastedBytes_ += chunks_.back().size - chunkUsed_;
+      }
+      chunks_.emplace_back(
+          Chunk{std::make_unique<char[]>(kArenaChunkSize), kArenaChunkSize});
+      chunkUsed_ = 0;
+      arenaBytes_ += kArenaChunkSize;
+    }
+    data = chunks_.back().data.get() + chunkUsed_;
+    chunkUsed_ += key.size();
+  }
+  std::memcpy(data, key.data(), key.size());
+  return {data, key.size()};
+}
+
+uint32_t
+KvStoreStorage::internOriginator(const std::string& originatorId) {
+  auto [it, inserted] =
+      originatorIndex_.emplace(originatorId, originators_.size());
+  if (inserted) {
+    originators_.emplace_back(originatorId);
+    originatorSlots_.emplace_back();
+  }
+  return it->second;
+}
+
+void
+KvStoreStorage::maybeCompactArena() {
+  if (arenaBytes_ <= kArenaChunkSize or arenaWastedBytes_ * 2 < arenaBytes_) {
+    return;
+  }
+
+  // Keep old chunks alive until all keys are copied
+  auto oldChunks = std::move(chunks_);
+  chunks_.clear();
+  chunkUsed_ = 0;
+  arenaBytes_ = 0;
+  arenaWastedBytes_ = 0;
+
+  decltype(index_) index;
+  index.reserve(index_.size());
+  decltype(orderedIndex_) orderedIndex;
+  for (const auto& [_, slot] : orderedIndex_) {
+    auto& entry = entries_[slot];
+    entry.key = allocateKey(entry.key);
+    index.emplace(entry.key, slot);
+    orderedIndex.emplace_hint(orderedIndex.end(), entry.key, slot);
+  }
+  index_ = std::move(index);
+  orderedIndex_ = std::move(orderedIndex);
+}
+
+} // namespace openr
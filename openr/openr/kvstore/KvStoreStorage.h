@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
+
+#include <openr/if/gen-cpp2/KvStore_types.h>
+
+namespace openr {
+
+/**
+ * Storage of key-values of a KvStore area, in place of `thrift::KeyVals`,
+ * meant to keep memory footprint and lookup cost low with millions of keys.
+ *
+ * - Keys are copied once into an arena of large chunks and referred to by
+ *   views everywhere else. Arena is compacted once erased keys waste more than
+ *   half of it.
+ * - Entries are compact headers (version, ttl, ttlVersion, hash) along with
+ *   the index of the interned originator ID, instead of a copy of originator
+ *   ID per key. Entries live in a slab, slots of erased entries are reused.
+ * - Point lookups go through an open-addressing hash table.
+ * - Ordered index over keys serves in-order and key prefix scans.
+ * - Per-originator index serves scans of keys of an originator.
+ *
+ * Stored values always have value and hash, as ttl-only updates are never
+ * stored, and hash is generated on insertion if missing.
+ *
+ * NOTE: Not thread-safe. Meant to be owned by KvStoreDb.
+ */
+class KvStoreStorage {
+ public:
+  struct Entry {
+    // View on key in the arena
+    std::string_view key;
+    int64_t version{0};
+    int64_t ttl{0};
+    int64_t ttlVersion{0};
+    int64_t hash{0};
+    // Index of interned originator ID
+    uint32_t originator{0};
+    std::string value;
+  };
+
+  // Keys are allocated in chunks of this size. Larger keys get own chunk.
+  static constexpr size_t kArenaChunkSize{64 * 1024};
+
+  KvStoreStorage() = default;
+
+  // Entries refer to the arena of the instance, which moves along
+  KvStoreStorage(const KvStoreStorage&) = delete;
+  KvStoreStorage& operator=(const KvStoreStorage&) = delete;
+  KvStoreStorage(KvStoreStorage&&) = default;
+  KvStoreStorage& operator=(KvStoreStorage&&) = default;
+
+  size_t
+  size() const {
+    return index_.size();
+  }
+
+  bool
+  empty() const {
+    return index_.empty();
+  }
+
+  /**
+   * Entry of the key, nullptr if not found. Pointer is invalidated by any
+   * update of the storage.
+   */
+  const Entry* find(std::string_view key) const;
+
+  const std::string& getOriginatorId(const Entry& entry) const;
+
+  // Materialize entry as thrift, optionally without value
+  thrift::Value toThriftValue(const Entry& entry, bool withValue = true) const;
+
+  // Materialize all entries as thrift
+  thrift::KeyVals toThrift() const;
+
+  /**
+   * Insert or replace value of the key. Value must be set. Hash is generated
+   * if not set.
+   */
+  void set(std::string_view key, const thrift::Value& value);
+
+  // Update ttl of the key. Returns false if the key is not found.
+  bool setTtl(std::string_view key, int64_t ttl, int64_t ttlVersion);
+
+  // Returns false if the key is not found
+  bool erase(std::string_view key);
+
+  void clear();
+
+  // Invoke callback with every entry, in key order
+  template <typename Callback>
+  void
+  forEach(Callback&& callback) const {
+    for (const auto& [_, slot] : orderedIndex_) {
+      callback(entries_[slot]);
+    }
+  }
+
+  // Invoke callback with every entry whose key starts with prefix, in order
+  template <typename Callback>
+  void
+  forEachWithPrefix(std::string_view prefix, Callback&& callback) const {
+    for (auto it = orderedIndex_.lower_bound(prefix);
+         it != orderedIndex_.end() and
+         it->first.substr(0, prefix.size()) == prefix;
+         ++it) {
+      callback(entries_[it->second]);
+    }
+  }
+
+  // Invoke callback with every entry originated by the node, in no order
+  template <typename Callback>
+  void
+  forEachWithOriginator(
+      const std::string& originatorId, Callback&& callback) const {
+    auto it = originatorIndex_.find(originatorId);
+    if (it == originatorIndex_.end()) {
+      return;
+    }
+    for (const auto slot : originatorSlots_[it->second]) {
+      callback(entries_[slot]);
+    }
+  }
+
+  // Number of keys originated by the node
+  size_t getNumKeysWithOriginator(const std::string& originatorId) const;
+
+  // Bytes of arena chunks, including space of erased keys
+  size_t
+  getArenaBytes() const {
+    return arenaBytes_;
+  }
+
+  // Bytes of arena taken by erased keys, reclaimed on compaction
+  size_t
+  getArenaWastedBytes() const {
+    return arenaWastedBytes_;
+  }
+
+  size_t
+  getNumOriginators() const {
+    return originators_.size();
+  }
+
+ private:
+  struct Chunk {
+    std::unique_ptr<char[]> data;
+    size_t size{0};
+  };
+
+  // Copy key into the arena
+  std::string_view allocateKey(std::string_view key);
+
+  uint32_t internOriginator(const std::string& originatorId);
+
+  // Move live keys into fresh arena if erased ones waste too much of it
+  void maybeCompactArena();
+
+  // Arena of keys. Last chunk is the one being filled.
+  std::vector<Chunk> chunks_;
+  size_t chunkUsed_{0};
+  size_t arenaBytes_{0};
+  size_t arenaWastedBytes_{0};
+
+  // Slab of entries, and slots of erased entries to be reused
+  std::vector<Entry> entries_;
+  std::vector<uint32_t> freeSlots_;
+
+  // Key to slot of its entry
+  folly::F14FastMap<std::string_view, uint32_t> index_;
+  std::map<std::string_view, uint32_t> orderedIndex_;
+
+  // Interned originator IDs. Bounded by number of nodes, hence never erased.
+  std::vector<std::string> originators_;
+  folly::F14FastMap<std::string, uint32_t> originatorIndex_;
+  // Slots of entries of every originator, indexed as originators_
+  std::vector<folly::F14FastSet<uint32_t>> originatorSlots_;
+};
+
+} // namespace openr
@@ -5,6 +5,8 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
+
 #include <folly/logging/xlog.h>
 #include <re2/re2.h>
 
@@ -105,6 +107,62 @@ isTtlUpdate(const thrift::Value& value) {
   return !value.value().has_value();
 }
 
+// Fields of a value compared on merge, common to thrift::Value and entries of
+// KvStoreStorage. Pointers are valid until the store is updated.
+struct ValueView {
+  int64_t version{0};
+  const std::string* originatorId{nullptr};
+  int64_t ttl{0};
+  int64_t ttlVersion{0};
+  std::optional<int64_t> hash;
+  // nullptr if value is not set
+  const std::string* value{nullptr};
+};
+
+ValueView
+toValueView(const thrift::Value& value) {
+  ValueView view;
+  view.version = *value.version();
+  view.originatorId = &*value.originatorId();
+  view.ttl = *value.ttl();
+  view.ttlVersion = *value.ttlVersion();
+  view.hash = value.hash().to_optional();
+  if (value.value().has_value()) {
+    view.value = &*value.value();
+  }
+  return view;
+}
+
+ValueView
+toValueView(const KvStoreStorage& kvStore, const KvStoreStorage::Entry& entry) {
+  ValueView view;
+  view.version = entry.version;
+  view.originatorId = &kvStore.getOriginatorId(entry);
+  view.ttl = entry.ttl;
+  view.ttlVersion = entry.ttlVersion;
+  view.hash = entry.hash;
+  view.value = &entry.value;
+  return view;
+}
+
+std::optional<ValueView>
+findValue(const thrift::KeyVals& kvStore, const std::string& key) {
+  auto kvStoreIt = kvStore.find(key);
+  if (kvStoreIt == kvStore.end()) {
+    return std::nullopt;
+  }
+  return toValueView(kvStoreIt->second);
+}
+
+std::optional<ValueView>
+findValue(const KvStoreStorage& kvStore, const std::string& key) {
+  const auto* entry = kvStore.find(key);
+  if (not entry) {
+    return std::nullopt;
+  }
+  return toValueView(kvStore, *entry);
+}
+
 /*
  * Inconsistency is detected with 3 following cases:
  * 1. received ttl update with a missing k-v pair
@@ -131,7 +189,7 @@ isTtlUpdate(const thrift::Value& value) {
  */
 bool
 isResyncNeeded(
-    const thrift::KeyVals& kvStore,
+    const std::optional<ValueView>& local,
     const std::string& key,
     const thrift::Value& value) {
   /*
@@ -140,12 +198,11 @@ isResyncNeeded(
    */
   bool inconsistencyDetected{false};
   int64_t myVersion{openr::Constants::kUndefinedVersion};
-  auto kvStoreIt = kvStore.find(key);
-  if (kvStoreIt != kvStore.end()) {
-    myVersion = *kvStoreIt->second.version();
+  if (local.has_value()) {
+    myVersion = local->version;
   }
 
-  if (kvStoreIt == kvStore.end()) {
+  if (not local.has_value()) {
     /*
      * Case 1: received ttl update with a missing k-v pair
      */
@@ -172,7 +229,7 @@ isResyncNeeded(
                myVersion);
 
     inconsistencyDetected = true;
-  } else if (*value.originatorId() != *kvStoreIt->second.originatorId()) {
+  } else if (*value.originatorId() != *local->originatorId) {
     /*
      * Case 3: received ttl update with a different originatorId
      */
@@ -183,20 +240,22 @@ isResyncNeeded(
                key,
                *value.version(),
                *value.originatorId(),
-               *kvStoreIt->second.originatorId());
+               *local->originatorId);
 
     inconsistencyDetected = true;
   }
   return inconsistencyDetected;
 }
 
-int64_t
-getExistingVersion(const std::string& key, const thrift::KeyVals& kvStore) {
-  auto kvStoreIt = kvStore.find(key);
-  if (kvStoreIt != kvStore.end()) {
-    return *kvStoreIt->second.version();
-  }
-  return openr::Constants::kUndefinedVersion;
+void
+logValueUpdate(const std::string& key, const thrift::Value& value) {
+  FB_LOG_EVERY_MS(INFO, 500) << fmt::format(
+      "Updating key: {}, Originator: {}, Version: {}, TtlVersion: {}, Ttl: {}",
+      key,
+      *value.originatorId(),
+      *value.version(),
+      *value.version(),
+      *value.ttl());
 }
 
 void
@@ -206,13 +265,7 @@ updateKvStoreValue(
     const thrift::Value& value) {
   auto kvStoreIt = kvStore.find(key);
 
-  FB_LOG_EVERY_MS(INFO, 500) << fmt::format(
-      "Updating key: {}, Originator: {}, Version: {}, TtlVersion: {}, Ttl: {}",
-      key,
-      *value.originatorId(),
-      *value.version(),
-      *value.version(),
-      *value.ttl());
+  logValueUpdate(key, value);
 
   CHECK(value.value().has_value());
   // grab the new value (this will copy, intended)
@@ -234,6 +287,17 @@ updateKvStoreValue(
   }
 }
 
+void
+updateKvStoreValue(
+    KvStoreStorage& kvStore,
+    const std::string& key,
+    const thrift::Value& value) {
+  logValueUpdate(key, value);
+
+  // hash is generated by the storage if it's not there
+  kvStore.set(key, value);
+}
+
 // update TTL only, nothing else
 void
 updateKvStoreTtl(
@@ -247,19 +311,25 @@ updateKvStoreTtl(
   kvStoreIt->second.ttlVersion() = *value.ttlVersion();
 }
 
-} // namespace util
+void
+updateKvStoreTtl(
+    KvStoreStorage& kvStore,
+    const std::string& key,
+    const thrift::Value& value) {
+  CHECK(kvStore.setTtl(key, *value.ttl(), *value.ttlVersion()));
+}
 
 MergeType
 getMergeType(
     const std::string& key,
     const thrift::Value& value,
-    const thrift::KeyVals& kvStore,
+    const std::optional<ValueView>& local,
     std::optional<std::string> const& sender,
     thrift::KvStoreMergeResult& stats) {
-  int64_t myVersion = util::getExistingVersion(key, kvStore);
-  auto kvStoreIt = kvStore.find(key);
+  int64_t myVersion =
+      local.has_value() ? local->version : openr::Constants::kUndefinedVersion;
 
-  if (util::isTtlUpdate(value)) {
+  if (isTtlUpdate(value)) {
     /*
      * No value field. This is ttl refreshing coming from local store(aka,
      * self-originated key) or ttl updates coming from remote node.
@@ -267,12 +337,12 @@ getMergeType(
      * NOTE: kvStore will try to detect possible inconsistencies and force a
      * full-sync if it is adjacency peer.
      */
-    if (util::isResyncNeeded(kvStore, key, value)) {
+    if (isResyncNeeded(local, key, value)) {
       auto senderId = sender.value_or("");
       if (senderId == *value.originatorId()) {
         return MergeType::RESYNC_NEEDED;
       }
-    } else if (*value.ttlVersion() > *kvStoreIt->second.ttlVersion()) {
+    } else if (*value.ttlVersion() > local->ttlVersion) {
       /*
        * Case 4: key exists, same version, same originatorId.
        */
@@ -280,12 +350,12 @@ getMergeType(
           "(mergeKeyValues) Update ttl key: {} with higher ttlVersion: {}, old one: {}",
           key,
           *value.ttlVersion(),
-          *kvStoreIt->second.ttlVersion());
+          local->ttlVersion);
 
       return MergeType::UPDATE_TTL_NEEDED;
     }
   } else {
-    if (not util::isValidVersionAndLog(myVersion, key, value, stats)) {
+    if (not isValidVersionAndLog(myVersion, key, value, stats)) {
       /*
        * skip if the version is invalid or old
        *
@@ -300,7 +370,7 @@ getMergeType(
        * i) coming key version is higher
        * ii) first time seeing this key(myVersion =0)
        *
-       * ATTN: for newVersion < myVersion case, util::isValidVersionAndLog()
+       * ATTN: for newVersion < myVersion case, isValidVersionAndLog()
        * has already guarded against that case. :)
        */
       XLOG(DBG4) << fmt::format(
@@ -310,7 +380,7 @@ getMergeType(
           myVersion);
 
       return MergeType::UPDATE_ALL_NEEDED;
-    } else if (*value.originatorId() > *kvStoreIt->second.originatorId()) {
+    } else if (*value.originatorId() > *local->originatorId) {
       /*
        * [2nd tie-breaker] originatorId - prefer higher
        */
@@ -318,10 +388,10 @@ getMergeType(
           "(mergeKeyValues) Update key: {} with higher originatorId: {}, old one: {}",
           key,
           *value.originatorId(),
-          *kvStoreIt->second.originatorId());
+          *local->originatorId);
 
       return MergeType::UPDATE_ALL_NEEDED;
-    } else if (*value.originatorId() == *kvStoreIt->second.originatorId()) {
+    } else if (*value.originatorId() == *local->originatorId) {
       /*
        * [3rd tie-breaker] value - prefer higher
        *
@@ -335,9 +405,9 @@ getMergeType(
       // Note: We assume local store should always have a value. If not, it is
       // an invalid case and is ok to crash kvstore. For non-ttl update, the
       // incoming keys should always have a value associated
+      CHECK(local->value);
       auto rc =
-          (apache::thrift::can_throw(*value.value()))
-              .compare(apache::thrift::can_throw(*kvStoreIt->second.value()));
+          (apache::thrift::can_throw(*value.value())).compare(*local->value);
 
       if (rc > 0) {
         // versions and orginatorIds are same but value is higher
@@ -349,12 +419,12 @@ getMergeType(
         /*
          * [4th tie-breaker] ttlVersion - prefer higher
          */
-        if (*value.ttlVersion() > *kvStoreIt->second.ttlVersion()) {
+        if (*value.ttlVersion() > local->ttlVersion) {
           XLOG(DBG4) << fmt::format(
               "(mergeKeyValues) Update key: {} with higher ttlVersion: {}, old one: {}",
               key,
               *value.ttlVersion(),
-              *kvStoreIt->second.ttlVersion());
+              local->ttlVersion);
 
           return MergeType::UPDATE_TTL_NEEDED;
         }
@@ -367,7 +437,7 @@ getMergeType(
       }
     } else {
       /*
-       * regarding to value.originatorId < kvStoreIt->second.originatorId
+       * regarding to value.originatorId < local originatorId
        * case, value in local store wins the tie-breaking and no update is
        * generated.
        */
@@ -377,19 +447,10 @@ getMergeType(
   return MergeType::NO_UPDATE_NEEDED;
 }
 
-bool
-isValidTtl(int64_t val) {
-  return val == Constants::kTtlInfinity || val > 0;
-}
-
-bool
-isValidVersion(const int64_t myVersion, const thrift::Value& incomingVal) {
-  return (incomingVal.version() > 0) and (incomingVal.version() >= myVersion);
-}
-
+template <typename KvStoreT>
 thrift::KvStoreMergeResult
 mergeKeyValues(
-    thrift::KeyVals& kvStore,
+    KvStoreT& kvStore,
     thrift::KeyVals const& keyVals,
     std::optional<KvStoreFilters> const& filters,
     std::optional<std::string> const& sender) {
@@ -398,37 +459,37 @@ mergeKeyValues(
   size_t nTtlUpdate{0};
 
   for (const auto& [key, value] : keyVals) {
-    if (not util::isKeyMatchAndLog(filters, key, value, result)) {
+    if (not isKeyMatchAndLog(filters, key, value, result)) {
       // skip if the filter is set and key does NOT match the filter
       continue;
     }
 
-    if (not util::isValidTtlAndLog(key, value, result)) {
+    if (not isValidTtlAndLog(key, value, result)) {
       // skip if the ttl is invalid
       continue;
     }
 
-    const MergeType mergeType =
-        getMergeType(key, value, kvStore, sender, result);
+    // ATTN: local value is invalidated once kvStore is updated
+    const auto local = findValue(kvStore, key);
+    const MergeType mergeType = getMergeType(key, value, local, sender, result);
 
-    if (util::noNeedUpdateAndLog(mergeType, key, result)) {
+    if (noNeedUpdateAndLog(mergeType, key, result)) {
       continue;
     }
 
-    if (util::isInconsistentAndLog(mergeType, key, result)) {
+    if (isInconsistentAndLog(mergeType, key, result)) {
       continue;
     }
 
-    auto kvStoreIt = kvStore.find(key);
     auto localVersion = -1;
     std::string localOriginatorId = "null";
     auto localTtl = -1;
     auto localTtlVersion = -1;
-    if (kvStoreIt != kvStore.end()) {
-      localVersion = *kvStoreIt->second.version();
-      localTtl = *kvStoreIt->second.ttl();
-      localTtlVersion = *kvStoreIt->second.ttlVersion();
-      localOriginatorId = *kvStoreIt->second.originatorId();
+    if (local.has_value()) {
+      localVersion = local->version;
+      localTtl = local->ttl;
+      localTtlVersion = local->ttlVersion;
+      localOriginatorId = *local->originatorId;
     }
     XLOG(DBG3) << fmt::format(
         "Updating key: {}\n  Version: {} -> {}\n  Originator: {} -> {}\n  TtlVersion: {} -> {}\n  Ttl: {} -> {}",
@@ -444,10 +505,10 @@ mergeKeyValues(
 
     if (mergeType == MergeType::UPDATE_ALL_NEEDED) {
       nValUpdate++;
-      util::updateKvStoreValue(kvStore, key, value);
+      updateKvStoreValue(kvStore, key, value);
     } else if (mergeType == MergeType::UPDATE_TTL_NEEDED) {
       nTtlUpdate++;
-      util::updateKvStoreTtl(kvStore, key, value);
+      updateKvStoreTtl(kvStore, key, value);
     }
     // announce the update
     result.keyVals()->emplace(key, value);
@@ -463,33 +524,30 @@ mergeKeyValues(
   return result;
 }
 
-/**
- * Compare two values to find out which value is better
- */
+// Compare two values to find out which value is better, see compareValues()
 ComparisonResult
-compareValues(const thrift::Value& v1, const thrift::Value& v2) {
+compareValues(const ValueView& v1, const ValueView& v2) {
   // compare version
-  if (*v1.version() != *v2.version()) {
-    return *v1.version() > *v2.version() ? ComparisonResult::FIRST
-                                         : ComparisonResult::SECOND;
+  if (v1.version != v2.version) {
+    return v1.version > v2.version ? ComparisonResult::FIRST
+                                   : ComparisonResult::SECOND;
   }
 
   // compare orginatorId
-  if (*v1.originatorId() != *v2.originatorId()) {
-    return *v1.originatorId() > *v2.originatorId() ? ComparisonResult::FIRST
-                                                   : ComparisonResult::SECOND;
+  if (*v1.originatorId != *v2.originatorId) {
+    return *v1.originatorId > *v2.originatorId ? ComparisonResult::FIRST
+                                               : ComparisonResult::SECOND;
   }
 
   // compare value
-  if (v1.hash().has_value() and v2.hash().has_value() and
-      *v1.hash() == *v2.hash()) {
+  if (v1.hash.has_value() and v2.hash.has_value() and *v1.hash == *v2.hash) {
     // TODO: `ttlVersion` and `ttl` value can be different on neighbor nodes.
     // The ttl-update should never be sent over the full-sync
     // hashes are same => (version, orginatorId, value are same)
     // compare ttl-version
-    if (*v1.ttlVersion() != *v2.ttlVersion()) {
-      return *v1.ttlVersion() > *v2.ttlVersion() ? ComparisonResult::FIRST
-                                                 : ComparisonResult::SECOND;
+    if (v1.ttlVersion != v2.ttlVersion) {
+      return v1.ttlVersion > v2.ttlVersion ? ComparisonResult::FIRST
+                                           : ComparisonResult::SECOND;
     } else {
       return ComparisonResult::TIED;
     }
@@ -497,8 +555,8 @@ compareValues(const thrift::Value& v1, const thrift::Value& v2) {
 
   // can't use hash, either it's missing or they are different
   // compare values
-  if (v1.value().has_value() and v2.value().has_value()) {
-    auto compareRes = (*v1.value()).compare(*v2.value());
+  if (v1.value and v2.value) {
+    auto compareRes = v1.value->compare(*v2.value);
     if (compareRes > 0) {
       return ComparisonResult::FIRST;
     } else if (compareRes < 0) {
@@ -512,28 +570,212 @@ compareValues(const thrift::Value& v1, const thrift::Value& v2) {
   }
 }
 
+} // namespace util
+
+MergeType
+getMergeType(
+    const std::string& key,
+    const thrift::Value& value,
+    const thrift::KeyVals& kvStore,
+    std::optional<std::string> const& sender,
+    thrift::KvStoreMergeResult& stats) {
+  return util::getMergeType(
+      key, value, util::findValue(kvStore, key), sender, stats);
+}
+
+MergeType
+getMergeType(
+    const std::string& key,
+    const thrift::Value& value,
+    const KvStoreStorage& kvStore,
+    std::optional<std::string> const& sender,
+    thrift::KvStoreMergeResult& stats) {
+  return util::getMergeType(
+      key, value, util::findValue(kvStore, key), sender, stats);
+}
+
+bool
+isValidTtl(int64_t val) {
+  return val == Constants::kTtlInfinity || val > 0;
+}
+
+bool
+isValidVersion(const int64_t myVersion, const thrift::Value& incomingVal) {
+  return (incomingVal.version() > 0) and (incomingVal.version() >= myVersion);
+}
+
+thrift::KvStoreMergeResult
+mergeKeyValues(
+    thrift::KeyVals& kvStore,
+    thrift::KeyVals const& keyVals,
+    std::optional<KvStoreFilters> const& filters,
+    std::optional<std::string> const& sender) {
+  return util::mergeKeyValues(kvStore, keyVals, filters, sender);
+}
+
+thrift::KvStoreMergeResult
+mergeKeyValues(
+    KvStoreStorage& kvStore,
+    thrift::KeyVals const& keyVals,
+    std::optional<KvStoreFilters> const& filters,
+    std::optional<std::string> const& sender) {
+  return util::mergeKeyValues(kvStore, keyVals, filters, sender);
+}
+
+/**
+ * Compare two values to find out which value is better
+ */
+ComparisonResult
+compareValues(const thrift::Value& v1, const thrift::Value& v2) {
+  return util::compareValues(util::toValueView(v1), util::toValueView(v2));
+}
+
+namespace {
+
+// Whether key prefix has no RE2 special character, hence matches keys
+// starting with it as is
+bool
+isLiteralKeyPrefix(std::string const& keyPrefix) {
+  return keyPrefix.find_first_of("\\.^$|?*+()[]{}") == std::string::npos;
+}
+
+// Literal key prefixes, sorted, without the ones covered by a shorter one
+std::vector<std::string>
+getLiteralKeyPrefixes(std::vector<std::string> const& keyPrefixes) {
+  std::vector<std::string> literals;
+  for (auto const& keyPrefix : keyPrefixes) {
+    if (isLiteralKeyPrefix(keyPrefix)) {
+      literals.emplace_back(keyPrefix);
+    }
+  }
+  std::sort(literals.begin(), literals.end());
+  std::vector<std::string> result;
+  for (auto& literal : literals) {
+    // Keys covered by a prefix sort right after it
+    if (not result.empty() and
+        literal.compare(0, result.back().size(), result.back()) == 0) {
+      continue;
+    }
+    result.emplace_back(std::move(literal));
+  }
+  return result;
+}
+
+std::vector<std::string>
+getRegexKeyPrefixes(std::vector<std::string> const& keyPrefixes) {
+  std::vector<std::string> result;
+  for (auto const& keyPrefix : keyPrefixes) {
+    if (not isLiteralKeyPrefix(keyPrefix)) {
+      result.emplace_back(keyPrefix);
+    }
+  }
+  return result;
+}
+
+/*
+ * Invoke callback with (key, entry) of every entry of the store matching the
+ * filters, exactly once. Literal key prefixes are planned into range scans of
+ * the ordered index, and originator IDs into scans of the per-originator
+ * index. True regexes fall back to a full scan, unless AND-ed with originator
+ * IDs.
+ */
+template <typename Callback>
+void
+forEachMatchingEntry(
+    const KvStoreStorage& kvStore,
+    const KvStoreFilters& kvFilters,
+    Callback&& callback) {
+  const auto& literals = kvFilters.getLiteralKeyPrefixes();
+  const auto originatorIds = kvFilters.getOriginatorIdList();
+  const bool hasRegex = kvFilters.hasRegexKeyPrefixes();
+
+  auto visitIfMatch = [&](const KvStoreStorage::Entry& entry) {
+    std::string key(entry.key);
+    if (kvFilters.keyMatch(key, kvStore.getOriginatorId(entry))) {
+      callback(std::move(key), entry);
+    }
+  };
+
+  if (kvFilters.getFilterOperator() == thrift::FilterOperator::AND) {
+    // Scan index of one filter, and check the others on every entry
+    if (not originatorIds.empty()) {
+      for (auto const& originatorId : originatorIds) {
+        kvStore.forEachWithOriginator(originatorId, visitIfMatch);
+      }
+    } else if (not literals.empty() and not hasRegex) {
+      for (auto const& literal : literals) {
+        kvStore.forEachWithPrefix(literal, visitIfMatch);
+      }
+    } else {
+      kvStore.forEach(visitIfMatch);
+    }
+    return;
+  }
+
+  // Union of scans of every filter
+  if (hasRegex or (literals.empty() and originatorIds.empty())) {
+    kvStore.forEach(visitIfMatch);
+    return;
+  }
+  for (auto const& literal : literals) {
+    kvStore.forEachWithPrefix(literal, [&](const KvStoreStorage::Entry& entry) {
+      callback(std::string(entry.key), entry);
+    });
+  }
+  for (auto const& originatorId : originatorIds) {
+    kvStore.forEachWithOriginator(
+        originatorId, [&](const KvStoreStorage::Entry& entry) {
+          std::string key(entry.key);
+          // Skip keys visited by prefix scans
+          if (literals.empty() or not kvFilters.keyMatch(key)) {
+            callback(std::move(key), entry);
+          }
+        });
+  }
+}
+
+} // namespace
+
 KvStoreFilters::KvStoreFilters(
     std::vector<std::string> const& keyPrefix,
     std::set<std::string> const& nodeIds,
     thrift::FilterOperator const& filterOperator)
     : keyPrefixList_(keyPrefix),
       originatorIds_(nodeIds),
-      keyRegexSet_(RegexSet(keyPrefixList_)),
+      literalKeyPrefixes_(getLiteralKeyPrefixes(keyPrefixList_)),
+      regexKeyPrefixes_(getRegexKeyPrefixes(keyPrefixList_)),
+      keyRegexSet_(RegexSet(regexKeyPrefixes_)),
       filterOperator_(filterOperator) {}
 
+bool
+KvStoreFilters::keyPrefixMatch(std::string const& key) const {
+  for (auto const& literal : literalKeyPrefixes_) {
+    if (key.compare(0, literal.size(), literal) == 0) {
+      return true;
+    }
+  }
+  return not regexKeyPrefixes_.empty() and keyRegexSet_.match(key);
+}
+
 // The function return true if there is a match on one of
 // the attributes, such as key prefix or originator ids.
 bool
 KvStoreFilters::keyMatchAny(
     std::string const& key, thrift::Value const& value) const {
+  return keyMatchAny(key, *value.originatorId());
+}
+
+bool
+KvStoreFilters::keyMatchAny(
+    std::string const& key, std::string const& originatorId) const {
   if (keyPrefixList_.empty() && originatorIds_.empty()) {
     // No filter and nothing to match against.
     return true;
   }
-  if (!keyPrefixList_.empty() && keyRegexSet_.match(key)) {
+  if (!keyPrefixList_.empty() && keyPrefixMatch(key)) {
     return true;
   }
-  if (!originatorIds_.empty() && originatorIds_.count(*value.originatorId())) {
+  if (!originatorIds_.empty() && originatorIds_.count(originatorId)) {
     return true;
   }
   return false;
@@ -544,17 +786,22 @@ KvStoreFilters::keyMatchAny(
 bool
 KvStoreFilters::keyMatchAll(
     std::string const& key, thrift::Value const& value) const {
+  return keyMatchAll(key, *value.originatorId());
+}
+
+bool
+KvStoreFilters::keyMatchAll(
+    std::string const& key, std::string const& originatorId) const {
   if (keyPrefixList_.empty() && originatorIds_.empty()) {
     // No filter and nothing to match against.
     return true;
   }
 
-  if (!keyPrefixList_.empty() && not keyRegexSet_.match(key)) {
+  if (!keyPrefixList_.empty() && not keyPrefixMatch(key)) {
     return false;
   }
 
-  if (!originatorIds_.empty() &&
-      not originatorIds_.count(*value.originatorId())) {
+  if (!originatorIds_.empty() && not originatorIds_.count(originatorId)) {
     return false;
   }
 
@@ -564,10 +811,16 @@ KvStoreFilters::keyMatchAll(
 bool
 KvStoreFilters::keyMatch(
     std::string const& key, thrift::Value const& value) const {
+  return keyMatch(key, *value.originatorId());
+}
+
+bool
+KvStoreFilters::keyMatch(
+    std::string const& key, std::string const& originatorId) const {
   if (filterOperator_ == thrift::FilterOperator::OR) {
-    return keyMatchAny(key, value);
+    return keyMatchAny(key, originatorId);
   }
-  return keyMatchAll(key, value);
+  return keyMatchAll(key, originatorId);
 }
 
 // The function return true if there is a key match
@@ -576,7 +829,7 @@ KvStoreFilters::keyMatch(std::string const& key) const {
   if (keyPrefixList_.empty()) {
     return true;
   }
-  return keyRegexSet_.match(key);
+  return keyPrefixMatch(key);
 }
 
 std::vector<std::string>
@@ -649,6 +902,47 @@ dumpDifference(
   return thriftPub;
 }
 
+thrift::Publication
+dumpDifference(
+    const std::string& area,
+    const KvStoreStorage& myKeyVal,
+    const thrift::KeyVals& reqKeyVal) {
+  thrift::Publication thriftPub;
+  thriftPub.area() = area;
+
+  thriftPub.tobeUpdatedKeys() = std::vector<std::string>{};
+
+  myKeyVal.forEach([&](const KvStoreStorage::Entry& entry) {
+    std::string myKey(entry.key);
+    const auto& reqKv = reqKeyVal.find(myKey);
+
+    if (reqKv == reqKeyVal.end()) {
+      // not exist in reqKeyVal
+      thriftPub.keyVals()->emplace(myKey, myKeyVal.toThriftValue(entry));
+      return;
+    }
+
+    ComparisonResult rc = util::compareValues(
+        util::toValueView(myKeyVal, entry), util::toValueView(reqKv->second));
+
+    if (rc == ComparisonResult::FIRST or rc == ComparisonResult::UNKNOWN) {
+      thriftPub.keyVals()->emplace(myKey, myKeyVal.toThriftValue(entry));
+    }
+    if (rc == ComparisonResult::SECOND or rc == ComparisonResult::UNKNOWN) {
+      thriftPub.tobeUpdatedKeys()->emplace_back(std::move(myKey));
+    }
+  });
+
+  for (const auto& [reqKey, reqVal] : reqKeyVal) {
+    if (not myKeyVal.find(reqKey)) {
+      // not exist in myKeyVal
+      thriftPub.tobeUpdatedKeys()->emplace_back(reqKey);
+    }
+  }
+
+  return thriftPub;
+}
+
 // dump the entries of my KV store whose keys match filter
 // KvStoreFilters contains `thrift::FilterOperator`
 // Default to thrift::FilterOperator::OR
@@ -675,6 +969,27 @@ dumpAllWithFilters(
   return thriftPub;
 }
 
+thrift::Publication
+dumpAllWithFilters(
+    const std::string& area,
+    const KvStoreStorage& kvStore,
+    const KvStoreFilters& kvFilters,
+    bool doNotPublishValue) {
+  thrift::Publication thriftPub;
+  thriftPub.area() = area;
+
+  forEachMatchingEntry(
+      kvStore,
+      kvFilters,
+      [&](std::string&& key, const KvStoreStorage::Entry& entry) {
+        thriftPub.keyVals()->emplace(
+            std::move(key),
+            kvStore.toThriftValue(entry, not doNotPublishValue));
+      });
+
+  return thriftPub;
+}
+
 // dump the hashes of my KV store whose keys match the given prefix
 // if prefix is the empty string, the full hash store is dumped
 thrift::Publication
@@ -698,6 +1013,24 @@ dumpHashWithFilters(
   }
   return thriftPub;
 }
+
+thrift::Publication
+dumpHashWithFilters(
+    const std::string& area,
+    const KvStoreStorage& kvStore,
+    const KvStoreFilters& kvFilters) {
+  thrift::Publication thriftPub;
+  thriftPub.area() = area;
+  forEachMatchingEntry(
+      kvStore,
+      kvFilters,
+      [&](std::string&& key, const KvStoreStorage::Entry& entry) {
+        thriftPub.keyVals()->emplace(
+            std::move(key),
+            kvStore.toThriftValue(entry, false /* withValue */));
+      });
+  return thriftPub;
+}
 // update TTL with remainng time to expire, TTL version remains
 // same so existing keys will not be updated with this TTL
 void
@@ -738,6 +1071,71 @@ updatePublicationTtl(
   }
 }
 
+std::vector<thrift::Publication>
+mergePublications(std::vector<thrift::Publication>&& pubs) {
+  struct MergedPublication {
+    thrift::Publication pub;
+    std::set<std::string> expiredKeys;
+  };
+  std::vector<MergedPublication> mergedPubs;
+  std::unordered_map<std::string, size_t> areaToIndex;
+  std::optional<int64_t> firstSeqNum;
+  std::optional<int64_t> lastSeqNum;
+
+  for (auto& pub : pubs) {
+    auto [it, inserted] = areaToIndex.emplace(*pub.area(), mergedPubs.size());
+    if (inserted) {
+      auto& mergedPub = mergedPubs.emplace_back().pub;
+      mergedPub.area() = *pub.area();
+    }
+    auto& merged = mergedPubs.at(it->second);
+    auto& mergedKeyVals = *merged.pub.keyVals();
+
+    for (auto& [key, val] : *pub.keyVals()) {
+      merged.expiredKeys.erase(key);
+      auto kv = mergedKeyVals.find(key);
+      // Fold TTL refresh into the value it refreshes
+      if (not val.value().has_value() and kv != mergedKeyVals.end() and
+          kv->second.value().has_value() and
+          *kv->second.version() == *val.version() and
+          *kv->second.originatorId() == *val.originatorId()) {
+        kv->second.ttl() = *val.ttl();
+        kv->second.ttlVersion() = *val.ttlVersion();
+        continue;
+      }
+      mergedKeyVals.insert_or_assign(key, std::move(val));
+    }
+    for (auto& key : *pub.expiredKeys()) {
+      mergedKeyVals.erase(key);
+      merged.expiredKeys.emplace(std::move(key));
+    }
+    if (pub.timestamp_ms().has_value()) {
+      merged.pub.timestamp_ms() = *pub.timestamp_ms();
+    }
+    if (pub.seqNum().has_value()) {
+      firstSeqNum = firstSeqNum.value_or(*pub.seqNum());
+      lastSeqNum = *pub.seqNum();
+    }
+  }
+
+  std::vector<thrift::Publication> result;
+  result.reserve(mergedPubs.size());
+  for (auto& merged : mergedPubs) {
+    merged.pub.expiredKeys() = {
+        merged.expiredKeys.begin(), merged.expiredKeys.end()};
+    // Only the last merged publication reflects all merged ones. Stream
+    // resumed from any other must replay all of them.
+    if (firstSeqNum.has_value()) {
+      merged.pub.seqNum() = *firstSeqNum - 1;
+    }
+    result.emplace_back(std::move(merged.pub));
+  }
+  if (lastSeqNum.has_value()) {
+    result.back().seqNum() = *lastSeqNum;
+  }
+  return result;
+}
+
 std::string
 getAreaTypeByAreaName(const std::string& area) {
   if (re2::RE2::FullMatch(area, re2::RE2(Constants::podEndingPattern))) {
@@ -13,6 +13,7 @@
 #include <openr/common/Types.h>
 #include <openr/if/gen-cpp2/KvStore_constants.h>
 #include <openr/if/gen-cpp2/KvStore_types.h>
+#include <openr/kvstore/KvStoreStorage.h>
 
 #include <folly/ssl/SSLSessionManager.h>
 
@@ -59,6 +60,14 @@ struct SelfOriginatedValue {
 using SelfOriginatedKeyVals =
     std::unordered_map<std::string, SelfOriginatedValue>;
 
+/*
+ * Filters of keys by key prefixes and originator IDs.
+ *
+ * Key prefixes are regexes anchored at the start of the key. Prefixes without
+ * regex special characters are literal and matched without RE2. Dumps of
+ * KvStoreStorage plan literal prefixes into range scans of its ordered index,
+ * and originator IDs into scans of its per-originator index.
+ */
 class KvStoreFilters {
  public:
   // takes the list of comma separated key prefixes to match,
@@ -71,11 +80,16 @@ class KvStoreFilters {
 
   // Check if key matches the filters
   bool keyMatchAny(std::string const& key, thrift::Value const& value) const;
+  bool keyMatchAny(
+      std::string const& key, std::string const& originatorId) const;
 
   // Check if key matches all the filters
   bool keyMatchAll(std::string const& key, thrift::Value const& value) const;
+  bool keyMatchAll(
+      std::string const& key, std::string const& originatorId) const;
 
   bool keyMatch(std::string const& key, thrift::Value const& value) const;
+  bool keyMatch(std::string const& key, std::string const& originatorId) const;
 
   // overload the function for key only match
   bool keyMatch(std::string const& key) const;
@@ -86,17 +100,41 @@ class KvStoreFilters {
   // return set of origninator IDs
   std::set<std::string> getOriginatorIdList() const;
 
+  // Literal key prefixes, sorted, none being prefix of another
+  std::vector<std::string> const&
+  getLiteralKeyPrefixes() const {
+    return literalKeyPrefixes_;
+  }
+
+  // Whether some key prefixes are true regexes
+  bool
+  hasRegexKeyPrefixes() const {
+    return not regexKeyPrefixes_.empty();
+  }
+
+  thrift::FilterOperator
+  getFilterOperator() const {
+    return filterOperator_;
+  }
+
   // print filters
   std::string str() const;
 
  private:
+  // Check if key matches one of the key prefixes. Prefix list must be set.
+  bool keyPrefixMatch(std::string const& key) const;
+
   // list of string prefixes, empty list matches all keys
   std::vector<std::string> keyPrefixList_{};
 
   // set of node IDs to match, empty set matches all nodes
   std::set<std::string> originatorIds_{};
 
-  // keyPrefix class to create RE2 set and to match keys
+  // key prefixes split into literal ones and true regexes
+  std::vector<std::string> literalKeyPrefixes_{};
+  std::vector<std::string> regexKeyPrefixes_{};
+
+  // keyPrefix class to create RE2 set and to match keys. Only holds regexes.
   RegexSet keyRegexSet_;
 
   // filter's OR/AND matching logic for attributes
@@ -237,6 +275,11 @@ thrift::KvStoreMergeResult mergeKeyValues(
     const thrift::KeyVals& keyVals,
     std::optional<KvStoreFilters> const& filters = std::nullopt,
     std::optional<std::string> const& senderName = std::nullopt);
+thrift::KvStoreMergeResult mergeKeyValues(
+    KvStoreStorage& kvStore,
+    const thrift::KeyVals& keyVals,
+    std::optional<KvStoreFilters> const& filters = std::nullopt,
+    std::optional<std::string> const& senderName = std::nullopt);
 
 /*
  * Compare two thrift::Values to figure out which value is better to
@@ -262,6 +305,10 @@ thrift::Publication dumpDifference(
     const std::string& area,
     const thrift::KeyVals& myKeyVal,
     const thrift::KeyVals& reqKeyVal);
+thrift::Publication dumpDifference(
+    const std::string& area,
+    const KvStoreStorage& myKeyVal,
+    const thrift::KeyVals& reqKeyVal);
 
 // Dump the entries of my KV store whose keys match the filter
 thrift::Publication dumpAllWithFilters(
@@ -269,6 +316,11 @@ thrift::Publication dumpAllWithFilters(
     const thrift::KeyVals& kvStore,
     const KvStoreFilters& kvFilters,
     bool doNotPublishValue = false);
+thrift::Publication dumpAllWithFilters(
+    const std::string& area,
+    const KvStoreStorage& kvStore,
+    const KvStoreFilters& kvFilters,
+    bool doNotPublishValue = false);
 
 // Dump the hashes of my KV store whose keys match the given prefix
 // If prefix is the empty sting, the full hash store is dumped
@@ -276,6 +328,10 @@ thrift::Publication dumpHashWithFilters(
     const std::string& area,
     const thrift::KeyVals& kvStore,
     const KvStoreFilters& kvFilters);
+thrift::Publication dumpHashWithFilters(
+    const std::string& area,
+    const KvStoreStorage& kvStore,
+    const KvStoreFilters& kvFilters);
 
 // Update Time to expire filed in Publication
 // If timeleft is below Constants::kTtlThreshold and removeAboutToExpire is
@@ -286,6 +342,25 @@ void updatePublicationTtl(
     thrift::Publication& thriftPub,
     const bool removeAboutToExpire = true);
 
+/*
+ * Merge consecutive publications into a single publication per area having
+ * the same effect when applied in order, i.e. the last update or expiry of
+ * every key wins. TTL-only updates are folded into the value they refresh.
+ *
+ * Sequence number of the last merged publication is the one of the last input
+ * publication. The others carry the sequence number preceding the first input
+ * publication, as resuming a stream from them must replay all inputs.
+ *
+ * NOTE: `nodeIds` and `tobeUpdatedKeys` are not retained as they are not
+ * applicable to stream subscribers.
+ *
+ * @param pubs - publications in the order they were published
+ *
+ * @return: merged publications in the order of first appearance of the area
+ */
+std::vector<thrift::Publication> mergePublications(
+    std::vector<thrift::Publication>&& pubs);
+
 /*
  * Check if TTL is valid.
  * Criteria: It must be infinite or positive number
@@ -326,6 +401,12 @@ MergeType getMergeType(
     const thrift::KeyVals& kvStore,
     std::optional<std::string> const& sender,
     thrift::KvStoreMergeResult& result);
+MergeType getMergeType(
+    const std::string& key,
+    const thrift::Value& value,
+    const KvStoreStorage& kvStore,
+    std::optional<std::string> const& sender,
+    thrift::KvStoreMergeResult& result);
 
 std::string getAreaTypeByAreaName(const std::string& area);
 } // namespace openr
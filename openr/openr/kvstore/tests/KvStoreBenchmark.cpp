@@ -12,6 +12,7 @@
 #include <openr/if/gen-cpp2/KvStoreServiceAsyncClient.h>
 #include <openr/if/gen-cpp2/KvStore_types.h>
 #include <openr/kvstore/KvStore.h>
+#include <openr/kvstore/KvStoreStorage.h>
 #include <openr/kvstore/KvStoreUtil.h>
 #include <openr/kvstore/KvStoreWrapper.h>
 #include <openr/monitor/SystemMetrics.h>
@@ -36,7 +37,50 @@ namespace openr {
 namespace {
 const std::string kMemoryBeforeOperationMB = "memory_before_operation(MB)";
 const std::string kMemoryAfterOperationMB = "memory_after_operation(MB)";
+const std::string kRssBeforeOperationMB = "rss_before_operation(MB)";
+const std::string kRssAfterOperationMB = "rss_after_operation(MB)";
+const std::string kBytesPerKey = "bytes_per_key";
+const std::string kNumDumpedKeys = "num_dumped_keys";
 const std::string kNodeId = "kvStore";
+// Size of per-prefix values, the bulk of keys of large stores
+const size_t kSizeOfPrefixValue = 128;
+// Number of originators of keys of large stores
+const size_t kNumOriginators = 1000;
+
+// Selective filters of dumps of large stores
+enum class DumpFilter {
+  // Literal key prefix of adjacency keys
+  ADJ_KEY_PREFIX = 0,
+  // Keys of a single originator
+  ORIGINATOR = 1,
+  // Regex key prefix matching adjacency keys
+  ADJ_KEY_REGEX = 2,
+};
+
+KvStoreFilters
+createDumpFilters(DumpFilter filter) {
+  switch (filter) {
+  case DumpFilter::ADJ_KEY_PREFIX:
+    return KvStoreFilters({"adj:"}, {});
+  case DumpFilter::ORIGINATOR:
+    return KvStoreFilters({}, {"node-1"});
+  case DumpFilter::ADJ_KEY_REGEX:
+    return KvStoreFilters({"ad[j]:"}, {});
+  }
+  return KvStoreFilters({}, {});
+}
+
+void
+insertKeyVal(
+    thrift::KeyVals& kvStore, std::string key, thrift::Value thriftValue) {
+  kvStore.emplace(std::move(key), std::move(thriftValue));
+}
+
+void
+insertKeyVal(
+    KvStoreStorage& kvStore, std::string key, thrift::Value thriftValue) {
+  kvStore.set(key, thriftValue);
+}
 } // namespace
 
 /**
@@ -84,6 +128,11 @@ class KvStoreHarness {
     }
   }
 
+  std::optional<size_t>
+  getRss() {
+    return sysMetrics_.getRSSMemBytes();
+  }
+
   uint64_t
   getVersion() {
     return version_;
@@ -127,8 +176,9 @@ class KvStoreHarness {
  * 1. Generate (key, value) pairs, and put them into kvStore
  * 2. Merge update with kvStore
  */
+template <typename KvStoreT>
 static void
-BM_KvStoreMergeKeyValues(
+runMergeKeyValues(
     folly::UserCounters& counters,
     uint32_t iters,
     uint32_t numOfKeysInStore,
@@ -138,7 +188,7 @@ BM_KvStoreMergeKeyValues(
   auto kvStoreHarness = std::make_unique<KvStoreHarness>();
 
   for (uint32_t i = 0; i < iters; i++) {
-    thrift::KeyVals kvStore;
+    KvStoreT kvStore;
     thrift::KeyVals update;
 
     // Insert (key, value)s into kvStore
@@ -150,10 +200,7 @@ BM_KvStoreMergeKeyValues(
           kNodeId, /* originatorId */
           value /* value */);
 
-      kvStore.emplace(
-          std::piecewise_construct,
-          std::forward_as_tuple(key),
-          std::forward_as_tuple(thriftValue));
+      insertKeyVal(kvStore, key, thriftValue);
 
       if (idx < numOfUpdateKeys) {
         auto updateThriftValue = createThriftValue(
@@ -184,6 +231,147 @@ BM_KvStoreMergeKeyValues(
   kvStoreHarness->clear();
 }
 
+static void
+BM_KvStoreMergeKeyValues(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    uint32_t numOfKeysInStore,
+    size_t numOfUpdateKeys) {
+  runMergeKeyValues<thrift::KeyVals>(
+      counters, iters, numOfKeysInStore, numOfUpdateKeys);
+}
+
+static void
+BM_KvStoreStorageMergeKeyValues(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    uint32_t numOfKeysInStore,
+    size_t numOfUpdateKeys) {
+  runMergeKeyValues<KvStoreStorage>(
+      counters, iters, numOfKeysInStore, numOfUpdateKeys);
+}
+
+/**
+ * Benchmark for memory footprint of a store:
+ * 1. Generate per-prefix (key, value) pairs from many originators
+ * 2. Insert them into an empty store, and record RSS growth per key
+ *
+ * ATTN: RSS growth is only accurate on the first iteration, as freed memory
+ * may be retained by the allocator.
+ */
+template <typename KvStoreT>
+static void
+runStoreMemory(
+    folly::UserCounters& counters, uint32_t iters, size_t numOfKeysInStore) {
+  auto suspender = folly::BenchmarkSuspender();
+  auto kvStoreHarness = std::make_unique<KvStoreHarness>();
+
+  for (uint32_t i = 0; i < iters; i++) {
+    std::vector<std::pair<std::string, thrift::Value>> keyVals;
+    keyVals.reserve(numOfKeysInStore);
+    for (uint32_t idx = 0; idx < numOfKeysInStore; idx++) {
+      keyVals.emplace_back(
+          genRandomStr(kSizeOfKey),
+          createThriftValue(
+              kvStoreHarness->getVersion(), /* version */
+              fmt::format("node-{}", idx % kNumOriginators), /* originatorId */
+              genRandomStr(kSizeOfPrefixValue) /* value */));
+    }
+
+    const auto rssBefore = kvStoreHarness->getRss();
+    auto kvStore = std::make_unique<KvStoreT>();
+
+    suspender.dismiss(); // Start measuring benchmark time
+    for (auto& [key, thriftValue] : keyVals) {
+      insertKeyVal(*kvStore, std::move(key), std::move(thriftValue));
+    }
+    suspender.rehire(); // Stop measuring benchmark time
+
+    const auto rssAfter = kvStoreHarness->getRss();
+    if (i == 0 and rssBefore.has_value() and rssAfter.has_value()) {
+      counters[kRssBeforeOperationMB] = *rssBefore / 1024 / 1024;
+      counters[kRssAfterOperationMB] = *rssAfter / 1024 / 1024;
+      counters[kBytesPerKey] = (*rssAfter - *rssBefore) / numOfKeysInStore;
+    }
+  }
+
+  kvStoreHarness->clear();
+}
+
+static void
+BM_KvStoreKeyValsMemory(
+    folly::UserCounters& counters, uint32_t iters, size_t numOfKeysInStore) {
+  runStoreMemory<thrift::KeyVals>(counters, iters, numOfKeysInStore);
+}
+
+static void
+BM_KvStoreStorageMemory(
+    folly::UserCounters& counters, uint32_t iters, size_t numOfKeysInStore) {
+  runStoreMemory<KvStoreStorage>(counters, iters, numOfKeysInStore);
+}
+
+/**
+ * Benchmark for selective dumps of a large store:
+ * 1. Put per-prefix keys and one adjacency key per originator into kvStore
+ * 2. Benchmark the time for dumpAllWithFilters() with a selective filter
+ */
+template <typename KvStoreT>
+static void
+runDumpWithFilters(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    size_t numOfKeysInStore,
+    DumpFilter filter) {
+  auto suspender = folly::BenchmarkSuspender();
+  auto kvStoreHarness = std::make_unique<KvStoreHarness>();
+
+  KvStoreT kvStore;
+  for (uint32_t idx = 0; idx < numOfKeysInStore; idx++) {
+    const auto originatorId = fmt::format("node-{}", idx % kNumOriginators);
+    auto key = idx < kNumOriginators
+        ? fmt::format("adj:{}", originatorId)
+        : genRandomStrWithPrefix("prefix:", kSizeOfKey);
+    insertKeyVal(
+        kvStore,
+        std::move(key),
+        createThriftValue(
+            kvStoreHarness->getVersion(), /* version */
+            originatorId, /* originatorId */
+            genRandomStr(kSizeOfPrefixValue) /* value */));
+  }
+  const auto kvFilters = createDumpFilters(filter);
+
+  for (uint32_t i = 0; i < iters; i++) {
+    suspender.dismiss(); // Start measuring benchmark time
+    auto thriftPub = dumpAllWithFilters(kTestingAreaName, kvStore, kvFilters);
+    suspender.rehire(); // Stop measuring benchmark time
+
+    counters[kNumDumpedKeys] = thriftPub.keyVals()->size();
+  }
+
+  kvStoreHarness->clear();
+}
+
+static void
+BM_KvStoreKeyValsDumpWithFilters(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    size_t numOfKeysInStore,
+    DumpFilter filter) {
+  runDumpWithFilters<thrift::KeyVals>(
+      counters, iters, numOfKeysInStore, filter);
+}
+
+static void
+BM_KvStoreStorageDumpWithFilters(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    size_t numOfKeysInStore,
+    DumpFilter filter) {
+  runDumpWithFilters<KvStoreStorage>(
+      counters, iters, numOfKeysInStore, filter);
+}
+
 /**
  * Benchmark for a full dump:
  * 1. Start kvStore
@@ -311,6 +499,38 @@ BENCHMARK_COUNTERS_NAME_PARAM(
 
 BENCHMARK_DRAW_LINE();
 
+// Same as above, with KvStoreStorage as store
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_KvStoreStorageMergeKeyValues, counters, 10000_100, 10000, 100);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_KvStoreStorageMergeKeyValues, counters, 10000_10000, 10000, 10000);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_KvStoreStorageMergeKeyValues, counters, 100000_100, 100000, 100);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_KvStoreStorageMergeKeyValues, counters, 100000_100000, 100000, 100000);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_KvStoreStorageMergeKeyValues, counters, 1000000_100, 1000000, 100);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_KvStoreStorageMergeKeyValues,
+    counters,
+    1000000_1000000,
+    1000000,
+    1000000);
+
+BENCHMARK_DRAW_LINE();
+
+// The parameter is number of keyVals in store
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_KvStoreKeyValsMemory, counters, 100000, 100000);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_KvStoreKeyValsMemory, counters, 1000000, 1000000);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_KvStoreStorageMemory, counters, 100000, 100000);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_KvStoreStorageMemory, counters, 1000000, 1000000);
+
+BENCHMARK_DRAW_LINE();
+
 // The parameter is number of keyVals already in store
 BENCHMARK_COUNTERS_NAME_PARAM(BM_KvStoreDumpAll, counters, 10, 10);
 BENCHMARK_COUNTERS_NAME_PARAM(BM_KvStoreDumpAll, counters, 100, 100);
@@ -321,6 +541,46 @@ BENCHMARK_COUNTERS_NAME_PARAM(BM_KvStoreDumpAll, counters, 1000000, 1000000);
 
 BENCHMARK_DRAW_LINE();
 
+// The first parameter is number of keyVals in store, the second the filter
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_KvStoreKeyValsDumpWithFilters,
+    counters,
+    1000000_adj_prefix,
+    1000000,
+    DumpFilter::ADJ_KEY_PREFIX);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_KvStoreStorageDumpWithFilters,
+    counters,
+    1000000_adj_prefix,
+    1000000,
+    DumpFilter::ADJ_KEY_PREFIX);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_KvStoreKeyValsDumpWithFilters,
+    counters,
+    1000000_originator,
+    1000000,
+    DumpFilter::ORIGINATOR);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_KvStoreStorageDumpWithFilters,
+    counters,
+    1000000_originator,
+    1000000,
+    DumpFilter::ORIGINATOR);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_KvStoreKeyValsDumpWithFilters,
+    counters,
+    1000000_adj_regex,
+    1000000,
+    DumpFilter::ADJ_KEY_REGEX);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_KvStoreStorageDumpWithFilters,
+    counters,
+    1000000_adj_regex,
+    1000000,
+    DumpFilter::ADJ_KEY_REGEX);
+
+BENCHMARK_DRAW_LINE();
+
 BENCHMARK_COUNTERS_NAME_PARAM(
     BM_KvStoreValueUpdate, counters, 10_keys, /* numOfUpdateKeys = */ 10);
 BENCHMARK_COUNTERS_NAME_PARAM(
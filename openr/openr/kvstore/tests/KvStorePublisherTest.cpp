@@ -22,8 +22,12 @@ TEST(KvStorePublisher, OnlyExpiredKeysFilterTest) {
   // We only keep the keys with prefix "adj:"
   filter.keys() = keys;
 
+  CoalescingStreamPublisher<thrift::Publication>::Options options;
+  options.name = "test";
+  options.coalesce = mergePublications;
   auto streamAndPublisher =
-      apache::thrift::ServerStream<thrift::Publication>::createPublisher();
+      CoalescingStreamPublisher<thrift::Publication>::createPublisher(
+          std::move(options), [] {});
 
   auto kvStorePublisher = std::make_unique<KvStorePublisher>(
       selectAreas,
@@ -59,6 +63,65 @@ TEST(KvStorePublisher, OnlyExpiredKeysFilterTest) {
           });
 }
 
+/**
+ * Verify that publications filtered out for the subscriber still advance its
+ * sequence number, so that it remains resumable.
+ */
+TEST(KvStorePublisher, ProgressPublicationTest) {
+  std::set<std::string> selectAreas{"default"};
+  thrift::KeyDumpParams filter;
+  filter.keys() = std::vector<std::string>{Constants::kAdjDbMarker.toString()};
+
+  CoalescingStreamPublisher<thrift::Publication>::Options options;
+  options.name = "test";
+  options.coalesce = mergePublications;
+  auto streamAndPublisher =
+      CoalescingStreamPublisher<thrift::Publication>::createPublisher(
+          std::move(options), [] {});
+
+  auto kvStorePublisher = std::make_unique<KvStorePublisher>(
+      selectAreas, std::move(filter), std::move(streamAndPublisher.second));
+  kvStorePublisher->setLastSeqNum(100);
+
+  // Publications 101-104 are filtered out by key or by area. Sequence number
+  // 101 is the oldest retained one.
+  for (int64_t seqNum = 101; seqNum <= 104; ++seqNum) {
+    thrift::Publication publication;
+    publication.area() = seqNum % 2 ? "default" : "other";
+    publication.keyVals()->emplace(
+        "prefix:test", createThriftValue(1, "node1", std::string("value")));
+    publication.seqNum() = seqNum;
+    kvStorePublisher->publish(publication, 101);
+  }
+
+  thrift::Publication publication;
+  publication.area() = "default";
+  publication.keyVals()->emplace(
+      "adj:test", createThriftValue(1, "node1", std::string("value")));
+  publication.seqNum() = 105;
+  kvStorePublisher->publish(publication, 101);
+
+  kvStorePublisher->complete();
+
+  // Progress is published once the last seen sequence number falls in the
+  // older half of the retained ones
+  std::vector<int64_t> seqNums;
+  std::vector<size_t> numKeyVals;
+  std::move(streamAndPublisher.first)
+      .toClientStreamUnsafeDoNotUse()
+      .subscribeInline(
+          [&](folly::Try<thrift::Publication>&& receivedPublication) {
+            if (receivedPublication.hasValue()) {
+              EXPECT_EQ("default", *receivedPublication->area());
+              EXPECT_TRUE(receivedPublication->expiredKeys()->empty());
+              seqNums.emplace_back(*receivedPublication->seqNum());
+              numKeyVals.emplace_back(receivedPublication->keyVals()->size());
+            }
+          });
+  EXPECT_EQ(std::vector<int64_t>({101, 103, 105}), seqNums);
+  EXPECT_EQ(std::vector<size_t>({0, 0, 1}), numKeyVals);
+}
+
 int
 main(int argc, char* argv[]) {
   // Parse command line flags
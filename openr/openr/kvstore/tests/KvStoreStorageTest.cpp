@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <random>
+
+#include <fmt/format.h>
+#include <folly/init/Init.h>
+#include <gtest/gtest.h>
+
+#include <openr/common/Util.h>
+#include <openr/kvstore/KvStoreStorage.h>
+#include <openr/kvstore/KvStoreUtil.h>
+
+using namespace openr;
+
+namespace {
+
+const std::string kArea{"area"};
+
+thrift::KeyVals
+createKeyVals(size_t numKeys, int64_t version, const std::string& prefix) {
+  thrift::KeyVals keyVals;
+  for (size_t i = 0; i < numKeys; ++i) {
+    keyVals.emplace(
+        fmt::format("{}{}", prefix, i),
+        createThriftValue(
+            version,
+            fmt::format("node{}", i % 3),
+            fmt::format("value{}", i),
+            Constants::kTtlInfinity,
+            0 /* ttl version */));
+  }
+  return keyVals;
+}
+
+} // namespace
+
+/**
+ * Verify point lookups and updates, and that originator IDs are interned.
+ */
+TEST(KvStoreStorageTest, SetFindErase) {
+  KvStoreStorage storage;
+  EXPECT_TRUE(storage.empty());
+  EXPECT_EQ(nullptr, storage.find("key1"));
+
+  auto value = createThriftValue(1, "node1", "value1", 3600, 0);
+  value.hash().reset();
+  storage.set("key1", value);
+  storage.set("key2", createThriftValue(2, "node1", "value2", 3600, 0));
+  EXPECT_EQ(2, storage.size());
+  EXPECT_EQ(1, storage.getNumOriginators());
+
+  // Hash is generated as it is not set
+  const auto* entry = storage.find("key1");
+  ASSERT_NE(nullptr, entry);
+  EXPECT_EQ("key1", entry->key);
+  EXPECT_EQ("node1", storage.getOriginatorId(*entry));
+  value.hash() = generateHash(1, "node1", value.value());
+  EXPECT_EQ(value, storage.toThriftValue(*entry));
+  EXPECT_FALSE(
+      storage.toThriftValue(*entry, false /* withValue */).value().has_value());
+
+  // Replace value
+  storage.set("key1", createThriftValue(3, "node2", "value3", 3600, 0));
+  entry = storage.find("key1");
+  ASSERT_NE(nullptr, entry);
+  EXPECT_EQ(3, entry->version);
+  EXPECT_EQ("node2", storage.getOriginatorId(*entry));
+  EXPECT_EQ("value3", entry->value);
+  EXPECT_EQ(2, storage.getNumOriginators());
+
+  // Update ttl
+  EXPECT_TRUE(storage.setTtl("key1", 100, 1));
+  EXPECT_FALSE(storage.setTtl("key3", 100, 1));
+  entry = storage.find("key1");
+  EXPECT_EQ(100, entry->ttl);
+  EXPECT_EQ(1, entry->ttlVersion);
+
+  // Erase
+  EXPECT_TRUE(storage.erase("key1"));
+  EXPECT_FALSE(storage.erase("key1"));
+  EXPECT_EQ(nullptr, storage.find("key1"));
+  EXPECT_EQ(1, storage.size());
+
+  // Slot of erased entry is reused
+  storage.set("key3", createThriftValue(1, "node1", "value", 3600, 0));
+  EXPECT_EQ(2, storage.size());
+  EXPECT_EQ("value", storage.find("key3")->value);
+  EXPECT_EQ("value2", storage.find("key2")->value);
+}
+
+/**
+ * Verify that entries are visited in key order, and that prefix scans visit
+ * exactly the keys with the prefix.
+ */
+TEST(KvStoreStorageTest, OrderedScan) {
+  KvStoreStorage storage;
+  for (const auto& key :
+       {"prefix:b", "adj:node2", "prefix:a", "adj:node1", "adj", "adk:"}) {
+    storage.set(key, createThriftValue(1, "node", "value", 3600, 0));
+  }
+
+  std::vector<std::string> keys;
+  storage.forEach([&](const KvStoreStorage::Entry& entry) {
+    keys.emplace_back(entry.key);
+  });
+  EXPECT_EQ(
+      std::vector<std::string>(
+          {"adj", "adj:node1", "adj:node2", "adk:", "prefix:a", "prefix:b"}),
+      keys);
+
+  keys.clear();
+  storage.forEachWithPrefix("adj:", [&](const KvStoreStorage::Entry& entry) {
+    keys.emplace_back(entry.key);
+  });
+  EXPECT_EQ(std::vector<std::string>({"adj:node1", "adj:node2"}), keys);
+
+  keys.clear();
+  storage.forEachWithPrefix("none", [&](const KvStoreStorage::Entry& entry) {
+    keys.emplace_back(entry.key);
+  });
+  EXPECT_TRUE(keys.empty());
+}
+
+/**
+ * Verify that arena is compacted once most keys are erased, and that
+ * remaining keys are intact.
+ */
+TEST(KvStoreStorageTest, ArenaCompaction) {
+  KvStoreStorage storage;
+  const auto keyVals = createKeyVals(100'000, 1, "prefix:");
+  for (const auto& [key, value] : keyVals) {
+    storage.set(key, value);
+  }
+  const auto arenaBytes = storage.getArenaBytes();
+  EXPECT_LT(KvStoreStorage::kArenaChunkSize, arenaBytes);
+
+  // Erase 9 out of 10 keys
+  size_t i{0};
+  for (const auto& [key, _] : keyVals) {
+    if (i++ % 10) {
+      EXPECT_TRUE(storage.erase(key));
+    }
+  }
+  EXPECT_EQ(10'000, storage.size());
+  EXPECT_GT(arenaBytes / 2, storage.getArenaBytes());
+  EXPECT_GT(storage.getArenaBytes() / 2, storage.getArenaWastedBytes());
+
+  i = 0;
+  for (const auto& [key, value] : keyVals) {
+    const auto* entry = storage.find(key);
+    if (i++ % 10) {
+      EXPECT_EQ(nullptr, entry);
+      continue;
+    }
+    ASSERT_NE(nullptr, entry);
+    EXPECT_EQ(key, entry->key);
+    EXPECT_EQ(*value.value(), entry->value);
+  }
+  EXPECT_EQ(10'000, storage.toThrift().size());
+}
+
+/**
+ * Verify that merging and dumping yield the same results on KvStoreStorage as
+ * on thrift::KeyVals, over random updates from several originators.
+ */
+TEST(KvStoreStorageTest, MergeParity) {
+  thrift::KeyVals keyVals;
+  KvStoreStorage storage;
+
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<int> keyDist(0, 200);
+  std::uniform_int_distribution<int> versionDist(1, 4);
+  std::uniform_int_distribution<int> nodeDist(0, 3);
+  std::uniform_int_distribution<int> valueDist(0, 2);
+
+  for (int round = 0; round < 200; ++round) {
+    thrift::KeyVals updates;
+    for (int i = 0; i < 20; ++i) {
+      const auto node = fmt::format("node{}", nodeDist(gen));
+      auto value = createThriftValue(
+          versionDist(gen),
+          node,
+          fmt::format("value{}", valueDist(gen)),
+          3600,
+          valueDist(gen) /* ttl version */);
+      // Some ttl-only updates
+      if (valueDist(gen) == 0) {
+        value.value().reset();
+      }
+      updates.emplace(fmt::format("key{}", keyDist(gen)), std::move(value));
+    }
+    const auto sender = fmt::format("node{}", nodeDist(gen));
+
+    const auto expected = mergeKeyValues(keyVals, updates, {}, sender);
+    const auto result = mergeKeyValues(storage, updates, {}, sender);
+    EXPECT_EQ(expected, result);
+    EXPECT_EQ(keyVals, storage.toThrift());
+  }
+
+  const KvStoreFilters filters({"key1"}, {"node2"});
+  EXPECT_EQ(
+      dumpAllWithFilters(kArea, keyVals, filters),
+      dumpAllWithFilters(kArea, storage, filters));
+  EXPECT_EQ(
+      dumpAllWithFilters(kArea, keyVals, filters, true),
+      dumpAllWithFilters(kArea, storage, filters, true));
+  EXPECT_EQ(
+      dumpHashWithFilters(kArea, keyVals, filters),
+      dumpHashWithFilters(kArea, storage, filters));
+
+  const auto reqKeyVals = createKeyVals(50, 2, "key");
+  const auto expected = dumpDifference(kArea, keyVals, reqKeyVals);
+  const auto result = dumpDifference(kArea, storage, reqKeyVals);
+  EXPECT_EQ(*expected.keyVals(), *result.keyVals());
+  // Keys are in key order for both
+  EXPECT_EQ(*expected.tobeUpdatedKeys(), *result.tobeUpdatedKeys());
+}
+
+/**
+ * Verify that dumps planned into index scans yield the same keys as a full
+ * scan matching every key, for every kind of filter.
+ */
+TEST(KvStoreStorageTest, FilteredDumpParity) {
+  thrift::KeyVals keyVals = createKeyVals(1000, 1, "prefix:");
+  auto adjKeyVals = createKeyVals(100, 1, "adj:");
+  keyVals.insert(adjKeyVals.begin(), adjKeyVals.end());
+  KvStoreStorage storage;
+  for (const auto& [key, value] : keyVals) {
+    storage.set(key, value);
+  }
+
+  const std::vector<std::vector<std::string>> keyPrefixes = {
+      {},
+      {"adj:"},
+      {"adj:", "adj:1", "prefix:99"},
+      {"none"},
+      {"prefix:9.9"},
+      {"adj:", "prefix:[12]0"},
+  };
+  const std::vector<std::set<std::string>> originatorIds = {
+      {}, {"node1"}, {"node0", "node2"}, {"none"}};
+
+  for (const auto& keys : keyPrefixes) {
+    for (const auto& nodes : originatorIds) {
+      for (const auto oper :
+           {thrift::FilterOperator::OR, thrift::FilterOperator::AND}) {
+        const KvStoreFilters filters(keys, nodes, oper);
+        SCOPED_TRACE(filters.str());
+        const auto expected = dumpAllWithFilters(kArea, keyVals, filters);
+        const auto result = dumpAllWithFilters(kArea, storage, filters);
+        EXPECT_EQ(*expected.keyVals(), *result.keyVals());
+        EXPECT_EQ(
+            *dumpHashWithFilters(kArea, keyVals, filters).keyVals(),
+            *dumpHashWithFilters(kArea, storage, filters).keyVals());
+      }
+    }
+  }
+
+  // Per-originator index follows updates of originator and erasures
+  storage.set("adj:0", createThriftValue(2, "node9", "value", 3600, 0));
+  storage.erase("adj:1");
+  EXPECT_EQ(1, storage.getNumKeysWithOriginator("node9"));
+  const auto result =
+      dumpAllWithFilters(kArea, storage, KvStoreFilters({"adj:"}, {"node9"}));
+  EXPECT_EQ(99, result.keyVals()->size());
+  EXPECT_EQ(
+      1,
+      dumpAllWithFilters(kArea, storage, KvStoreFilters({}, {"node9"}))
+          .keyVals()
+          ->size());
+}
+
+int
+main(int argc, char* argv[]) {
+  // Parse command line flags
+  testing::InitGoogleTest(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  folly::init(&argc, &argv);
+  FLAGS_logtostderr = true;
+
+  // Run the tests
+  return RUN_ALL_TESTS();
+}
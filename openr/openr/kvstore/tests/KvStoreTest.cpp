@@ -2907,6 +2907,75 @@ TEST_F(KvStoreTestFixture, KeySyncMultipleArea) {
   }
 }
 
+/**
+ * Verify that keys are synced and isolated per area when KvStoreDb of every
+ * area runs on its own event base, and that requests spanning areas are
+ * answered from all of them.
+ */
+TEST_F(KvStoreTestFixture, KeySyncPerAreaEventBase) {
+  const std::string podArea{"pod-area"};
+  const std::string planeArea{"plane-area"};
+  const AreaId podAreaId{podArea};
+  const AreaId planeAreaId{planeArea};
+
+  auto confA = getTestKvConf("storeA");
+  confA.enable_per_area_event_base() = true;
+  auto confB = getTestKvConf("storeB");
+  confB.enable_per_area_event_base() = true;
+  auto storeA = createKvStore(confA, {podArea, planeArea});
+  auto storeB = createKvStore(confB, {podArea, planeArea});
+  storeA->run();
+  storeB->run();
+
+  // Event bases of areas are exposed to be monitored by Watchdog
+  EXPECT_EQ(2, storeA->getKvStore()->getAreaEvbs().size());
+
+  storeA->addPeer(podAreaId, "storeB", storeB->getPeerSpec());
+  storeA->addPeer(planeAreaId, "storeB", storeB->getPeerSpec());
+  storeB->addPeer(podAreaId, "storeA", storeA->getPeerSpec());
+  storeB->addPeer(planeAreaId, "storeA", storeA->getPeerSpec());
+  waitForAllPeersInitialized();
+
+  // KvStore synced signal is published once both areas are synced
+  storeA->recvKvStoreSyncedSignal();
+  storeB->recvKvStoreSyncedSignal();
+
+  const auto podVal = createThriftValue(
+      1 /* version */, "storeA", "pod", Constants::kTtlInfinity);
+  const auto planeVal = createThriftValue(
+      1 /* version */, "storeB", "plane", Constants::kTtlInfinity);
+  EXPECT_TRUE(storeA->setKey(podAreaId, "pod-key", podVal));
+  EXPECT_TRUE(storeB->setKey(planeAreaId, "plane-key", planeVal));
+  waitForKeyInStoreWithTimeout(storeB, podAreaId, "pod-key");
+  waitForKeyInStoreWithTimeout(storeA, planeAreaId, "plane-key");
+
+  for (auto* store : {storeA, storeB}) {
+    EXPECT_FALSE(store->getKey(planeAreaId, "pod-key").has_value());
+    EXPECT_FALSE(store->getKey(podAreaId, "plane-key").has_value());
+    EXPECT_EQ(1, store->dumpAll(podAreaId).count("pod-key"));
+    EXPECT_EQ(1, store->dumpAll(planeAreaId).count("plane-key"));
+
+    auto summary = store->getSummary({});
+    ASSERT_EQ(2, summary.size());
+    EXPECT_EQ(1, *summary.at(0).keyValsCount());
+    EXPECT_EQ(1, *summary.at(1).keyValsCount());
+
+    // Counters add up over areas
+    EXPECT_EQ(2, store->getCounters().at("kvstore.num_keys"));
+  }
+
+  // Dump spanning both areas returns a publication per area
+  thrift::KeyDumpParams params;
+  auto pubs = storeA->getKvStore()
+                  ->semifuture_dumpKvStoreKeys(params, {podArea, planeArea})
+                  .get();
+  ASSERT_EQ(2, pubs->size());
+  EXPECT_EQ(planeArea, *pubs->at(0).area());
+  EXPECT_EQ(1, pubs->at(0).keyVals()->count("plane-key"));
+  EXPECT_EQ(podArea, *pubs->at(1).area());
+  EXPECT_EQ(1, pubs->at(1).keyVals()->count("pod-key"));
+}
+
 /**
  * this is to verify correctness of 3-way full-sync between default and
  * non-default Areas. storeA is in kDefaultArea, while storeB is in areaB.
@@ -466,6 +466,25 @@ TEST(KvStoreUtil, KvStoreFiltersTest) {
   ASSERT_FALSE(andFilter.keyMatch(node1_key1, node3_val1)); // Match key only
   ASSERT_FALSE(andFilter.keyMatch(node3_key1, node1_val1)); // Match node only
   ASSERT_FALSE(andFilter.keyMatch(node3_key1, node3_val1)); // No match
+
+  // 3. Test split of literal and regex key prefixes
+  auto mixedFilter = KvStoreFilters(
+      {"prefix:", "adj:", "prefix:node1:", "prefix:node[12]:key1"}, {});
+  ASSERT_EQ(
+      std::vector<std::string>({"adj:", "prefix:"}),
+      mixedFilter.getLiteralKeyPrefixes());
+  ASSERT_TRUE(mixedFilter.hasRegexKeyPrefixes());
+  ASSERT_TRUE(mixedFilter.keyMatch("adj:node1"));
+  ASSERT_TRUE(mixedFilter.keyMatch(node3_key1));
+  ASSERT_FALSE(mixedFilter.keyMatch("other:adj:"));
+  ASSERT_FALSE(orFilter.hasRegexKeyPrefixes());
+
+  auto regexFilter = KvStoreFilters({"prefix:node[12]:key1"}, {});
+  ASSERT_TRUE(regexFilter.getLiteralKeyPrefixes().empty());
+  ASSERT_TRUE(regexFilter.keyMatch(node1_key1));
+  ASSERT_TRUE(regexFilter.keyMatch(node2_key1));
+  ASSERT_FALSE(regexFilter.keyMatch(node1_key2));
+  ASSERT_FALSE(regexFilter.keyMatch(node3_key1));
 }
 
 TEST(KvStoreUtil, IsValidTtlTest) {
@@ -662,6 +681,52 @@ TEST(KvStoreUtil, GetMergeTypeTest) {
   }
 }
 
+TEST(KvStoreUtil, MergePublicationsTest) {
+  std::vector<thrift::Publication> pubs(4);
+  pubs.at(0).area() = "area1";
+  pubs.at(0).keyVals()->emplace(
+      "key1", createThriftValue(1, "node1", std::string("value1"), 1000));
+  pubs.at(0).keyVals()->emplace(
+      "key2", createThriftValue(1, "node1", std::string("value2"), 1000));
+  pubs.at(0).seqNum() = 10;
+
+  pubs.at(1).area() = "area2";
+  pubs.at(1).expiredKeys()->emplace_back("key3");
+  pubs.at(1).seqNum() = 11;
+
+  // TTL refresh of key1 and expiry of key2 in area1
+  pubs.at(2).area() = "area1";
+  pubs.at(2).keyVals()->emplace(
+      "key1",
+      createThriftValue(1, "node1", std::nullopt, 2000, 1 /* ttl version */));
+  pubs.at(2).expiredKeys()->emplace_back("key2");
+  pubs.at(2).seqNum() = 12;
+
+  // key3 in area2 is re-added
+  pubs.at(3).area() = "area2";
+  pubs.at(3).keyVals()->emplace(
+      "key3", createThriftValue(2, "node1", std::string("value3")));
+  pubs.at(3).seqNum() = 13;
+
+  const auto merged = mergePublications(std::move(pubs));
+  ASSERT_EQ(2, merged.size());
+
+  EXPECT_EQ("area1", *merged.at(0).area());
+  ASSERT_EQ(1, merged.at(0).keyVals()->size());
+  const auto& val1 = merged.at(0).keyVals()->at("key1");
+  EXPECT_EQ("value1", val1.value().value());
+  EXPECT_EQ(2000, *val1.ttl());
+  EXPECT_EQ(1, *val1.ttlVersion());
+  EXPECT_EQ(std::vector<std::string>({"key2"}), *merged.at(0).expiredKeys());
+  // resuming from first publication must replay all of them
+  EXPECT_EQ(9, merged.at(0).seqNum().value());
+
+  EXPECT_EQ("area2", *merged.at(1).area());
+  ASSERT_EQ(1, merged.at(1).keyVals()->count("key3"));
+  EXPECT_TRUE(merged.at(1).expiredKeys()->empty());
+  EXPECT_EQ(13, merged.at(1).seqNum().value());
+}
+
 //
 //
 //
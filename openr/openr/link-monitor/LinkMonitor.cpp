@@ -162,6 +162,10 @@ LinkMonitor::LinkMonitor(
             [this, area]() noexcept { advertiseAdjacencies(area); }));
   }
 
+  // Create batched publisher of per-neighbor metric counters
+  neighborMetricCounters_ = std::make_unique<NeighborMetricCounters>(
+      getEvb(), Constants::kNeighborMetricCountersPublishInterval);
+
   // Create throttled interfaces and addresses advertiser
   advertiseIfaceAddrThrottled_ = std::make_unique<AsyncThrottle>(
       getEvb(), Constants::kLinkThrottleTimeout, [this]() noexcept {
@@ -751,8 +755,7 @@ LinkMonitor::advertiseAdjacencies(const std::string& area) {
   for (const auto& [_, areaAdjacencies] : adjacencies_) {
     for (const auto& [_, adjValue] : areaAdjacencies) {
       auto& adj = adjValue.adj_;
-      fb303::fbData->setCounter(
-          "link_monitor.metric." + *adj.otherNodeName(), *adj.metric());
+      neighborMetricCounters_->update(*adj.otherNodeName(), *adj.metric());
     }
   }
 }
@@ -1025,7 +1028,7 @@ LinkMonitor::buildAdjacencyDatabase(const std::string& area) {
   // Add perf information if enabled
   if (enablePerfMeasurement_) {
     thrift::PerfEvents perfEvents;
-    addPerfEvent(perfEvents, nodeId_, "ADJ_DB_UPDATED");
+    addPerfEvent(perfEvents, nodeId_, thrift::PerfEventType::ADJ_DB_UPDATED);
     adjDb.perfEvents() = perfEvents;
   } else {
     DCHECK(!adjDb.perfEvents().has_value());
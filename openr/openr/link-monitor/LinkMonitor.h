@@ -22,6 +22,7 @@
 #include <openr/if/gen-cpp2/Types_types.h>
 #include <openr/link-monitor/AdjacencyEntry.h>
 #include <openr/link-monitor/InterfaceEntry.h>
+#include <openr/link-monitor/NeighborMetricCounters.h>
 #include <openr/messaging/ReplicateQueue.h>
 #include <openr/monitor/LogSample.h>
 #include <openr/nl/NetlinkProtocolSocket.h>
@@ -411,6 +412,9 @@ class LinkMonitor final : public OpenrEventBase {
   // Timer for processing interfaces which are in backoff states
   std::unique_ptr<folly::AsyncTimeout> advertiseIfaceAddrTimer_;
 
+  // Batched publication of per-neighbor metric counters
+  std::unique_ptr<NeighborMetricCounters> neighborMetricCounters_;
+
   // Exp backoff for resyncing InterfaceDb from netlink
   ExponentialBackoff<std::chrono::milliseconds> expBackoff_;
 
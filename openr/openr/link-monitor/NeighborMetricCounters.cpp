@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <fb303/ServiceData.h>
+
+#include <openr/link-monitor/NeighborMetricCounters.h>
+
+namespace fb303 = facebook::fb303;
+
+namespace openr {
+
+NeighborMetricCounters::NeighborMetricCounters(
+    folly::EventBase* evb, std::chrono::milliseconds publishInterval)
+    : publishThrottled_(
+          evb, publishInterval, [this]() noexcept { publish(); }) {}
+
+void
+NeighborMetricCounters::update(const std::string& nodeName, int64_t metric) {
+  auto [it, inserted] = counters_.try_emplace(nodeName);
+  auto& counter = it->second;
+  if (inserted) {
+    counter.name = "link_monitor.metric." + nodeName;
+  } else if (counter.value == metric) {
+    return; // No change
+  }
+
+  counter.value = metric;
+  if (not counter.dirty) {
+    counter.dirty = true;
+    dirtyCounters_.emplace_back(&counter);
+  }
+  publishThrottled_();
+}
+
+void
+NeighborMetricCounters::publish() {
+  if (publishThrottled_.isActive()) {
+    publishThrottled_.cancel();
+  }
+  for (auto* counter : dirtyCounters_) {
+    fb303::fbData->setCounter(counter->name, counter->value);
+    counter->dirty = false;
+  }
+  dirtyCounters_.clear();
+}
+
+} // namespace openr
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <folly/io/async/EventBase.h>
+
+#include <openr/common/AsyncThrottle.h>
+
+namespace openr {
+
+/**
+ * Publishes per-neighbor metric counters, i.e. `link_monitor.metric.<node>`.
+ *
+ * Counter names are built once, when a neighbor is first seen. Updates are
+ * recorded locally and only values which differ from the last published
+ * value are marked dirty. Dirty counters are published in a single batch on
+ * throttled timer expiry, instead of one fb303 update per adjacency per
+ * advertisement.
+ *
+ * NOTE: Not thread-safe. All methods must be invoked from the event base
+ * thread passed in constructor.
+ */
+class NeighborMetricCounters final {
+ public:
+  NeighborMetricCounters(
+      folly::EventBase* evb, std::chrono::milliseconds publishInterval);
+
+  // Record metric of neighbor. Schedules publication if value has changed.
+  void update(const std::string& nodeName, int64_t metric);
+
+  // Publish all dirty counters immediately
+  void publish();
+
+  // Number of counters with unpublished values
+  size_t
+  getNumDirtyCounters() const {
+    return dirtyCounters_.size();
+  }
+
+ private:
+  struct Counter {
+    // Pre-built fb303 counter name
+    std::string name;
+    // Latest recorded value
+    int64_t value{0};
+    // Is value pending publication
+    bool dirty{false};
+  };
+
+  folly::F14NodeMap<std::string /* nodeName */, Counter> counters_;
+
+  // Counters pending publication. Pointers are stable as counters are never
+  // erased from node map.
+  std::vector<Counter*> dirtyCounters_;
+
+  // Throttled batch publication
+  AsyncThrottle publishThrottled_;
+};
+
+} // namespace openr
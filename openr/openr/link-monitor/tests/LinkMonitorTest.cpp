@@ -24,6 +24,7 @@
 #include <openr/if/gen-cpp2/Types_types.h>
 #include <openr/kvstore/KvStoreWrapper.h>
 #include <openr/link-monitor/LinkMonitor.h>
+#include <openr/link-monitor/NeighborMetricCounters.h>
 #include <openr/prefix-manager/PrefixManager.h>
 #include <openr/tests/mocks/NetlinkEventsInjector.h>
 #include <openr/tests/utils/Utils.h>
@@ -2850,6 +2851,46 @@ TEST_F(LinkStatusTestFixture, LinkStatusRecords) {
   }
 }
 
+/**
+ * Verify batched publication of per-neighbor metric counters
+ * - Only changed values are marked dirty
+ * - Dirty counters are published on throttle expiry with same counter names
+ */
+TEST(NeighborMetricCountersTest, BatchedPublication) {
+  facebook::fb303::fbData->resetAllData();
+  folly::EventBase evb;
+  NeighborMetricCounters counters(&evb, std::chrono::milliseconds(10));
+
+  // New neighbors are always published
+  counters.update("node-2", 10);
+  counters.update("node-3", 20);
+  counters.update("node-2", 11);
+  EXPECT_EQ(2, counters.getNumDirtyCounters());
+  EXPECT_FALSE(
+      facebook::fb303::fbData->hasCounter("link_monitor.metric.node-2"));
+
+  // Publish on throttle expiry
+  evb.loopOnce();
+  EXPECT_EQ(0, counters.getNumDirtyCounters());
+  EXPECT_EQ(
+      11, facebook::fb303::fbData->getCounter("link_monitor.metric.node-2"));
+  EXPECT_EQ(
+      20, facebook::fb303::fbData->getCounter("link_monitor.metric.node-3"));
+
+  // Unchanged values are not re-published
+  counters.update("node-2", 11);
+  counters.update("node-3", 20);
+  EXPECT_EQ(0, counters.getNumDirtyCounters());
+
+  // Explicit publication
+  counters.update("node-3", 30);
+  EXPECT_EQ(1, counters.getNumDirtyCounters());
+  counters.publish();
+  EXPECT_EQ(0, counters.getNumDirtyCounters());
+  EXPECT_EQ(
+      30, facebook::fb303::fbData->getCounter("link_monitor.metric.node-3"));
+}
+
 int
 main(int argc, char* argv[]) {
   // Parse command line flags
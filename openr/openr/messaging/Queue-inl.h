@@ -70,11 +70,14 @@ RWQueue<ValueType>::push(ValueTypeT&& val) {
     // Unblock a pending read
     auto& pendingRead = pendingReads_.front().get();
     pendingRead.data.emplace(std::forward<ValueTypeT>(val));
+    pendingRead.enqueueTime = std::chrono::steady_clock::now();
     pendingRead.baton.post();
     pendingReads_.pop_front();
   } else {
     // Add data into the queue
-    queue_.emplace_back(std::forward<ValueTypeT>(val));
+    queue_.emplace_back(Entry{
+        ValueType(std::forward<ValueTypeT>(val)),
+        std::chrono::steady_clock::now()});
   }
   ++writes_;
 
@@ -103,7 +106,7 @@ RWQueue<ValueType>::get() {
   // Wait for baton and read the data
   pendingRead.baton.wait();
   if (pendingRead.data) {
-    ++reads_;
+    onRead(pendingRead);
     return std::move(pendingRead.data).value();
   }
   return folly::makeUnexpected(QueueError::QUEUE_CLOSED);
@@ -130,7 +133,7 @@ RWQueue<ValueType>::getCoro() {
   // Wait for baton and read the data
   co_await pendingRead.baton;
   if (pendingRead.data) {
-    ++reads_;
+    onRead(pendingRead);
     co_return std::move(pendingRead.data).value();
   }
   co_return folly::makeUnexpected(QueueError::QUEUE_CLOSED);
@@ -149,7 +152,8 @@ RWQueue<ValueType>::getAnyImpl(PendingRead& pendingRead) {
 
   // Perform immediate read if data is available
   if (queue_.size()) {
-    pendingRead.data.emplace(std::move(queue_.front()));
+    pendingRead.data.emplace(std::move(queue_.front().data));
+    pendingRead.enqueueTime = queue_.front().enqueueTime;
     queue_.pop_front();
     return true;
   }
@@ -159,6 +163,17 @@ RWQueue<ValueType>::getAnyImpl(PendingRead& pendingRead) {
   return false;
 }
 
+template <typename ValueType>
+void
+RWQueue<ValueType>::onRead(const PendingRead& pendingRead) {
+  const auto now = std::chrono::steady_clock::now();
+  const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+      now - pendingRead.enqueueTime);
+  std::lock_guard<std::mutex> l(lock_);
+  ++reads_;
+  latencyUs_.addValue(latency.count(), now);
+}
+
 template <typename ValueType>
 void
 RWQueue<ValueType>::close() {
@@ -223,7 +238,15 @@ template <typename ValueType>
 RWQueueStats
 RWQueue<ValueType>::getStats() {
   std::lock_guard<std::mutex> l(lock_);
-  return RWQueueStats{"", reads_, writes_, queue_.size()};
+  const auto latencyUs = latencyUs_.get();
+  return RWQueueStats{
+      "",
+      reads_,
+      writes_,
+      queue_.size(),
+      latencyUs.getPercentile(50),
+      latencyUs.getPercentile(99),
+      latencyUs.getMax()};
 }
 
 } // namespace openr::messaging
@@ -8,6 +8,7 @@
 #pragma once
 
 #include <any>
+#include <chrono>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -19,6 +20,9 @@
 #include <folly/experimental/coro/Task.h>
 #endif
 
+#include <openr/common/Constants.h>
+#include <openr/common/LatencyHistogram.h>
+
 namespace openr::messaging {
 
 enum class QueueError {
@@ -31,6 +35,10 @@ struct RWQueueStats {
   const size_t reads{0};
   const size_t writes{0};
   const size_t size{0};
+  // Enqueue to dequeue latency of recent reads
+  const int64_t latencyP50Us{0};
+  const int64_t latencyP99Us{0};
+  const int64_t latencyMaxUs{0};
 };
 
 template <typename ValueType>
@@ -149,6 +157,12 @@ class RWQueue {
   struct PendingRead {
     folly::fibers::Baton baton;
     std::optional<ValueType> data;
+    std::chrono::steady_clock::time_point enqueueTime;
+  };
+
+  struct Entry {
+    ValueType data;
+    std::chrono::steady_clock::time_point enqueueTime;
   };
 
   /**
@@ -159,6 +173,9 @@ class RWQueue {
    */
   folly::Expected<bool, QueueError> getAnyImpl(PendingRead& pendingRead);
 
+  // Account completed read of the data
+  void onRead(const PendingRead& pendingRead);
+
   // Lock to protect below private variables
   std::mutex lock_;
 
@@ -169,13 +186,16 @@ class RWQueue {
   std::deque<std::reference_wrapper<PendingRead>> pendingReads_;
 
   // Pending data
-  std::deque<ValueType> queue_;
+  std::deque<Entry> queue_;
 
   // Sent messages
   size_t writes_{0};
 
   // Received messages
   size_t reads_{0};
+
+  // Enqueue to dequeue latency of received messages
+  WindowedLatencyHistogram latencyUs_{Constants::kRuntimeStatsWindow};
 };
 
 } // namespace openr::messaging
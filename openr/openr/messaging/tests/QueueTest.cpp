@@ -59,6 +59,34 @@ TEST(RWQueueTest, SizeAndReaders) {
   EXPECT_EQ(4, q.numReads());
 }
 
+/**
+ * Verify that enqueue to dequeue latency is reported, both for queued data
+ * and for data handed over to a pending read.
+ */
+TEST(RWQueueTest, Latency) {
+  RWQueue<int> q;
+  EXPECT_EQ(0, q.getStats().latencyMaxUs);
+
+  q.push(1);
+  /* sleep override */
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(1, q.get().value());
+  auto stats = q.getStats();
+  EXPECT_LE(20000, stats.latencyMaxUs);
+  EXPECT_LE(stats.latencyP50Us, stats.latencyMaxUs);
+
+  // Pending read is unblocked right away
+  folly::EventBase evb;
+  auto& manager = folly::fibers::getFiberManager(evb);
+  manager.addTask([&q]() mutable { EXPECT_EQ(2, q.get().value()); });
+  evb.loopOnce();
+  q.push(2);
+  evb.loopOnce();
+  stats = q.getStats();
+  EXPECT_EQ(2, stats.reads);
+  EXPECT_GT(20000, stats.latencyP50Us);
+}
+
 TEST(RWQueueTest, DataTypes) {
   // class with const field
   class A {
@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <openr/monitor/CpuProfiler.h>
+
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+#include <memory>
+#include <mutex>
+
+#include <fmt/format.h>
+#include <folly/Demangle.h>
+#include <folly/Indestructible.h>
+#include <folly/String.h>
+#include <folly/Synchronized.h>
+#include <folly/logging/xlog.h>
+
+#include <openr/common/Constants.h>
+#include <openr/common/Flags.h>
+
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+namespace openr {
+
+namespace {
+
+// Frames of the signal handler and of the signal trampoline
+constexpr size_t kSkipFrames{2};
+
+struct Sample {
+  size_t numFrames{0};
+  std::array<void*, CpuProfiler::kMaxFrames + kSkipFrames> frames;
+};
+
+// Ring of samples of a thread, written only by the signal handler running on
+// that thread, and read only by the collector
+struct ThreadSamples {
+  explicit ThreadSamples(std::string module) : module(std::move(module)) {}
+
+  const std::string module;
+  std::array<Sample, CpuProfiler::kRingSize> ring;
+  // Number of samples written. Incremented once the sample is written.
+  std::atomic<uint64_t> head{0};
+  // Number of samples consumed by the collector
+  uint64_t tail{0};
+  // Set on thread exit. Ring is dropped once drained.
+  std::atomic<bool> exited{false};
+};
+
+// All registered threads, including exited ones not yet drained
+folly::Synchronized<std::vector<std::shared_ptr<ThreadSamples>>>&
+getThreads() {
+  static folly::Indestructible<
+      folly::Synchronized<std::vector<std::shared_ptr<ThreadSamples>>>>
+      threads;
+  return *threads;
+}
+
+// Ring of the calling thread, read by the signal handler
+thread_local ThreadSamples* tSamples{nullptr};
+
+// Stops sampling of the thread on its exit
+struct ThreadRegistration {
+  ~ThreadRegistration() {
+    if (hasTimer) {
+      timer_delete(timer);
+    }
+    if (samples) {
+      tSamples = nullptr;
+      samples->exited.store(true, std::memory_order_release);
+    }
+  }
+
+  std::shared_ptr<ThreadSamples> samples;
+  timer_t timer{};
+  bool hasTimer{false};
+};
+
+thread_local ThreadRegistration tRegistration;
+
+// NOTE: Must be async-signal-safe. Doesn't lock or allocate.
+void
+onProfSignal(int /* signum */, siginfo_t* /* info */, void* /* context */) {
+  auto* samples = tSamples;
+  if (not samples) {
+    return;
+  }
+  const auto savedErrno = errno;
+  const auto head = samples->head.load(std::memory_order_relaxed);
+  auto& sample = samples->ring[head % CpuProfiler::kRingSize];
+  sample.numFrames = ::backtrace(sample.frames.data(), sample.frames.size());
+  samples->head.store(head + 1, std::memory_order_release);
+  errno = savedErrno;
+}
+
+void
+installSignalHandler() {
+  static std::once_flag once;
+  std::call_once(once, [] {
+    // backtrace() loads the unwinder on first use, which isn't signal-safe
+    void* frames[1];
+    ::backtrace(frames, 1);
+
+    struct sigaction action {};
+    action.sa_sigaction = onProfSignal;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    PCHECK(sigaction(SIGPROF, &action, nullptr) == 0);
+  });
+}
+
+} // namespace
+
+void
+CpuProfiler::registerThread(const std::string& module) {
+  if (not isEnabled() or tRegistration.samples) {
+    return;
+  }
+  installSignalHandler();
+
+  auto samples = std::make_shared<ThreadSamples>(module);
+  getThreads().wlock()->emplace_back(samples);
+  tRegistration.samples = samples;
+  tSamples = samples.get();
+
+  // Deliver SIGPROF to this thread on every period of its CPU time
+  struct sigevent event {};
+  event.sigev_notify = SIGEV_THREAD_ID;
+  event.sigev_signo = SIGPROF;
+  event.sigev_notify_thread_id = static_cast<pid_t>(::syscall(SYS_gettid));
+  if (timer_create(CLOCK_THREAD_CPUTIME_ID, &event, &tRegistration.timer)) {
+    XLOG(ERR) << "Failed to create CPU profiler timer for " << module
+              << " thread: " << folly::errnoStr(errno);
+    return;
+  }
+  tRegistration.hasTimer = true;
+
+  const int64_t periodNs = 1'000'000'000 / FLAGS_cpu_profiler_hz;
+  struct itimerspec spec {};
+  spec.it_interval.tv_sec = periodNs / 1'000'000'000;
+  spec.it_interval.tv_nsec = periodNs % 1'000'000'000;
+  spec.it_value = spec.it_interval;
+  if (timer_settime(tRegistration.timer, 0, &spec, nullptr)) {
+    XLOG(ERR) << "Failed to start CPU profiler timer for " << module
+              << " thread: " << folly::errnoStr(errno);
+    return;
+  }
+  XLOG(INFO) << "Profiling CPU of " << module << " thread at "
+             << FLAGS_cpu_profiler_hz << "Hz";
+}
+
+bool
+CpuProfiler::isEnabled() {
+  return FLAGS_cpu_profiler_hz > 0;
+}
+
+void
+CpuProfiler::collect() {
+  rotate(std::chrono::steady_clock::now());
+
+  auto threads = getThreads().wlock();
+  for (auto it = threads->begin(); it != threads->end();) {
+    auto& samples = **it;
+    // Read before head, so that all samples of an exited thread are drained
+    const bool exited = samples.exited.load(std::memory_order_acquire);
+    const auto head = samples.head.load(std::memory_order_acquire);
+    auto& module = current_[samples.module];
+
+    // Samples overwritten since the last collection
+    if (head - samples.tail > kRingSize) {
+      module.numSamples += head - samples.tail - kRingSize;
+      module.numDropped += head - samples.tail - kRingSize;
+      samples.tail = head - kRingSize;
+    }
+
+    for (; samples.tail < head; ++samples.tail) {
+      const auto& sample = samples.ring[samples.tail % kRingSize];
+      Stack stack;
+      const auto numFrames = std::min(sample.numFrames, sample.frames.size());
+      for (size_t i = kSkipFrames; i < numFrames; ++i) {
+        stack.emplace_back(reinterpret_cast<uintptr_t>(sample.frames[i]));
+      }
+      // Sample may have been overwritten while being copied
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (samples.head.load(std::memory_order_relaxed) - samples.tail >
+          kRingSize) {
+        ++module.numSamples;
+        ++module.numDropped;
+        continue;
+      }
+      addSample(samples.module, std::move(stack));
+    }
+
+    if (exited) {
+      it = threads->erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+std::vector<thrift::ModuleCpuProfile>
+CpuProfiler::getProfiles() {
+  collect();
+
+  std::map<std::string, thrift::ModuleCpuProfile> profiles;
+  for (const auto* window : {&previous_, &current_}) {
+    for (const auto& [module, moduleStacks] : *window) {
+      auto& profile = profiles[module];
+      profile.module() = module;
+      *profile.numSamples() += moduleStacks.numSamples;
+      *profile.numDroppedSamples() += moduleStacks.numDropped;
+      for (const auto& [stack, count] : moduleStacks.stacks) {
+        // Root frame first
+        std::string folded;
+        for (auto frame = stack.rbegin(); frame != stack.rend(); ++frame) {
+          if (not folded.empty()) {
+            folded.push_back(';');
+          }
+          folded.append(symbolize(*frame));
+        }
+        (*profile.foldedStacks())[folded] += count;
+      }
+    }
+  }
+
+  std::vector<thrift::ModuleCpuProfile> result;
+  result.reserve(profiles.size());
+  for (auto& [_, profile] : profiles) {
+    result.emplace_back(std::move(profile));
+  }
+  return result;
+}
+
+void
+CpuProfiler::rotate(std::chrono::steady_clock::time_point now) {
+  const auto elapsed = now - windowStart_;
+  if (elapsed < Constants::kCpuProfileWindow) {
+    return;
+  }
+  if (elapsed < 2 * Constants::kCpuProfileWindow) {
+    previous_ = std::move(current_);
+    windowStart_ += Constants::kCpuProfileWindow;
+  } else {
+    previous_.clear();
+    windowStart_ = now;
+  }
+  current_.clear();
+  symbols_.clear();
+}
+
+void
+CpuProfiler::addSample(const std::string& module, Stack stack) {
+  auto& moduleStacks = current_[module];
+  ++moduleStacks.numSamples;
+  auto it = moduleStacks.stacks.find(stack);
+  if (it != moduleStacks.stacks.end()) {
+    ++it->second;
+  } else if (moduleStacks.stacks.size() < kMaxStacksPerModule) {
+    moduleStacks.stacks.emplace(std::move(stack), 1);
+  } else {
+    ++moduleStacks.numDropped;
+  }
+}
+
+const std::string&
+CpuProfiler::symbolize(uintptr_t address) {
+  auto it = symbols_.find(address);
+  if (it != symbols_.end()) {
+    return it->second;
+  }
+
+  // Return addresses point past the call, to the next instruction
+  Dl_info info;
+  std::string symbol;
+  if (::dladdr(reinterpret_cast<void*>(address - 1), &info) and
+      info.dli_sname) {
+    symbol = folly::demangle(info.dli_sname).toStdString();
+  } else {
+    // Not in dynamic symbol table, e.g. binary linked without -rdynamic
+    symbol = fmt::format("{:#x}", address);
+  }
+  return symbols_.emplace(address, std::move(symbol)).first->second;
+}
+
+} // namespace openr
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <openr/if/gen-cpp2/Types_types.h>
+
+namespace openr {
+
+/**
+ * Sampling CPU profiler of Open/R threads, meant to run continuously in
+ * production at low frequency.
+ *
+ * Every registered thread (one per module's event base) gets a timer on its
+ * own CPU clock, delivering SIGPROF to the thread every 1/hz seconds of CPU
+ * time it consumes. The signal handler captures the stack into a fixed-size
+ * per-thread ring, without locking or allocating. `collect()` periodically
+ * drains the rings and aggregates stacks per module. Samples are hence
+ * attributed to the module whose thread consumed the CPU.
+ *
+ * Memory is bounded: rings are fixed-size, and number of distinct stacks per
+ * module is capped by `kMaxStacksPerModule`, further stacks being counted as
+ * dropped. Aggregation covers the current and the previous window of
+ * `Constants::kCpuProfileWindow`.
+ */
+class CpuProfiler {
+ public:
+  // Maximum number of frames captured per sample
+  static constexpr size_t kMaxFrames{48};
+  // Samples buffered per thread between two collections
+  static constexpr size_t kRingSize{256};
+  // Maximum number of distinct stacks aggregated per module per window
+  static constexpr size_t kMaxStacksPerModule{2048};
+
+  /**
+   * Register calling thread to be profiled as part of the module. Sampling
+   * starts right away if the profiler is enabled, i.e. --cpu_profiler_hz > 0.
+   * The thread is unregistered on its exit.
+   */
+  static void registerThread(const std::string& module);
+
+  // Whether samples are being taken
+  static bool isEnabled();
+
+  /**
+   * Move samples of registered threads into per-module aggregation. Expected
+   * to be invoked periodically, more often than the rings wrap around.
+   */
+  void collect();
+
+  /**
+   * Get folded stacks of every module with symbolized frames, root first,
+   * separated by ';'. Can be rendered by flamegraph.pl as is.
+   */
+  std::vector<thrift::ModuleCpuProfile> getProfiles();
+
+ private:
+  using Stack = std::vector<uintptr_t>;
+
+  struct ModuleStacks {
+    std::map<Stack, int64_t> stacks;
+    int64_t numSamples{0};
+    int64_t numDropped{0};
+  };
+
+  using Window = std::unordered_map<std::string /* module */, ModuleStacks>;
+
+  // Start new window if current one has elapsed
+  void rotate(std::chrono::steady_clock::time_point now);
+
+  // Add sample of a module to current window
+  void addSample(const std::string& module, Stack stack);
+
+  // Name of the function containing the address, cached
+  const std::string& symbolize(uintptr_t address);
+
+  std::chrono::steady_clock::time_point windowStart_{
+      std::chrono::steady_clock::now()};
+  Window current_;
+  Window previous_;
+
+  // Symbols of sampled addresses, cleared on window rotation
+  std::unordered_map<uintptr_t, std::string> symbols_;
+};
+
+} // namespace openr
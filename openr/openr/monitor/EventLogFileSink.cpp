@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "openr/monitor/EventLogFileSink.h"
+
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <cstdio>
+
+#include <fmt/format.h>
+#include <folly/Exception.h>
+#include <folly/FileUtil.h>
+#include <folly/io/Cursor.h>
+#include <folly/io/IOBuf.h>
+#include <folly/lang/Bits.h>
+#include <glog/logging.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+namespace openr {
+
+EventLogFileSink::EventLogFileSink(
+    std::string filePath, size_t maxFileBytes, uint32_t maxFiles)
+    : filePath_(std::move(filePath)),
+      maxFileBytes_(maxFileBytes),
+      maxFiles_(maxFiles) {
+  CHECK(not filePath_.empty());
+  CHECK_GT(maxFileBytes_, 0);
+  CHECK_GT(maxFiles_, 0);
+  openFile();
+}
+
+void
+EventLogFileSink::write(const LogSample& sample) {
+  const auto record =
+      apache::thrift::CompactSerializer::serialize<std::string>(
+          sample.toThrift());
+  const uint32_t header = folly::Endian::big(uint32_t(record.size()));
+  const size_t recordBytes = sizeof(header) + record.size();
+
+  if (fileBytes_ > 0 and fileBytes_ + recordBytes > maxFileBytes_) {
+    rotate();
+  }
+
+  iovec iov[2];
+  iov[0].iov_base = const_cast<uint32_t*>(&header);
+  iov[0].iov_len = sizeof(header);
+  iov[1].iov_base = const_cast<char*>(record.data());
+  iov[1].iov_len = record.size();
+  folly::checkUnixError(
+      folly::writevFull(file_.fd(), iov, 2),
+      "Failed to write event log to ",
+      filePath_);
+  fileBytes_ += recordBytes;
+}
+
+std::vector<LogSample>
+EventLogFileSink::readFile(const std::string& filePath) {
+  std::string data;
+  if (not folly::readFile(filePath.c_str(), data)) {
+    throw std::runtime_error(
+        fmt::format("Failed to read event log file {}", filePath));
+  }
+
+  std::vector<LogSample> samples;
+  auto buf = folly::IOBuf::wrapBuffer(data.data(), data.size());
+  folly::io::Cursor cursor(buf.get());
+  while (not cursor.isAtEnd()) {
+    // Throws std::out_of_range on truncated record
+    const auto length = cursor.readBE<uint32_t>();
+    const auto record = cursor.readFixedString(length);
+    samples.emplace_back(LogSample::fromThrift(
+        apache::thrift::CompactSerializer::deserialize<thrift::EventLogRecord>(
+            record)));
+  }
+  return samples;
+}
+
+void
+EventLogFileSink::openFile() {
+  file_ = folly::File(filePath_, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC);
+  const auto size = ::lseek(file_.fd(), 0, SEEK_END);
+  folly::checkUnixError(size, "Failed to seek event log file ", filePath_);
+  fileBytes_ = size;
+}
+
+void
+EventLogFileSink::rotate() {
+  file_.close();
+  // Oldest file is overwritten by the next one, if any
+  for (uint32_t n = maxFiles_ - 1; n > 0; --n) {
+    ::rename(getFilePath(n - 1).c_str(), getFilePath(n).c_str());
+  }
+  if (maxFiles_ == 1) {
+    ::unlink(filePath_.c_str());
+  }
+  openFile();
+}
+
+std::string
+EventLogFileSink::getFilePath(uint32_t n) const {
+  return n == 0 ? filePath_ : fmt::format("{}.{}", filePath_, n);
+}
+
+} // namespace openr
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <folly/File.h>
+
+#include <openr/monitor/LogSample.h>
+
+namespace openr {
+
+/**
+ * Appends event logs to a local file in binary format, so that events survive
+ * the bounded in-memory log of Monitor and process restarts.
+ *
+ * Each record is `thrift::EventLogRecord` serialized with CompactSerializer,
+ * prefixed by its length as 32-bit big-endian integer. Once the file reaches
+ * `maxFileBytes`, it is rotated: `<file>` is renamed to `<file>.1`, `<file>.1`
+ * to `<file>.2` and so on, keeping at most `maxFiles` files in total.
+ *
+ * NOTE: Not thread-safe. Meant to be used from the Monitor event base, off the
+ * path of the modules producing events.
+ */
+class EventLogFileSink {
+ public:
+  EventLogFileSink(
+      std::string filePath, size_t maxFileBytes, uint32_t maxFiles);
+
+  /**
+   * Encode and append the sample, rotating file if needed. Throws
+   * std::system_error on I/O failure.
+   */
+  void write(const LogSample& sample);
+
+  /**
+   * Decode all records of a file written by the sink. Throws if file can't be
+   * read or is malformed.
+   */
+  static std::vector<LogSample> readFile(const std::string& filePath);
+
+ private:
+  // Open (or create) the current file for append
+  void openFile();
+
+  // Shift rotated files by one and start a new current file
+  void rotate();
+
+  // Path of the n-th rotated file, 0 being the current file
+  std::string getFilePath(uint32_t n) const;
+
+  const std::string filePath_;
+  const size_t maxFileBytes_{0};
+  const uint32_t maxFiles_{0};
+
+  // Current file and its size
+  folly::File file_;
+  size_t fileBytes_{0};
+};
+
+} // namespace openr
@@ -7,8 +7,10 @@
 
 #include "openr/monitor/LogSample.h"
 
-#include <folly/json/DynamicConverter.h>
+#include <fmt/format.h>
+#include <folly/json/dynamic.h>
 #include <folly/json/json.h>
+#include <folly/lang/Assume.h>
 
 namespace {
 
@@ -31,9 +33,7 @@ LogSample::LogSample() : LogSample(std::chrono::system_clock::now()) {}
 
 LogSample::LogSample(std::chrono::system_clock::time_point timestamp)
     : timestamp_(timestamp) {
-  json_ = folly::dynamic::object;
-
-  // add the timestamp to the json sample
+  // add the timestamp to the sample
   addInt(
       kTimeCol,
       std::chrono::duration_cast<std::chrono::seconds>(
@@ -41,149 +41,259 @@ LogSample::LogSample(std::chrono::system_clock::time_point timestamp)
           .count());
 }
 
-LogSample::LogSample(
-    folly::dynamic json, std::chrono::system_clock::time_point timestamp)
-    : json_(json), timestamp_(timestamp) {}
-
 LogSample
 LogSample::fromJson(const std::string& json) {
   auto dynamic = folly::parseJson(json);
   // will throw if this sample doesn't have a timestamp
-  auto timestamp = std::chrono::system_clock::time_point(
-      std::chrono::seconds(dynamic[INT_KEY][kTimeCol].getInt()));
-  return LogSample(dynamic, timestamp);
+  LogSample sample(std::chrono::system_clock::time_point(
+      std::chrono::seconds(dynamic[INT_KEY][kTimeCol].getInt())));
+
+  if (auto ints = dynamic.get_ptr(INT_KEY)) {
+    for (const auto& [key, value] : ints->items()) {
+      sample.addInt(key.asString(), value.asInt());
+    }
+  }
+  if (auto doubles = dynamic.get_ptr(DOUBLE_KEY)) {
+    for (const auto& [key, value] : doubles->items()) {
+      sample.addDouble(key.asString(), value.asDouble());
+    }
+  }
+  if (auto strings = dynamic.get_ptr(STRING_KEY)) {
+    for (const auto& [key, value] : strings->items()) {
+      sample.addString(key.asString(), value.asString());
+    }
+  }
+  if (auto vectors = dynamic.get_ptr(STRINGVECTOR_KEY)) {
+    for (const auto& [key, value] : vectors->items()) {
+      std::vector<std::string> values;
+      for (const auto& v : value) {
+        values.emplace_back(v.asString());
+      }
+      sample.addStringVector(key.asString(), values);
+    }
+  }
+  if (auto tagsets = dynamic.get_ptr(STRINGTAGSET_KEY)) {
+    for (const auto& [key, value] : tagsets->items()) {
+      std::set<std::string> tags;
+      for (const auto& v : value) {
+        tags.emplace(v.asString());
+      }
+      sample.addStringTagset(key.asString(), tags);
+    }
+  }
+  return sample;
 }
 
 std::string
 LogSample::toJson() const {
+  folly::dynamic json = folly::dynamic::object;
+  for (const auto& attr : attributes_) {
+    auto& section =
+        json.setDefault(getSectionKey(attr.type), folly::dynamic::object());
+    switch (attr.type) {
+    case ValueType::INT:
+      section[attr.key] = attr.intValue;
+      break;
+    case ValueType::DOUBLE:
+      section[attr.key] = attr.doubleValue;
+      break;
+    case ValueType::STRING:
+      section[attr.key] = attr.stringValue;
+      break;
+    case ValueType::STRING_VECTOR:
+    case ValueType::STRING_TAGSET:
+      section[attr.key] =
+          folly::dynamic(attr.stringValues.begin(), attr.stringValues.end());
+      break;
+    }
+  }
+
   folly::json::serialization_opts opts;
   opts.sort_keys = true;
-  return folly::json::serialize(json_, opts);
+  return folly::json::serialize(json, opts);
 }
 
-void
-LogSample::addInt(folly::StringPiece key, int64_t value) {
-  if (json_.find(INT_KEY) == json_.items().end()) {
-    json_.insert(INT_KEY, folly::dynamic::object());
+thrift::EventLogRecord
+LogSample::toThrift() const {
+  thrift::EventLogRecord record;
+  record.timestampUs() =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          timestamp_.time_since_epoch())
+          .count();
+  for (const auto& attr : attributes_) {
+    switch (attr.type) {
+    case ValueType::INT:
+      record.ints()->emplace(attr.key, attr.intValue);
+      break;
+    case ValueType::DOUBLE:
+      record.doubles()->emplace(attr.key, attr.doubleValue);
+      break;
+    case ValueType::STRING:
+      record.strings()->emplace(attr.key, attr.stringValue);
+      break;
+    case ValueType::STRING_VECTOR:
+      record.stringVectors()->emplace(attr.key, attr.stringValues);
+      break;
+    case ValueType::STRING_TAGSET:
+      record.stringTagsets()->emplace(
+          attr.key,
+          std::set<std::string>(
+              attr.stringValues.begin(), attr.stringValues.end()));
+      break;
+    }
+  }
+  return record;
+}
+
+LogSample
+LogSample::fromThrift(const thrift::EventLogRecord& record) {
+  LogSample sample(std::chrono::system_clock::time_point(
+      std::chrono::microseconds(*record.timestampUs())));
+  for (const auto& [key, value] : *record.ints()) {
+    sample.addInt(key, value);
+  }
+  for (const auto& [key, value] : *record.doubles()) {
+    sample.addDouble(key, value);
+  }
+  for (const auto& [key, value] : *record.strings()) {
+    sample.addString(key, value);
   }
+  for (const auto& [key, values] : *record.stringVectors()) {
+    sample.addStringVector(key, values);
+  }
+  for (const auto& [key, tags] : *record.stringTagsets()) {
+    sample.addStringTagset(key, tags);
+  }
+  return sample;
+}
 
-  json_[INT_KEY][key] = value;
+void
+LogSample::addInt(folly::StringPiece key, int64_t value) {
+  setAttribute(ValueType::INT, key).intValue = value;
 }
 
 void
 LogSample::addDouble(folly::StringPiece key, double value) {
-  if (json_.find(DOUBLE_KEY) == json_.items().end()) {
-    json_.insert(DOUBLE_KEY, folly::dynamic::object());
-  }
-
-  json_[DOUBLE_KEY][key] = value;
+  setAttribute(ValueType::DOUBLE, key).doubleValue = value;
 }
 
 void
 LogSample::addString(folly::StringPiece key, folly::StringPiece value) {
-  if (json_.find(STRING_KEY) == json_.items().end()) {
-    json_.insert(STRING_KEY, folly::dynamic::object());
-  }
-
-  json_[STRING_KEY][key] = value;
+  setAttribute(ValueType::STRING, key).stringValue.assign(
+      value.data(), value.size());
 }
 
 void
 LogSample::addStringVector(
     folly::StringPiece key, const std::vector<std::string>& values) {
-  if (json_.find(STRINGVECTOR_KEY) == json_.items().end()) {
-    json_.insert(STRINGVECTOR_KEY, folly::dynamic::object());
-  }
-
-  json_[STRINGVECTOR_KEY][key] = folly::dynamic(values.begin(), values.end());
+  setAttribute(ValueType::STRING_VECTOR, key).stringValues = values;
 }
 
 void
 LogSample::addStringTagset(
     folly::StringPiece key, const std::set<std::string>& tags) {
-  if (json_.find(STRINGTAGSET_KEY) == json_.items().end()) {
-    json_.insert(STRINGTAGSET_KEY, folly::dynamic::object());
-  }
-
-  json_[STRINGTAGSET_KEY][key] = folly::dynamic(tags.begin(), tags.end());
+  setAttribute(ValueType::STRING_TAGSET, key)
+      .stringValues.assign(tags.begin(), tags.end());
 }
 
 int64_t
 LogSample::getInt(folly::StringPiece key) const {
-  return folly::convertTo<int64_t>(getInnerValue(INT_KEY, key));
+  return getAttribute(ValueType::INT, key).intValue;
 }
 
 double
 LogSample::getDouble(folly::StringPiece key) const {
-  return folly::convertTo<double>(getInnerValue(DOUBLE_KEY, key));
+  return getAttribute(ValueType::DOUBLE, key).doubleValue;
 }
 
 std::string
 LogSample::getString(folly::StringPiece key) const {
-  return folly::convertTo<std::string>(getInnerValue(STRING_KEY, key));
+  return getAttribute(ValueType::STRING, key).stringValue;
 }
 
 std::vector<std::string>
 LogSample::getStringVector(folly::StringPiece key) const {
-  return folly::convertTo<std::vector<std::string>>(
-      getInnerValue(STRINGVECTOR_KEY, key));
+  return getAttribute(ValueType::STRING_VECTOR, key).stringValues;
 }
 
 std::set<std::string>
 LogSample::getStringTagset(folly::StringPiece key) const {
-  return folly::convertTo<std::set<std::string>>(
-      getInnerValue(STRINGTAGSET_KEY, key));
+  const auto& values = getAttribute(ValueType::STRING_TAGSET, key).stringValues;
+  return std::set<std::string>(values.begin(), values.end());
 }
 
 bool
 LogSample::isIntSet(folly::StringPiece key) const {
-  return isInnerValueSet(INT_KEY, key);
+  return findAttribute(ValueType::INT, key) != nullptr;
 }
 
 bool
 LogSample::isDoubleSet(folly::StringPiece key) const {
-  return isInnerValueSet(DOUBLE_KEY, key);
+  return findAttribute(ValueType::DOUBLE, key) != nullptr;
 }
 
 bool
 LogSample::isStringSet(folly::StringPiece key) const {
-  return isInnerValueSet(STRING_KEY, key);
+  return findAttribute(ValueType::STRING, key) != nullptr;
 }
 
 bool
 LogSample::isStringVectorSet(folly::StringPiece key) const {
-  return isInnerValueSet(STRINGVECTOR_KEY, key);
+  return findAttribute(ValueType::STRING_VECTOR, key) != nullptr;
 }
 
 bool
 LogSample::isStringTagsetSet(folly::StringPiece key) const {
-  return isInnerValueSet(STRINGTAGSET_KEY, key);
+  return findAttribute(ValueType::STRING_TAGSET, key) != nullptr;
 }
 
-bool
-LogSample::isInnerValueSet(
-    folly::StringPiece keyType, folly::StringPiece key) const {
-  if (auto obj = json_.get_ptr(keyType)) {
-    if (auto data = obj->get_ptr(key)) {
-      (void)data;
-      return true;
-    }
+LogSample::Attribute&
+LogSample::setAttribute(ValueType type, folly::StringPiece key) {
+  if (auto attr = findAttribute(type, key)) {
+    return const_cast<Attribute&>(*attr);
+  }
+  auto& attr = attributes_.emplace_back();
+  attr.type = type;
+  attr.key.assign(key.data(), key.size());
+  return attr;
+}
+
+const LogSample::Attribute&
+LogSample::getAttribute(ValueType type, folly::StringPiece key) const {
+  if (auto attr = findAttribute(type, key)) {
+    return *attr;
   }
 
-  return false;
+  throw std::invalid_argument(fmt::format(
+      "invalid key: {} with keyType: {} ", key, getSectionKey(type)));
 }
 
-const folly::dynamic&
-LogSample::getInnerValue(
-    folly::StringPiece keyType, folly::StringPiece key) const {
-  if (auto obj = json_.get_ptr(keyType)) {
-    if (auto data = obj->get_ptr(key)) {
-      return *data;
+const LogSample::Attribute*
+LogSample::findAttribute(ValueType type, folly::StringPiece key) const {
+  // NOTE: Linear scan is faster than hashing for the handful of attributes
+  for (const auto& attr : attributes_) {
+    if (attr.type == type and attr.key == key) {
+      return &attr;
     }
   }
+  return nullptr;
+}
 
-  throw std::invalid_argument(
-      fmt::format("invalid key: {} with keyType: {} ", key, keyType));
+const std::string&
+LogSample::getSectionKey(ValueType type) {
+  switch (type) {
+  case ValueType::INT:
+    return INT_KEY;
+  case ValueType::DOUBLE:
+    return DOUBLE_KEY;
+  case ValueType::STRING:
+    return STRING_KEY;
+  case ValueType::STRING_VECTOR:
+    return STRINGVECTOR_KEY;
+  case ValueType::STRING_TAGSET:
+    return STRINGTAGSET_KEY;
+  }
+  folly::assume_unreachable();
 }
 
 } // namespace openr
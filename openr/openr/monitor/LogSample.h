@@ -13,7 +13,9 @@
 #include <vector>
 
 #include <folly/Range.h>
-#include <folly/json/dynamic.h>
+#include <folly/small_vector.h>
+
+#include <openr/if/gen-cpp2/Types_types.h>
 
 namespace openr {
 
@@ -25,6 +27,11 @@ namespace openr {
  * This class is strictly meant to make things easier for services to create
  * samples and serialize them to json objects.
  *
+ * Attributes are stored as typed values in inline storage, and hence creating
+ * and moving a sample with a handful of short attributes doesn't allocate.
+ * JSON is rendered only on demand with `toJson()`, and binary representation
+ * for persistence is `thrift::EventLogRecord`.
+ *
  * Example usecase:
  *    LogSample sample(std::chrono::system_clock::now());
  *    sample.addString("event", "NEIGHBOR_UP");
@@ -52,11 +59,14 @@ class LogSample {
    */
   explicit LogSample(std::chrono::system_clock::time_point timestamp);
 
-  LogSample(
-      folly::dynamic json, std::chrono::system_clock::time_point timestamp);
-
   static LogSample fromJson(const std::string& json);
 
+  /**
+   * Convert to/from binary representation. Conversion is lossless.
+   */
+  thrift::EventLogRecord toThrift() const;
+  static LogSample fromThrift(const thrift::EventLogRecord& record);
+
   /**
    * Get json representation of the Sample. Can easily be sent to monitoring
    * service over write.
@@ -102,13 +112,39 @@ class LogSample {
   bool isStringTagsetSet(folly::StringPiece key) const;
 
  private:
-  bool isInnerValueSet(
-      folly::StringPiece keyType, folly::StringPiece key) const;
-  const folly::dynamic& getInnerValue(
-      folly::StringPiece keyType, folly::StringPiece key) const;
-
-  // Internal json representation of this sample
-  folly::dynamic json_ = folly::dynamic::object;
+  // Type of the value. Determines the section of attribute in json.
+  enum class ValueType : uint8_t {
+    INT,
+    DOUBLE,
+    STRING,
+    STRING_VECTOR,
+    STRING_TAGSET,
+  };
+
+  struct Attribute {
+    ValueType type;
+    std::string key;
+    int64_t intValue{0};
+    double doubleValue{0};
+    std::string stringValue;
+    // Values of vector, or sorted values of tagset
+    std::vector<std::string> stringValues;
+  };
+
+  // Add attribute or overwrite existing attribute of the same type and key
+  Attribute& setAttribute(ValueType type, folly::StringPiece key);
+
+  // Throws std::invalid_argument if attribute doesn't exist
+  const Attribute& getAttribute(ValueType type, folly::StringPiece key) const;
+
+  const Attribute* findAttribute(
+      ValueType type, folly::StringPiece key) const;
+
+  // Name of the json section holding attributes of given type
+  static const std::string& getSectionKey(ValueType type);
+
+  // Typed attributes in insertion order. Common events fit inline.
+  folly::small_vector<Attribute, 8> attributes_;
 
   // Timepoint associated with this sample
   std::chrono::system_clock::time_point timestamp_;
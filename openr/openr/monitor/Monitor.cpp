@@ -7,7 +7,12 @@
 
 #include "openr/monitor/Monitor.h"
 
+#include <fmt/format.h>
 #include <folly/logging/xlog.h>
+#include <folly/memory/MallctlHelper.h>
+#include <folly/memory/Malloc.h>
+
+#include <openr/common/Constants.h>
 
 namespace openr {
 
@@ -20,8 +25,33 @@ Monitor::processEventLog(LogSample const& eventLog) {
 
 void
 Monitor::dumpHeapProfile() {
-  XLOG(INFO)
-      << "Please add your own implementation to dump the heap memory profile.";
+  // NOTE: Could add your own implementation for other allocators
+  if (not folly::usingJEMalloc()) {
+    XLOG(INFO) << "Heap profile is only supported with jemalloc";
+    return;
+  }
+
+  try {
+    // Profiling is compiled in but inactive by default, see `malloc_conf`.
+    // Allocations are sampled from now on, and dumped on next invocation.
+    if (not isHeapProfilingActive_) {
+      folly::mallctlWrite("prof.active", true);
+      isHeapProfilingActive_ = true;
+      XLOG(INFO) << "Activated heap profiling";
+      return;
+    }
+
+    auto path = fmt::format(
+        "{}.{}.heap",
+        Constants::kHeapProfilePrefix,
+        numHeapProfiles_++ % Constants::kMaxHeapProfiles);
+    folly::mallctlWrite("prof.dump", path.c_str());
+    XLOG(INFO) << "Dumped heap profile to " << path;
+    addHeapProfileDump(std::move(path));
+  } catch (const std::exception& e) {
+    XLOG(ERR) << "Failed to dump heap profile. Error: "
+              << folly::exceptionStr(e);
+  }
 }
 
 } // namespace openr
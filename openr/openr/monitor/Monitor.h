@@ -26,11 +26,14 @@ class Monitor : public MonitorBase {
   //  print the log sample to syslog
   void processEventLog(LogSample const& eventLog) override;
 
-  // Get the heap profile
+  // Dump the heap profile with jemalloc, into rotated files
   void dumpHeapProfile() override;
 
   // Status of Heap Profiling tool
   bool isHeapProfilingActive_ = false;
+
+  // Number of heap profiles dumped
+  uint64_t numHeapProfiles_{0};
 };
 
 } // namespace openr
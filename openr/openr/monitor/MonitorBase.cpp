@@ -7,20 +7,62 @@
 
 #include "openr/monitor/MonitorBase.h"
 #include <folly/logging/xlog.h>
+#include <folly/memory/MallctlHelper.h>
+#include <folly/memory/Malloc.h>
 #include <openr/common/Constants.h>
+#include <openr/common/Flags.h>
 
 namespace openr {
 
+namespace {
+
+// Heap usage reported by jemalloc, if in use
+std::optional<thrift::HeapProfile>
+getHeapUsage() {
+  if (not folly::usingJEMalloc()) {
+    return std::nullopt;
+  }
+  thrift::HeapProfile heap;
+  try {
+    // Refresh cached stats
+    folly::mallctlWrite<uint64_t>("epoch", 1);
+    size_t bytes{0};
+    folly::mallctlRead<size_t>("stats.allocated", &bytes);
+    heap.allocatedBytes() = bytes;
+    folly::mallctlRead<size_t>("stats.active", &bytes);
+    heap.activeBytes() = bytes;
+    folly::mallctlRead<size_t>("stats.resident", &bytes);
+    heap.residentBytes() = bytes;
+  } catch (const std::exception& e) {
+    XLOG(ERR) << "Failed to read heap stats. Error: " << folly::exceptionStr(e);
+  }
+  return heap;
+}
+
+} // namespace
+
 MonitorBase::MonitorBase(
     std::shared_ptr<const Config> config,
     const std::string& category,
     messaging::RQueue<LogSample> logSampleQueue)
     : category_{category},
+      nodeName_{config->getNodeName()},
       maxLogEvents_{
           folly::to<uint32_t>(*config->getMonitorConfig().max_event_log())},
       startTime_{std::chrono::steady_clock::now()} {
   // Initialize stats counter
   fb303::fbData->addStatExportType("monitor.log.publish.failure", fb303::COUNT);
+  fb303::fbData->addStatExportType(
+      "monitor.log.file_write.failure", fb303::COUNT);
+
+  recentLogs_.wlock()->logs.reserve(maxLogEvents_);
+
+  if (not FLAGS_event_log_file.empty()) {
+    eventLogFileSink_ = std::make_unique<EventLogFileSink>(
+        FLAGS_event_log_file,
+        folly::to<size_t>(FLAGS_event_log_file_max_bytes),
+        folly::to<uint32_t>(FLAGS_event_log_file_max_files));
+  }
 
   // Periodically set process cpu/uptime/memory counter
   setProcessCounterTimer_ =
@@ -44,6 +86,18 @@ MonitorBase::MonitorBase(
     dumpHeapProfileTimer_->scheduleTimeout(0);
   }
 
+  // Periodically drain samples of the CPU profiler
+  if (CpuProfiler::isEnabled()) {
+    collectCpuProfileTimer_ =
+        folly::AsyncTimeout::make(*getEvb(), [this]() noexcept {
+          cpuProfiler_.collect();
+          collectCpuProfileTimer_->scheduleTimeout(
+              Constants::kCpuProfileCollectInterval);
+        });
+    collectCpuProfileTimer_->scheduleTimeout(
+        Constants::kCpuProfileCollectInterval);
+  }
+
   // Fiber task to read the LogSample from queue and publish
   addFiberTask(
       [q = std::move(logSampleQueue), config, this]() mutable noexcept {
@@ -61,22 +115,32 @@ MonitorBase::MonitorBase(
 
           // validate, process and publish the event logs
           try {
-            auto inputLog = maybeLog.value();
+            auto inputLog = std::move(maybeLog).value();
             // add common attributes
             inputLog.addString("node_name", config->getNodeName());
 
             // throws std::invalid_argument if not exist
             inputLog.getString("event");
 
-            // add to recent log list
-            if (recentLog_.size() >= maxLogEvents_) {
-              recentLog_.pop_front();
+            // add to recent log ring. Stored log is modified only by this
+            // fiber, and hence can be referenced without lock below.
+            const auto& log = addRecentLog(std::move(inputLog));
+
+            // persist the log if enabled
+            if (eventLogFileSink_) {
+              try {
+                eventLogFileSink_->write(log);
+              } catch (const std::exception& e) {
+                fb303::fbData->addStatValue(
+                    "monitor.log.file_write.failure", 1, fb303::COUNT);
+                XLOG(ERR) << "Failed to write the log to file. Error: "
+                          << folly::exceptionStr(e);
+              }
             }
-            recentLog_.emplace_back(inputLog.toJson());
 
             // publish the log if enable log submission
             if (config->isLogSubmissionEnabled()) {
-              processEventLog(inputLog);
+              processEventLog(log);
             }
           } catch (const std::exception& e) {
             fb303::fbData->addStatValue(
@@ -88,9 +152,66 @@ MonitorBase::MonitorBase(
       });
 }
 
+const LogSample&
+MonitorBase::addRecentLog(LogSample&& log) {
+  auto recentLogs = recentLogs_.wlock();
+  if (recentLogs->logs.size() < maxLogEvents_) {
+    return recentLogs->logs.emplace_back(std::move(log));
+  }
+  if (maxLogEvents_ == 0) {
+    // Keep the log outside of the ring for the caller to process
+    return lastLog_ = std::move(log);
+  }
+  auto& slot = recentLogs->logs.at(recentLogs->head);
+  slot = std::move(log);
+  recentLogs->head = (recentLogs->head + 1) % maxLogEvents_;
+  return slot;
+}
+
 std::list<std::string>
 MonitorBase::getRecentEventLogs() {
-  return recentLog_;
+  std::list<std::string> recentLogs;
+  recentLogs_.withRLock([&recentLogs](const RecentLogs& ring) {
+    const auto numLogs = ring.logs.size();
+    for (size_t i = 0; i < numLogs; ++i) {
+      recentLogs.emplace_back(
+          ring.logs.at((ring.head + i) % numLogs).toJson());
+    }
+  });
+  return recentLogs;
+}
+
+folly::SemiFuture<std::unique_ptr<thrift::ProcessProfile>>
+MonitorBase::getProcessProfile() {
+  folly::Promise<std::unique_ptr<thrift::ProcessProfile>> p;
+  auto sf = p.getSemiFuture();
+  runInEventBaseThread([p = std::move(p), this]() mutable {
+    auto profile = std::make_unique<thrift::ProcessProfile>();
+    profile->thisNodeName() = nodeName_;
+    if (CpuProfiler::isEnabled()) {
+      profile->cpuProfilerHz() = FLAGS_cpu_profiler_hz;
+      profile->modules() = cpuProfiler_.getProfiles();
+    }
+    if (auto heap = getHeapUsage()) {
+      heap->dumpFiles() = std::vector<std::string>(
+          heapProfileDumps_.begin(), heapProfileDumps_.end());
+      profile->heap() = std::move(*heap);
+    }
+    p.setValue(std::move(profile));
+  });
+  return sf;
+}
+
+void
+MonitorBase::addHeapProfileDump(std::string path) {
+  // Dump files are rotated, drop the overwritten one
+  heapProfileDumps_.erase(
+      std::remove(heapProfileDumps_.begin(), heapProfileDumps_.end(), path),
+      heapProfileDumps_.end());
+  heapProfileDumps_.emplace_back(std::move(path));
+  if (heapProfileDumps_.size() > Constants::kMaxHeapProfiles) {
+    heapProfileDumps_.pop_front();
+  }
 }
 
 void
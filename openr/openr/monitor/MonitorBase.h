@@ -7,12 +7,18 @@
 
 #pragma once
 
+#include <deque>
+
 #include <folly/Function.h>
+#include <folly/Synchronized.h>
+#include <folly/futures/Future.h>
 
 #include <fb303/ServiceData.h>
 #include <openr/common/OpenrEventBase.h>
 #include <openr/config/Config.h>
 #include <openr/messaging/ReplicateQueue.h>
+#include <openr/monitor/CpuProfiler.h>
+#include <openr/monitor/EventLogFileSink.h>
 #include <openr/monitor/LogSample.h>
 #include <openr/monitor/SystemMetrics.h>
 
@@ -25,9 +31,12 @@ namespace openr {
  * implements common functions:
  * 1. Start a fiber to read the log queue and export logs to database based on
  *    subclass's processEventLog() implementation.
- * 2. Store and return the most recent logs;
+ * 2. Store the most recent logs, and return them as json on demand;
+ *    Optionally append all logs to a rotated binary file (--event_log_file);
  * 3. Export process counters: process.memory.rss, process.uptime,
  *    and process.cpu.pct
+ * 4. Aggregate samples of the CPU profiler (--cpu_profiler_hz), and return
+ *    them along with heap usage and recent heap profile dumps on demand.
  */
 class MonitorBase : public OpenrEventBase {
  public:
@@ -36,9 +45,13 @@ class MonitorBase : public OpenrEventBase {
       const std::string& category,
       messaging::RQueue<LogSample> logSampleQueue);
 
-  // Get recent event logs
+  // Get recent event logs, oldest first, as json. Thread-safe.
   std::list<std::string> getRecentEventLogs();
 
+  // Get CPU profile of every module and heap usage
+  folly::SemiFuture<std::unique_ptr<thrift::ProcessProfile>>
+  getProcessProfile();
+
   // Destructor
   virtual ~MonitorBase() = default;
 
@@ -46,6 +59,10 @@ class MonitorBase : public OpenrEventBase {
   // Category for log message
   const std::string category_;
 
+  // Record heap profile dumped by `dumpHeapProfile()`. Only most recent
+  // `Constants::kMaxHeapProfiles` are reported.
+  void addHeapProfileDump(std::string path);
+
  private:
   // Pure virtual function for processing and publishing a log
   virtual void processEventLog(LogSample const& eventLog) = 0;
@@ -56,14 +73,32 @@ class MonitorBase : public OpenrEventBase {
   // Set process counters
   void updateProcessCounters();
 
+  // Add log to the ring of recent logs, evicting the oldest one if full.
+  // Returns the stored log, valid until the next call.
+  const LogSample& addRecentLog(LogSample&& log);
+
+  const std::string nodeName_;
+
   // Common information added to each log: "domain", "node-name", etc
   LogSample commonLogToMerge_;
 
   // Number of last log events to queue
   const uint32_t maxLogEvents_{0};
 
-  // List of recent log
-  std::list<std::string> recentLog_{};
+  // Ring of recent logs, preallocated to `maxLogEvents_` and overwritten in
+  // place once full. Written only by the log processing fiber.
+  struct RecentLogs {
+    std::vector<LogSample> logs;
+    // Index of the oldest log once ring is full
+    size_t head{0};
+  };
+  folly::Synchronized<RecentLogs> recentLogs_;
+
+  // Holds the last log if ring is disabled, i.e. `maxLogEvents_` is 0
+  LogSample lastLog_;
+
+  // Optional binary file sink of all logs
+  std::unique_ptr<EventLogFileSink> eventLogFileSink_;
 
   // Timer to periodically set process cpu/uptime/memory counter
   std::unique_ptr<folly::AsyncTimeout> setProcessCounterTimer_;
@@ -71,6 +106,13 @@ class MonitorBase : public OpenrEventBase {
   // Timer to periodically dump the heap profile
   std::unique_ptr<folly::AsyncTimeout> dumpHeapProfileTimer_;
 
+  // Most recent heap profile dumps, oldest first
+  std::deque<std::string> heapProfileDumps_;
+
+  // Aggregation of CPU profiler samples, and timer to periodically collect them
+  CpuProfiler cpuProfiler_;
+  std::unique_ptr<folly::AsyncTimeout> collectCpuProfileTimer_;
+
   // Start timestamp for calculate process.uptime.seconds
   const std::chrono::steady_clock::time_point startTime_;
 
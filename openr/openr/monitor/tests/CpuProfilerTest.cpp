@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <openr/monitor/CpuProfiler.h>
+
+#include <time.h>
+#include <thread>
+
+#include <folly/Benchmark.h>
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <openr/common/Flags.h>
+
+using namespace openr;
+
+namespace {
+
+// CPU time consumed by the calling thread
+std::chrono::nanoseconds
+getThreadCpuTime() {
+  struct timespec ts {};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+// Burn CPU of the calling thread for the given CPU time
+void
+spin(std::chrono::milliseconds cpuTime) {
+  const auto start = getThreadCpuTime();
+  uint64_t value{0};
+  while (getThreadCpuTime() - start < cpuTime) {
+    folly::doNotOptimizeAway(++value);
+  }
+}
+
+} // namespace
+
+/**
+ * Verify that samples of a registered thread are attributed to its module, and
+ * that unregistered threads are not sampled.
+ */
+TEST(CpuProfilerTest, Sample) {
+  FLAGS_cpu_profiler_hz = 1000;
+  CpuProfiler profiler;
+
+  std::thread registered([]() {
+    CpuProfiler::registerThread("spf");
+    spin(std::chrono::milliseconds(100));
+  });
+  std::thread unregistered([]() { spin(std::chrono::milliseconds(100)); });
+  registered.join();
+  unregistered.join();
+
+  const auto profiles = profiler.getProfiles();
+  ASSERT_EQ(1, profiles.size());
+  const auto& profile = profiles.at(0);
+  EXPECT_EQ("spf", *profile.module());
+  // At least half of the expected 100 samples
+  EXPECT_LE(50, *profile.numSamples());
+
+  int64_t numSamples{0};
+  for (const auto& [stack, count] : *profile.foldedStacks()) {
+    EXPECT_FALSE(stack.empty());
+    numSamples += count;
+  }
+  EXPECT_EQ(*profile.numSamples(), numSamples + *profile.numDroppedSamples());
+
+  // Ring of the exited thread is drained and dropped
+  EXPECT_EQ(*profile.numSamples(), *profiler.getProfiles().at(0).numSamples());
+}
+
+/**
+ * Verify that threads are not sampled if the profiler is disabled.
+ */
+TEST(CpuProfilerTest, Disabled) {
+  FLAGS_cpu_profiler_hz = 0;
+  EXPECT_FALSE(CpuProfiler::isEnabled());
+  CpuProfiler profiler;
+
+  std::thread registered([]() {
+    CpuProfiler::registerThread("spf");
+    spin(std::chrono::milliseconds(50));
+  });
+  registered.join();
+
+  EXPECT_TRUE(profiler.getProfiles().empty());
+}
+
+int
+main(int argc, char* argv[]) {
+  ::testing::InitGoogleTest(&argc, argv);
+  google::InstallFailureSignalHandler();
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <folly/json/dynamic.h>
+#include <folly/json/json.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include <openr/monitor/LogSample.h>
+
+namespace {
+// Number of heap allocations made by the process
+std::atomic<uint64_t> numAllocs{0};
+} // namespace
+
+// Count allocations to report allocations per event
+void*
+operator new(size_t size) {
+  numAllocs.fetch_add(1, std::memory_order_relaxed);
+  if (auto ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void
+operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void
+operator delete(void* ptr, size_t /* size */) noexcept {
+  std::free(ptr);
+}
+
+namespace openr {
+
+namespace {
+
+/**
+ * Create typical event log, as logged by LinkMonitor on neighbor event, and
+ * hand it over to monitor.
+ */
+void
+logNeighborEvent(LogSample& slot) {
+  LogSample sample;
+  sample.addString("event", "NEIGHBOR_UP");
+  sample.addString("neighbor", "node111");
+  sample.addString("interface", "po1201");
+  sample.addString("remote_interface", "po1202");
+  sample.addString("area", "area0");
+  sample.addInt("rtt_us", 3000);
+  sample.addString("node_name", "node222");
+  slot = std::move(sample);
+}
+
+// Same event built with the former folly::dynamic representation
+std::string
+logNeighborEventDynamic() {
+  folly::dynamic json = folly::dynamic::object;
+  json["int"] = folly::dynamic::object("time", 1234)("rtt_us", 3000);
+  json["normal"] = folly::dynamic::object("event", "NEIGHBOR_UP")(
+      "neighbor", "node111")("interface", "po1201")(
+      "remote_interface", "po1202")("area", "area0")("node_name", "node222");
+  folly::json::serialization_opts opts;
+  opts.sort_keys = true;
+  return folly::json::serialize(json, opts);
+}
+
+// Report allocations per event since `startAllocs`
+void
+recordAllocs(
+    folly::UserCounters& counters, uint64_t startAllocs, uint32_t iters) {
+  counters["allocs_per_event"] =
+      (numAllocs.load(std::memory_order_relaxed) - startAllocs) / iters;
+}
+
+} // namespace
+
+/**
+ * Producer cost of an event: create and hand over the typed sample.
+ */
+BENCHMARK_COUNTERS(BM_LogSampleCreate, counters, iters) {
+  LogSample slot;
+  const auto startAllocs = numAllocs.load(std::memory_order_relaxed);
+  for (uint32_t i = 0; i < iters; ++i) {
+    logNeighborEvent(slot);
+  }
+  recordAllocs(counters, startAllocs, iters);
+  folly::doNotOptimizeAway(slot);
+}
+
+/**
+ * Producer cost of an event with the former pipeline: build folly::dynamic and
+ * render JSON for the recent log.
+ */
+BENCHMARK_COUNTERS_RELATIVE(BM_DynamicToJson, counters, iters) {
+  const auto startAllocs = numAllocs.load(std::memory_order_relaxed);
+  for (uint32_t i = 0; i < iters; ++i) {
+    auto json = logNeighborEventDynamic();
+    folly::doNotOptimizeAway(json);
+  }
+  recordAllocs(counters, startAllocs, iters);
+}
+
+BENCHMARK_DRAW_LINE();
+
+/**
+ * Encoder cost of an event for the binary event log file.
+ */
+BENCHMARK_COUNTERS(BM_LogSampleEncode, counters, iters) {
+  folly::BenchmarkSuspender suspender;
+  LogSample sample;
+  logNeighborEvent(sample);
+  suspender.dismiss();
+
+  const auto startAllocs = numAllocs.load(std::memory_order_relaxed);
+  for (uint32_t i = 0; i < iters; ++i) {
+    auto record = apache::thrift::CompactSerializer::serialize<std::string>(
+        sample.toThrift());
+    folly::doNotOptimizeAway(record);
+  }
+  recordAllocs(counters, startAllocs, iters);
+}
+
+/**
+ * Cost of rendering JSON of an event, now paid only by `getEventLogs`.
+ */
+BENCHMARK_COUNTERS(BM_LogSampleToJson, counters, iters) {
+  folly::BenchmarkSuspender suspender;
+  LogSample sample;
+  logNeighborEvent(sample);
+  suspender.dismiss();
+
+  const auto startAllocs = numAllocs.load(std::memory_order_relaxed);
+  for (uint32_t i = 0; i < iters; ++i) {
+    auto json = sample.toJson();
+    folly::doNotOptimizeAway(json);
+  }
+  recordAllocs(counters, startAllocs, iters);
+}
+
+} // namespace openr
+
+int
+main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -153,6 +153,34 @@ TEST(LogSampleTest, fromJsonTest) {
   EXPECT_THROW(LogSample::fromJson(jsonSampleNoTimeKey), std::exception);
 }
 
+TEST(LogSampleTest, ThriftTest) {
+  const auto timestamp = std::chrono::system_clock::time_point(
+      std::chrono::seconds(111) + std::chrono::microseconds(222));
+  LogSample sample(timestamp);
+  sample.addInt("int-key", 123);
+  sample.addDouble("double-key", 123.456);
+  sample.addString("string-key", "hello world");
+  sample.addStringVector("vector-key", {"val2", "val1"});
+  sample.addStringTagset("tagset-key", {"tag1", "tag2"});
+  // Same key with different types is allowed
+  sample.addString("int-key", "not an int");
+  // Value is overwritten
+  sample.addInt("int-key", 456);
+
+  const auto record = sample.toThrift();
+  EXPECT_EQ(111000222, *record.timestampUs());
+  EXPECT_EQ(456, record.ints()->at("int-key"));
+  EXPECT_EQ("not an int", record.strings()->at("int-key"));
+
+  // Conversion is lossless
+  const auto decoded = LogSample::fromThrift(record);
+  EXPECT_EQ(timestamp, decoded.getTimestamp());
+  EXPECT_EQ(sample.toJson(), decoded.toJson());
+  EXPECT_EQ(
+      std::vector<std::string>({"val2", "val1"}),
+      decoded.getStringVector("vector-key"));
+}
+
 } // namespace openr
 
 int
@@ -7,17 +7,24 @@
 
 #include <openr/monitor/MonitorBase.h>
 
+#include <folly/testing/TestUtil.h>
 #include <glog/logging.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <openr/common/Constants.h>
 #include <openr/config/Config.h>
+#include <openr/monitor/EventLogFileSink.h>
 #include <openr/monitor/SystemMetrics.h>
 
 using namespace std;
 using namespace openr;
 using namespace testing;
 
+namespace {
+// Number of recent logs kept by monitor
+const int32_t kMaxEventLog{3};
+} // namespace
+
 // MockClass for mocking the processEventLog() function
 class MonitorMock : public MonitorBase {
  public:
@@ -37,6 +44,7 @@ class MonitorTestFixture : public ::testing::Test {
     // generate a config for testing
     openr::thrift::OpenrConfig config;
     *config.node_name() = "node1";
+    config.monitor_config()->max_event_log() = kMaxEventLog;
 
     monitor = make_unique<MonitorMock>(
         std::make_unique<openr::Config>(config),
@@ -110,6 +118,79 @@ TEST_F(MonitorTestFixture, LogBasicOperation) {
   }
 }
 
+TEST_F(MonitorTestFixture, RecentLogRing) {
+  const int numLogs = kMaxEventLog + 2;
+  for (int i = 0; i < numLogs; ++i) {
+    LogSample log;
+    log.addString("event", "event_unit_test");
+    log.addInt("num", i);
+    eventLogUpdatesQueue.push(std::move(log));
+  }
+
+  // Wait for the fiber to process the last log
+  while (true) {
+    auto recentLogs = monitor->getRecentEventLogs();
+    if (not recentLogs.empty() and
+        LogSample::fromJson(recentLogs.back()).getInt("num") == numLogs - 1) {
+      break;
+    }
+    std::this_thread::yield();
+  }
+
+  // Only the most recent logs are kept, oldest first
+  auto recentLogs = monitor->getRecentEventLogs();
+  ASSERT_EQ(kMaxEventLog, recentLogs.size());
+  int num = numLogs - kMaxEventLog;
+  for (const auto& log : recentLogs) {
+    EXPECT_EQ(num++, LogSample::fromJson(log).getInt("num"));
+  }
+}
+
+TEST(EventLogFileSinkTest, WriteAndRotate) {
+  folly::test::TemporaryDirectory tmpDir("event_log_test");
+  const auto filePath = (tmpDir.path() / "event_log.bin").string();
+
+  auto createLog = [](int num) {
+    LogSample log(std::chrono::system_clock::time_point(
+        std::chrono::microseconds(1000 + num)));
+    log.addString("event", "event_unit_test");
+    log.addInt("num", num);
+    log.addStringVector("addresses", {"1.2.3.4", "fe80::1"});
+    return log;
+  };
+
+  {
+    EventLogFileSink sink(filePath, 1024 * 1024, 2);
+    sink.write(createLog(0));
+    sink.write(createLog(1));
+  }
+
+  // Records are decoded in order, losslessly
+  auto logs = EventLogFileSink::readFile(filePath);
+  ASSERT_EQ(2, logs.size());
+  for (int num = 0; num < 2; ++num) {
+    EXPECT_EQ(createLog(num).toJson(), logs.at(num).toJson());
+    EXPECT_EQ(createLog(num).getTimestamp(), logs.at(num).getTimestamp());
+  }
+
+  {
+    // Re-opened file is appended to. Every subsequent record exceeds the size
+    // limit and rotates the file, keeping two files in total.
+    EventLogFileSink sink(filePath, 1, 2);
+    sink.write(createLog(2));
+    sink.write(createLog(3));
+  }
+
+  logs = EventLogFileSink::readFile(filePath);
+  ASSERT_EQ(1, logs.size());
+  EXPECT_EQ(3, logs.at(0).getInt("num"));
+  logs = EventLogFileSink::readFile(filePath + ".1");
+  ASSERT_EQ(1, logs.size());
+  EXPECT_EQ(2, logs.at(0).getInt("num"));
+  EXPECT_THROW(
+      EventLogFileSink::readFile(filePath + ".2"), std::runtime_error);
+}
+
 TEST_F(MonitorTestFixture, ProcessCounterTest) {
   // Wait for calling getCPUpercentage() twice for calculating the cpu% counter
   while (true) {
@@ -52,10 +52,6 @@ NetlinkAddrMessage::init(int type) {
   if (type == RTM_NEWADDR) {
     msghdr_->nlmsg_flags |= NLM_F_CREATE;
   }
-
-  // intialize the route address message header
-  auto nlmsgAlen = NLMSG_ALIGN(sizeof(struct nlmsghdr));
-  ifaddrmsg_ = reinterpret_cast<struct ifaddrmsg*>((char*)msghdr_ + nlmsgAlen);
 }
 
 int
@@ -77,14 +73,14 @@ NetlinkAddrMessage::addOrDeleteIfAddress(
   // initialize netlink address fields
   auto ip = std::get<0>(ifAddr.getPrefix().value());
   uint8_t prefixLen = std::get<1>(ifAddr.getPrefix().value());
-  ifaddrmsg_->ifa_family = ifAddr.getFamily();
-  ifaddrmsg_->ifa_prefixlen = prefixLen;
-  ifaddrmsg_->ifa_flags =
+  getIfAddrMsg()->ifa_family = ifAddr.getFamily();
+  getIfAddrMsg()->ifa_prefixlen = prefixLen;
+  getIfAddrMsg()->ifa_flags =
       (ifAddr.getFlags().has_value() ? ifAddr.getFlags().value() : 0);
   if (ifAddr.getScope().has_value()) {
-    ifaddrmsg_->ifa_scope = ifAddr.getScope().value();
+    getIfAddrMsg()->ifa_scope = ifAddr.getScope().value();
   }
-  ifaddrmsg_->ifa_index = ifAddr.getIfIndex();
+  getIfAddrMsg()->ifa_index = ifAddr.getIfIndex();
 
   const char* const ipptr = reinterpret_cast<const char*>(ip.bytes());
   int status = addAttributes(IFA_ADDRESS, ipptr, ip.byteCount());
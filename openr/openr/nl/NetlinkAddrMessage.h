@@ -72,7 +72,10 @@ class NetlinkAddrMessage final : public NetlinkMessageBase {
   //
 
   // pointer to interface message header
-  struct ifaddrmsg* ifaddrmsg_{nullptr};
+  struct ifaddrmsg*
+  getIfAddrMsg() const {
+    return reinterpret_cast<struct ifaddrmsg*>(NLMSG_DATA(msghdr_));
+  }
 
   // promise to be fulfilled when receiving kernel reply
   folly::Promise<folly::Expected<std::vector<IfAddress>, int>> addrPromise_;
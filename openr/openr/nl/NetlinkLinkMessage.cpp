@@ -60,12 +60,8 @@ NetlinkLinkMessage::init(int type, uint32_t linkFlags) {
     msghdr_->nlmsg_flags |= NLM_F_REPLACE;
   }
 
-  // intialize the route link message header
-  auto nlmsgAlen = NLMSG_ALIGN(sizeof(struct nlmsghdr));
-  ifinfomsg_ = reinterpret_cast<struct ifinfomsg*>((char*)msghdr_ + nlmsgAlen);
-
-  ifinfomsg_->ifi_flags = linkFlags;
-  ifinfomsg_->ifi_change = 0xffffffff;
+  getIfInfoMsg()->ifi_flags = linkFlags;
+  getIfInfoMsg()->ifi_change = 0xffffffff;
 }
 
 Link
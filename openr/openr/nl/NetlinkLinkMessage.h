@@ -89,7 +89,10 @@ class NetlinkLinkMessage final : public NetlinkMessageBase {
   //
 
   // pointer to link message header
-  struct ifinfomsg* ifinfomsg_{nullptr};
+  struct ifinfomsg*
+  getIfInfoMsg() const {
+    return reinterpret_cast<struct ifinfomsg*>(NLMSG_DATA(msghdr_));
+  }
 
   // promise to be fulfilled when receiving kernel reply
   folly::Promise<folly::Expected<std::vector<Link>, int>> linkPromise_;
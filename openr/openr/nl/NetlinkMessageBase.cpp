@@ -5,6 +5,8 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
+
 #include <folly/logging/xlog.h>
 
 #include <openr/nl/NetlinkMessageBase.h>
@@ -12,10 +14,10 @@
 namespace openr::fbnl {
 
 NetlinkMessageBase::NetlinkMessageBase()
-    : msghdr_(reinterpret_cast<struct nlmsghdr*>(msg.data())) {}
+    : msghdr_(reinterpret_cast<struct nlmsghdr*>(buffer_.data())) {}
 
 NetlinkMessageBase::NetlinkMessageBase(int type)
-    : msghdr_(reinterpret_cast<struct nlmsghdr*>(msg.data())) {
+    : msghdr_(reinterpret_cast<struct nlmsghdr*>(buffer_.data())) {
   // initialize netlink header
   msghdr_->nlmsg_len = NLMSG_LENGTH(0);
   msghdr_->nlmsg_type = type;
@@ -42,11 +44,16 @@ NetlinkMessageBase::getDataLength() const {
 
 struct rtattr*
 NetlinkMessageBase::addSubAttributes(
-    struct rtattr* rta, int type, const void* data, uint32_t len) const {
+    struct rtattr* rta,
+    int type,
+    const void* data,
+    uint32_t len,
+    uint32_t bufferLen) const {
   struct rtattr* subrta{nullptr};
   uint32_t subRtaLen = RTA_LENGTH(len);
 
-  if (RTA_ALIGN(rta->rta_len) + RTA_ALIGN(subRtaLen) > kMaxNlPayloadSize) {
+  if (RTA_ALIGN(rta->rta_len) + RTA_ALIGN(subRtaLen) >
+      std::min(bufferLen, kMaxNlAttrSize)) {
     XLOG(ERR) << "No buffer for adding attr: " << type << " length: " << len;
     return subrta;
   }
@@ -72,10 +79,13 @@ NetlinkMessageBase::addAttributes(
   uint32_t rtaLen = (RTA_LENGTH(len));
   uint32_t nlmsgAlen = NLMSG_ALIGN((msghdr_)->nlmsg_len);
 
-  if (nlmsgAlen + RTA_ALIGN(rtaLen) > kMaxNlPayloadSize) {
+  // Grow message buffer if needed
+  if (rtaLen > kMaxNlAttrSize or
+      not buffer_.resize(nlmsgAlen + RTA_ALIGN(rtaLen))) {
     XLOG(ERR) << "Space not available to add attribute type " << type;
     return ENOBUFS;
   }
+  msghdr_ = reinterpret_cast<struct nlmsghdr*>(buffer_.data());
 
   // set the pointer to the aligned location
   struct rtattr* rptr =
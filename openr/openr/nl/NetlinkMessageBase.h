@@ -16,14 +16,18 @@
 #include <sys/socket.h>
 #include <sys/types.h>
 #include <climits>
+#include <limits>
 
 #include <folly/futures/Future.h>
 
+#include <openr/nl/NetlinkMessageBuffer.h>
+#include <openr/nl/NetlinkRouteView.h>
 #include <openr/nl/NetlinkTypes.h>
 
 namespace openr::fbnl {
 
-constexpr uint16_t kMaxNlPayloadSize{4096};
+// Maximum length of an attribute, limited by 16 bit `rta_len`
+constexpr uint32_t kMaxNlAttrSize{std::numeric_limits<uint16_t>::max()};
 
 /*
  * Data structure representing a netlink message, either to be sent or received.
@@ -34,7 +38,8 @@ constexpr uint16_t kMaxNlPayloadSize{4096};
  * Aim of the message is to faciliate serialization and deserialization of
  * C++ object (application) to/from bytes (kernel).
  *
- * Maximum size of message is limited by `kMaxNlPayloadSize` parameter.
+ * Message is backed by a pooled buffer of `kMaxNlPayloadSize` bytes, which
+ * grows on demand (e.g. for wide ECMP routes) up to `kMaxNlMessageSize`.
  */
 /*
  * For netlink reference:
@@ -100,9 +105,6 @@ class NetlinkMessageBase {
   // get current length
   uint32_t getDataLength() const;
 
-  // Buffer to create message
-  std::array<char, kMaxNlPayloadSize> msg = {};
-
   /**
    * APIs for accumulating objects of `GET_<>` request. These APIs are invoked
    * when an object is received from kernel in-response to this netlink-message.
@@ -111,10 +113,13 @@ class NetlinkMessageBase {
    *
    * e.g. GET_ROUTE request will invoke `rcvdRoute(..)` for each route received
    *      from kernel. At the end `setReturnStatus(..)` will be invoked.
+   *
+   * NOTE: Routes are passed as a view of the message in the receive buffer.
+   * Sub-classes must copy or materialize it before returning.
    */
 
   virtual void
-  rcvdRoute(Route&& /* route */) {
+  rcvdRoute(const RouteView& /* route */) {
     CHECK(false) << "Must be implemented by subclass";
   }
 
@@ -172,6 +177,9 @@ class NetlinkMessageBase {
    *          data => data value
    *          length => data length
    *
+   * Message buffer is grown if needed. NOTE: Growing may relocate the
+   * buffer, hence pointers into the message must not be held across calls.
+   *
    * @return:
    *  - EVNOBUFS: if enough buffer is not available
    *  - 0: on success
@@ -187,13 +195,22 @@ class NetlinkMessageBase {
    *          type => data type
    *          data => data value
    *          length => data length
+   *          bufferLen => length of buffer `rta` is placed at
    *
    * @return: route attribute struct ptr
    */
   struct rtattr* addSubAttributes(
-      struct rtattr* rta, int type, const void* data, uint32_t len) const;
+      struct rtattr* rta,
+      int type,
+      const void* data,
+      uint32_t len,
+      uint32_t bufferLen = kMaxNlPayloadSize) const;
+
+  // Buffer to create message
+  NetlinkMessageBuffer buffer_;
 
-  // pointer to the netlink message header
+  // pointer to the netlink message header. NOTE: Pointers to family specific
+  // headers must be derived from it on access, as buffer may be relocated.
   struct nlmsghdr* msghdr_{nullptr};
 
  private:
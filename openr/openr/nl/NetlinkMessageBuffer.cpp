@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include <folly/Synchronized.h>
+#include <glog/logging.h>
+
+#include <openr/nl/NetlinkMessageBuffer.h>
+
+namespace openr::fbnl {
+
+namespace {
+
+// Number of power-of-two size classes in [kMaxNlPayloadSize, kMaxNlMessageSize]
+constexpr size_t kNumSizeClasses{6};
+static_assert(
+    (uint32_t{kMaxNlPayloadSize} << (kNumSizeClasses - 1)) ==
+    kMaxNlMessageSize);
+
+// Upper bound on memory retained by pool per size class
+constexpr size_t kMaxPooledBytesPerSizeClass{16 * 1024 * 1024};
+
+constexpr uint32_t
+getSizeClassCapacity(uint8_t sizeClass) {
+  return uint32_t{kMaxNlPayloadSize} << sizeClass;
+}
+
+uint8_t
+getSizeClass(uint32_t size) {
+  uint8_t sizeClass{0};
+  while (getSizeClassCapacity(sizeClass) < size) {
+    ++sizeClass;
+  }
+  return sizeClass;
+}
+
+class BufferPool {
+ public:
+  char*
+  acquire(uint8_t sizeClass) {
+    char* buf{nullptr};
+    {
+      auto lockedFreeList = freeLists_.at(sizeClass).lock();
+      if (not lockedFreeList->empty()) {
+        buf = lockedFreeList->back();
+        lockedFreeList->pop_back();
+      }
+    }
+    if (buf) {
+      reuses_.fetch_add(1, std::memory_order_relaxed);
+      pooledBytes_.fetch_sub(
+          getSizeClassCapacity(sizeClass), std::memory_order_relaxed);
+      return buf;
+    }
+    allocations_.fetch_add(1, std::memory_order_relaxed);
+    return static_cast<char*>(::operator new(getSizeClassCapacity(sizeClass)));
+  }
+
+  void
+  release(char* buf, uint8_t sizeClass) noexcept {
+    const auto capacity = getSizeClassCapacity(sizeClass);
+    {
+      auto lockedFreeList = freeLists_.at(sizeClass).lock();
+      if ((lockedFreeList->size() + 1) * capacity <=
+          kMaxPooledBytesPerSizeClass) {
+        lockedFreeList->push_back(buf);
+        buf = nullptr;
+      }
+    }
+    if (buf) {
+      ::operator delete(buf);
+    } else {
+      pooledBytes_.fetch_add(capacity, std::memory_order_relaxed);
+    }
+  }
+
+  NetlinkMessageBuffer::PoolStats
+  getStats() const {
+    NetlinkMessageBuffer::PoolStats stats;
+    stats.allocations = allocations_.load(std::memory_order_relaxed);
+    stats.reuses = reuses_.load(std::memory_order_relaxed);
+    stats.pooledBytes = pooledBytes_.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+ private:
+  std::array<
+      folly::Synchronized<std::vector<char*>, std::mutex>,
+      kNumSizeClasses>
+      freeLists_;
+  std::atomic<uint64_t> allocations_{0};
+  std::atomic<uint64_t> reuses_{0};
+  std::atomic<uint64_t> pooledBytes_{0};
+};
+
+BufferPool&
+getBufferPool() {
+  // NOTE: Intentionally leaked to stay valid during static destruction
+  static auto* pool = new BufferPool();
+  return *pool;
+}
+
+} // namespace
+
+NetlinkMessageBuffer::NetlinkMessageBuffer(uint32_t size) {
+  CHECK_LE(size, kMaxNlMessageSize);
+  sizeClass_ = getSizeClass(size);
+  data_ = getBufferPool().acquire(sizeClass_);
+  size_ = size;
+  std::memset(data_, 0, size_);
+}
+
+NetlinkMessageBuffer::~NetlinkMessageBuffer() {
+  release();
+}
+
+NetlinkMessageBuffer::NetlinkMessageBuffer(
+    NetlinkMessageBuffer&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      sizeClass_(other.sizeClass_) {}
+
+NetlinkMessageBuffer&
+NetlinkMessageBuffer::operator=(NetlinkMessageBuffer&& other) noexcept {
+  if (this != &other) {
+    release();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    sizeClass_ = other.sizeClass_;
+  }
+  return *this;
+}
+
+bool
+NetlinkMessageBuffer::resize(uint32_t size) {
+  if (size <= size_) {
+    return true;
+  }
+  if (size > kMaxNlMessageSize) {
+    return false;
+  }
+
+  // Grow within the size class
+  if (size <= getSizeClassCapacity(sizeClass_)) {
+    std::memset(data_ + size_, 0, size - size_);
+    size_ = size;
+    return true;
+  }
+
+  // Move content to buffer of larger size class
+  NetlinkMessageBuffer newBuffer(size);
+  std::memcpy(newBuffer.data_, data_, size_);
+  *this = std::move(newBuffer);
+  return true;
+}
+
+void
+NetlinkMessageBuffer::release() noexcept {
+  if (data_) {
+    getBufferPool().release(data_, sizeClass_);
+    data_ = nullptr;
+    size_ = 0;
+  }
+}
+
+NetlinkMessageBuffer::PoolStats
+NetlinkMessageBuffer::getPoolStats() {
+  return getBufferPool().getStats();
+}
+
+} // namespace openr::fbnl
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace openr::fbnl {
+
+// Default size of netlink message buffer
+constexpr uint16_t kMaxNlPayloadSize{4096};
+
+// Maximum size a netlink message buffer can grow to. Allows RTA_MULTIPATH
+// attribute, which is limited by 16 bit `rta_len`, to be fully utilized.
+constexpr uint32_t kMaxNlMessageSize{128 * 1024};
+
+/*
+ * Zero initialized, variable size buffer for building netlink messages.
+ *
+ * Buffers are carved out of a process wide pool of power-of-two size classes,
+ * from `kMaxNlPayloadSize` to `kMaxNlMessageSize`. Released buffers are
+ * recycled instead of returned to allocator, hence programming large number
+ * of routes doesn't incur an allocation per message. Buffer is usually
+ * created by the caller thread and released on netlink event base thread,
+ * thus pool is thread-safe.
+ *
+ * Buffer can be grown with `resize(..)`, which is free as long as new size
+ * fits within the size class of buffer. Otherwise the content is moved to a
+ * buffer of larger size class, invalidating all pointers into the buffer.
+ */
+class NetlinkMessageBuffer final {
+ public:
+  explicit NetlinkMessageBuffer(uint32_t size = kMaxNlPayloadSize);
+
+  ~NetlinkMessageBuffer();
+
+  NetlinkMessageBuffer(NetlinkMessageBuffer&& other) noexcept;
+  NetlinkMessageBuffer& operator=(NetlinkMessageBuffer&& other) noexcept;
+
+  char*
+  data() const {
+    return data_;
+  }
+
+  // Usable, zero initialized size of the buffer
+  uint32_t
+  size() const {
+    return size_;
+  }
+
+  /*
+   * Grow buffer to at least `size` bytes, preserving the existing content.
+   * New bytes are zero initialized. Returns false if `size` exceeds
+   * `kMaxNlMessageSize`.
+   */
+  bool resize(uint32_t size);
+
+  /*
+   * Pool statistics. `allocations` counts buffers obtained from allocator,
+   * `reuses` counts buffers served from the pool.
+   */
+  struct PoolStats {
+    uint64_t allocations{0};
+    uint64_t reuses{0};
+    uint64_t pooledBytes{0};
+  };
+  static PoolStats getPoolStats();
+
+ private:
+  NetlinkMessageBuffer(NetlinkMessageBuffer const&) = delete;
+  NetlinkMessageBuffer& operator=(NetlinkMessageBuffer const&) = delete;
+
+  void release() noexcept;
+
+  char* data_{nullptr};
+  uint32_t size_{0};
+  uint8_t sizeClass_{0};
+};
+
+} // namespace openr::fbnl
@@ -48,10 +48,7 @@ NetlinkNeighborMessage::init(int type, uint32_t neighFlags) {
     msghdr_->nlmsg_flags |= NLM_F_DUMP;
   }
 
-  // intialize the route neighbor message header
-  auto nlmsgAlen = NLMSG_ALIGN(sizeof(struct nlmsghdr));
-  ndmsg_ = reinterpret_cast<struct ndmsg*>((char*)msghdr_ + nlmsgAlen);
-  ndmsg_->ndm_flags = neighFlags;
+  getNdMsg()->ndm_flags = neighFlags;
 }
 
 Neighbor
@@ -89,7 +89,10 @@ class NetlinkNeighborMessage final : public NetlinkMessageBase {
   void rcvdNeighbor(Neighbor&& ifAddr) override;
 
   // pointer to neighbor message header
-  struct ndmsg* ndmsg_{nullptr};
+  struct ndmsg*
+  getNdMsg() const {
+    return reinterpret_cast<struct ndmsg*>(NLMSG_DATA(msghdr_));
+  }
 
   // promise to be fulfilled when receiving kernel reply
   folly::Promise<folly::Expected<std::vector<Neighbor>, int>> neighborPromise_;
@@ -15,19 +15,54 @@ namespace fb303 = facebook::fb303;
 
 namespace openr::fbnl {
 
+namespace {
+
+/**
+ * Create filter for retrieving unicast routes of given address family and
+ * protocol. Address family is set via default route of the family.
+ */
+fbnl::Route
+createUnicastRouteFilter(
+    int family, uint8_t protocolId, std::optional<uint8_t> routeTableId) {
+  fbnl::RouteBuilder builder;
+  if (family == AF_INET) {
+    builder.setDestination({folly::IPAddressV4("0.0.0.0"), 0});
+  } else {
+    builder.setDestination({folly::IPAddressV6("::"), 0});
+  }
+  // Set protocol ID
+  builder.setProtocolId(protocolId);
+  builder.setType(RTN_UNSPEC); // Explicitly set type to 0
+  // Set route table ID if given
+  if (routeTableId.has_value()) {
+    builder.setRouteTable(routeTableId.value());
+  }
+  return builder.build();
+}
+
+} // namespace
+
 NetlinkProtocolSocket::NetlinkProtocolSocket(
     folly::EventBase* evb,
     messaging::ReplicateQueue<NetlinkEvent>& netlinkEventsQ,
-    bool enableIPv6RouteReplaceSemantics)
+    bool enableIPv6RouteReplaceSemantics,
+    uint32_t recvBufSize,
+    uint32_t maxRecvBufSize)
     : EventHandler(evb),
       evb_(evb),
       netlinkEventsQueue_(netlinkEventsQ),
-      enableIPv6RouteReplaceSemantics_(enableIPv6RouteReplaceSemantics) {
+      enableIPv6RouteReplaceSemantics_(enableIPv6RouteReplaceSemantics),
+      recvBufSize_(recvBufSize),
+      maxRecvBufSize_(std::max(recvBufSize, maxRecvBufSize)) {
   // We expect ctrl-evb not be running. Attaching and scheduling
   // of timers is not thread safe.
   CHECK_NOTNULL(evb_);
   CHECK(not evb_->isRunning());
 
+  fbData->addStatExportType("netlink.recv.datagrams", fb303::AVG);
+  fbData->addStatExportType("netlink.recv.overruns", fb303::SUM);
+  fbData->addStatExportType("netlink.recv.truncated", fb303::SUM);
+
   nlMessageTimer_ = folly::AsyncTimeout::make(*evb_, [this]() noexcept {
     DCHECK(false) << "This shouldn't occur usually. Adding DCHECK to get "
                   << "attention in UTs";
@@ -114,9 +149,8 @@ NetlinkProtocolSocket::init() {
   if (nlSock_ < 0) {
     XLOG(FATAL) << "Netlink socket create failed.";
   }
-  int size = kNetlinkSockRecvBuf;
   // increase socket recv buffer size
-  if (setsockopt(nlSock_, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size)) < 0) {
+  if (not setRecvBufSize(recvBufSize_)) {
     XLOG(FATAL) << "Netlink socket set recv buffer failed.";
   };
 
@@ -153,6 +187,46 @@ NetlinkProtocolSocket::init() {
   sendNetlinkMessage();
 }
 
+bool
+NetlinkProtocolSocket::setRecvBufSize(uint32_t size) {
+  // NOTE: SO_RCVBUFFORCE allows exceeding `net.core.rmem_max` but requires
+  // CAP_NET_ADMIN. Fallback to SO_RCVBUF, which is capped by `rmem_max`.
+  const int sizeInt = size;
+  const bool forced = setsockopt(
+                          nlSock_,
+                          SOL_SOCKET,
+                          SO_RCVBUFFORCE,
+                          &sizeInt,
+                          sizeof(sizeInt)) == 0;
+  if (not forced and
+      setsockopt(nlSock_, SOL_SOCKET, SO_RCVBUF, &sizeInt, sizeof(sizeInt)) <
+          0) {
+    return false;
+  }
+  fbData->setCounter("netlink.recv.rcvbuf_bytes", size);
+  return true;
+}
+
+void
+NetlinkProtocolSocket::handleRecvOverrun() {
+  fbData->addStatValue("netlink.recv.overruns", 1, fb303::SUM);
+  if (recvBufSize_ >= maxRecvBufSize_) {
+    XLOG(ERR) << "Netlink socket receive buffer overrun. Buffer is already at "
+              << "max size " << maxRecvBufSize_ << " bytes";
+    return;
+  }
+
+  const auto newSize = std::min(recvBufSize_ * 2, maxRecvBufSize_);
+  XLOG(WARNING) << "Netlink socket receive buffer overrun. Growing buffer "
+                << "from " << recvBufSize_ << " to " << newSize << " bytes";
+  if (setRecvBufSize(newSize)) {
+    recvBufSize_ = newSize;
+  } else {
+    XLOG(ERR) << "Failed to grow netlink socket receive buffer. Error: "
+              << folly::errnoStr(errno);
+  }
+}
+
 void
 NetlinkProtocolSocket::handlerReady(uint16_t events) noexcept {
   CHECK_EQ(events, folly::EventHandler::READ);
@@ -283,10 +357,9 @@ NetlinkProtocolSocket::sendNetlinkMessage() {
 }
 
 void
-NetlinkProtocolSocket::processMessage(
-    const std::array<char, kMaxNlPayloadSize>& rxMsg, uint32_t bytesRead) {
+NetlinkProtocolSocket::processMessage(const char* rxMsg, uint32_t bytesRead) {
   // first netlink message header
-  struct nlmsghdr* nlh = (struct nlmsghdr*)rxMsg.data();
+  struct nlmsghdr* nlh = (struct nlmsghdr*)rxMsg;
   do {
     if (!NLMSG_OK(nlh, bytesRead)) {
       break;
@@ -300,13 +373,14 @@ NetlinkProtocolSocket::processMessage(
     switch (nlh->nlmsg_type) {
     case RTM_NEWROUTE:
     case RTM_DELROUTE: {
-      // next RTM message to be processed
-      auto route = NetlinkRouteMessage::parseMessage(nlh);
+      // next RTM message to be processed. NOTE: Route is passed as a view of
+      // the receive buffer and is materialized only if requested.
+      const RouteView route(nlh);
       if (nlSeqIt != nlSeqNumMap_.end()) {
         // Extend message timer as we received a valid ack
         nlMessageTimer_->scheduleTimeout(kNlRequestAckTimeout);
         // Received route in response to request
-        nlSeqIt->second->rcvdRoute(std::move(route));
+        nlSeqIt->second->rcvdRoute(route);
       } else {
         // Route notification
         fbData->addStatValue("netlink.notifications.route", 1, fb303::SUM);
@@ -433,24 +507,59 @@ NetlinkProtocolSocket::processMessage(
 
 void
 NetlinkProtocolSocket::recvNetlinkMessage() {
-  // messages buffer
-  std::array<char, kMaxNlPayloadSize> recvMsg = {};
+  uint32_t numDatagrams{0};
+  while (numDatagrams < kMaxNlRecvBatch) {
+    // Peek length of next datagram without copying it. NOTE: With MSG_TRUNC,
+    // real length of datagram is returned even if it is longer than the
+    // buffer. Grow buffer ahead of reading, so that datagrams carrying large
+    // routes (e.g. wide ECMP) are not truncated.
+    int32_t bytesRead =
+        ::recv(nlSock_, nullptr, 0, MSG_DONTWAIT | MSG_PEEK | MSG_TRUNC);
+    if (bytesRead > 0 and static_cast<uint32_t>(bytesRead) > rxBuffer_.size()) {
+      rxBuffer_.resize(
+          std::min(static_cast<uint32_t>(bytesRead), kMaxNlMessageSize));
+    }
+    if (bytesRead >= 0) {
+      bytesRead = ::recv(
+          nlSock_,
+          rxBuffer_.data(),
+          rxBuffer_.size(),
+          MSG_DONTWAIT | MSG_TRUNC);
+    }
+    XLOG(DBG4) << "Message received with size: " << bytesRead;
 
-  int32_t bytesRead = ::recv(nlSock_, recvMsg.data(), kMaxNlPayloadSize, 0);
-  XLOG(DBG4) << "Message received with size: " << bytesRead;
+    if (bytesRead < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        break; // Socket is drained
+      }
+      if (errno == ENOBUFS) {
+        handleRecvOverrun();
+        continue;
+      }
+      XLOG(ERR) << "Error in netlink socket receive: " << bytesRead
+                << " err: " << folly::errnoStr(std::abs(errno));
+      fbData->addStatValue("netlink.errors", 1, fb303::SUM);
+      break;
+    }
 
-  if (bytesRead < 0) {
-    if (errno == EINTR || errno == EAGAIN) {
-      return;
+    ++numDatagrams;
+    uint32_t bytesAvailable = static_cast<uint32_t>(bytesRead);
+    if (bytesAvailable > rxBuffer_.size()) {
+      // Datagram exceeds maximum message size. Process messages which fit in
+      // the buffer.
+      XLOG(ERR) << "Netlink datagram of " << bytesAvailable << " bytes "
+                << "truncated to " << rxBuffer_.size() << " bytes";
+      fbData->addStatValue("netlink.recv.truncated", 1, fb303::SUM);
+      fbData->addStatValue("netlink.errors", 1, fb303::SUM);
+      bytesAvailable = rxBuffer_.size();
     }
-    XLOG(ERR) << "Error in netlink socket receive: " << bytesRead
-              << " err: " << folly::errnoStr(std::abs(errno));
-    fbData->addStatValue("netlink.errors", 1, fb303::SUM);
-    return;
-  } else {
-    fbData->addStatValue("netlink.bytes.rx", bytesRead, fb303::SUM);
+    fbData->addStatValue("netlink.bytes.rx", bytesAvailable, fb303::SUM);
+    processMessage(rxBuffer_.data(), bytesAvailable);
   }
-  processMessage(recvMsg, static_cast<uint32_t>(bytesRead));
+  fbData->addStatValue("netlink.recv.datagrams", numDatagrams, fb303::AVG);
 }
 
 folly::SemiFuture<folly::Unit>
@@ -712,33 +821,14 @@ NetlinkProtocolSocket::getAllRoutes(std::optional<uint8_t> routeTableId) {
 folly::SemiFuture<folly::Expected<std::vector<fbnl::Route>, int>>
 NetlinkProtocolSocket::getIPv4Routes(
     uint8_t protocolId, std::optional<uint8_t> routeTableId) {
-  fbnl::RouteBuilder builder;
-  // Set address family to MPLS with default v4 route
-  builder.setDestination({folly::IPAddressV4("0.0.0.0"), 0});
-  // Set protocol ID
-  builder.setProtocolId(protocolId);
-  builder.setType(RTN_UNSPEC); // Explicitly set type to 0
-  // Set route table ID if given
-  if (routeTableId.has_value()) {
-    builder.setRouteTable(routeTableId.value());
-  }
-  return getRoutes(builder.build());
+  return getRoutes(createUnicastRouteFilter(AF_INET, protocolId, routeTableId));
 }
 
 folly::SemiFuture<folly::Expected<std::vector<fbnl::Route>, int>>
 NetlinkProtocolSocket::getIPv6Routes(
     uint8_t protocolId, std::optional<uint8_t> routeTableId) {
-  fbnl::RouteBuilder builder;
-  // Set address family to MPLS with default v6 route
-  builder.setDestination({folly::IPAddressV6("::"), 0});
-  // Set protocol ID
-  builder.setProtocolId(protocolId);
-  builder.setType(RTN_UNSPEC); // Explicitly set type to 0
-  // Set route table ID if given
-  if (routeTableId.has_value()) {
-    builder.setRouteTable(routeTableId.value());
-  }
-  return getRoutes(builder.build());
+  return getRoutes(
+      createUnicastRouteFilter(AF_INET6, protocolId, routeTableId));
 }
 
 folly::SemiFuture<folly::Expected<std::vector<fbnl::Route>, int>>
@@ -756,4 +846,31 @@ NetlinkProtocolSocket::getMplsRoutes(
   return getRoutes(builder.build());
 }
 
+folly::SemiFuture<folly::Expected<RouteDump, int>>
+NetlinkProtocolSocket::getRouteDump(const fbnl::Route& filter) {
+  XLOG(DBG1) << "Netlink get route dump with filter. " << filter.str();
+  auto routeMsg = std::make_unique<openr::fbnl::NetlinkRouteMessage>();
+  auto future = routeMsg->getRouteDumpSemiFuture();
+
+  // Initialize message fields to get all routes
+  routeMsg->initGet(0, filter);
+  notifQueue_.putMessage(std::move(routeMsg));
+
+  return future;
+}
+
+folly::SemiFuture<folly::Expected<RouteDump, int>>
+NetlinkProtocolSocket::getIPv4RouteDump(
+    uint8_t protocolId, std::optional<uint8_t> routeTableId) {
+  return getRouteDump(
+      createUnicastRouteFilter(AF_INET, protocolId, routeTableId));
+}
+
+folly::SemiFuture<folly::Expected<RouteDump, int>>
+NetlinkProtocolSocket::getIPv6RouteDump(
+    uint8_t protocolId, std::optional<uint8_t> routeTableId) {
+  return getRouteDump(
+      createUnicastRouteFilter(AF_INET6, protocolId, routeTableId));
+}
+
 } // namespace openr::fbnl
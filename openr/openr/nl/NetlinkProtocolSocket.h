@@ -29,8 +29,19 @@ namespace openr::fbnl {
 using NetlinkEvent =
     std::variant<fbnl::Link, fbnl::IfAddress, fbnl::Neighbor, fbnl::Rule>;
 
-// Receive socket buffer for netlink socket
+// Receive socket buffer for netlink socket. On receive buffer overrun, socket
+// buffer is doubled up to `kNetlinkSockMaxRecvBuf`.
 constexpr uint32_t kNetlinkSockRecvBuf{1 * 1024 * 1024};
+constexpr uint32_t kNetlinkSockMaxRecvBuf{16 * 1024 * 1024};
+
+// Size of buffer for receiving datagrams. Kernel sizes dump datagrams based on
+// size of buffer provided by reader, up to 32KB. Larger buffer thus reduces
+// number of datagrams (and syscalls) of a dump.
+constexpr uint32_t kNetlinkRecvBufferSize{32 * 1024};
+
+// Maximum number of datagrams drained from socket per read event. Bounds the
+// time event base spends reading before serving other events.
+constexpr uint32_t kMaxNlRecvBatch{64};
 
 // Maximum number of in-flight messages. `kMinIovMsg` indicates the soft
 // requirement for sending bufferred messages.
@@ -91,6 +102,10 @@ constexpr std::chrono::milliseconds kNlRequestAckTimeout{1000};
  *   netlink.requests.latency_ms : Average latency of netlink request
  *   netlink.bytes.rx : Bytes received over netlink socket
  *   netlink.bytes.tx : Bytes sent over netlink socket
+ *   netlink.recv.datagrams : Datagrams drained per read event
+ *   netlink.recv.overruns : Receive buffer overruns, i.e. dropped messages
+ *   netlink.recv.truncated : Datagrams exceeding maximum message size
+ *   netlink.recv.rcvbuf_bytes : Current socket receive buffer size
  *   netlink.notifications.link : Received link notifications
  *   netlink.notifications.addr : Received address notifications
  *   netlink.notifications.neighbors : Received neighbor notifications
@@ -101,7 +116,9 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   explicit NetlinkProtocolSocket(
       folly::EventBase* evb,
       messaging::ReplicateQueue<NetlinkEvent>& netlinkEventsQ,
-      bool enableIPv6RouteReplaceSemantics = false);
+      bool enableIPv6RouteReplaceSemantics = false,
+      uint32_t recvBufSize = kNetlinkSockRecvBuf,
+      uint32_t maxRecvBufSize = kNetlinkSockMaxRecvBuf);
 
   virtual ~NetlinkProtocolSocket();
 
@@ -231,6 +248,19 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   getMplsRoutes(
       uint8_t protocolId, std::optional<uint8_t> routeTableId = std::nullopt);
 
+  /**
+   * Variants of route retrieval APIs returning routes in their wire format.
+   * Routes are accessed via `RouteView` without materializing `fbnl::Route`,
+   * which makes them preferable for large dumps compared against the desired
+   * state, e.g. FIB sync. Filter semantics are same as of `getRoutes(..)`.
+   */
+  virtual folly::SemiFuture<folly::Expected<RouteDump, int>> getRouteDump(
+      const fbnl::Route& filter);
+  virtual folly::SemiFuture<folly::Expected<RouteDump, int>> getIPv4RouteDump(
+      uint8_t protocolId, std::optional<uint8_t> routeTableId = std::nullopt);
+  virtual folly::SemiFuture<folly::Expected<RouteDump, int>> getIPv6RouteDump(
+      uint8_t protocolId, std::optional<uint8_t> routeTableId = std::nullopt);
+
   /**
    * Utility function to accumulate result of multiple requests into one.
    * It will throw the exception with the first non-zero value(aka error code),
@@ -254,14 +284,20 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   // Send a message batch to netlink socket from queue_
   void sendNetlinkMessage();
 
-  // Receive messages from netlink socket. Invoke `processMessage` for every
-  // message received.
+  // Receive messages from netlink socket. Drains up to `kMaxNlRecvBatch`
+  // datagrams and invokes `processMessage` for every datagram received.
   void recvNetlinkMessage();
 
   // Process received netlink message. Set return values for pending requests
   // or send notifications.
-  void processMessage(
-      const std::array<char, kMaxNlPayloadSize>& rxMsg, uint32_t bytesRead);
+  void processMessage(const char* rxMsg, uint32_t bytesRead);
+
+  // Set socket receive buffer size. Returns false on failure.
+  bool setRecvBufSize(uint32_t size);
+
+  // Handle receive buffer overrun. Kernel has dropped messages as socket
+  // receive buffer is full. Grow socket receive buffer.
+  void handleRecvOverrun();
 
   // Process ack message. Set return status on pending requests in nlSeqNumMap_
   // Resume sending messages from queue_ if any pending
@@ -285,6 +321,14 @@ class NetlinkProtocolSocket : public folly::EventHandler {
   // Use new IPv6 route replace semantics. See documentation for addRoute(...)
   const bool enableIPv6RouteReplaceSemantics_{false};
 
+  // Current and maximum size of socket receive buffer. Current size is
+  // preserved when socket is re-initialized.
+  uint32_t recvBufSize_{kNetlinkSockRecvBuf};
+  const uint32_t maxRecvBufSize_{kNetlinkSockMaxRecvBuf};
+
+  // Buffer for receiving datagrams. Grows if a datagram was truncated.
+  NetlinkMessageBuffer rxBuffer_{kNetlinkRecvBufferSize};
+
   // Netlink socket fd. Created when class is constructed. Re-created on timeout
   // when no response is received for any of our pending requests.
   int nlSock_{-1};
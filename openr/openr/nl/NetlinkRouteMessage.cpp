@@ -18,7 +18,7 @@ NetlinkRouteMessage::~NetlinkRouteMessage() {
 }
 
 void
-NetlinkRouteMessage::rcvdRoute(Route&& route) {
+NetlinkRouteMessage::rcvdRoute(const RouteView& route) {
   //
   // Implement application side filters for table and protocol if specified
   //
@@ -35,31 +35,22 @@ NetlinkRouteMessage::rcvdRoute(Route&& route) {
     return; // ignore the route
   }
 
-  NextHopSet reversedMplsLabelNhs;
-  bool reverted = false;
-  for (auto nh : route.getNextHops()) {
-    auto pushLabels = nh.getPushLabels();
-    // reverse the push labels becasue thrift API definition.
-    if (pushLabels.has_value()) {
-      reverted = true;
-      std::reverse(pushLabels.value().begin(), pushLabels.value().end());
-      nh.setPushLabels(pushLabels.value());
-    }
-    reversedMplsLabelNhs.insert(nh);
-  }
-  if (reverted) {
-    route.setNextHops(reversedMplsLabelNhs);
+  if (dumpRouteViews_) {
+    rcvdRouteDump_.append(route.getMessagePtr());
+    return;
   }
 
-  rcvdRoutes_.emplace_back(std::move(route));
+  rcvdRoutes_.emplace_back(route.toRoute());
 }
 
 void
 NetlinkRouteMessage::setReturnStatus(int status) {
   if (status == 0) {
     routePromise_.setValue(std::move(rcvdRoutes_));
+    routeDumpPromise_.setValue(std::move(rcvdRouteDump_));
   } else {
     routePromise_.setValue(folly::makeUnexpected(status));
+    routeDumpPromise_.setValue(folly::makeUnexpected(status));
   }
 
   NetlinkMessageBase::setReturnStatus(status);
@@ -79,7 +70,7 @@ NetlinkRouteMessage::init(int type, uint32_t rtFlags, const Route& route) {
   if (type == RTM_GETROUTE) {
     // Get routes matching subsequent criteria specified below
     msghdr_->nlmsg_flags |= NLM_F_DUMP;
-    // NOTE - Only `rtmsg_->rtm_family` will be used by kernel as filter
+    // NOTE - Only `rtmsg->rtm_family` will be used by kernel as filter
     // parameter. Other parameters such as table, protocol, scope, type will
     // need to be filtered on user side.
     filters_.table = route.getRouteTable();
@@ -99,24 +90,21 @@ NetlinkRouteMessage::init(int type, uint32_t rtFlags, const Route& route) {
     msghdr_->nlmsg_flags |= NLM_F_REPLACE;
   }
 
-  // intialize the route meesage header
-  auto nlmsgAlen = NLMSG_ALIGN(sizeof(struct nlmsghdr));
-  rtmsg_ = reinterpret_cast<struct rtmsg*>((char*)msghdr_ + nlmsgAlen);
-
   // Initialize values from route object or function params
+  struct rtmsg* hdr = getRtMsg();
   const int routeTable = route.getRouteTable();
-  rtmsg_->rtm_table = routeTable < 256 ? routeTable : RT_TABLE_COMPAT;
-  rtmsg_->rtm_protocol = route.getProtocolId();
-  rtmsg_->rtm_scope = route.getScope();
-  rtmsg_->rtm_type = route.getType();
-  rtmsg_->rtm_family = route.getFamily();
-  rtmsg_->rtm_src_len = 0;
-  rtmsg_->rtm_tos = 0;
-  rtmsg_->rtm_flags = rtFlags;
+  hdr->rtm_table = routeTable < 256 ? routeTable : RT_TABLE_COMPAT;
+  hdr->rtm_protocol = route.getProtocolId();
+  hdr->rtm_scope = route.getScope();
+  hdr->rtm_type = route.getType();
+  hdr->rtm_family = route.getFamily();
+  hdr->rtm_src_len = 0;
+  hdr->rtm_tos = 0;
+  hdr->rtm_flags = rtFlags;
 
   auto rtFlag = route.getFlags();
   if (rtFlag.has_value()) {
-    rtmsg_->rtm_flags |= rtFlag.value();
+    hdr->rtm_flags |= rtFlag.value();
   }
 }
 
@@ -200,8 +188,11 @@ NetlinkRouteMessage::addIpNexthop(
                                               : sizeof(struct _NextHop);
     memcpy(nh.ip, reinterpret_cast<const char*>(gw.bytes()), gw.byteCount());
     if (addSubAttributes(
-            rta, RTA_VIA, reinterpret_cast<const char*>(&nh), nhLen) ==
-        nullptr) {
+            rta,
+            RTA_VIA,
+            reinterpret_cast<const char*>(&nh),
+            nhLen,
+            kMaxNlAttrSize) == nullptr) {
       return ENOBUFS;
     }
 
@@ -209,7 +200,8 @@ NetlinkRouteMessage::addIpNexthop(
     rtnh->rtnh_len += nhLen + sizeof(struct rtattr);
   } else {
     // RTA_GATEWAY
-    if (addSubAttributes(rta, RTA_GATEWAY, gw.bytes(), gw.byteCount()) ==
+    if (addSubAttributes(
+            rta, RTA_GATEWAY, gw.bytes(), gw.byteCount(), kMaxNlAttrSize) ==
         nullptr) {
       return ENOBUFS;
     }
@@ -251,7 +243,8 @@ NetlinkRouteMessage::addSwapOrPHPNexthop(
             rta,
             RTA_NEWDST,
             reinterpret_cast<const char*>(&swapLabel),
-            sizeof(swapLabel)) == nullptr) {
+            sizeof(swapLabel),
+            kMaxNlAttrSize) == nullptr) {
       return ENOBUFS;
     }
   }
@@ -268,8 +261,11 @@ NetlinkRouteMessage::addSwapOrPHPNexthop(
   }
   memcpy(via.ip, reinterpret_cast<const char*>(gw.bytes()), gw.byteCount());
   if (addSubAttributes(
-          rta, RTA_VIA, reinterpret_cast<const char*>(&via), viaLen) ==
-      nullptr) {
+          rta,
+          RTA_VIA,
+          reinterpret_cast<const char*>(&via),
+          viaLen,
+          kMaxNlAttrSize) == nullptr) {
     return ENOBUFS;
   }
 
@@ -299,8 +295,11 @@ NetlinkRouteMessage::addPopNexthop(
 
   int oif = rtnh->rtnh_ifindex;
   if (addSubAttributes(
-          rta, RTA_OIF, reinterpret_cast<const char*>(&oif), sizeof(oif)) ==
-      nullptr) {
+          rta,
+          RTA_OIF,
+          reinterpret_cast<const char*>(&oif),
+          sizeof(oif),
+          kMaxNlAttrSize) == nullptr) {
     return ENOBUFS;
   }
 
@@ -331,7 +330,8 @@ NetlinkRouteMessage::addPushNexthop(
   size_t prevLen = rta->rta_len;
 
   // RTA_ENCAP sub attribute
-  struct rtattr* rtaEncap = addSubAttributes(rta, RTA_ENCAP, nullptr, 0);
+  struct rtattr* rtaEncap =
+      addSubAttributes(rta, RTA_ENCAP, nullptr, 0, kMaxNlAttrSize);
   if (rtaEncap == nullptr) {
     return ENOBUFS;
   }
@@ -352,7 +352,8 @@ NetlinkRouteMessage::addPushNexthop(
     mplsLabel[i++].entry = encodeLabel(label, bos);
   }
   size_t totalSize = labels.value().size() * sizeof(struct mpls_label);
-  if (addSubAttributes(rta, MPLS_IPTUNNEL_DST, &mplsLabel, totalSize) ==
+  if (addSubAttributes(
+          rta, MPLS_IPTUNNEL_DST, &mplsLabel, totalSize, kMaxNlAttrSize) ==
       nullptr) {
     return ENOBUFS;
   };
@@ -362,8 +363,12 @@ NetlinkRouteMessage::addPushNexthop(
 
   // RTA_ENCAP_TYPE sub attribute
   uint16_t encapType = LWTUNNEL_ENCAP_MPLS;
-  if (addSubAttributes(rta, RTA_ENCAP_TYPE, &encapType, sizeof(encapType)) ==
-      nullptr) {
+  if (addSubAttributes(
+          rta,
+          RTA_ENCAP_TYPE,
+          &encapType,
+          sizeof(encapType),
+          kMaxNlAttrSize) == nullptr) {
     return ENOBUFS;
   };
 
@@ -374,8 +379,11 @@ NetlinkRouteMessage::addPushNexthop(
   auto const via = path.getGateway();
   if (via.has_value()) {
     if (addSubAttributes(
-            rta, RTA_GATEWAY, via.value().bytes(), via.value().byteCount()) ==
-        nullptr) {
+            rta,
+            RTA_GATEWAY,
+            via.value().bytes(),
+            via.value().byteCount(),
+            kMaxNlAttrSize) == nullptr) {
       return ENOBUFS;
     };
 
@@ -388,9 +396,12 @@ NetlinkRouteMessage::addPushNexthop(
 
 int
 NetlinkRouteMessage::addNextHops(const Route& route) {
-  std::array<char, kMaxNlPayloadSize> nhop = {};
   int status{0};
   if (route.getNextHops().size() && route.isMultiPath()) {
+    // Scratch buffer for RTA_MULTIPATH, sized for encoding all next-hops
+    NetlinkMessageBuffer nhop(static_cast<uint32_t>(std::min<size_t>(
+        kMaxNlAttrSize,
+        RTA_LENGTH(0) + route.getNextHops().size() * kMaxNlNextHopSize)));
     if ((status = addMultiPathNexthop(nhop, route))) {
       return status;
     }
@@ -409,14 +420,14 @@ NetlinkRouteMessage::addNextHops(const Route& route) {
   }
 
   // print attributes when log level is enabled
-  showRtmMsg(rtmsg_);
+  showRtmMsg(getRtMsg());
 
   return 0;
 }
 
 int
 NetlinkRouteMessage::addMultiPathNexthop(
-    std::array<char, kMaxNlPayloadSize>& nhop, const Route& route) const {
+    NetlinkMessageBuffer& nhop, const Route& route) const {
   // Add [RTA_MULTIPATH - label, via, dev][RTA_ENCAP][RTA_ENCAP_TYPE]
   struct rtattr* rta = reinterpret_cast<struct rtattr*>(nhop.data());
 
@@ -428,6 +439,11 @@ NetlinkRouteMessage::addMultiPathNexthop(
   int result{0};
   const auto& paths = route.getNextHops();
   for (const auto& path : paths) {
+    // Scratch buffer must have room for encoding next-hop
+    if (RTA_ALIGN(rta->rta_len) + kMaxNlNextHopSize > nhop.size()) {
+      XLOG(ERR) << "No buffer for adding next-hop of multipath route";
+      return ENOBUFS;
+    }
     rtnh->rtnh_len = sizeof(*rtnh);
     rta->rta_len += rtnh->rtnh_len;
     auto action = path.getLabelAction();
@@ -803,8 +819,8 @@ NetlinkRouteMessage::addRoute(const Route& route) {
 
   init(RTM_NEWROUTE, 0, route);
 
-  rtmsg_->rtm_family = addressFamily;
-  rtmsg_->rtm_dst_len = plen; /* netmask */
+  getRtMsg()->rtm_family = addressFamily;
+  getRtMsg()->rtm_dst_len = plen; /* netmask */
   const char* const ipptr = reinterpret_cast<const char*>(ip.bytes());
   int status{0};
   if ((status = addAttributes(RTA_DST, ipptr, ip.byteCount()))) {
@@ -859,8 +875,8 @@ NetlinkRouteMessage::deleteRoute(const Route& route) {
 
   auto plen = std::get<1>(pfix);
   auto ip = std::get<0>(pfix);
-  rtmsg_->rtm_family = addressFamily;
-  rtmsg_->rtm_dst_len = plen; /* netmask */
+  getRtMsg()->rtm_family = addressFamily;
+  getRtMsg()->rtm_dst_len = plen; /* netmask */
   const char* const ipptr = reinterpret_cast<const char*>(ip.bytes());
 
   int status{0};
@@ -874,9 +890,9 @@ NetlinkRouteMessage::deleteRoute(const Route& route) {
 int
 NetlinkRouteMessage::addLabelRoute(const Route& route) {
   init(RTM_NEWROUTE, 0, route);
-  rtmsg_->rtm_family = AF_MPLS;
-  rtmsg_->rtm_dst_len = kLabelSizeBits;
-  rtmsg_->rtm_flags = 0;
+  getRtMsg()->rtm_family = AF_MPLS;
+  getRtMsg()->rtm_dst_len = kLabelSizeBits;
+  getRtMsg()->rtm_flags = 0;
   struct mpls_label mlabel;
 
   if (route.getFamily() != AF_MPLS) {
@@ -905,9 +921,9 @@ NetlinkRouteMessage::addLabelRoute(const Route& route) {
 int
 NetlinkRouteMessage::deleteLabelRoute(const Route& route) {
   init(RTM_DELROUTE, 0, route);
-  rtmsg_->rtm_family = AF_MPLS;
-  rtmsg_->rtm_dst_len = kLabelSizeBits;
-  rtmsg_->rtm_flags = 0;
+  getRtMsg()->rtm_family = AF_MPLS;
+  getRtMsg()->rtm_dst_len = kLabelSizeBits;
+  getRtMsg()->rtm_flags = 0;
   struct mpls_label mlabel;
   auto label = route.getMplsLabel();
   if (!label.has_value()) {
@@ -10,6 +10,7 @@
 #include <folly/IPAddress.h>
 #include <openr/if/gen-cpp2/Network_types.h>
 #include <openr/nl/NetlinkMessageBase.h>
+#include <openr/nl/NetlinkRouteView.h>
 #include <openr/nl/NetlinkTypes.h>
 
 extern "C" {
@@ -25,6 +26,10 @@ extern "C" {
 namespace openr::fbnl {
 
 constexpr uint16_t kMaxLabels{16};
+// Upper bound on encoded size of a next-hop within RTA_MULTIPATH, i.e.
+// rtnexthop + RTA_ENCAP(MPLS_IPTUNNEL_DST) + RTA_ENCAP_TYPE + RTA_VIA
+constexpr uint32_t kMaxNlNextHopSize{
+    128 + kMaxLabels * sizeof(struct mpls_label)};
 constexpr uint32_t kLabelBosShift{8};
 constexpr uint32_t kLabelShift{12};
 constexpr uint32_t kLabelSizeBits{20};
@@ -70,6 +75,14 @@ class NetlinkRouteMessage final : public NetlinkMessageBase {
     return routePromise_.getSemiFuture();
   }
 
+  // Get future for received routes in their wire format in response to GET
+  // request. Routes are not materialized into `Route` objects.
+  folly::SemiFuture<folly::Expected<RouteDump, int>>
+  getRouteDumpSemiFuture() {
+    dumpRouteViews_ = true;
+    return routeDumpPromise_.getSemiFuture();
+  }
+
   // initiallize route message with default params
   void init(int type, uint32_t flags, const Route& route);
 
@@ -96,7 +109,7 @@ class NetlinkRouteMessage final : public NetlinkMessageBase {
 
  private:
   // inherited class implementation
-  void rcvdRoute(Route&& route) override;
+  void rcvdRoute(const RouteView& route) override;
 
   // process netlink next hops
   static std::vector<NextHop> parseNextHops(
@@ -123,7 +136,7 @@ class NetlinkRouteMessage final : public NetlinkMessageBase {
 
   // Add ECMP paths
   int addMultiPathNexthop(
-      std::array<char, kMaxNlPayloadSize>& nhop, const Route& route) const;
+      NetlinkMessageBuffer& nhop, const Route& route) const;
 
   // Add single mpls encap nexthop
   int addSingleMplsNexthop(const Route& route);
@@ -159,7 +172,10 @@ class NetlinkRouteMessage final : public NetlinkMessageBase {
   //
 
   // pointer to route message header
-  struct rtmsg* rtmsg_{nullptr};
+  struct rtmsg*
+  getRtMsg() const {
+    return reinterpret_cast<struct rtmsg*>(NLMSG_DATA(msghdr_));
+  }
 
   // for RTA_VIA nexthop
   struct _NextHop {
@@ -181,6 +197,11 @@ class NetlinkRouteMessage final : public NetlinkMessageBase {
   // promise to be fulfilled when receiving kernel reply
   folly::Promise<folly::Expected<std::vector<Route>, int>> routePromise_;
   std::vector<Route> rcvdRoutes_;
+
+  // promise to be fulfilled with received routes in their wire format
+  folly::Promise<folly::Expected<RouteDump, int>> routeDumpPromise_;
+  RouteDump rcvdRouteDump_;
+  bool dumpRouteViews_{false};
 };
 
 } // namespace openr::fbnl
@@ -0,0 +1,420 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+#include <folly/hash/Hash.h>
+
+#include <openr/nl/NetlinkRouteMessage.h>
+#include <openr/nl/NetlinkRouteView.h>
+
+namespace openr::fbnl {
+
+namespace {
+
+uint32_t
+decodeLabel(const struct mpls_label& label) {
+  return ntohl(label.entry) >> kLabelShift;
+}
+
+} // namespace
+
+RouteView::RouteView(const struct nlmsghdr* nlmsg)
+    : nlmsg_(nlmsg),
+      rtm_(reinterpret_cast<const struct rtmsg*>(NLMSG_DATA(nlmsg))),
+      table_(rtm_->rtm_table) {
+  const struct rtattr* routeAttr;
+  auto routeAttrLen = RTM_PAYLOAD(nlmsg);
+  // index all route attributes
+  for (routeAttr = RTM_RTA(rtm_); RTA_OK(routeAttr, routeAttrLen);
+       routeAttr = RTA_NEXT(routeAttr, routeAttrLen)) {
+    switch (routeAttr->rta_type) {
+    case RTA_DST: {
+      dst_ = routeAttr;
+    } break;
+
+    case RTA_PRIORITY: {
+      priority_ = *(reinterpret_cast<const uint32_t*> RTA_DATA(routeAttr));
+    } break;
+
+    // 32bit Routing table ID; if set, rtm_table is ignored
+    case RTA_TABLE: {
+      table_ = *(reinterpret_cast<const uint32_t*> RTA_DATA(routeAttr));
+    } break;
+
+    case RTA_MULTIPATH: {
+      multipath_ = routeAttr;
+    } break;
+
+    // Nexthop attributes
+    case RTA_GATEWAY:
+    case RTA_OIF:
+    case RTA_VIA:
+    case RTA_ENCAP:
+    case RTA_NEWDST: {
+      indexNextHopAttribute(routeAttr, nexthop_);
+    } break;
+    }
+  }
+}
+
+void
+RouteView::indexNextHopAttribute(
+    const struct rtattr* routeAttr, NextHopAttrs& attrs) {
+  switch (routeAttr->rta_type) {
+  case RTA_GATEWAY:
+  case RTA_VIA: {
+    attrs.gateway = routeAttr;
+  } break;
+
+  case RTA_OIF: {
+    attrs.ifIndex = *(reinterpret_cast<const int*> RTA_DATA(routeAttr));
+  } break;
+
+  case RTA_ENCAP: {
+    attrs.encap = routeAttr;
+  } break;
+
+  case RTA_NEWDST: {
+    attrs.newDst = routeAttr;
+  } break;
+  }
+}
+
+folly::CIDRNetwork
+RouteView::getDestination() const {
+  const auto family = getFamily();
+  if (family != AF_INET && family != AF_INET6) {
+    return {};
+  }
+  if (dst_ == nullptr) {
+    // Default route might be missing RTA_DST attribute
+    if (rtm_->rtm_dst_len != 0) {
+      return {};
+    }
+    return family == AF_INET
+        ? folly::CIDRNetwork{folly::IPAddressV4("0.0.0.0"), 0}
+        : folly::CIDRNetwork{folly::IPAddressV6("::"), 0};
+  }
+  const auto* data = reinterpret_cast<const uint8_t*> RTA_DATA(dst_);
+  if (family == AF_INET) {
+    return {
+        folly::IPAddressV4::fromBinary(folly::ByteRange(data, 4)),
+        rtm_->rtm_dst_len};
+  }
+  return {
+      folly::IPAddressV6::fromBinary(folly::ByteRange(data, 16)),
+      rtm_->rtm_dst_len};
+}
+
+std::optional<uint32_t>
+RouteView::getMplsLabel() const {
+  if (getFamily() != AF_MPLS || dst_ == nullptr) {
+    return std::nullopt;
+  }
+  return decodeLabel(
+      *(reinterpret_cast<const struct mpls_label*> RTA_DATA(dst_)));
+}
+
+size_t
+RouteView::hash() const {
+  std::string_view key;
+  if (dst_ != nullptr) {
+    key = std::string_view(
+        reinterpret_cast<const char*> RTA_DATA(dst_), RTA_PAYLOAD(dst_));
+  }
+  return folly::hash::hash_combine(
+      getFamily(), rtm_->rtm_dst_len, std::hash<std::string_view>()(key));
+}
+
+void
+RouteView::forEachNextHop(
+    folly::FunctionRef<bool(const NextHopAttrs&)> visitor) const {
+  if (multipath_ == nullptr) {
+    // don't report empty nexthop
+    if (!getGatewayBytes(nexthop_).empty() || nexthop_.ifIndex.has_value()) {
+      visitor(nexthop_);
+    }
+    return;
+  }
+
+  const struct rtnexthop* nh =
+      reinterpret_cast<const struct rtnexthop*> RTA_DATA(multipath_);
+  int nhLen = RTA_PAYLOAD(multipath_);
+  while (RTNH_OK(nh, nhLen)) {
+    NextHopAttrs attrs;
+    attrs.ifIndex = nh->rtnh_ifindex;
+    // Set the next-hop weight if available
+    if (getFamily() != AF_MPLS) {
+      attrs.weight = nh->rtnh_hops + 1;
+    }
+    const struct rtattr* routeAttr;
+    auto routeAttrLen = nh->rtnh_len - sizeof(*nh);
+    for (routeAttr = RTNH_DATA(nh); RTA_OK(routeAttr, routeAttrLen);
+         routeAttr = RTA_NEXT(routeAttr, routeAttrLen)) {
+      indexNextHopAttribute(routeAttr, attrs);
+    }
+    if (!visitor(attrs)) {
+      return;
+    }
+    nhLen -= NLMSG_ALIGN(nh->rtnh_len);
+    nh = RTNH_NEXT(nh);
+  }
+}
+
+size_t
+RouteView::getNumNextHops() const {
+  size_t numNextHops{0};
+  forEachNextHop([&numNextHops](const NextHopAttrs&) {
+    ++numNextHops;
+    return true;
+  });
+  return numNextHops;
+}
+
+folly::ByteRange
+RouteView::getGatewayBytes(const NextHopAttrs& attrs) const {
+  if (attrs.gateway == nullptr) {
+    return {};
+  }
+  const auto* data = reinterpret_cast<const uint8_t*> RTA_DATA(attrs.gateway);
+  if (attrs.gateway->rta_type == RTA_VIA) {
+    // via nexthop used for MPLS PHP or SWAP. Address follows the family.
+    data += sizeof(uint16_t);
+    return folly::ByteRange(data, attrs.gateway->rta_len > 16 ? 16 : 4);
+  }
+  switch (getFamily()) {
+  case AF_INET:
+    return folly::ByteRange(data, 4);
+  case AF_INET6:
+    return folly::ByteRange(data, 16);
+  default:
+    return {};
+  }
+}
+
+std::optional<folly::Range<const struct mpls_label*>>
+RouteView::getPushLabels(const NextHopAttrs& attrs) {
+  if (attrs.encap == nullptr) {
+    return std::nullopt;
+  }
+  const struct rtattr* mplsAttr =
+      reinterpret_cast<const struct rtattr*> RTA_DATA(attrs.encap);
+  int mplsAttrLen = RTA_PAYLOAD(attrs.encap);
+  for (; RTA_OK(mplsAttr, mplsAttrLen);
+       mplsAttr = RTA_NEXT(mplsAttr, mplsAttrLen)) {
+    if (mplsAttr->rta_type == MPLS_IPTUNNEL_DST) {
+      const auto* labels =
+          reinterpret_cast<const struct mpls_label*> RTA_DATA(mplsAttr);
+      // each mpls label entry is 32 bits (20 bit label, and other fields)
+      return folly::Range<const struct mpls_label*>(
+          labels, RTA_PAYLOAD(mplsAttr) / sizeof(struct mpls_label));
+    }
+  }
+  return std::nullopt;
+}
+
+bool
+RouteView::nextHopEquals(const NextHopAttrs& attrs, const NextHop& nh) const {
+  if (attrs.ifIndex != nh.getIfIndex()) {
+    return false;
+  }
+  if (std::max(attrs.weight, uint8_t(1)) !=
+      std::max(nh.getWeight(), uint8_t(1))) {
+    return false;
+  }
+
+  // Gateway (also determines next-hop family)
+  const auto gateway = getGatewayBytes(attrs);
+  const auto& nhGateway = nh.getGateway();
+  if (gateway.empty() != !nhGateway.has_value()) {
+    return false;
+  }
+  if (nhGateway.has_value() &&
+      (nhGateway->byteCount() != gateway.size() ||
+       std::memcmp(nhGateway->bytes(), gateway.data(), gateway.size()))) {
+    return false;
+  }
+
+  // Push labels. NOTE: Labels on the wire are in reverse order of thrift API
+  // definition
+  const auto pushLabels = getPushLabels(attrs);
+  const auto& nhPushLabels = nh.getPushLabels();
+  const bool hasPushLabels = pushLabels.has_value();
+  if (hasPushLabels != nhPushLabels.has_value()) {
+    return false;
+  }
+  if (hasPushLabels) {
+    if (pushLabels->size() != nhPushLabels->size()) {
+      return false;
+    }
+    for (size_t i = 0; i < pushLabels->size(); ++i) {
+      const auto& label = (*pushLabels)[pushLabels->size() - 1 - i];
+      if (nhPushLabels->at(i) != static_cast<int32_t>(decodeLabel(label))) {
+        return false;
+      }
+    }
+  }
+
+  // Swap label
+  std::optional<uint32_t> swapLabel;
+  if (attrs.newDst != nullptr) {
+    swapLabel = decodeLabel(
+        *(reinterpret_cast<const struct mpls_label*> RTA_DATA(attrs.newDst)));
+  }
+  if (swapLabel != nh.getSwapLabel()) {
+    return false;
+  }
+
+  // Inferring MPLS action from nexthop fields, same as parser
+  std::optional<thrift::MplsActionCode> labelAction;
+  if (hasPushLabels) {
+    labelAction = thrift::MplsActionCode::PUSH;
+  } else if (getFamily() == AF_MPLS) {
+    if (!gateway.empty()) {
+      labelAction = swapLabel.has_value() ? thrift::MplsActionCode::SWAP
+                                          : thrift::MplsActionCode::PHP;
+    } else {
+      labelAction = thrift::MplsActionCode::POP_AND_LOOKUP;
+    }
+  }
+  return labelAction == nh.getLabelAction();
+}
+
+NextHop
+RouteView::toNextHop(const NextHopAttrs& attrs) const {
+  NextHopBuilder nhBuilder;
+  if (attrs.ifIndex.has_value()) {
+    nhBuilder.setIfIndex(attrs.ifIndex.value());
+  }
+  const auto gateway = getGatewayBytes(attrs);
+  if (gateway.size() == 4) {
+    nhBuilder.setGateway(folly::IPAddressV4::fromBinary(gateway));
+  } else if (gateway.size() == 16) {
+    nhBuilder.setGateway(folly::IPAddressV6::fromBinary(gateway));
+  }
+  const auto pushLabels = getPushLabels(attrs);
+  if (pushLabels.has_value()) {
+    // Reverse the push labels because of thrift API definition
+    std::vector<int32_t> labels;
+    labels.reserve(pushLabels->size());
+    for (auto it = pushLabels->rbegin(); it != pushLabels->rend(); ++it) {
+      labels.emplace_back(decodeLabel(*it));
+    }
+    nhBuilder.setPushLabels(labels);
+  }
+  if (attrs.newDst != nullptr) {
+    nhBuilder.setSwapLabel(decodeLabel(
+        *(reinterpret_cast<const struct mpls_label*> RTA_DATA(attrs.newDst))));
+  }
+  if (attrs.weight) {
+    nhBuilder.setWeight(attrs.weight);
+  }
+
+  // Inferring MPLS action from nexthop fields, same as parser
+  if (nhBuilder.getPushLabels().has_value()) {
+    nhBuilder.setLabelAction(thrift::MplsActionCode::PUSH);
+  } else if (getFamily() == AF_MPLS) {
+    if (nhBuilder.getGateway().has_value()) {
+      nhBuilder.setLabelAction(
+          nhBuilder.getSwapLabel().has_value() ? thrift::MplsActionCode::SWAP
+                                               : thrift::MplsActionCode::PHP);
+    } else {
+      nhBuilder.setLabelAction(thrift::MplsActionCode::POP_AND_LOOKUP);
+    }
+  }
+  return nhBuilder.build();
+}
+
+NextHopSet
+RouteView::getNextHops() const {
+  NextHopSet nextHops;
+  forEachNextHop([this, &nextHops](const NextHopAttrs& attrs) {
+    nextHops.emplace(toNextHop(attrs));
+    return true;
+  });
+  return nextHops;
+}
+
+Route
+RouteView::toRoute() const {
+  auto route = NetlinkRouteMessage::parseMessage(nlmsg_);
+
+  // Reverse the push labels because of thrift API definition
+  NextHopSet reversedMplsLabelNhs;
+  bool reverted = false;
+  for (auto nh : route.getNextHops()) {
+    auto pushLabels = nh.getPushLabels();
+    if (pushLabels.has_value()) {
+      reverted = true;
+      std::reverse(pushLabels.value().begin(), pushLabels.value().end());
+      nh.setPushLabels(pushLabels.value());
+    }
+    reversedMplsLabelNhs.insert(nh);
+  }
+  if (reverted) {
+    route.setNextHops(reversedMplsLabelNhs);
+  }
+  return route;
+}
+
+bool
+operator==(const RouteView& lhs, const Route& rhs) {
+  // Attributes never set by the parser
+  if (rhs.getTos().has_value() || rhs.getMtu().has_value() ||
+      rhs.getAdvMss().has_value() || rhs.getOIf().has_value()) {
+    return false;
+  }
+
+  const auto mplsLabel = lhs.getMplsLabel();
+  const auto dst = lhs.getDestination();
+  const uint8_t family = mplsLabel.has_value() ? AF_MPLS : dst.first.family();
+  if (family != rhs.getFamily() || mplsLabel != rhs.getMplsLabel() ||
+      dst != rhs.getDestination() || lhs.getType() != rhs.getType() ||
+      lhs.getRouteTable() != rhs.getRouteTable() ||
+      lhs.getProtocolId() != rhs.getProtocolId() ||
+      lhs.getScope() != rhs.getScope() || lhs.isValid() != rhs.isValid() ||
+      lhs.getFlags() != rhs.getFlags() ||
+      lhs.getPriority() != rhs.getPriority()) {
+    return false;
+  }
+
+  // Verify all nexthops are in each other. NOTE: Next-hop sets are small,
+  // hence a linear lookup is cheaper than hashing (NextHopHash formats
+  // strings).
+  const auto& nextHops = rhs.getNextHops();
+  size_t numNextHops{0};
+  bool found{true};
+  lhs.forEachNextHop([&](const RouteView::NextHopAttrs& attrs) {
+    ++numNextHops;
+    found = std::any_of(
+        nextHops.begin(), nextHops.end(), [&](const NextHop& nh) {
+          return lhs.nextHopEquals(attrs, nh);
+        });
+    return found;
+  });
+  return found && numNextHops == nextHops.size();
+}
+
+void
+RouteDump::append(const struct nlmsghdr* nlmsg) {
+  const size_t offset = data_.size();
+  offsets_.emplace_back(static_cast<uint32_t>(offset));
+  // keep next message aligned
+  data_.resize(offset + NLMSG_ALIGN(nlmsg->nlmsg_len) / sizeof(Word), 0);
+  std::memcpy(data_.data() + offset, nlmsg, nlmsg->nlmsg_len);
+}
+
+RouteView
+RouteDump::operator[](size_t index) const {
+  return RouteView(
+      reinterpret_cast<const struct nlmsghdr*>(data_.data() + offsets_[index]));
+}
+
+} // namespace openr::fbnl
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <folly/Function.h>
+#include <folly/IPAddress.h>
+#include <openr/nl/NetlinkTypes.h>
+
+extern "C" {
+#include <linux/mpls.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+}
+
+namespace openr::fbnl {
+
+/**
+ * Non-owning, read-only view of a route message (RTM_NEWROUTE/RTM_DELROUTE)
+ * in its wire format.
+ *
+ * Materializing `fbnl::Route` for every route of a dump is dominated by
+ * allocations (optional fields, IP addresses, label vectors and a hash-set of
+ * next-hops), while FIB sync only needs to compare dumped routes against the
+ * desired state. RouteView indexes the attributes of the message in a single
+ * pass and answers key, hash and equality queries directly from the wire
+ * encoding. `toRoute()` materializes the route when really needed.
+ *
+ * Semantics match `NetlinkRouteMessage::parseMessage(..)` followed by the
+ * push-label reversal applied to dumped routes, i.e. `view == route` if and
+ * only if `view.toRoute() == route`.
+ *
+ * NOTE: View must not outlive the buffer holding the message.
+ */
+class RouteView final {
+ public:
+  explicit RouteView(const struct nlmsghdr* nlmsg);
+
+  const struct nlmsghdr*
+  getMessagePtr() const {
+    return nlmsg_;
+  }
+
+  // Address family of the message (rtm_family)
+  uint8_t
+  getFamily() const {
+    return rtm_->rtm_family;
+  }
+
+  uint8_t
+  getType() const {
+    return rtm_->rtm_type;
+  }
+
+  uint8_t
+  getProtocolId() const {
+    return rtm_->rtm_protocol;
+  }
+
+  uint8_t
+  getScope() const {
+    return rtm_->rtm_scope;
+  }
+
+  uint32_t
+  getFlags() const {
+    return rtm_->rtm_flags;
+  }
+
+  // RTA_TABLE if present, otherwise rtm_table
+  uint32_t
+  getRouteTable() const {
+    return table_;
+  }
+
+  std::optional<uint32_t>
+  getPriority() const {
+    return priority_;
+  }
+
+  bool
+  isValid() const {
+    return nlmsg_->nlmsg_type == RTM_NEWROUTE;
+  }
+
+  // Destination of unicast route. Default route if RTA_DST is missing.
+  folly::CIDRNetwork getDestination() const;
+
+  // Top label of MPLS route
+  std::optional<uint32_t> getMplsLabel() const;
+
+  // Hash of the route key, i.e. destination prefix or top label
+  size_t hash() const;
+
+  // Number of (non-empty) next-hops
+  size_t getNumNextHops() const;
+
+  // Materialize next-hops or the whole route
+  NextHopSet getNextHops() const;
+  Route toRoute() const;
+
+  // Compare with route without materializing next-hops
+  friend bool operator==(const RouteView& lhs, const Route& rhs);
+
+ private:
+  // Attributes of a single next-hop
+  struct NextHopAttrs {
+    std::optional<int> ifIndex;
+    // RTA_GATEWAY or RTA_VIA, whichever comes last
+    const struct rtattr* gateway{nullptr};
+    const struct rtattr* encap{nullptr};
+    const struct rtattr* newDst{nullptr};
+    uint8_t weight{0};
+  };
+
+  // Invoke `visitor` for every non-empty next-hop, until it returns false
+  void forEachNextHop(
+      folly::FunctionRef<bool(const NextHopAttrs&)> visitor) const;
+
+  // Record next-hop attribute into `attrs`
+  static void indexNextHopAttribute(
+      const struct rtattr* routeAttr, NextHopAttrs& attrs);
+
+  // Decode gateway address. Empty range if missing or unsupported.
+  folly::ByteRange getGatewayBytes(const NextHopAttrs& attrs) const;
+
+  // Label stack of RTA_ENCAP in wire order
+  static std::optional<folly::Range<const struct mpls_label*>> getPushLabels(
+      const NextHopAttrs& attrs);
+
+  // Compare next-hop attributes with next-hop
+  bool nextHopEquals(const NextHopAttrs& attrs, const NextHop& nh) const;
+
+  NextHop toNextHop(const NextHopAttrs& attrs) const;
+
+  const struct nlmsghdr* nlmsg_{nullptr};
+  const struct rtmsg* rtm_{nullptr};
+  const struct rtattr* dst_{nullptr};
+  const struct rtattr* multipath_{nullptr};
+  uint32_t table_{0};
+  std::optional<uint32_t> priority_;
+  // Single next-hop attributes, ignored if RTA_MULTIPATH is present
+  NextHopAttrs nexthop_;
+};
+
+inline bool
+operator!=(const RouteView& lhs, const Route& rhs) {
+  return !(lhs == rhs);
+}
+
+/**
+ * Route messages received in response to a route dump, stored back to back in
+ * their wire format. Each message is copied once from the receive buffer and
+ * accessed through `RouteView`.
+ */
+class RouteDump final {
+ public:
+  class const_iterator {
+   public:
+    const_iterator(const RouteDump* dump, size_t index)
+        : dump_(dump), index_(index) {}
+
+    RouteView
+    operator*() const {
+      return (*dump_)[index_];
+    }
+
+    const_iterator&
+    operator++() {
+      ++index_;
+      return *this;
+    }
+
+    bool
+    operator==(const const_iterator& other) const {
+      return index_ == other.index_;
+    }
+
+    bool
+    operator!=(const const_iterator& other) const {
+      return index_ != other.index_;
+    }
+
+   private:
+    const RouteDump* dump_{nullptr};
+    size_t index_{0};
+  };
+
+  // Copy route message into the dump
+  void append(const struct nlmsghdr* nlmsg);
+
+  RouteView operator[](size_t index) const;
+
+  size_t
+  size() const {
+    return offsets_.size();
+  }
+
+  bool
+  empty() const {
+    return offsets_.empty();
+  }
+
+  // Total size of stored messages in bytes
+  size_t
+  getNumBytes() const {
+    return data_.size() * sizeof(Word);
+  }
+
+  const_iterator
+  begin() const {
+    return const_iterator(this, 0);
+  }
+
+  const_iterator
+  end() const {
+    return const_iterator(this, size());
+  }
+
+ private:
+  // Storage unit of messages. Guarantees alignment of message headers.
+  using Word = uint32_t;
+  static_assert(NLMSG_ALIGNTO == sizeof(Word));
+
+  // NLMSG_ALIGN'ed messages
+  std::vector<Word> data_;
+  // Offset of each message in `data_`, in words
+  std::vector<uint32_t> offsets_;
+};
+
+} // namespace openr::fbnl
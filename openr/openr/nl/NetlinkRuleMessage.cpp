@@ -53,10 +53,6 @@ NetlinkRuleMessage::init(int type) {
     msghdr_->nlmsg_flags |= NLM_F_CREATE;
     msghdr_->nlmsg_flags |= NLM_F_REPLACE;
   }
-
-  // intialize the rule message header
-  auto nlmsgAlen = NLMSG_ALIGN(sizeof(struct nlmsghdr));
-  rulehdr_ = reinterpret_cast<struct fib_rule_hdr*>((char*)msghdr_ + nlmsgAlen);
 }
 
 Rule
@@ -113,9 +109,9 @@ NetlinkRuleMessage::addRuleAttributes(const Rule& rule) {
 
   const uint32_t table = rule.getTable();
   // set rulehdr fields
-  rulehdr_->table = table < 256 ? table : RT_TABLE_COMPAT;
-  rulehdr_->action = rule.getAction();
-  rulehdr_->family = rule.getFamily();
+  getRuleHdr()->table = table < 256 ? table : RT_TABLE_COMPAT;
+  getRuleHdr()->action = rule.getAction();
+  getRuleHdr()->family = rule.getFamily();
 
   // add attributes
   if ((status = addAttributes(
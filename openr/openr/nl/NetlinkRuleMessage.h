@@ -75,7 +75,10 @@ class NetlinkRuleMessage final : public NetlinkMessageBase {
 
   //     __u32 flags;
   //   };
-  struct fib_rule_hdr* rulehdr_{nullptr};
+  struct fib_rule_hdr*
+  getRuleHdr() const {
+    return reinterpret_cast<struct fib_rule_hdr*>(NLMSG_DATA(msghdr_));
+  }
 
   // promise to be fulfilled when receiving kernel reply
   folly::Promise<folly::Expected<std::vector<Rule>, int>> rulePromise_;
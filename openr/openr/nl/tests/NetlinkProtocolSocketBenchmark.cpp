@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <sched.h>
+#include <unistd.h>
+#include <thread>
+
+#include <folly/Benchmark.h>
+#include <folly/IPAddress.h>
+#include <folly/Subprocess.h>
+#include <folly/init/Init.h>
+#include <folly/io/async/EventBase.h>
+#include <folly/system/Shell.h>
+
+#include <openr/nl/NetlinkProtocolSocket.h>
+
+using namespace folly::literals::shell_literals;
+
+namespace {
+// Dummy interface routes are programmed on
+const std::string kIfName{"dummyBench"};
+const folly::IPAddress kIfAddr{"fc00:bench::1"};
+const folly::IPAddress kNexthop{"fc00:bench::2"};
+// Protocol and table of programmed routes
+const uint8_t kRouteProtoId{99};
+const uint8_t kRouteTableId{99};
+// Number of route add/delete requests in flight
+const size_t kRouteBatchSize{10000};
+} // namespace
+
+namespace openr::fbnl {
+
+void
+runCmd(std::vector<std::string> cmd) {
+  folly::Subprocess proc(std::move(cmd));
+  CHECK_EQ(0, proc.wait().exitStatus());
+}
+
+/**
+ * Wrapper for running netlink socket and creating dummy interface.
+ * NOTE: Expected to be run in dedicated network namespace (see `main`)
+ */
+class NetlinkSocketWrapper {
+ public:
+  NetlinkSocketWrapper() {
+    runCmd("ip link add {} type dummy"_shellify(kIfName.c_str()));
+    runCmd("ip link set dev {} up"_shellify(kIfName.c_str()));
+    runCmd("ip -6 addr add {}/64 dev {} nodad"_shellify(
+        kIfAddr.str().c_str(), kIfName.c_str()));
+
+    nlSock = std::make_unique<NetlinkProtocolSocket>(&evb, eventsQueue);
+    evbThread = std::thread([this]() { evb.loopForever(); });
+    evb.waitUntilRunning();
+
+    for (const auto& link : nlSock->getAllLinks().get().value()) {
+      if (link.getLinkName() == kIfName) {
+        ifIndex = link.getIfIndex();
+      }
+    }
+    CHECK_NE(0, ifIndex);
+  }
+
+  ~NetlinkSocketWrapper() {
+    evb.runInEventBaseThreadAndWait([this]() { nlSock.reset(); });
+    evb.terminateLoopSoon();
+    evbThread.join();
+    eventsQueue.close();
+    runCmd("ip link del {}"_shellify(kIfName.c_str()));
+  }
+
+  // Program `numOfRoutes` routes, or delete them
+  void
+  programRoutes(size_t numOfRoutes, bool add) {
+    std::vector<folly::SemiFuture<int>> futures;
+    for (size_t i = 0; i < numOfRoutes; ++i) {
+      auto prefix = folly::IPAddress::createNetwork(
+          fmt::format("fc01:{:x}:{:x}::/64", i >> 16, i & 0xffff));
+      RouteBuilder builder;
+      builder.setDestination(prefix)
+          .setProtocolId(kRouteProtoId)
+          .setRouteTable(kRouteTableId);
+      NextHopBuilder nhBuilder;
+      nhBuilder.setGateway(kNexthop).setIfIndex(ifIndex);
+      builder.addNextHop(nhBuilder.build());
+      futures.emplace_back(
+          add ? nlSock->addRoute(builder.build())
+              : nlSock->deleteRoute(builder.build()));
+      if (futures.size() >= kRouteBatchSize) {
+        NetlinkProtocolSocket::collectReturnStatus(std::move(futures)).get();
+        futures.clear();
+      }
+    }
+    NetlinkProtocolSocket::collectReturnStatus(std::move(futures)).get();
+  }
+
+  folly::EventBase evb;
+  std::thread evbThread;
+  messaging::ReplicateQueue<NetlinkEvent> eventsQueue;
+  std::unique_ptr<NetlinkProtocolSocket> nlSock;
+  int ifIndex{0};
+};
+
+/**
+ * Benchmark full table dump of routes from kernel
+ * 1. Program `numOfRoutes` routes in dedicated table
+ * 2. Dump all routes of table
+ * 3. Delete programmed routes
+ */
+void
+BM_NetlinkDumpRoutes(uint32_t iters, size_t numOfRoutes) {
+  auto suspender = folly::BenchmarkSuspender();
+  auto wrapper = std::make_unique<NetlinkSocketWrapper>();
+  wrapper->programRoutes(numOfRoutes, true /* add */);
+
+  suspender.dismiss(); // Start measuring benchmark time
+  for (uint32_t i = 0; i < iters; ++i) {
+    auto routes =
+        wrapper->nlSock->getIPv6Routes(kRouteProtoId, kRouteTableId)
+            .get()
+            .value();
+    CHECK_EQ(numOfRoutes, routes.size());
+  }
+  suspender.rehire(); // Stop measuring time again
+
+  wrapper->programRoutes(numOfRoutes, false /* add */);
+}
+
+BENCHMARK_NAMED_PARAM(BM_NetlinkDumpRoutes, 10k, 10000);
+BENCHMARK_NAMED_PARAM(BM_NetlinkDumpRoutes, 100k, 100000);
+BENCHMARK_NAMED_PARAM(BM_NetlinkDumpRoutes, 1M, 1000000);
+
+} // namespace openr::fbnl
+
+int
+main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  if (getuid()) {
+    LOG(ERROR) << "Must run this benchmark as root";
+    return 1;
+  }
+  // Run in dedicated network namespace to not disturb routes of host
+  PCHECK(unshare(CLONE_NEWNET) == 0) << "Failed to create network namespace";
+  folly::runBenchmarks();
+  return 0;
+}
@@ -1318,8 +1318,10 @@ TEST_F(NlMessageFixture, IpRouteMultipleLabelNextHops) {
 }
 
 TEST_F(NlMessageFixture, MaxPayloadExceeded) {
-  // check for max payload handling. Add nexthops that exceeds payload size
-  // Should error out
+  // check for max payload handling. Add nexthops that exceeds maximum size of
+  // RTA_MULTIPATH attribute (message buffer grows up to it). A PHP nexthop
+  // takes about 32 bytes, hence 4096 of them exceed the 64KB attribute
+  // length. Encoding fails with ENOBUFS before the route reaches the kernel.
 
   std::vector<NextHop> paths;
   struct v6Addr addr6 {
@@ -1327,7 +1329,7 @@ TEST_F(NlMessageFixture, MaxPayloadExceeded) {
       { 0 }
     }
   };
-  for (uint32_t i = 0; i < 200; i++) {
+  for (uint32_t i = 0; i < 4096; i++) {
     addr6.u32_addr[0] = htonl(0xfe800000 + i);
     folly::IPAddress ipAddress = folly::IPAddress::fromBinary(folly::ByteRange(
         static_cast<const unsigned char*>(&addr6.u8_addr[0]), 16));
@@ -5,8 +5,12 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <openr/nl/NetlinkMessageBuffer.h>
+#include <openr/nl/NetlinkRouteMessage.h>
+#include <openr/nl/NetlinkRouteView.h>
 #include <openr/nl/NetlinkTypes.h>
 
+#include <fmt/format.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
 
@@ -654,6 +658,228 @@ TEST(NetlinkTypes, RuleTypeBaseTest) {
   EXPECT_EQ(priority, rule.getPriority());
 }
 
+TEST(NetlinkMessageBuffer, GrowAndReuseTest) {
+  auto statsBefore = NetlinkMessageBuffer::getPoolStats();
+  {
+    NetlinkMessageBuffer buffer;
+    EXPECT_EQ(kMaxNlPayloadSize, buffer.size());
+    EXPECT_EQ(0, buffer.data()[kMaxNlPayloadSize - 1]);
+
+    // Grow beyond default size. Content is preserved and new bytes are zero
+    buffer.data()[0] = 'a';
+    EXPECT_TRUE(buffer.resize(3 * kMaxNlPayloadSize));
+    EXPECT_EQ(3 * kMaxNlPayloadSize, buffer.size());
+    EXPECT_EQ('a', buffer.data()[0]);
+    EXPECT_EQ(0, buffer.data()[3 * kMaxNlPayloadSize - 1]);
+
+    // Can't grow beyond max size
+    EXPECT_FALSE(buffer.resize(kMaxNlMessageSize + 1));
+  }
+
+  // Released buffers are served from pool
+  auto statsAfterGrow = NetlinkMessageBuffer::getPoolStats();
+  {
+    NetlinkMessageBuffer buffer;
+    EXPECT_EQ(0, buffer.data()[0]);
+  }
+  auto statsAfterReuse = NetlinkMessageBuffer::getPoolStats();
+  EXPECT_LE(statsBefore.allocations, statsAfterGrow.allocations);
+  EXPECT_EQ(statsAfterGrow.allocations, statsAfterReuse.allocations);
+  EXPECT_EQ(statsAfterGrow.reuses + 1, statsAfterReuse.reuses);
+}
+
+TEST(NetlinkMessageBuffer, WideEcmpRouteTest) {
+  // Route with 256 next-hops doesn't fit in default message buffer
+  RouteBuilder builder;
+  builder.setDestination(folly::IPAddress::createNetwork("fc00::/64"))
+      .setProtocolId(kProtocolId);
+  for (uint32_t i = 0; i < 256; ++i) {
+    NextHopBuilder nhBuilder;
+    nhBuilder.setIfIndex(kIfIndex).setGateway(
+        folly::IPAddress(fmt::format("fe80::{:x}", i + 1)));
+    builder.addNextHop(nhBuilder.build());
+  }
+  auto route = builder.build();
+
+  NetlinkRouteMessage msg;
+  EXPECT_EQ(0, msg.addRoute(route));
+  EXPECT_LT(kMaxNlPayloadSize, msg.getDataLength());
+  EXPECT_EQ(RTM_NEWROUTE, msg.getMessageType());
+  msg.setReturnStatus(0);
+}
+
+TEST(NetlinkMessageBuffer, MaxPayloadExceededTest) {
+  // Encoding of 4096 PHP next-hops exceeds the 16-bit length of the
+  // RTA_MULTIPATH attribute. It fails before reaching the kernel.
+  RouteBuilder builder;
+  builder.setMplsLabel(100).setProtocolId(kProtocolId);
+  for (uint32_t i = 0; i < 4096; ++i) {
+    NextHopBuilder nhBuilder;
+    nhBuilder.setIfIndex(kIfIndex)
+        .setGateway(folly::IPAddress(fmt::format("fe80::{:x}", i + 1)))
+        .setLabelAction(thrift::MplsActionCode::PHP);
+    builder.addNextHop(nhBuilder.build());
+  }
+  auto route = builder.build();
+
+  NetlinkRouteMessage msg;
+  EXPECT_EQ(ENOBUFS, msg.addLabelRoute(route));
+  msg.setReturnStatus(ENOBUFS);
+}
+
+namespace {
+
+// Route as reported by kernel on dump of programmed route
+Route
+createDumpedRoute(
+    const folly::CIDRNetwork& prefix,
+    size_t numNextHops,
+    std::optional<std::vector<int32_t>> pushLabels = std::nullopt) {
+  RouteBuilder builder;
+  builder.setDestination(prefix)
+      .setProtocolId(kProtocolId)
+      .setPriority(10)
+      .setFlags(0)
+      .setValid(true);
+  for (size_t i = 0; i < numNextHops; ++i) {
+    NextHopBuilder nhBuilder;
+    nhBuilder.setIfIndex(kIfIndex)
+        .setGateway(folly::IPAddress(fmt::format("fe80::{:x}", i + 1)))
+        .setWeight(kWeight);
+    if (pushLabels.has_value()) {
+      nhBuilder.setPushLabels(pushLabels.value())
+          .setLabelAction(thrift::MplsActionCode::PUSH);
+    }
+    builder.addNextHop(nhBuilder.build());
+  }
+  return builder.build();
+}
+
+} // namespace
+
+TEST(RouteView, UnicastRouteTest) {
+  const auto prefix = folly::IPAddress::createNetwork("fc00:cafe::/64");
+  const auto route = createDumpedRoute(prefix, 4);
+
+  NetlinkRouteMessage msg;
+  EXPECT_EQ(0, msg.addRoute(route));
+  const RouteView view(msg.getMessagePtr());
+
+  EXPECT_EQ(AF_INET6, view.getFamily());
+  EXPECT_EQ(prefix, view.getDestination());
+  EXPECT_EQ(std::nullopt, view.getMplsLabel());
+  EXPECT_EQ(kProtocolId, view.getProtocolId());
+  EXPECT_EQ(RT_TABLE_MAIN, view.getRouteTable());
+  EXPECT_EQ(10u, view.getPriority());
+  EXPECT_TRUE(view.isValid());
+  EXPECT_EQ(4, view.getNumNextHops());
+
+  // View compares and materializes same as parser
+  EXPECT_TRUE(view == route);
+  EXPECT_EQ(route, view.toRoute());
+  EXPECT_EQ(route.getNextHops(), view.getNextHops());
+
+  // Differs in next-hops or attributes
+  EXPECT_TRUE(view != createDumpedRoute(prefix, 3));
+  EXPECT_TRUE(view != createDumpedRoute(prefix, 5));
+  EXPECT_TRUE(
+      view !=
+      createDumpedRoute(folly::IPAddress::createNetwork("fc00:cafe::/80"), 4));
+  RouteBuilder builder;
+  builder.setDestination(prefix)
+      .setProtocolId(kProtocolId)
+      .setPriority(20)
+      .setFlags(0)
+      .setValid(true);
+  for (auto const& nh : route.getNextHops()) {
+    builder.addNextHop(nh);
+  }
+  EXPECT_TRUE(view != builder.build());
+
+  msg.setReturnStatus(0);
+}
+
+TEST(RouteView, PushLabelRouteTest) {
+  const auto prefix = folly::IPAddress::createNetwork("fc00:cafe::/64");
+  const auto route = createDumpedRoute(prefix, 2, std::vector<int32_t>{1, 2});
+
+  NetlinkRouteMessage msg;
+  EXPECT_EQ(0, msg.addRoute(route));
+  const RouteView view(msg.getMessagePtr());
+
+  // Labels are reported in thrift API order
+  EXPECT_TRUE(view == route);
+  EXPECT_EQ(route, view.toRoute());
+  for (auto const& nh : view.getNextHops()) {
+    EXPECT_EQ(std::vector<int32_t>({1, 2}), nh.getPushLabels());
+    EXPECT_EQ(thrift::MplsActionCode::PUSH, nh.getLabelAction());
+  }
+  EXPECT_TRUE(
+      view != createDumpedRoute(prefix, 2, std::vector<int32_t>{2, 1}));
+  EXPECT_TRUE(view != createDumpedRoute(prefix, 2));
+
+  msg.setReturnStatus(0);
+}
+
+TEST(RouteView, MplsRouteTest) {
+  RouteBuilder builder;
+  builder.setMplsLabel(100).setProtocolId(kProtocolId).setFlags(0).setValid(
+      true);
+  NextHopBuilder nhBuilder;
+  builder.addNextHop(nhBuilder.setIfIndex(kIfIndex)
+                         .setGateway(folly::IPAddress("fe80::1"))
+                         .setSwapLabel(200)
+                         .setLabelAction(thrift::MplsActionCode::SWAP)
+                         .build());
+  nhBuilder.reset();
+  builder.addNextHop(nhBuilder.setIfIndex(kIfIndex)
+                         .setGateway(folly::IPAddress("fe80::2"))
+                         .setLabelAction(thrift::MplsActionCode::PHP)
+                         .build());
+  const auto route = builder.build();
+
+  NetlinkRouteMessage msg;
+  EXPECT_EQ(0, msg.addLabelRoute(route));
+  const RouteView view(msg.getMessagePtr());
+
+  EXPECT_EQ(AF_MPLS, view.getFamily());
+  EXPECT_EQ(100u, view.getMplsLabel());
+  EXPECT_EQ(2, view.getNumNextHops());
+  EXPECT_TRUE(view == route);
+  EXPECT_EQ(route, view.toRoute());
+
+  msg.setReturnStatus(0);
+}
+
+TEST(RouteDump, AppendAndIterateTest) {
+  RouteDump dump;
+  EXPECT_TRUE(dump.empty());
+
+  std::vector<Route> routes;
+  for (size_t i = 0; i < 100; ++i) {
+    routes.emplace_back(createDumpedRoute(
+        folly::IPAddress::createNetwork(fmt::format("fc00:{:x}::/64", i)),
+        (i % 8) + 1));
+    NetlinkRouteMessage msg;
+    EXPECT_EQ(0, msg.addRoute(routes.back()));
+    dump.append(msg.getMessagePtr());
+    msg.setReturnStatus(0);
+  }
+  EXPECT_EQ(routes.size(), dump.size());
+
+  // Views are independent of receive buffer and in order of receipt
+  size_t i = 0;
+  std::unordered_set<size_t> hashes;
+  for (auto const view : dump) {
+    EXPECT_TRUE(view == routes.at(i));
+    EXPECT_EQ(view.hash(), dump[i].hash());
+    hashes.emplace(view.hash());
+    ++i;
+  }
+  EXPECT_EQ(routes.size(), i);
+  EXPECT_EQ(routes.size(), hashes.size());
+}
+
 int
 main(int argc, char* argv[]) {
   // Parse command line flags
@@ -13,6 +13,7 @@
 #include <glog/logging.h>
 #include <thrift/lib/cpp2/server/ThriftServer.h>
 
+#include <openr/common/Flags.h>
 #include <openr/common/OpenrEventBase.h>
 #include <openr/nl/NetlinkProtocolSocket.h>
 #include <openr/platform/NetlinkFibHandler.h>
@@ -39,7 +40,11 @@ main(int argc, char** argv) {
   openr::messaging::ReplicateQueue<openr::fbnl::NetlinkEvent>
       netlinkEventsQueue;
   auto nlSock = std::make_unique<openr::fbnl::NetlinkProtocolSocket>(
-      nlEvb.get(), netlinkEventsQueue);
+      nlEvb.get(),
+      netlinkEventsQueue,
+      false /* enableIPv6RouteReplaceSemantics */,
+      FLAGS_netlink_rcvbuf_bytes,
+      FLAGS_netlink_max_rcvbuf_bytes);
   allThreads.emplace_back([&nlEvb]() {
     XLOG(INFO) << "Starting NetlinkProtolSocketEvl thread...";
     folly::setThreadName("NetlinkProtolSocketEvl");
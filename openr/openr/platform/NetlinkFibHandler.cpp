@@ -35,6 +35,19 @@ createSemiFutureWithClientIdError() {
   return std::move(sf);
 }
 
+// Compare route in kernel against the desired route
+bool
+isSameRoute(const fbnl::RouteView& existing, const fbnl::Route& desired) {
+  // Linux will report a null next-hop for RTN_BLACKHOLE type while RIB does
+  // not. Materialize (rare) blackhole routes to drop it.
+  if (existing.getType() == RTN_BLACKHOLE) {
+    auto route = existing.toRoute();
+    route.setNextHops({});
+    return route == desired;
+  }
+  return existing == desired;
+}
+
 } // namespace
 
 NetlinkFibHandler::NetlinkFibHandler(
@@ -205,44 +218,42 @@ NetlinkFibHandler::semifuture_syncFib(
   // Create set of existing route
   // NOTE: Synchronous call to retrieve all the routes. We first make both
   // requests to retrieve IPv4 and IPv6 routes. Subsequently we wait on them
-  // to complete and prepare the map of existing routes
-  std::unordered_map<folly::CIDRNetwork, fbnl::Route> existingRoutes;
-  {
-    auto v4Routes = nlSock_->getIPv4Routes(protocol.value(), routeTable_).get();
-    auto v6Routes = nlSock_->getIPv6Routes(protocol.value(), routeTable_).get();
-    if (v4Routes.hasError()) {
-      throw fbnl::NlException("Failed fetching IPv4 routes", v4Routes.error());
-    }
-    if (v6Routes.hasError()) {
-      throw fbnl::NlException("Failed fetching IPv6 routes", v6Routes.error());
-    }
-    for (auto& routesPtr : {&v4Routes, &v6Routes}) {
-      for (auto& route : routesPtr->value()) {
-        const auto prefix = route.getDestination();
-        // Linux will report a null next-hop for RTN_BLACKHOLE type while
-        // RIB does not
-        if (route.getType() == RTN_BLACKHOLE) {
-          route.setNextHops({});
-        }
-        existingRoutes.emplace(prefix, std::move(route));
-      }
+  // to complete and prepare the map of existing routes. Routes are kept in
+  // their wire format and compared against desired routes without being
+  // materialized.
+  auto v4Routes =
+      nlSock_->getIPv4RouteDump(protocol.value(), routeTable_).get();
+  auto v6Routes =
+      nlSock_->getIPv6RouteDump(protocol.value(), routeTable_).get();
+  if (v4Routes.hasError()) {
+    throw fbnl::NlException("Failed fetching IPv4 routes", v4Routes.error());
+  }
+  if (v6Routes.hasError()) {
+    throw fbnl::NlException("Failed fetching IPv6 routes", v6Routes.error());
+  }
+  std::unordered_map<folly::CIDRNetwork, fbnl::RouteView> existingRoutes;
+  existingRoutes.reserve(v4Routes->size() + v6Routes->size());
+  for (auto const* routes : {&v4Routes.value(), &v6Routes.value()}) {
+    for (auto const route : *routes) {
+      existingRoutes.emplace(route.getDestination(), route);
     }
   }
 
   // Go over the new routes. Add or update
   std::unordered_set<folly::CIDRNetwork> newPrefixes;
+  newPrefixes.reserve(unicastRoutes->size());
   for (auto& route : *unicastRoutes) {
     const auto network = toIPNetwork(*route.dest());
     newPrefixes.insert(network);
     auto nlRoute = buildRoute(route, protocol.value());
     auto it = existingRoutes.find(network);
-    if (it != existingRoutes.end() and it->second == nlRoute) {
+    if (it != existingRoutes.end() and isSameRoute(it->second, nlRoute)) {
       // Existing route is same as the one we're trying to add. SKIP
       continue;
     }
     if (it != existingRoutes.end()) {
-      XLOG(INFO) << "Updating unicast-route " << "\n[OLD] " << it->second.str()
-                 << "\n[NEW] " << nlRoute.str();
+      XLOG(INFO) << "Updating unicast-route " << "\n[OLD] "
+                 << it->second.toRoute().str() << "\n[NEW] " << nlRoute.str();
     } else {
       XLOG(INFO) << "Adding unicast-route \n[NEW]" << nlRoute.str();
     }
@@ -259,7 +270,7 @@ NetlinkFibHandler::semifuture_syncFib(
     // Delete stale route
     XLOG(INFO) << "Deleting unicast-route "
                << folly::IPAddress::networkToString(prefix);
-    result.emplace_back(nlSock_->deleteRoute(nlRoute));
+    result.emplace_back(nlSock_->deleteRoute(nlRoute.toRoute()));
   }
 
   // Return collected result
@@ -358,21 +369,21 @@ NetlinkFibHandler::semifuture_getRouteTableByClient(int16_t clientId) {
   CHECK(protocol.has_value());
   XLOG(INFO) << "Get unicast routes for client " << getClientName(clientId);
 
-  auto v4Routes = nlSock_->getIPv4Routes(protocol.value(), routeTable_);
-  auto v6Routes = nlSock_->getIPv6Routes(protocol.value(), routeTable_);
+  auto v4Routes = nlSock_->getIPv4RouteDump(protocol.value(), routeTable_);
+  auto v6Routes = nlSock_->getIPv6RouteDump(protocol.value(), routeTable_);
   return folly::collectAll(std::move(v4Routes), std::move(v6Routes))
       .deferValue(
           [this](std::tuple<
-                 folly::Try<folly::Expected<std::vector<fbnl::Route>, int>>,
-                 folly::Try<folly::Expected<std::vector<fbnl::Route>, int>>>&&
-                     res) {
+                 folly::Try<folly::Expected<fbnl::RouteDump, int>>,
+                 folly::Try<folly::Expected<fbnl::RouteDump, int>>>&& res) {
             auto routes = std::make_unique<std::vector<thrift::UnicastRoute>>();
-            for (auto& nlRoutes : {std::get<0>(res), std::get<1>(res)}) {
-              if (nlRoutes.value().hasError()) {
+            for (auto* nlRoutes : {&std::get<0>(res), &std::get<1>(res)}) {
+              if (nlRoutes->value().hasError()) {
                 throw fbnl::NlException(
-                    "Failed fetching routes", nlRoutes.value().error());
+                    "Failed fetching routes", nlRoutes->value().error());
               }
-              for (auto& nlRoute : nlRoutes.value().value()) {
+              routes->reserve(routes->size() + nlRoutes->value()->size());
+              for (auto const nlRoute : nlRoutes->value().value()) {
                 thrift::UnicastRoute route;
                 route.dest() = toIpPrefix(nlRoute.getDestination());
                 route.nextHops() = toThriftNextHops(nlRoute.getNextHops());
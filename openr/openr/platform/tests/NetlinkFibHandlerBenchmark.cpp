@@ -22,6 +22,8 @@
 #include <folly/system/Shell.h>
 #include <folly/test/TestUtils.h>
 
+#include <openr/common/NetworkUtil.h>
+#include <openr/nl/NetlinkRouteMessage.h>
 #include <openr/platform/NetlinkFibHandler.h>
 #include <openr/tests/mocks/MockNetlinkProtocolSocket.h>
 #include <openr/tests/mocks/PrefixGenerator.h>
@@ -39,6 +41,9 @@ const uint8_t kNumOfNexthops = 128;
 
 const int16_t kFibId{static_cast<int16_t>(openr::thrift::FibClient::OPENR)};
 
+// Protocol id of routes encoded into netlink messages
+const uint8_t kRouteProtoId{99};
+
 } // namespace
 
 namespace openr {
@@ -106,12 +111,189 @@ BM_NetlinkFibHandler(uint32_t iters, size_t numOfPrefixes) {
   }
 }
 
+/**
+ * Create `numOfPrefixes` IPv6 routes with `numOfNexthops` ECMP next-hops, as
+ * reported by kernel on route dump
+ */
+std::vector<Route>
+createRoutes(size_t numOfPrefixes, size_t numOfNexthops) {
+  PrefixGenerator prefixGenerator;
+  const auto prefixes =
+      prefixGenerator.ipv6PrefixGenerator(numOfPrefixes, kBitMaskLen);
+
+  std::vector<NextHop> nexthops;
+  for (size_t i = 0; i < numOfNexthops; ++i) {
+    nexthops.emplace_back(
+        NextHopBuilder()
+            .setIfIndex(1)
+            .setGateway(folly::IPAddress(fmt::format("fe80::{:x}", i + 1)))
+            .build());
+  }
+
+  std::vector<Route> routes;
+  routes.reserve(numOfPrefixes);
+  for (const auto& prefix : prefixes) {
+    RouteBuilder builder;
+    builder.setDestination(toIPNetwork(prefix))
+        .setProtocolId(kRouteProtoId)
+        .setFlags(0)
+        .setValid(true);
+    for (const auto& nexthop : nexthops) {
+      builder.addNextHop(nexthop);
+    }
+    routes.emplace_back(builder.build());
+  }
+  return routes;
+}
+
+/**
+ * Encode routes into route messages in their wire format, i.e. as received
+ * on route dump
+ */
+RouteDump
+createRouteDump(const std::vector<Route>& routes) {
+  RouteDump dump;
+  for (const auto& route : routes) {
+    NetlinkRouteMessage msg;
+    CHECK_EQ(0, msg.addRoute(route));
+    dump.append(msg.getMessagePtr());
+    msg.setReturnStatus(0);
+  }
+  return dump;
+}
+
+/**
+ * Benchmark for encoding routes into netlink messages
+ * 1. Generate routes with `numOfNexthops` ECMP next-hops
+ * 2. Encode all routes into route messages, i.e. messages queued for sending
+ * 3. Complete and release all messages
+ *
+ * Reports number of message buffers obtained from allocator and served from
+ * buffer pool per iteration.
+ */
+static void
+BM_NetlinkRouteMessageEncode(
+    folly::UserCounters& counters,
+    uint32_t iters,
+    size_t numOfPrefixes,
+    size_t numOfNexthops) {
+  auto suspender = folly::BenchmarkSuspender();
+  const auto routes = createRoutes(numOfPrefixes, numOfNexthops);
+
+  const auto statsBefore = NetlinkMessageBuffer::getPoolStats();
+  suspender.dismiss(); // Start measuring benchmark time
+
+  for (uint32_t i = 0; i < iters; i++) {
+    std::vector<std::unique_ptr<NetlinkRouteMessage>> msgs;
+    msgs.reserve(routes.size());
+    for (const auto& route : routes) {
+      auto msg = std::make_unique<NetlinkRouteMessage>();
+      CHECK_EQ(0, msg->addRoute(route));
+      msgs.emplace_back(std::move(msg));
+    }
+    for (auto& msg : msgs) {
+      msg->setReturnStatus(0);
+    }
+  }
+
+  suspender.rehire(); // Stop measuring time again
+  const auto statsAfter = NetlinkMessageBuffer::getPoolStats();
+  counters["buffer_allocations"] =
+      (statsAfter.allocations - statsBefore.allocations) / iters;
+  counters["buffer_reuses"] = (statsAfter.reuses - statsBefore.reuses) / iters;
+}
+
+/**
+ * Benchmark for parsing dumped routes into `fbnl::Route`, i.e. the dump path
+ * of `getRoutes(..)`
+ */
+static void
+BM_NetlinkRouteMessageParse(
+    uint32_t iters, size_t numOfPrefixes, size_t numOfNexthops) {
+  auto suspender = folly::BenchmarkSuspender();
+  const auto dump = createRouteDump(createRoutes(numOfPrefixes, numOfNexthops));
+  suspender.dismiss(); // Start measuring benchmark time
+
+  for (uint32_t i = 0; i < iters; i++) {
+    std::vector<Route> routes;
+    routes.reserve(dump.size());
+    for (const auto view : dump) {
+      routes.emplace_back(view.toRoute());
+    }
+    folly::doNotOptimizeAway(routes);
+  }
+}
+
+/**
+ * Benchmark for comparing dumped routes against desired routes via
+ * `RouteView`, i.e. the dump path of FIB sync
+ */
+static void
+BM_NetlinkRouteViewCompare(
+    uint32_t iters, size_t numOfPrefixes, size_t numOfNexthops) {
+  auto suspender = folly::BenchmarkSuspender();
+  const auto routes = createRoutes(numOfPrefixes, numOfNexthops);
+  const auto dump = createRouteDump(routes);
+  suspender.dismiss(); // Start measuring benchmark time
+
+  for (uint32_t i = 0; i < iters; i++) {
+    size_t index{0};
+    for (const auto view : dump) {
+      CHECK(view == routes[index++]);
+    }
+  }
+}
+
+/**
+ * Benchmark for comparing dumped routes against desired routes after
+ * materializing them, i.e. the dump path of FIB sync prior to `RouteView`
+ */
+static void
+BM_NetlinkRouteParseCompare(
+    uint32_t iters, size_t numOfPrefixes, size_t numOfNexthops) {
+  auto suspender = folly::BenchmarkSuspender();
+  const auto routes = createRoutes(numOfPrefixes, numOfNexthops);
+  const auto dump = createRouteDump(routes);
+  suspender.dismiss(); // Start measuring benchmark time
+
+  for (uint32_t i = 0; i < iters; i++) {
+    size_t index{0};
+    for (const auto view : dump) {
+      CHECK(view.toRoute() == routes[index++]);
+    }
+  }
+}
+
 // The parameter is the number of prefixes
 BENCHMARK_PARAM(BM_NetlinkFibHandler, 10);
 BENCHMARK_PARAM(BM_NetlinkFibHandler, 100);
 BENCHMARK_PARAM(BM_NetlinkFibHandler, 1000);
 BENCHMARK_PARAM(BM_NetlinkFibHandler, 10000);
 
+// The parameters are the number of prefixes and next-hops
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_NetlinkRouteMessageEncode, counters, 10k_1, 10000, 1);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_NetlinkRouteMessageEncode, counters, 10k_16, 10000, 16);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_NetlinkRouteMessageEncode, counters, 10k_128, 10000, 128);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_NetlinkRouteMessageEncode, counters, 10k_256, 10000, 256);
+BENCHMARK_COUNTERS_NAME_PARAM(
+    BM_NetlinkRouteMessageEncode, counters, 100k_16, 100000, 16);
+
+// The parameters are the number of prefixes and next-hops
+BENCHMARK_NAMED_PARAM(BM_NetlinkRouteMessageParse, 10k_1, 10000, 1);
+BENCHMARK_NAMED_PARAM(BM_NetlinkRouteMessageParse, 10k_16, 10000, 16);
+BENCHMARK_NAMED_PARAM(BM_NetlinkRouteMessageParse, 100k_16, 100000, 16);
+BENCHMARK_NAMED_PARAM(BM_NetlinkRouteParseCompare, 10k_1, 10000, 1);
+BENCHMARK_RELATIVE_NAMED_PARAM(BM_NetlinkRouteViewCompare, 10k_1, 10000, 1);
+BENCHMARK_NAMED_PARAM(BM_NetlinkRouteParseCompare, 10k_16, 10000, 16);
+BENCHMARK_RELATIVE_NAMED_PARAM(BM_NetlinkRouteViewCompare, 10k_16, 10000, 16);
+BENCHMARK_NAMED_PARAM(BM_NetlinkRouteParseCompare, 100k_16, 100000, 16);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    BM_NetlinkRouteViewCompare, 100k_16, 100000, 16);
+
 } // namespace openr
 
 int
@@ -15,10 +15,12 @@ PolicyManager::PolicyManager(
     const neteng::config::routing_policy::PolicyConfig& config) {}
 PolicyManager::~PolicyManager() = default;
 
-std::pair<std::shared_ptr<thrift::PrefixEntry>, std::string /*policy name*/>
+std::pair<
+    std::shared_ptr<const thrift::PrefixEntry>,
+    std::string /*policy name*/>
 PolicyManager::applyPolicy(
     const std::string& policyStatementName,
-    const std::shared_ptr<thrift::PrefixEntry>& prefixEntry,
+    const std::shared_ptr<const thrift::PrefixEntry>& prefixEntry,
     const std::optional<OpenrPolicyActionData>& policyActionData,
     const std::optional<OpenrPolicyMatchData>& policyMatchData) noexcept {
   return {prefixEntry, "Always Allow"};
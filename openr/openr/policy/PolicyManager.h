@@ -24,10 +24,12 @@ class PolicyManager {
       const neteng::config::routing_policy::PolicyConfig& config);
   ~PolicyManager();
 
-  std::pair<std::shared_ptr<thrift::PrefixEntry>, std::string /*policy name*/>
+  std::pair<
+      std::shared_ptr<const thrift::PrefixEntry>,
+      std::string /*policy name*/>
   applyPolicy(
       const std::string& policyStatementName,
-      const std::shared_ptr<thrift::PrefixEntry>& prefixEntry,
+      const std::shared_ptr<const thrift::PrefixEntry>& prefixEntry,
       const std::optional<OpenrPolicyActionData>& policyActionData =
           std::nullopt,
       const std::optional<OpenrPolicyMatchData>& policyMatchData =
@@ -471,7 +471,7 @@ PrefixManager::addKvStoreKeyHelper(const PrefixEntry& entry) {
     }
 
     // run ingress policy
-    std::shared_ptr<thrift::PrefixEntry> postPolicyTPrefixEntry;
+    std::shared_ptr<const thrift::PrefixEntry> postPolicyTPrefixEntry;
     std::string hitPolicyName;
 
     const auto& policy = areaToPolicy_.at(toArea);
@@ -1126,7 +1126,7 @@ PrefixManager::filterAndAddAreaRoute(
   }
 
   // run policy
-  std::shared_ptr<thrift::PrefixEntry> postPolicyTPrefixEntry;
+  std::shared_ptr<const thrift::PrefixEntry> postPolicyTPrefixEntry;
   std::string hitPolicyName{};
 
   const auto& policy = areaToPolicy_.at(area);
@@ -1466,7 +1466,7 @@ PrefixManager::processOriginatedPrefixes() {
           allAreaIds());
       if (route.originatedPrefix.install_to_fib().has_value() &&
           *route.originatedPrefix.install_to_fib()) {
-        advertisedPrefixes.back().nexthops = route.unicastEntry.nexthops;
+        advertisedPrefixes.back().nexthops = route.unicastEntry.nexthops.get();
       }
       XLOG(INFO) << "[Route Origination] Advertising originated route "
                  << folly::IPAddress::networkToString(network);
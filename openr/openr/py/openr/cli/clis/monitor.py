@@ -18,6 +18,7 @@ class MonitorCli:
         self.monitor.add_command(CountersCli().counters)
         self.monitor.add_command(MonitorLogs().logs)
         self.monitor.add_command(MonitorStatistics().statistics)
+        self.monitor.add_command(MonitorProfile().profile)
 
     @click.group(cls=deduceCommandGroup)
     @click.pass_context
@@ -57,3 +58,16 @@ class MonitorStatistics:
         """Print counters in pretty format"""
 
         monitor.StatisticsCmd(cli_opts).run()
+
+
+class MonitorProfile:
+    @click.command()
+    @click.option("--module", default="", help="Only show the given module")
+    @click.option(
+        "--output", default="", help="Write folded stacks to file for flamegraph.pl"
+    )
+    @click.pass_obj
+    def profile(cli_opts, module, output):  # noqa: B902
+        """Print CPU profile of every module and heap usage"""
+
+        monitor.ProfileCmd(cli_opts).run(module, output)
@@ -15,6 +15,8 @@ from openr.py.openr.cli.utils.options import breeze_option
 class PerfCli(object):
     def __init__(self):
         self.perf.add_command(ViewFibCli().fib)
+        self.perf.add_command(ViewConvergenceCli().convergence)
+        self.perf.add_command(ViewRuntimeCli().runtime)
 
     @click.group()
     @click.pass_context
@@ -30,3 +32,21 @@ class ViewFibCli(object):
         """View latest perf log of fib module from this node"""
 
         perf.ViewFibCmd(cli_opts).run()
+
+
+class ViewConvergenceCli(object):
+    @click.command()
+    @click.pass_obj
+    def convergence(cli_opts):  # noqa: B902
+        """View latency distribution of convergence stages on this node"""
+
+        perf.ViewConvergenceCmd(cli_opts).run()
+
+
+class ViewRuntimeCli(object):
+    @click.command()
+    @click.pass_obj
+    def runtime(cli_opts):  # noqa: B902
+        """View event loop lag and queue latency of every module"""
+
+        perf.ViewRuntimeCmd(cli_opts).run()
@@ -168,3 +168,50 @@ class StatisticsCmd(MonitorCmd):
 
         counters = await client.getCounters()
         self.print_stats(stats_templates, counters)
+
+
+class ProfileCmd(MonitorCmd):
+    async def _run(
+        self,
+        client: OpenrCtrlCppClient.Async,
+        module: str = "",
+        output: str = "",
+        *args,
+        **kwargs,
+    ) -> None:
+        resp = await client.getProcessProfile()
+        modules = [m for m in resp.modules if not module or m.module == module]
+
+        if resp.cpuProfilerHz:
+            print(
+                "CPU profile of {} at {}Hz".format(
+                    resp.thisNodeName, resp.cpuProfilerHz
+                )
+            )
+            rows = []
+            for m in modules:
+                rows.append([m.module, m.numSamples, m.numDroppedSamples])
+            headers = ["Module", "Samples", "Dropped"]
+            print(tabulate.tabulate(rows, headers=headers))
+            print()
+        else:
+            print("CPU profiler is disabled. Enable with --cpu_profiler_hz")
+
+        # Folded stacks rooted at the module, for flamegraph.pl
+        if output:
+            with open(output, "w") as f:
+                for m in modules:
+                    for stack, count in sorted(m.foldedStacks.items()):
+                        f.write("{};{} {}\n".format(m.module, stack, count))
+            print("Wrote folded stacks to {}".format(output))
+
+        heap = resp.heap
+        if heap is not None:
+            rows = [
+                ["Allocated", printing.sprint_bytes(heap.allocatedBytes)],
+                ["Active", printing.sprint_bytes(heap.activeBytes)],
+                ["Resident", printing.sprint_bytes(heap.residentBytes)],
+            ]
+            print(tabulate.tabulate(rows, headers=["Heap", "Bytes"]))
+            for dump_file in heap.dumpFiles:
+                print("Heap profile: {}".format(dump_file))
@@ -37,3 +37,88 @@ class ViewFibCmd(OpenrCtrlCmd):
             print("Perf Event Item: {}, total duration: {}ms".format(i, total_duration))
             print(tabulate.tabulate(rows, headers=headers))
             print()
+
+
+class ViewConvergenceCmd(OpenrCtrlCmd):
+    async def _run(
+        self,
+        client: OpenrCtrlCppClient.Async,
+        *args,
+        **kwargs,
+    ) -> None:
+        resp = await client.getConvergenceStats()
+        headers = ["Stage", "Count", "Min", "Avg", "P50", "P90", "P99", "Max"]
+        rows = []
+        for stage, stats in sorted(resp.stages.items()):
+            rows.append(
+                [
+                    stage,
+                    stats.count,
+                    stats.minMs,
+                    stats.avgMs,
+                    stats.p50Ms,
+                    stats.p90Ms,
+                    stats.p99Ms,
+                    stats.maxMs,
+                ]
+            )
+        print("Convergence latency (ms) of {}".format(resp.thisNodeName))
+        print(tabulate.tabulate(rows, headers=headers))
+        print()
+
+
+class ViewRuntimeCmd(OpenrCtrlCmd):
+    async def _run(
+        self,
+        client: OpenrCtrlCppClient.Async,
+        *args,
+        **kwargs,
+    ) -> None:
+        resp = await client.getRuntimeStats()
+        print("Event loops (us) of {}".format(resp.thisNodeName))
+        headers = [
+            "Module",
+            "Lag P50",
+            "Lag P99",
+            "Lag Max",
+            "Busy P50",
+            "Busy P99",
+            "Busy Max",
+            "Slow Loops",
+            "Pending",
+        ]
+        rows = []
+        for evb in resp.eventBases:
+            rows.append(
+                [
+                    evb.name,
+                    evb.loopLagP50Us,
+                    evb.loopLagP99Us,
+                    evb.loopLagMaxUs,
+                    evb.busyTimeP50Us,
+                    evb.busyTimeP99Us,
+                    evb.busyTimeMaxUs,
+                    evb.numSlowLoops,
+                    evb.notificationQueueSize,
+                ]
+            )
+        print(tabulate.tabulate(rows, headers=headers))
+        print()
+
+        print("Queue latency (us)")
+        headers = ["Queue", "Size", "Reads", "Writes", "P50", "P99", "Max"]
+        rows = []
+        for queue in resp.queues:
+            rows.append(
+                [
+                    queue.name,
+                    queue.size,
+                    queue.reads,
+                    queue.writes,
+                    queue.latencyP50Us,
+                    queue.latencyP99Us,
+                    queue.latencyMaxUs,
+                ]
+            )
+        print(tabulate.tabulate(rows, headers=headers))
+        print()
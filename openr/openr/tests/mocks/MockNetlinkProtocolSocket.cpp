@@ -6,6 +6,7 @@
  */
 
 #include <net/if.h>
+#include <openr/nl/NetlinkRouteMessage.h>
 #include <openr/tests/mocks/MockNetlinkProtocolSocket.h>
 
 #include <fb303/ServiceData.h>
@@ -127,6 +128,27 @@ MockNetlinkProtocolSocket::getRoutes(const fbnl::Route& filter) {
   return result;
 }
 
+folly::SemiFuture<folly::Expected<RouteDump, int>>
+MockNetlinkProtocolSocket::getRouteDump(const fbnl::Route& filter) {
+  auto routes = getRoutes(filter).get();
+  if (routes.hasError()) {
+    return folly::makeUnexpected(routes.error());
+  }
+
+  // Encode routes the same way they're programmed in kernel
+  RouteDump dump;
+  for (auto const& route : routes.value()) {
+    NetlinkRouteMessage msg;
+    const int status = route.getFamily() == AF_MPLS ? msg.addLabelRoute(route)
+                                                    : msg.addRoute(route);
+    msg.setReturnStatus(status);
+    if (status == 0) {
+      dump.append(msg.getMessagePtr());
+    }
+  }
+  return dump;
+}
+
 folly::SemiFuture<int>
 MockNetlinkProtocolSocket::addIfAddress(const fbnl::IfAddress& addr) {
   // Search for addr list of interface index (it must exists)
@@ -54,6 +54,8 @@ class MockNetlinkProtocolSocket : public NetlinkProtocolSocket {
   folly::SemiFuture<int> deleteRoute(const fbnl::Route& route) override;
   folly::SemiFuture<folly::Expected<std::vector<fbnl::Route>, int>> getRoutes(
       const fbnl::Route& filter) override;
+  folly::SemiFuture<folly::Expected<RouteDump, int>> getRouteDump(
+      const fbnl::Route& filter) override;
 
   folly::SemiFuture<int> addIfAddress(const fbnl::IfAddress&) override;
   folly::SemiFuture<int> deleteIfAddress(const fbnl::IfAddress&) override;
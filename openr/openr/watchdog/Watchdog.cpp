@@ -59,6 +59,75 @@ Watchdog::addQueue(messaging::ReplicateQueueBase& q, const std::string& qName) {
   }
 }
 
+folly::SemiFuture<std::unique_ptr<thrift::RuntimeStats>>
+Watchdog::getRuntimeStats() {
+  folly::Promise<std::unique_ptr<thrift::RuntimeStats>> p;
+  auto sf = p.getSemiFuture();
+  runInEventBaseThread([p = std::move(p), this]() mutable {
+    auto stats = std::make_unique<thrift::RuntimeStats>();
+    stats->thisNodeName() = myNodeName_;
+    stats->eventBases() = getEventBaseStats();
+    stats->queues() = getQueueLatencyStats();
+    p.setValue(std::move(stats));
+  });
+  return sf;
+}
+
+std::vector<thrift::EventBaseStats>
+Watchdog::getEventBaseStats() const {
+  std::vector<thrift::EventBaseStats> eventBases;
+  for (auto const& evb : monitorEvbs_) {
+    const auto loopStats = evb->getLoopStats();
+    thrift::EventBaseStats stats;
+    stats.name() = evb->getEvbName();
+    stats.loopLagP50Us() = loopStats.loopLagUs.getPercentile(50);
+    stats.loopLagP99Us() = loopStats.loopLagUs.getPercentile(99);
+    stats.loopLagMaxUs() = loopStats.loopLagUs.getMax();
+    stats.busyTimeP50Us() = loopStats.busyTimeUs.getPercentile(50);
+    stats.busyTimeP99Us() = loopStats.busyTimeUs.getPercentile(99);
+    stats.busyTimeMaxUs() = loopStats.busyTimeUs.getMax();
+    stats.numSlowLoops() = loopStats.numSlowLoops;
+    for (auto const& slowLoop : loopStats.slowLoops) {
+      thrift::SlowLoop entry;
+      entry.unixTs() = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           slowLoop.timestamp.time_since_epoch())
+                           .count();
+      entry.busyTimeUs() = slowLoop.busyTime.count();
+      stats.slowLoops()->emplace_back(std::move(entry));
+    }
+    stats.notificationQueueSize() = evb->getEvb()->getNotificationQueueSize();
+    eventBases.emplace_back(std::move(stats));
+  }
+  // Stable order for readers
+  std::sort(
+      eventBases.begin(), eventBases.end(), [](auto const& a, auto const& b) {
+        return *a.name() < *b.name();
+      });
+  return eventBases;
+}
+
+std::vector<thrift::QueueLatencyStats>
+Watchdog::getQueueLatencyStats() const {
+  std::vector<thrift::QueueLatencyStats> queues;
+  for (auto const& [qName, q] : monitoredQs_) {
+    for (auto const& stat : q.get().getReplicationStats()) {
+      thrift::QueueLatencyStats stats;
+      stats.name() = fmt::format("{}-{}", qName, stat.queueId);
+      stats.size() = stat.size;
+      stats.reads() = stat.reads;
+      stats.writes() = stat.writes;
+      stats.latencyP50Us() = stat.latencyP50Us;
+      stats.latencyP99Us() = stat.latencyP99Us;
+      stats.latencyMaxUs() = stat.latencyMaxUs;
+      queues.emplace_back(std::move(stats));
+    }
+  }
+  std::sort(queues.begin(), queues.end(), [](auto const& a, auto const& b) {
+    return *a.name() < *b.name();
+  });
+  return queues;
+}
+
 bool
 Watchdog::memoryLimitExceeded() {
   bool result;
@@ -157,6 +226,22 @@ Watchdog::updateThreadCounters() {
     fb303::fbData->setCounter(
         fmt::format("watchdog.evb_queue_size.{}", evb->getEvbName()),
         evb->getEvb()->getNotificationQueueSize());
+
+    // Record event loop health to identify saturated modules
+    const auto loopStats = evb->getLoopStats();
+    const auto& name = evb->getEvbName();
+    fb303::fbData->setCounter(
+        fmt::format("watchdog.evb.{}.loop_lag_us.p99", name),
+        loopStats.loopLagUs.getPercentile(99));
+    fb303::fbData->setCounter(
+        fmt::format("watchdog.evb.{}.loop_lag_us.max", name),
+        loopStats.loopLagUs.getMax());
+    fb303::fbData->setCounter(
+        fmt::format("watchdog.evb.{}.busy_time_us.p99", name),
+        loopStats.busyTimeUs.getPercentile(99));
+    fb303::fbData->setCounter(
+        fmt::format("watchdog.evb.{}.slow_loops", name),
+        loopStats.numSlowLoops);
   }
 }
 
@@ -197,6 +282,21 @@ Watchdog::updateQueueCounters() {
       fb303::fbData->setCounter(
           fmt::format("messaging.rw_queue.{}-{}.sent", qName, stat.queueId),
           stat.writes);
+
+      fb303::fbData->setCounter(
+          fmt::format(
+              "messaging.rw_queue.{}-{}.latency_us.p50", qName, stat.queueId),
+          stat.latencyP50Us);
+
+      fb303::fbData->setCounter(
+          fmt::format(
+              "messaging.rw_queue.{}-{}.latency_us.p99", qName, stat.queueId),
+          stat.latencyP99Us);
+
+      fb303::fbData->setCounter(
+          fmt::format(
+              "messaging.rw_queue.{}-{}.latency_us.max", qName, stat.queueId),
+          stat.latencyMaxUs);
     }
   }
 }
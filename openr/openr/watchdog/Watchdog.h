@@ -9,9 +9,11 @@
 
 #include <folly/container/F14Map.h>
 #include <folly/container/F14Set.h>
+#include <folly/futures/Future.h>
 #include <folly/io/async/AsyncTimeout.h>
 #include <openr/common/OpenrEventBase.h>
 #include <openr/config/Config.h>
+#include <openr/if/gen-cpp2/Types_types.h>
 #include <openr/messaging/ReplicateQueue.h>
 #include <openr/monitor/SystemMetrics.h>
 
@@ -34,6 +36,12 @@ class Watchdog final : public OpenrEventBase {
    */
   void addQueue(messaging::ReplicateQueueBase& q, const std::string& qName);
 
+  /**
+   * Get event loop stats of monitored event bases and latency stats of
+   * monitored queues
+   */
+  folly::SemiFuture<std::unique_ptr<thrift::RuntimeStats>> getRuntimeStats();
+
  private:
   // monitor thread status in case they get stuck
   void monitorThreadStatus();
@@ -47,6 +55,10 @@ class Watchdog final : public OpenrEventBase {
   // update counters for each ReplicatedQueue and its internal RWQueues
   void updateQueueCounters();
 
+  // collect runtime stats of monitored event bases and queues
+  std::vector<thrift::EventBaseStats> getEventBaseStats() const;
+  std::vector<thrift::QueueLatencyStats> getQueueLatencyStats() const;
+
   // force to abort, aka, crash process
   void fireCrash(const std::string& msg);
 
@@ -206,6 +206,37 @@ TEST_F(WatchdogTestFixture, QueueCounterReport) {
   teardownDummyEvb();
 }
 
+TEST_F(WatchdogTestFixture, RuntimeStats) {
+  setupDummyEvb();
+
+  messaging::ReplicateQueue<int> q;
+  auto reader = q.getReader();
+  watchdog_->addQueue(q, "Queue");
+
+  q.push(1);
+  /* sleep override */
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(1, reader.get().value());
+
+  auto stats = watchdog_->getRuntimeStats().get();
+  EXPECT_EQ(nodeId_, *stats->thisNodeName());
+
+  ASSERT_EQ(1, stats->eventBases()->size());
+  const auto& evbStats = stats->eventBases()->at(0);
+  EXPECT_EQ("dummyEvb", *evbStats.name());
+  EXPECT_LE(*evbStats.loopLagP50Us(), *evbStats.loopLagMaxUs());
+  EXPECT_LE(*evbStats.busyTimeP50Us(), *evbStats.busyTimeMaxUs());
+
+  ASSERT_EQ(1, stats->queues()->size());
+  const auto& queueStats = stats->queues()->at(0);
+  EXPECT_EQ("Queue-0", *queueStats.name());
+  EXPECT_EQ(1, *queueStats.reads());
+  EXPECT_EQ(0, *queueStats.size());
+  EXPECT_LE(10000, *queueStats.latencyMaxUs());
+
+  teardownDummyEvb();
+}
+
 int
 main(int argc, char* argv[]) {
   // Parse command line flags